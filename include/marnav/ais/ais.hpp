@@ -17,6 +17,7 @@ public:
 };
 
 std::unique_ptr<message> make_message(const std::vector<std::pair<std::string, uint32_t>> & v);
+std::unique_ptr<message> make_message(const raw & bits);
 std::vector<std::pair<std::string, uint32_t>> encode_message(const message & msg);
 
 uint8_t decode_armoring(char c);
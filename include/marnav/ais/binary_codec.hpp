@@ -0,0 +1,22 @@
+#ifndef MARNAV__AIS__BINARY_CODEC__HPP
+#define MARNAV__AIS__BINARY_CODEC__HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <marnav/ais/message.hpp>
+
+namespace marnav
+{
+namespace ais
+{
+void encode_binary(std::vector<uint8_t> & buffer, const message & msg);
+std::vector<uint8_t> encode_binary(const message & msg);
+
+std::unique_ptr<message> decode_binary(
+	const uint8_t * data, std::size_t size, std::size_t & pos);
+std::unique_ptr<message> decode_binary(const std::vector<uint8_t> & data);
+}
+}
+
+#endif
@@ -304,6 +304,7 @@ constexpr static const uint32_t second_not_available = 60;
 class message : public binary_data
 {
 	friend std::vector<std::pair<std::string, uint32_t>> encode_message(const message & msg);
+	friend void encode_binary(std::vector<uint8_t> & buffer, const message & msg);
 
 public:
 	virtual ~message() = default;
@@ -0,0 +1,100 @@
+#ifndef MARNAV__AIS__TARGET_PREDICTOR__HPP
+#define MARNAV__AIS__TARGET_PREDICTOR__HPP
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+#include <marnav/geo/position.hpp>
+#include <marnav/utils/mmsi.hpp>
+#include <marnav/utils/optional.hpp>
+
+namespace marnav
+{
+namespace ais
+{
+class message_01;
+class message_18;
+
+/// @brief Dead reckoning of AIS targets.
+///
+/// Keeps the last fix, speed, course and rate of turn of each target and
+/// extrapolates the positions to a requested time. This provides positions
+/// of all targets at the same time, even if they report only every few minutes.
+///
+/// The extrapolation uses a local approximation of the WGS84 ellipsoid
+/// around the last fix, which is accurate for distances of a few nautical
+/// miles. If the rate of turn is known, targets move on a circular arc.
+/// The state of all targets is stored in contiguous arrays, which makes
+/// advancing all targets a tight loop without any geodesic computation.
+///
+/// The time of a fix is not part of the AIS messages, it has to be provided
+/// by the caller, e.g. the time of reception.
+///
+/// Example:
+/// @code
+/// ais::target_predictor predictor;
+///
+/// // for each received position report
+/// predictor.update(ais::message_cast<ais::message_01>(msg), receive_time);
+///
+/// // for each frame
+/// std::vector<ais::target_predictor::prediction> targets;
+/// predictor.advance_all(std::chrono::system_clock::now(), targets);
+/// @endcode
+///
+class target_predictor
+{
+public:
+	using time_point = std::chrono::system_clock::time_point;
+
+	struct prediction {
+		utils::mmsi mmsi;
+		geo::position pos;
+	};
+
+	/// Default maximum time for which positions are extrapolated.
+	constexpr static std::chrono::seconds default_horizon = std::chrono::seconds{600};
+
+	explicit target_predictor(std::chrono::seconds horizon = default_horizon);
+
+	target_predictor(const target_predictor &) = default;
+	target_predictor(target_predictor &&) = default;
+
+	target_predictor & operator=(const target_predictor &) = default;
+	target_predictor & operator=(target_predictor &&) = default;
+
+	bool update(const message_01 & m, time_point t);
+	bool update(const message_18 & m, time_point t);
+	void update(const utils::mmsi & m, const geo::position & pos, double sog, double cog,
+		double rot, time_point t);
+
+	void remove(const utils::mmsi & m);
+	void expire(time_point t);
+
+	std::size_t size() const noexcept { return mmsi_.size(); }
+
+	utils::optional<geo::position> predict(const utils::mmsi & m, time_point t) const;
+	void advance_all(time_point t, std::vector<prediction> & result) const;
+
+private:
+	double horizon_; // [s]
+
+	std::unordered_map<utils::mmsi::value_type, std::size_t> index_;
+
+	// state of all targets, one entry per target
+	std::vector<utils::mmsi::value_type> mmsi_;
+	std::vector<double> time_; // [s] since epoch
+	std::vector<double> lat_; // [deg]
+	std::vector<double> lon_; // [deg]
+	std::vector<double> lat_scale_; // [deg/m]
+	std::vector<double> lon_scale_; // [deg/m]
+	std::vector<double> vn_; // [m/s] north component of speed
+	std::vector<double> ve_; // [m/s] east component of speed
+	std::vector<double> rot_; // [rad/s]
+
+	geo::position advance(std::size_t i, double t) const;
+};
+}
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef MARNAV__GEO__GEOFENCE__HPP
+#define MARNAV__GEO__GEOFENCE__HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <marnav/geo/polygon.hpp>
+#include <marnav/utils/mmsi.hpp>
+
+namespace marnav
+{
+namespace geo
+{
+
+/// @brief Indexed containment tests of positions against many polygonal zones.
+///
+/// All zones are preprocessed into a regular grid of cells. Each cell knows
+/// which zones cover it completely and, for zones whose boundary passes through
+/// the cell, the edges within the cell as well as whether the center of the cell
+/// is inside the zone. A query therefore only has to look at the edges of the one
+/// cell the position falls into, regardless of the number and the complexity
+/// of the zones.
+///
+/// In addition to the plain queries, the geofence keeps track of the zones
+/// each vessel (identified by its MMSI) is in, and reports transitions
+/// incrementally. As long as a vessel stays within a cell which is not crossed
+/// by any zone boundary, no test is performed at all.
+///
+/// The results are identical to `polygon::inside` for all positions.
+///
+/// @note Zones must not cross the date line (180W == 180E).
+///
+/// Example:
+/// @code
+/// geofence fence{0.01};
+/// const auto harbour = fence.add_zone(polygon{{...}});
+///
+/// std::vector<geofence::transition> events;
+/// fence.update(utils::mmsi{211000000}, {47.0, 8.0}, events);
+/// for (auto const & e : events) {
+///     if ((e.zone == harbour) && (e.type == geofence::transition_type::enter)) {
+///         // ...
+///     }
+/// }
+/// @endcode
+///
+class geofence
+{
+public:
+	using zone_id = uint32_t;
+
+	enum class transition_type { enter, exit };
+
+	struct transition {
+		utils::mmsi mmsi;
+		zone_id zone;
+		transition_type type;
+	};
+
+	/// Default size of a cell in degrees (latitude and longitude).
+	constexpr static double default_cell_size = 0.05;
+
+	explicit geofence(double cell_size = default_cell_size);
+
+	geofence(const geofence &) = default;
+	geofence(geofence &&) = default;
+
+	geofence & operator=(const geofence &) = default;
+	geofence & operator=(geofence &&) = default;
+
+	zone_id add_zone(const polygon & p);
+
+	std::size_t size() const noexcept { return zones_.size(); }
+	const polygon & get_zone(zone_id id) const;
+
+	std::vector<zone_id> zones_at(const position & p) const;
+	void zones_at(const position & p, std::vector<zone_id> & result) const;
+	bool inside(zone_id id, const position & p) const;
+
+	void update(const utils::mmsi & m, const position & p, std::vector<transition> & events);
+	void remove(const utils::mmsi & m, std::vector<transition> & events);
+	const std::vector<zone_id> & zones_of(const utils::mmsi & m) const;
+
+private:
+	using cell_key = uint64_t;
+
+	struct edge {
+		double ax;
+		double ay;
+		double bx;
+		double by;
+	};
+
+	struct entry {
+		zone_id zone;
+		bool center_inside;
+		std::vector<edge> edges;
+	};
+
+	struct cell {
+		std::vector<entry> entries;
+		bool has_edges = false;
+	};
+
+	struct vessel {
+		cell_key key;
+		std::size_t generation; ///< Number of zones at the last update.
+		std::vector<zone_id> zones;
+	};
+
+	double cell_size_;
+	std::vector<polygon> zones_;
+	std::unordered_map<cell_key, cell> cells_;
+	std::unordered_map<utils::mmsi::value_type, vessel> vessels_;
+	std::vector<zone_id> scratch_;
+
+	int64_t row_of(double lat) const;
+	int64_t col_of(double lon) const;
+	cell_key key_of(const position & p) const;
+	static cell_key make_key(int64_t row, int64_t col);
+	position center_of(cell_key key) const;
+
+	const cell * find_cell(cell_key key) const;
+	bool inside(const entry & e, cell_key key, const position & p) const;
+};
+}
+}
+
+#endif
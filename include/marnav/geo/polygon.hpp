@@ -0,0 +1,69 @@
+#ifndef MARNAV__GEO__POLYGON__HPP
+#define MARNAV__GEO__POLYGON__HPP
+
+#include <vector>
+#include <marnav/geo/position.hpp>
+
+namespace marnav
+{
+namespace geo
+{
+
+/// @brief This class represents a geographical polygon, defined by an
+/// outer ring and an arbitrary number of holes.
+///
+/// The rings are closed implicitly, the last point must not repeat the first
+/// one. Latitude and longitude are treated as planar coordinates, which is
+/// fine for zones of the size of ports or traffic separation schemes.
+///
+/// @note Polygons must not cross the date line (180W == 180E).
+///
+/// Example:
+/// @code
+/// polygon p{{{1.0, 1.0}, {1.0, 2.0}, {0.0, 2.0}, {0.0, 1.0}}};
+/// p.add_hole({{0.6, 1.4}, {0.6, 1.6}, {0.4, 1.6}, {0.4, 1.4}});
+///
+/// p.inside({0.8, 1.2}); // true
+/// p.inside({0.5, 1.5}); // false, inside the hole
+/// @endcode
+///
+class polygon
+{
+public:
+	using ring = std::vector<position>;
+
+	polygon() = delete;
+	explicit polygon(const ring & outer);
+	polygon(const ring & outer, const std::vector<ring> & holes);
+
+	polygon(const polygon &) = default;
+	polygon(polygon &&) noexcept = default;
+
+	polygon & operator=(const polygon &) = default;
+	polygon & operator=(polygon &&) noexcept = default;
+
+	void add_hole(const ring & hole);
+
+	const ring & outer() const { return outer_; }
+	const std::vector<ring> & holes() const { return holes_; }
+
+	latitude top() const { return top_; }
+	latitude bottom() const { return bottom_; }
+	longitude left() const { return left_; }
+	longitude right() const { return right_; }
+
+	bool inside(const position & p) const;
+
+private:
+	ring outer_;
+	std::vector<ring> holes_;
+
+	latitude top_;
+	latitude bottom_;
+	longitude left_;
+	longitude right_;
+};
+}
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef MARNAV__GEO__TRACK__HPP
+#define MARNAV__GEO__TRACK__HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <marnav/geo/position.hpp>
+
+namespace marnav
+{
+namespace geo
+{
+
+/// @brief A position of a track together with the time of the report.
+struct track_point {
+	position pos;
+	std::chrono::system_clock::time_point time;
+};
+
+/// @brief Streaming simplification of tracks.
+///
+/// Reduces the number of points of a track, while guaranteeing a maximum
+/// cross track error of all dropped points with respect to the simplified track.
+/// Points are pushed one at a time, the points to keep are appended to an output
+/// container as soon as they are known (opening window algorithm).
+///
+/// The state per track is bounded by the capacity of the window. If the window
+/// is full, the newest point in it is kept, regardless of the error.
+///
+/// Distances and azimuths are computed using `distance_ellipsoid_vincenty`,
+/// only one such computation is necessary per pushed point.
+///
+/// Example:
+/// @code
+/// track_simplifier simplifier{10.0}; // 10 meters
+/// std::vector<track_point> track;
+///
+/// for (auto const & p : reports)
+///     simplifier.push(p, track);
+/// simplifier.flush(track);
+/// @endcode
+///
+class track_simplifier
+{
+public:
+	/// Default maximum number of points within the window.
+	constexpr static std::size_t default_capacity = 64;
+
+	explicit track_simplifier(double tolerance, std::size_t capacity = default_capacity);
+
+	track_simplifier(const track_simplifier &) = default;
+	track_simplifier(track_simplifier &&) = default;
+
+	track_simplifier & operator=(const track_simplifier &) = default;
+	track_simplifier & operator=(track_simplifier &&) = default;
+
+	double tolerance() const noexcept { return tolerance_; }
+	std::size_t capacity() const noexcept { return capacity_; }
+
+	void push(const track_point & p, std::vector<track_point> & result);
+	void flush(std::vector<track_point> & result);
+	void reset();
+
+private:
+	/// A point of the window, with its distance [m] and azimuth [rad] relative
+	/// to the anchor.
+	struct sample {
+		track_point point;
+		double distance;
+		double azimuth;
+	};
+
+	double tolerance_;
+	std::size_t capacity_;
+	bool has_anchor_ = false;
+	track_point anchor_;
+	std::vector<sample> window_;
+
+	sample make_sample(const track_point & p) const;
+	bool within_tolerance(const sample & candidate) const;
+};
+
+/// @brief Compact binary encoding of tracks.
+///
+/// The format consists of a two byte magic (`'M'`, `'T'`), a version byte and
+/// the points. Each point is stored as difference to its predecessor:
+/// latitude and longitude in 1e-7 degrees (approx. 1cm) and time in
+/// milliseconds, all three as zig-zag encoded variable length integers.
+/// The first point is stored relative to zero.
+///
+/// Typical reports of vessels need 6 to 9 bytes per point.
+///
+/// Points can be appended at any time, the encoded data is always complete.
+class track_encoder
+{
+public:
+	constexpr static uint8_t version = 1;
+
+	track_encoder();
+
+	void append(const track_point & p);
+
+	std::size_t size() const noexcept { return size_; }
+	const std::vector<uint8_t> & data() const noexcept { return data_; }
+
+private:
+	std::vector<uint8_t> data_;
+	std::size_t size_ = 0;
+	int64_t lat_ = 0;
+	int64_t lon_ = 0;
+	int64_t time_ = 0;
+
+	void append_value(int64_t value);
+};
+
+std::vector<track_point> decode_track(const uint8_t * data, std::size_t size);
+std::vector<track_point> decode_track(const std::vector<uint8_t> & data);
+}
+}
+
+#endif
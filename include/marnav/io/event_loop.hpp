@@ -0,0 +1,112 @@
+#ifndef MARNAV__IO__EVENT_LOOP__HPP
+#define MARNAV__IO__EVENT_LOOP__HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <marnav/io/device.hpp>
+#include <marnav/seatalk/message.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Single threaded event loop, servicing many devices at once.
+///
+/// Devices must implement `selectable` in addition to `device`. They are
+/// registered with `epoll(7)`, all data available is read and fed into
+/// a framer per device. Complete NMEA sentences or SeaTalk messages are
+/// dispatched to the handler of the device.
+///
+/// Timers are processed by the same loop. Handlers of devices and timers
+/// are called from the thread executing `run` or `run_once`, they may
+/// add or remove devices and timers, and stop the loop.
+///
+/// Devices which reach the end of file or fail to read are removed
+/// from the loop and closed.
+///
+/// @note This is Linux specific.
+///
+/// Example:
+/// @code
+/// io::event_loop loop;
+/// for (auto const & port : ports) {
+///     loop.add_nmea(io::make_default_nmea_serial(port), [](const std::string & s) {
+///         auto sentence = nmea::make_sentence(s);
+///         // ...
+///     });
+/// }
+/// loop.add_timer(std::chrono::seconds{1}, []() { /* ... */ });
+/// loop.run();
+/// @endcode
+///
+class event_loop
+{
+public:
+	using source_id = uint64_t;
+	using timer_id = uint64_t;
+	using clock = std::chrono::steady_clock;
+
+	using nmea_handler = std::function<void(const std::string &)>;
+	using seatalk_handler = std::function<void(const seatalk::raw &)>;
+	using timer_handler = std::function<void()>;
+
+	event_loop();
+	~event_loop();
+
+	event_loop(const event_loop &) = delete;
+	event_loop(event_loop &&) = delete;
+
+	event_loop & operator=(const event_loop &) = delete;
+	event_loop & operator=(event_loop &&) = delete;
+
+	source_id add_nmea(std::unique_ptr<device> && dev, nmea_handler handler);
+	source_id add_seatalk(std::unique_ptr<device> && dev, seatalk_handler handler);
+	void remove(source_id id);
+	std::size_t size() const noexcept { return sources_.size(); }
+
+	timer_id add_timer(clock::duration interval, timer_handler handler, bool repeat = true);
+	void cancel_timer(timer_id id);
+
+	std::size_t run_once(int timeout_ms = -1);
+	void run();
+	void stop() noexcept { stopped_ = true; }
+
+private:
+	class source;
+	class nmea_source;
+	class seatalk_source;
+
+	struct timer {
+		clock::time_point deadline;
+		clock::duration interval;
+		bool repeat;
+		timer_handler handler;
+	};
+
+	using deadline_entry = std::pair<clock::time_point, timer_id>;
+
+	int epfd_;
+	bool stopped_ = false;
+	source_id next_source_ = 1;
+	timer_id next_timer_ = 1;
+	std::unordered_map<source_id, std::unique_ptr<source>> sources_;
+	std::vector<std::unique_ptr<source>> removed_;
+	std::unordered_map<timer_id, timer> timers_;
+	std::priority_queue<deadline_entry, std::vector<deadline_entry>, std::greater<deadline_entry>>
+		deadlines_;
+	std::vector<char> buffer_;
+
+	source_id add(std::unique_ptr<source> && s);
+	int next_timeout(int timeout_ms) const;
+	std::size_t process_timers();
+};
+}
+}
+
+#endif
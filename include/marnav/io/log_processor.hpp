@@ -0,0 +1,111 @@
+#ifndef MARNAV__IO__LOG_PROCESSOR__HPP
+#define MARNAV__IO__LOG_PROCESSOR__HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <marnav/ais/message.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/sentence_filter.hpp>
+
+namespace marnav
+{
+namespace io
+{
+class mapped_file;
+
+/// @brief Parses recorded NMEA data from memory, using multiple threads.
+///
+/// The data, typically a `mapped_file`, is split into chunks of approximately
+/// the configured size. Chunks always end after a line feed, therefore no
+/// sentence is split between chunks. The chunks are parsed by worker threads
+/// (`nmea::make_sentence`), AIS messages are assembled from VDM/VDO fragments
+/// (`ais::make_message`).
+///
+/// The results are delivered to the handler in the order they appear in
+/// the data, as if the data was processed by one thread. This includes AIS
+/// messages whose fragments are spread over two or more chunks, they are
+/// assembled when the results are merged.
+///
+/// The handler is called by the thread calling `run`, while the workers
+/// parse the following chunks. The number of chunks parsed ahead is limited,
+/// the memory used does not depend on the size of the data.
+///
+/// Sentences which cannot be parsed are counted as errors and not delivered.
+/// Sentences rejected by the filter (see `set_filter`) are not parsed at all.
+///
+/// Example:
+/// @code
+/// io::mapped_file file{"recording.nmea"};
+/// file.open();
+/// io::log_processor p{file, io::log_processor::options{4}};
+/// const auto stats = p.run([](io::log_processor::result && r) {
+///     if (r.message) {
+///         // ...
+///     }
+/// });
+/// @endcode
+class log_processor
+{
+public:
+	struct options {
+		options(std::size_t t = 0, std::size_t c = 1024 * 1024)
+			: threads(t)
+			, chunk_size(c)
+		{
+		}
+
+		std::size_t threads; ///< Number of parser threads, zero: one per core.
+		std::size_t chunk_size; ///< Approximate size of a chunk in bytes.
+	};
+
+	/// A parsed sentence. If the sentence completes an AIS message,
+	/// the message is provided as well.
+	struct result {
+		std::unique_ptr<nmea::sentence> sentence;
+		std::unique_ptr<ais::message> message;
+	};
+
+	struct stats {
+		uint64_t chunks = 0; ///< Number of chunks processed.
+		uint64_t sentences = 0; ///< Sentences delivered.
+		uint64_t messages = 0; ///< AIS messages delivered.
+		uint64_t overflows = 0; ///< Sentences too long for the framer.
+		uint64_t errors = 0; ///< Sentences or AIS messages failed to parse.
+		uint64_t filtered = 0; ///< Sentences rejected by the filter.
+	};
+
+	using handler = std::function<void(result &&)>;
+
+	log_processor() = delete;
+	log_processor(const char * data, std::size_t size, const options & opt = options{});
+	explicit log_processor(const mapped_file & file, const options & opt = options{});
+
+	log_processor(const log_processor &) = default;
+	log_processor(log_processor &&) = default;
+
+	log_processor & operator=(const log_processor &) = default;
+	log_processor & operator=(log_processor &&) = default;
+
+	void set_filter(const nmea::sentence_filter & f) { filter_ = f; }
+	const nmea::sentence_filter & get_filter() const noexcept { return filter_; }
+
+	/// Returns the number of parser threads used by `run`.
+	std::size_t get_threads() const noexcept { return opt_.threads; }
+
+	stats run(const handler & h) const;
+
+	static std::vector<std::size_t> split(
+		const char * data, std::size_t size, std::size_t chunk_size);
+
+private:
+	const char * data_;
+	std::size_t size_;
+	options opt_;
+	nmea::sentence_filter filter_;
+};
+}
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef MARNAV__IO__LOG_REPLAY__HPP
+#define MARNAV__IO__LOG_REPLAY__HPP
+
+#include <chrono>
+#include <string>
+#include <marnav/io/nmea_framer.hpp>
+
+namespace marnav
+{
+namespace io
+{
+class mapped_file;
+
+/// @brief Replays recorded NMEA data from memory.
+///
+/// Reads sentences from a contiguous span of bytes, typically a `mapped_file`,
+/// and optionally paces their delivery according to the time stamps of their
+/// tag blocks (`c:` parameter, UNIX time in seconds or milliseconds).
+///
+/// The speed factor controls the pacing:
+/// - `0.0`: as fast as possible (default)
+/// - `1.0`: real time
+/// - `N`: N times faster than real time
+///
+/// Sentences without time stamp are delivered immediately.
+///
+/// Example:
+/// @code
+/// io::mapped_file file{"recording.nmea"};
+/// file.open();
+/// io::log_replay replay{file, 10.0};
+/// std::string s;
+/// while (replay.read_sentence(s)) {
+///     auto sentence = nmea::make_sentence(s);
+///     // ...
+/// }
+/// @endcode
+class log_replay
+{
+public:
+	log_replay() = delete;
+	log_replay(const char * data, std::size_t size, double speed = 0.0);
+	explicit log_replay(const mapped_file & file, double speed = 0.0);
+
+	log_replay(const log_replay &) = default;
+	log_replay(log_replay &&) = default;
+
+	log_replay & operator=(const log_replay &) = default;
+	log_replay & operator=(log_replay &&) = default;
+
+	bool read_sentence(std::string & s);
+
+	void set_speed(double speed);
+	double get_speed() const noexcept { return speed_; }
+
+	void rewind();
+
+	/// Returns the number of bytes processed.
+	std::size_t tell() const noexcept { return pos_; }
+
+private:
+	const char * data_;
+	std::size_t size_;
+	std::size_t pos_ = 0;
+	double speed_;
+	nmea_framer framer_;
+
+	bool started_ = false;
+	double first_time_ = 0.0; // [s]
+	std::chrono::steady_clock::time_point start_;
+
+	void pace(const std::string & s);
+};
+}
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef MARNAV__IO__MAPPED_FILE__HPP
+#define MARNAV__IO__MAPPED_FILE__HPP
+
+#include <string>
+#include <marnav/io/device.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Read only access to a file, mapped into memory.
+///
+/// The contents of the file are accessible as contiguous span of bytes,
+/// which can be fed into a framer (e.g. `nmea_framer`) directly. The kernel
+/// is advised, that the file will be read sequentially.
+///
+/// It is also possible to use the file as a normal device, however this
+/// means copying the data.
+///
+/// Example:
+/// @code
+/// io::mapped_file file{"recording.nmea"};
+/// file.open();
+/// io::nmea_framer framer;
+/// framer.feed(file.data(), file.size(), [](const std::string & s) {
+///     // ...
+/// });
+/// @endcode
+///
+/// @note This is POSIX specific.
+class mapped_file : public device
+{
+public:
+	virtual ~mapped_file();
+
+	mapped_file() = delete;
+	explicit mapped_file(const std::string & filename);
+	mapped_file(const mapped_file &) = delete;
+	mapped_file(mapped_file &&) noexcept;
+
+	mapped_file & operator=(const mapped_file &) = delete;
+	mapped_file & operator=(mapped_file &&) noexcept;
+
+	virtual void open() override;
+	virtual void close() override;
+	virtual int read(char * buffer, uint32_t size) override;
+	virtual int write(const char * buffer, uint32_t size) override;
+
+	/// Returns a pointer to the contents of the file, `nullptr` if the file
+	/// is not open or empty.
+	const char * data() const noexcept { return data_; }
+
+	/// Returns the size of the file in bytes, zero if the file is not open.
+	std::size_t size() const noexcept { return size_; }
+
+	/// Returns the current read position of the device.
+	std::size_t tell() const noexcept { return pos_; }
+
+	void seek(std::size_t pos);
+
+private:
+	std::string filename_;
+	const char * data_ = nullptr;
+	std::size_t size_ = 0;
+	std::size_t pos_ = 0;
+	bool open_ = false;
+};
+}
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef MARNAV__IO__METRICS__HPP
+#define MARNAV__IO__METRICS__HPP
+
+#include <marnav/ais/message.hpp>
+#include <marnav/nmea/sentence_id.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace marnav
+{
+namespace nmea
+{
+class sentence; // forward declaration
+}
+
+namespace io
+{
+/// @brief Histogram of durations, with fixed buckets.
+///
+/// The upper bounds of the buckets are powers of two microseconds, from
+/// 1us up to 16.384ms. The last bucket holds all longer durations.
+///
+/// Recording is lock-free, using only relaxed atomic operations. It may be
+/// read from any thread at any time, the buckets are not guaranteed to be
+/// consistent among each other while recording is going on.
+class latency_histogram
+{
+public:
+	static constexpr std::size_t num_buckets = 16;
+
+	struct snapshot {
+		std::array<uint64_t, num_buckets> buckets = {{}}; ///< Not cumulative.
+		uint64_t count = 0;
+		std::chrono::nanoseconds sum{0};
+	};
+
+	latency_histogram() noexcept;
+	latency_histogram(const latency_histogram &) = delete;
+	latency_histogram & operator=(const latency_histogram &) = delete;
+
+	void record(std::chrono::nanoseconds d) noexcept;
+	snapshot get() const noexcept;
+
+	static std::chrono::nanoseconds upper_bound(std::size_t bucket) noexcept;
+
+private:
+	std::array<std::atomic<uint64_t>, num_buckets> buckets_;
+	std::atomic<uint64_t> sum_;
+};
+
+/// @brief Counters and parse latencies of a stream of data, e.g. a reader
+///   or a device of a pipeline.
+///
+/// All counters are relaxed atomics, there is one writer (the thread
+/// reading or parsing the stream) and any number of readers, taking
+/// snapshots. The cost of recording is a few atomic additions, the
+/// metrics are meant to be enabled in production.
+///
+/// Example:
+/// @code
+/// auto metrics = std::make_shared<io::stream_metrics>();
+/// reader.set_metrics(metrics);
+/// // ...
+/// io::write_prometheus(std::cout, "ttyUSB0", metrics->get());
+/// @endcode
+class stream_metrics
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	/// Events counted per stream.
+	enum class event : std::size_t {
+		bytes, ///< Bytes received.
+		frames, ///< Complete sentences or messages delivered by the framer.
+		filtered, ///< Sentences rejected by a filter.
+		overflows, ///< Sentences too long, the framer discarded data to resynchronize.
+		checksum_errors, ///< Sentences with wrong checksums.
+		unknown_sentences, ///< Sentences not supported.
+		parse_errors, ///< Sentences failed to parse, other than above.
+		ais_errors, ///< AIS messages failed to parse or not supported.
+		collisions, ///< SeaTalk bus collisions.
+		bus_errors, ///< SeaTalk bus errors.
+	};
+
+	static constexpr std::size_t num_events = 10;
+
+	/// Number of sentence IDs, all IDs up to `nmea::sentence_id::STALK`.
+	static constexpr std::size_t num_sentence_ids
+		= static_cast<std::size_t>(nmea::sentence_id::STALK) + 1;
+
+	/// Number of AIS message types, 0..27.
+	static constexpr std::size_t num_message_ids
+		= static_cast<std::size_t>(ais::message_id::position_report_for_long_range_applications)
+		+ 1;
+
+	struct sentence_snapshot {
+		nmea::sentence_id id;
+		latency_histogram::snapshot latency;
+	};
+
+	struct message_snapshot {
+		ais::message_id id;
+		latency_histogram::snapshot latency;
+	};
+
+	struct snapshot {
+		clock::time_point time;
+		std::array<uint64_t, num_events> events = {{}};
+		std::vector<sentence_snapshot> sentences; ///< Parsed sentences, only present IDs.
+		std::vector<message_snapshot> messages; ///< Parsed AIS messages, only present types.
+
+		uint64_t get(event e) const noexcept { return events[static_cast<std::size_t>(e)]; }
+	};
+
+	stream_metrics() noexcept;
+	stream_metrics(const stream_metrics &) = delete;
+	stream_metrics & operator=(const stream_metrics &) = delete;
+
+	/// Counts the event.
+	void count(event e, uint64_t n = 1) noexcept
+	{
+		events_[static_cast<std::size_t>(e)].fetch_add(n, std::memory_order_relaxed);
+	}
+
+	void record(nmea::sentence_id id, clock::duration d) noexcept;
+	void record(ais::message_id id, clock::duration d) noexcept;
+
+	snapshot get() const;
+
+private:
+	std::array<std::atomic<uint64_t>, num_events> events_;
+	std::array<latency_histogram, num_sentence_ids> sentences_;
+	std::array<latency_histogram, num_message_ids> messages_;
+};
+
+std::string to_string(stream_metrics::event e);
+
+double rate(const stream_metrics::snapshot & from, const stream_metrics::snapshot & to,
+	stream_metrics::event e);
+
+std::unique_ptr<nmea::sentence> parse_sentence(const std::string & s, stream_metrics & m);
+std::unique_ptr<ais::message> parse_message(
+	const std::vector<std::pair<std::string, uint32_t>> & payload, stream_metrics & m);
+
+void write_prometheus(std::ostream & os, const std::string & stream,
+	const stream_metrics::snapshot & s);
+void write_prometheus(std::ostream & os,
+	const std::vector<std::pair<std::string, stream_metrics::snapshot>> & streams);
+}
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef MARNAV__IO__MULTIPLEXER__HPP
+#define MARNAV__IO__MULTIPLEXER__HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <marnav/io/device.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Forwards NMEA sentences from many inputs to many outputs.
+///
+/// Sentences received from the inputs are validated (`nmea::validate_sentence`),
+/// but not parsed. Valid sentences are routed to all outputs whose filter
+/// matches the talker and the tag of the sentence.
+///
+/// Every output has its own bounded queue of sentences. Queued sentences are
+/// written without blocking, as many as possible at once (`writev`). A slow
+/// output does not stall the others, if its queue is full, new sentences for
+/// this output are dropped and counted.
+///
+/// All devices must implement `selectable` in addition to `device`, the file
+/// descriptors of the outputs are switched to non-blocking mode.
+///
+/// The multiplexer runs in the thread calling `run` or `run_once`. Sentences
+/// from other sources can be routed using `dispatch`.
+///
+/// @note This is POSIX specific.
+///
+/// Example:
+/// @code
+/// io::multiplexer mux;
+/// mux.add_input(io::make_default_nmea_serial("/dev/ttyUSB0"));
+/// mux.add_output(io::make_default_nmea_serial("/dev/ttyUSB1"));
+/// mux.add_output(io::make_default_nmea_serial("/dev/ttyUSB2"), {{"GP"}, {"RMC", "GGA"}});
+/// mux.run();
+/// @endcode
+class multiplexer
+{
+public:
+	using input_id = std::size_t;
+	using output_id = std::size_t;
+
+	/// Routing filter of an output. A sentence passes, if its talker is one of
+	/// `talkers` and its tag one of `tags`. Empty lists let everything pass.
+	/// Proprietary sentences have no talker, their tag is the complete address.
+	struct filter {
+		std::vector<std::string> talkers; ///< e.g. `GP`, `AI`
+		std::vector<std::string> tags; ///< e.g. `RMC`, `VDM`, `PGRME`
+
+		bool matches(const std::string & talker, const std::string & tag) const;
+	};
+
+	/// Counters of an output.
+	struct output_stats {
+		std::size_t depth = 0; ///< Number of queued sentences.
+		std::size_t max_depth = 0; ///< Highest number of queued sentences so far.
+		uint64_t sent = 0; ///< Number of completely written sentences.
+		uint64_t dropped = 0; ///< Number of sentences dropped because the queue was full.
+		uint64_t errors = 0; ///< Number of write errors.
+		uint64_t writes = 0; ///< Number of write system calls.
+	};
+
+	static constexpr std::size_t default_queue_size = 256;
+
+	multiplexer();
+	~multiplexer();
+
+	multiplexer(const multiplexer &) = delete;
+	multiplexer(multiplexer &&) = delete;
+
+	multiplexer & operator=(const multiplexer &) = delete;
+	multiplexer & operator=(multiplexer &&) = delete;
+
+	input_id add_input(std::unique_ptr<device> && dev);
+	output_id add_output(std::unique_ptr<device> && dev, const filter & f = filter{},
+		std::size_t queue_size = default_queue_size);
+
+	std::size_t dispatch(const std::string & s);
+	std::size_t flush();
+
+	std::size_t run_once(int timeout_ms = -1);
+	void run();
+	void stop() noexcept { stopped_ = true; }
+
+	/// Returns the number of inputs, which are still active.
+	std::size_t inputs() const noexcept;
+	std::size_t outputs() const noexcept { return outputs_.size(); }
+
+	output_stats get_output_stats(output_id id) const;
+
+	/// Returns the number of sentences, which were not valid.
+	uint64_t get_invalid() const noexcept { return invalid_; }
+
+private:
+	class input;
+	class output;
+
+	std::vector<std::unique_ptr<input>> inputs_;
+	std::vector<std::unique_ptr<output>> outputs_;
+	std::vector<char> buffer_;
+	uint64_t invalid_ = 0;
+	bool stopped_ = false;
+};
+}
+}
+
+#endif
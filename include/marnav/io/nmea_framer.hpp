@@ -0,0 +1,113 @@
+#ifndef MARNAV__IO__NMEA_FRAMER__HPP
+#define MARNAV__IO__NMEA_FRAMER__HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Splits a stream of characters into NMEA sentences.
+///
+/// The framer does not perform any IO, it is fed with data from arbitrary
+/// sources, one character at a time or in chunks of any size. Carriage
+/// returns, control and non-ASCII characters are ignored, sentences are
+/// terminated by a line feed. Empty lines are ignored.
+///
+/// If a sentence gets too long (probably the end of line was missed),
+/// the partial sentence is discarded and all data up to the next end of
+/// line is ignored. This is reported as overflow. Lines starting with a
+/// tag block (`\`) may exceed the maximum length of a sentence by the
+/// maximum length of a tag block.
+///
+/// Optionally, the data can be fed together with its time of reception
+/// (e.g. from `serial::read`). The framer provides the time of the first
+/// character of every sentence.
+///
+/// Example:
+/// @code
+/// nmea_framer framer;
+/// framer.feed(buffer, size, [](const std::string & s) { std::cout << s << '\n'; });
+/// @endcode
+class nmea_framer
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	enum class status { none, complete, overflow };
+
+	/// Default maximum length of a tag block, including its delimiters.
+	static constexpr std::size_t default_max_tag_block_length = 82;
+
+	nmea_framer();
+	nmea_framer(std::size_t max_length, std::size_t max_tag_block_length);
+	nmea_framer(const nmea_framer &) = default;
+	nmea_framer(nmea_framer &&) = default;
+
+	nmea_framer & operator=(const nmea_framer &) = default;
+	nmea_framer & operator=(nmea_framer &&) = default;
+
+	status feed(char c);
+	status feed(char c, clock::time_point t);
+
+	/// Processes all characters of the buffer, the handler is called for
+	/// every complete sentence.
+	///
+	/// @param[in] data The data to process.
+	/// @param[in] size Number of characters.
+	/// @param[in] handler Function object callable with `const std::string &`.
+	template <class Handler> void feed(const char * data, std::size_t size, Handler && handler)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+			if (feed(data[i]) == status::complete)
+				handler(sentence_);
+	}
+
+	/// Processes all characters of the buffer, which were received at the
+	/// specified time. The handler is called for every complete sentence.
+	///
+	/// @param[in] data The data to process.
+	/// @param[in] size Number of characters.
+	/// @param[in] t Time of reception of the data.
+	/// @param[in] handler Function object callable with `const std::string &`.
+	template <class Handler>
+	void feed(const char * data, std::size_t size, clock::time_point t, Handler && handler)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+			if (feed(data[i], t) == status::complete)
+				handler(sentence_);
+	}
+
+	/// Returns the last complete sentence. Valid only until the next character
+	/// is fed into the framer.
+	const std::string & sentence() const noexcept { return sentence_; }
+
+	/// Returns the time of reception of the first character of the last
+	/// complete sentence. This is the epoch of the clock, if the data was
+	/// fed without time. Valid only until the next character is fed into
+	/// the framer.
+	clock::time_point timestamp() const noexcept { return start_; }
+
+	void reset();
+
+	uint64_t get_overflows() const noexcept { return overflows_; }
+	std::size_t get_max_length() const noexcept { return max_length_; }
+	std::size_t get_max_tag_block_length() const noexcept { return max_tag_block_length_; }
+
+private:
+	std::size_t max_length_;
+	std::size_t max_tag_block_length_;
+	std::string sentence_;
+	clock::time_point start_;
+	bool complete_ = false;
+	bool overflow_ = false;
+	uint64_t overflows_ = 0;
+
+	std::size_t limit() const noexcept;
+};
+}
+}
+
+#endif
@@ -2,7 +2,10 @@
 #define MARNAV__IO__NMEA_READER__HPP
 
 #include <marnav/io/device.hpp>
+#include <marnav/io/metrics.hpp>
+#include <marnav/io/nmea_framer.hpp>
 #include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/sentence_filter.hpp>
 
 namespace marnav
 {
@@ -15,6 +18,12 @@ namespace io
 ///
 /// This reader opens the device upon construction.
 ///
+/// Sentences rejected by the filter (see `set_filter`) are skipped, they are
+/// not passed to `process_sentence`.
+///
+/// If metrics are set (see `set_metrics`), received bytes, sentences, filtered
+/// sentences and overflows are counted.
+///
 class nmea_reader
 {
 public:
@@ -30,6 +39,14 @@ public:
 	void close();
 	bool read();
 
+	/// Sets the filter for received sentences, may be changed any time.
+	void set_filter(const nmea::sentence_filter & f) { filter_ = f; }
+	const nmea::sentence_filter & get_filter() const noexcept { return filter_; }
+
+	/// Sets the metrics to count into, `nullptr` disables counting.
+	void set_metrics(std::shared_ptr<stream_metrics> m) { metrics_ = std::move(m); }
+	std::shared_ptr<stream_metrics> get_metrics() const { return metrics_; }
+
 protected:
 	virtual void process_sentence(const std::string &) = 0;
 
@@ -38,7 +55,9 @@ private:
 	bool read_data();
 
 	char raw_;
-	std::string sentence_;
+	nmea_framer framer_;
+	nmea::sentence_filter filter_;
+	std::shared_ptr<stream_metrics> metrics_;
 	std::unique_ptr<device> dev_; ///< Device to read data from.
 };
 }
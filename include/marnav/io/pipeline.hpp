@@ -0,0 +1,156 @@
+#ifndef MARNAV__IO__PIPELINE__HPP
+#define MARNAV__IO__PIPELINE__HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <marnav/ais/message.hpp>
+#include <marnav/io/device.hpp>
+#include <marnav/io/metrics.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/sentence_filter.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Multi threaded reading and parsing of NMEA data from many devices.
+///
+/// Every device is read by its own thread, the data is split into sentences
+/// which are queued into a lock-free ring of fixed size slots. A configurable
+/// number of worker threads parse the sentences (`nmea::make_sentence`) and
+/// assemble AIS messages from VDM/VDO fragments (`ais::make_message`). The
+/// results are queued into another ring per device, from which they are
+/// taken by `poll`.
+///
+/// Every device is assigned to exactly one worker, therefore the results
+/// of a device are delivered in the order they were received. There is no
+/// order between devices.
+///
+/// If a ring is full, the behaviour is defined by the backpressure policy:
+/// - `block`: the producing thread waits until there is space in the ring
+/// - `drop_oldest`: the oldest entry of the ring is discarded
+/// - `drop_newest`: the new entry is discarded
+///
+/// Sentences which cannot be parsed are counted as errors and not delivered.
+/// If an AIS message cannot be assembled or is not supported, the sentence
+/// completing it is still delivered, without message, and counted as AIS error.
+/// Sentences rejected by the filter (see `set_filter`) are discarded by the
+/// reading threads, before they are queued.
+///
+/// Every device has its metrics (see `get_metrics`), counting received
+/// bytes and sentences, parse errors and parse times per sentence ID and
+/// AIS message type.
+///
+/// Threads reading devices which are `selectable` check regularly, if the
+/// pipeline is about to be stopped. Other devices must not block forever.
+///
+/// @note This is POSIX specific.
+///
+/// Example:
+/// @code
+/// io::pipeline p{io::pipeline::options{4, 1024, io::pipeline::backpressure::drop_oldest}};
+/// for (auto const & port : ports)
+///     p.add(io::make_default_nmea_serial(port));
+/// p.start();
+/// while (!p.done()) {
+///     if (p.poll([](io::pipeline::result && r) { /* ... */ }) == 0)
+///         std::this_thread::sleep_for(std::chrono::milliseconds{1});
+/// }
+/// @endcode
+class pipeline
+{
+public:
+	using source_id = std::size_t;
+
+	enum class backpressure { block, drop_oldest, drop_newest };
+
+	struct options {
+		options(std::size_t w = 1, std::size_t q = 1024, backpressure p = backpressure::block)
+			: workers(w)
+			, queue_size(q)
+			, policy(p)
+		{
+		}
+
+		std::size_t workers; ///< Number of parser threads.
+		std::size_t queue_size; ///< Number of entries per ring.
+		backpressure policy;
+	};
+
+	/// A parsed sentence. If the sentence completes an AIS message,
+	/// the message is provided as well, unless it failed to parse.
+	struct result {
+		source_id source = 0;
+		std::unique_ptr<nmea::sentence> sentence;
+		std::unique_ptr<ais::message> message;
+	};
+
+	/// Counters of a ring between two stages.
+	struct stage_stats {
+		std::size_t depth = 0; ///< Current number of entries.
+		std::size_t max_depth = 0; ///< Highest number of entries so far.
+		uint64_t processed = 0; ///< Entries taken from the ring.
+		uint64_t dropped = 0; ///< Entries discarded by backpressure.
+	};
+
+	/// Counters of a device, input is the ring of raw sentences,
+	/// output is the ring of parsed sentences.
+	struct stats {
+		stage_stats input;
+		stage_stats output;
+		uint64_t overflows = 0; ///< Sentences too long for the framer.
+		uint64_t errors = 0; ///< Sentences failed to parse.
+		uint64_t ais_errors = 0; ///< AIS messages failed to parse or not supported.
+		uint64_t filtered = 0; ///< Sentences rejected by the filter.
+	};
+
+	using handler = std::function<void(result &&)>;
+
+	explicit pipeline(const options & opt = options{});
+	~pipeline();
+
+	pipeline(const pipeline &) = delete;
+	pipeline(pipeline &&) = delete;
+
+	pipeline & operator=(const pipeline &) = delete;
+	pipeline & operator=(pipeline &&) = delete;
+
+	source_id add(std::unique_ptr<device> && dev);
+	void set_filter(const nmea::sentence_filter & f);
+	std::size_t size() const noexcept { return sources_.size(); }
+
+	void start();
+	void stop();
+
+	std::size_t poll(const handler & h, std::size_t max = std::numeric_limits<std::size_t>::max());
+	bool done() const;
+
+	stats get_stats(source_id id) const;
+	std::shared_ptr<const stream_metrics> get_metrics(source_id id) const;
+
+private:
+	class source;
+
+	options opt_;
+	nmea::sentence_filter filter_;
+	std::vector<std::unique_ptr<source>> sources_;
+	std::vector<std::thread> threads_;
+	bool started_ = false;
+	std::atomic<bool> running_{false};
+	std::atomic<std::size_t> active_workers_{0};
+	std::size_t next_poll_ = 0;
+
+	void read_loop(source & s);
+	void work_loop(std::size_t index);
+	bool process(source & s);
+};
+}
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef MARNAV__IO__SEATALK_FRAMER__HPP
+#define MARNAV__IO__SEATALK_FRAMER__HPP
+
+#include <chrono>
+#include <cstdint>
+#include <marnav/seatalk/message.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Splits a stream of bytes, read from a SeaTalk bus, into messages.
+///
+/// The data is expected as delivered by termios configured with `PARMRK`,
+/// which is used to distinguish command bytes from data bytes.
+/// The framer does not perform any IO, it is fed with data from arbitrary
+/// sources, one byte at a time or in chunks of any size.
+///
+/// Bytes which are not valid escape sequences are reported as error, the
+/// framer recovers automatically.
+///
+/// Optionally, the data can be fed together with its time of reception
+/// (e.g. from `serial::read`). The framer provides the time of the first
+/// byte of every message.
+class seatalk_framer
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	enum class status { none, complete, error };
+
+	seatalk_framer();
+	seatalk_framer(const seatalk_framer &) = default;
+	seatalk_framer(seatalk_framer &&) = default;
+
+	seatalk_framer & operator=(const seatalk_framer &) = default;
+	seatalk_framer & operator=(seatalk_framer &&) = default;
+
+	status feed(uint8_t c);
+	status feed(uint8_t c, clock::time_point t);
+
+	/// Processes all bytes of the buffer, the handler is called for
+	/// every complete message.
+	///
+	/// @param[in] data The data to process.
+	/// @param[in] size Number of bytes.
+	/// @param[in] handler Function object callable with `const seatalk::raw &`.
+	template <class Handler> void feed(const uint8_t * data, std::size_t size, Handler && handler)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+			if (feed(data[i]) == status::complete)
+				handler(message_);
+	}
+
+	/// Processes all bytes of the buffer, which were received at the
+	/// specified time. The handler is called for every complete message.
+	///
+	/// @param[in] data The data to process.
+	/// @param[in] size Number of bytes.
+	/// @param[in] t Time of reception of the data.
+	/// @param[in] handler Function object callable with `const seatalk::raw &`.
+	template <class Handler>
+	void feed(const uint8_t * data, std::size_t size, clock::time_point t, Handler && handler)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+			if (feed(data[i], t) == status::complete)
+				handler(message_);
+	}
+
+	/// Returns the last complete message. Valid only until the next byte
+	/// is fed into the framer.
+	const seatalk::raw & message() const noexcept { return message_; }
+
+	/// Returns the time of reception of the first byte of the last complete
+	/// message. This is the epoch of the clock, if the data was fed without
+	/// time. Valid only until the next byte is fed into the framer.
+	clock::time_point timestamp() const noexcept { return start_; }
+
+	uint32_t get_collisions() const noexcept { return collisions_; }
+	uint32_t get_errors() const noexcept { return errors_; }
+
+private:
+	enum class State { READ, ESCAPE, PARITY };
+
+	State state_ = State::READ;
+	uint8_t index_ = 0;
+	uint8_t remaining_ = 255;
+	uint8_t data_[seatalk::MAX_MESSAGE_SIZE];
+	uint32_t collisions_ = 0;
+	uint32_t errors_ = 0;
+	seatalk::raw message_;
+	clock::time_point current_; // first byte of the current escape sequence
+	clock::time_point start_; // first byte of the current message
+
+	static uint8_t parity(uint8_t a);
+	void write_cmd(uint8_t c);
+	status write_data(uint8_t c);
+};
+}
+}
+
+#endif
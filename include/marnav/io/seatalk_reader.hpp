@@ -2,6 +2,8 @@
 #define MARNAV__IO__SEATALK_READER__HPP
 
 #include <marnav/io/device.hpp>
+#include <marnav/io/metrics.hpp>
+#include <marnav/io/seatalk_framer.hpp>
 #include <marnav/seatalk/message.hpp>
 
 namespace marnav
@@ -13,6 +15,9 @@ namespace io
 ///
 /// In order to use this SeaTalk reader, it must be subclassed.
 ///
+/// If metrics are set (see `set_metrics`), received bytes, messages, bus
+/// collisions and errors are counted.
+///
 /// @example read_seatalk.cpp
 class seatalk_reader
 {
@@ -29,33 +34,22 @@ public:
 
 	void close();
 	bool read();
-	uint32_t get_collisions() const { return ctx_.collisions; }
+	uint32_t get_collisions() const { return framer_.get_collisions(); }
+
+	/// Sets the metrics to count into, `nullptr` disables counting.
+	void set_metrics(std::shared_ptr<stream_metrics> m) { metrics_ = std::move(m); }
+	std::shared_ptr<stream_metrics> get_metrics() const { return metrics_; }
 
 protected:
 	virtual void process_message(const seatalk::raw &) = 0;
 
 private:
-	enum class State { READ, ESCAPE, PARITY };
-
-	struct context {
-		State state;
-		uint8_t index;
-		uint8_t remaining;
-		uint8_t data[seatalk::MAX_MESSAGE_SIZE];
-
-		uint8_t raw;
-		uint32_t collisions;
-	};
-
-	void emit_message();
-
-	uint8_t parity(uint8_t a) const;
-	void write_cmd(uint8_t c);
-	void write_data(uint8_t c);
 	void process_seatalk();
 	bool read_data();
 
-	context ctx_;
+	uint8_t raw_;
+	seatalk_framer framer_;
+	std::shared_ptr<stream_metrics> metrics_;
 	std::unique_ptr<device> dev_; ///< Device to read data from.
 };
 }
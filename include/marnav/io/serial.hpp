@@ -1,8 +1,10 @@
 #ifndef MARNAV__IO__SERIAL__HPP
 #define MARNAV__IO__SERIAL__HPP
 
+#include <chrono>
 #include <string>
 #include <marnav/io/device.hpp>
+#include <marnav/io/selectable.hpp>
 
 namespace marnav
 {
@@ -12,9 +14,25 @@ namespace io
 /// communication.
 ///
 /// Since this is termios based, it is platform dependent.
-class serial : public device
+///
+/// For low latency applications, the reception behaviour can be configured
+/// (see `read_options`), and data can be read together with the time of
+/// reception:
+/// @code
+/// io::serial::read_options opt;
+/// opt.low_latency = true;
+/// io::serial dev{"/dev/ttyUSB0", io::serial::baud::baud_38400, io::serial::databits::bit_8,
+///     io::serial::stopbits::bit_1, io::serial::parity::none};
+/// dev.set_read_options(opt);
+/// dev.open();
+/// io::serial::clock::time_point t;
+/// const int rc = dev.read(buffer, sizeof(buffer), t);
+/// @endcode
+class serial : public device, virtual public selectable
 {
 public:
+	using clock = std::chrono::steady_clock;
+
 	enum class baud {
 		baud_300,
 		baud_600,
@@ -35,6 +53,24 @@ public:
 
 	enum class parity { none, even, odd, mark };
 
+	/// Options concerning the reception of data.
+	struct read_options {
+		/// Minimum number of characters for a read (`VMIN`).
+		uint8_t min_chars = 1;
+
+		/// Timeout of a read in tenths of a second (`VTIME`), zero waits
+		/// for `min_chars` indefinitely.
+		uint8_t timeout = 0;
+
+		/// Reads do not block, if no data is available they fail with `EAGAIN`.
+		bool non_blocking = false;
+
+		/// Requests the driver to deliver received data immediately, instead
+		/// of buffering it for a while (Linux only, ignored if not supported
+		/// by the driver).
+		bool low_latency = false;
+	};
+
 	virtual ~serial();
 
 	serial() = delete;
@@ -49,6 +85,13 @@ public:
 	virtual int read(char * buffer, uint32_t size) override;
 	virtual int write(const char * buffer, uint32_t size) override;
 
+	int read(char * buffer, uint32_t size, clock::time_point & t);
+
+	void set_read_options(const read_options & opt);
+	const read_options & get_read_options() const noexcept { return options_; }
+
+	virtual int get_fd() const override { return fd; }
+
 protected:
 	int fd; ///< File descriptor for serial device communication.
 
@@ -58,6 +101,9 @@ private:
 	databits data_bits_;
 	stopbits stop_bits_;
 	parity par_;
+	read_options options_;
+
+	void apply_read_options();
 };
 }
 }
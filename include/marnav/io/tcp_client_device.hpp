@@ -0,0 +1,81 @@
+#ifndef MARNAV__IO__TCP_CLIENT_DEVICE__HPP
+#define MARNAV__IO__TCP_CLIENT_DEVICE__HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <marnav/io/device.hpp>
+#include <marnav/io/selectable.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Connects to a TCP server, typically an AIS provider, and receives data.
+///
+/// Data is received in large chunks (up to `buffer_size` bytes per system call)
+/// into an internal buffer, which can be processed in place with `receive`.
+/// Of course it is also possible to `read` into a buffer of the caller,
+/// and to `write` data to the server.
+///
+/// Example, feeding the data into a framer without copying:
+/// @code
+/// io::tcp_client_device dev{"ais.example.com", 5631};
+/// dev.open();
+/// io::nmea_framer framer;
+/// while (dev.receive([&framer](const char * data, std::size_t size) {
+///     framer.feed(data, size, [](const std::string & s) { /* ... */ });
+/// }) > 0) {
+/// }
+/// @endcode
+///
+/// @note This is POSIX specific.
+class tcp_client_device : public device, virtual public selectable
+{
+public:
+	static constexpr std::size_t buffer_size = 65536;
+
+	virtual ~tcp_client_device();
+
+	tcp_client_device() = delete;
+	tcp_client_device(const std::string & host, uint16_t port);
+	tcp_client_device(const tcp_client_device &) = delete;
+	tcp_client_device(tcp_client_device &&) noexcept;
+
+	tcp_client_device & operator=(const tcp_client_device &) = delete;
+	tcp_client_device & operator=(tcp_client_device &&) noexcept;
+
+	virtual void open() override;
+	virtual void close() override;
+	virtual int read(char * buffer, uint32_t size) override;
+	virtual int write(const char * buffer, uint32_t size) override;
+
+	virtual int get_fd() const override { return fd_; }
+
+	/// Receives data into the internal buffer and passes it to the handler.
+	/// The data is valid only during the call of the handler.
+	///
+	/// @param[in] handler Function object callable with `(const char *, std::size_t)`.
+	/// @return Number of received bytes, zero if the connection was closed
+	///   by the server, -1 on error (`errno` is set).
+	/// @exception std::runtime_error Device not open.
+	template <class Handler> int receive(Handler && handler)
+	{
+		const int rc = fill();
+		if (rc > 0)
+			handler(buffer_.data(), static_cast<std::size_t>(rc));
+		return rc;
+	}
+
+private:
+	std::string host_;
+	uint16_t port_;
+	int fd_ = -1;
+	std::vector<char> buffer_;
+
+	int fill();
+};
+}
+}
+
+#endif
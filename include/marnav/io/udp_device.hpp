@@ -0,0 +1,97 @@
+#ifndef MARNAV__IO__UDP_DEVICE__HPP
+#define MARNAV__IO__UDP_DEVICE__HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <marnav/io/device.hpp>
+#include <marnav/io/selectable.hpp>
+
+namespace marnav
+{
+namespace io
+{
+/// @brief Receives datagrams, typically NMEA sentences broadcast by multiplexers.
+///
+/// The device binds to the specified local address and port. It drains up
+/// to `batch_size` datagrams per system call (`recvmmsg`), which are kept
+/// in internal buffers. They can be processed in place with `receive`, or
+/// copied with `read`.
+///
+/// Datagrams larger than `max_datagram_size` are truncated, they are
+/// counted (`get_truncated`) and discarded.
+///
+/// Example, feeding the data into a framer without copying:
+/// @code
+/// io::udp_device dev{"0.0.0.0", 10110};
+/// dev.open();
+/// io::nmea_framer framer;
+/// for (;;) {
+///     dev.receive([&framer](const char * data, std::size_t size) {
+///         framer.feed(data, size, [](const std::string & s) { /* ... */ });
+///     });
+/// }
+/// @endcode
+///
+/// @note This is POSIX specific, `recvmmsg` is Linux specific.
+class udp_device : public device, virtual public selectable
+{
+public:
+	static constexpr std::size_t batch_size = 32;
+	static constexpr std::size_t max_datagram_size = 2048;
+
+	virtual ~udp_device();
+
+	udp_device() = delete;
+	udp_device(const std::string & address, uint16_t port);
+	udp_device(const udp_device &) = delete;
+	udp_device(udp_device &&) noexcept;
+
+	udp_device & operator=(const udp_device &) = delete;
+	udp_device & operator=(udp_device &&) noexcept;
+
+	virtual void open() override;
+	virtual void close() override;
+	virtual int read(char * buffer, uint32_t size) override;
+	virtual int write(const char * buffer, uint32_t size) override;
+
+	virtual int get_fd() const override { return fd_; }
+
+	/// Receives datagrams and passes them to the handler, one call per
+	/// datagram. The data is valid only during the call of the handler.
+	/// Data not yet consumed by `read` is passed first.
+	///
+	/// @param[in] handler Function object callable with `(const char *, std::size_t)`.
+	/// @return Number of datagrams, or -1 on error (`errno` is set).
+	/// @exception std::runtime_error Device not open.
+	template <class Handler> int receive(Handler && handler)
+	{
+		const int rc = fill();
+		if (rc < 0)
+			return rc;
+		for (; next_ < count_; ++next_, offset_ = 0)
+			handler(data(next_) + offset_, sizes_[next_] - offset_);
+		return rc;
+	}
+
+	uint16_t get_port() const noexcept { return port_; }
+	uint64_t get_truncated() const noexcept { return truncated_; }
+
+private:
+	std::string address_;
+	uint16_t port_;
+	int fd_ = -1;
+	std::vector<char> buffer_;
+	std::vector<std::size_t> sizes_;
+	std::size_t count_ = 0; // number of received datagrams in the buffer
+	std::size_t next_ = 0; // next datagram to process
+	std::size_t offset_ = 0; // offset within the next datagram, already read
+	uint64_t truncated_ = 0;
+
+	const char * data(std::size_t i) const { return buffer_.data() + i * max_datagram_size; }
+	int fill();
+};
+}
+}
+
+#endif
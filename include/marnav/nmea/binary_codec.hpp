@@ -0,0 +1,49 @@
+#ifndef MARNAV__NMEA__BINARY_CODEC__HPP
+#define MARNAV__NMEA__BINARY_CODEC__HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace marnav
+{
+namespace nmea
+{
+class sentence;
+
+/// Version of the binary encoding, increased with incompatible changes.
+constexpr uint8_t binary_version = 1;
+
+/// Kind of data within a binary record.
+enum class binary_record : uint8_t {
+	sentence = 1, ///< A NMEA sentence, see `nmea::encode_binary`.
+	ais_message = 2, ///< An AIS message, see `ais::encode_binary`.
+};
+
+/// Information about a binary record.
+struct binary_header {
+	binary_record kind;
+	std::size_t size; ///< Size of the complete record in bytes, including the header.
+	std::size_t body; ///< Offset of the data of the record, relative to its start.
+};
+
+binary_header read_binary_header(const uint8_t * data, std::size_t size, std::size_t pos);
+
+void encode_binary(std::vector<uint8_t> & buffer, const sentence & s);
+std::vector<uint8_t> encode_binary(const sentence & s);
+
+std::unique_ptr<sentence> decode_binary(
+	const uint8_t * data, std::size_t size, std::size_t & pos);
+std::unique_ptr<sentence> decode_binary(const std::vector<uint8_t> & data);
+
+/// @cond DEV
+namespace detail
+{
+std::size_t begin_binary_record(std::vector<uint8_t> & buffer, binary_record kind);
+void end_binary_record(std::vector<uint8_t> & buffer, std::size_t start);
+}
+/// @endcond
+}
+}
+
+#endif
@@ -2,7 +2,9 @@
 #define MARNAV_NMEA_DETAIL_HPP
 
 #include <marnav/nmea/checksum_enum.hpp>
+#include <marnav/nmea/sentence_id.hpp>
 #include <marnav/nmea/talker_id.hpp>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -17,8 +19,18 @@ class sentence; // forward declaration
 
 namespace detail
 {
+class binary_fields; // forward declaration
+
+talker find_talker(char a, char b) noexcept;
+sentence_id find_sentence_id(const char * tag, std::size_t size) noexcept;
+
 std::tuple<talker, std::string> parse_address(const std::string & address);
 
+std::unique_ptr<sentence> create_sentence(
+	talker talk, const std::string & tag, const std::vector<std::string> & fields);
+std::unique_ptr<sentence> create_sentence(
+	talker talk, const std::string & tag, binary_fields & fields);
+
 void ensure_checksum(
 	const std::string & s, const std::string & expected, std::string::size_type start_pos);
 
@@ -74,6 +74,7 @@ public:
 
 protected:
 	gga(talker talk, fields::const_iterator first, fields::const_iterator last);
+	gga(talker talk, detail::binary_fields & f);
 	virtual void append_data_to(std::string &) const override;
 
 private:
@@ -52,6 +52,7 @@ public:
 
 protected:
 	gll(talker talk, fields::const_iterator first, fields::const_iterator last);
+	gll(talker talk, detail::binary_fields & f);
 	virtual void append_data_to(std::string &) const override;
 
 private:
@@ -0,0 +1,121 @@
+#ifndef MARNAV__NMEA__GROUP_ASSEMBLER__HPP
+#define MARNAV__NMEA__GROUP_ASSEMBLER__HPP
+
+#include <marnav/nmea/sentence.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @brief Reassembles groups of sentences, bound together by the group
+///   of their tag blocks (`g:1-2-73874`), as used by IEC 61162-450 streams.
+///
+/// Groups are identified by the source (`s:`) and the group ID of the tag
+/// block. A group is complete if all of its sentences have arrived, they are
+/// provided in the order of their number within the group, regardless of their
+/// order of arrival. Complete groups are provided as soon as their last
+/// sentence arrives.
+///
+/// Pending groups are held in a pool of fixed size, allocated at construction.
+/// If the pool is exhausted, the oldest pending group is dropped. Groups which
+/// are not complete within the timeout are expired.
+///
+/// Sentences without valid group are not held, they are provided as groups
+/// of one sentence.
+///
+/// Example:
+/// @code
+/// nmea::group_assembler assembler;
+/// ...
+/// if (assembler.add(nmea::make_sentence(raw)) == nmea::group_assembler::status::complete) {
+///     for (auto & s : assembler.group())
+///         process(*s);
+/// }
+/// @endcode
+class group_assembler
+{
+public:
+	using clock = std::chrono::steady_clock;
+	using group_type = std::vector<std::unique_ptr<sentence>>;
+
+	/// Maximum number of characters of a source, same as within tag blocks.
+	static constexpr std::size_t max_source_size = 15;
+
+	enum class status {
+		none, ///< The sentence was added to a pending group.
+		complete, ///< The sentence completed a group.
+		ungrouped, ///< The sentence is not part of a group.
+		error, ///< The group of the sentence is invalid, the sentence was discarded.
+	};
+
+	struct options {
+		std::size_t capacity = 64; ///< Maximum number of pending groups.
+		std::size_t max_group_size = 16; ///< Maximum number of sentences per group.
+		clock::duration timeout = std::chrono::seconds{2}; ///< Expiry of pending groups.
+	};
+
+	struct stats {
+		uint64_t completed = 0; ///< Complete groups.
+		uint64_t expired = 0; ///< Pending groups expired by timeout.
+		uint64_t out_of_order = 0; ///< Complete groups, whose sentences arrived out of order.
+		uint64_t dropped = 0; ///< Pending groups dropped, pool exhausted or duplicate sentence.
+		uint64_t ungrouped = 0; ///< Sentences without group.
+		uint64_t errors = 0; ///< Sentences with invalid group.
+	};
+
+	group_assembler();
+	explicit group_assembler(const options & opt);
+
+	group_assembler(const group_assembler &) = delete;
+	group_assembler & operator=(const group_assembler &) = delete;
+
+	group_assembler(group_assembler &&) = default;
+	group_assembler & operator=(group_assembler &&) = default;
+
+	status add(std::unique_ptr<sentence> s);
+	status add(std::unique_ptr<sentence> s, clock::time_point t);
+
+	std::size_t expire(clock::time_point t);
+	void reset();
+
+	/// Returns the last complete group, or the last sentence without group.
+	/// The sentences may be moved out, the group is valid only until the next
+	/// sentence is added.
+	group_type & group() noexcept { return group_; }
+
+	std::size_t pending() const noexcept { return pending_; }
+	std::size_t get_capacity() const noexcept { return slots_.size(); }
+	const stats & get_stats() const noexcept { return stats_; }
+
+private:
+	/// A pending group, the sentences are indexed by their number within the group.
+	struct slot {
+		bool used = false;
+		bool out_of_order = false;
+		char source[max_source_size];
+		std::size_t source_size = 0;
+		int id = 0;
+		int received = 0;
+		clock::time_point start;
+		group_type sentences;
+	};
+
+	slot * find(const char * source, std::size_t source_size, int id) noexcept;
+	slot & acquire();
+	void release(slot & s) noexcept;
+
+	options opt_;
+	std::vector<slot> slots_;
+	std::size_t pending_ = 0;
+	clock::time_point next_expiry_ = clock::time_point::max();
+	group_type group_;
+	stats stats_;
+};
+}
+}
+
+#endif
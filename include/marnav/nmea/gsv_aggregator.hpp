@@ -0,0 +1,117 @@
+#ifndef MARNAV__NMEA__GSV_AGGREGATOR__HPP
+#define MARNAV__NMEA__GSV_AGGREGATOR__HPP
+
+#include <marnav/nmea/gsv.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @brief Aggregates the satellites of all GSV sentences of a cycle into
+///   a snapshot of the constellation, per talker.
+///
+/// Every talker (e.g. GPS, GLONASS, Galileo, BeiDou) has a table of fixed
+/// capacity, which is double buffered. The sentences of a cycle are written
+/// into the back buffer, which is published when the last sentence of the
+/// cycle arrives. Cycles with missing sentences are discarded.
+///
+/// There must be only one thread adding sentences, any number of threads may
+/// read snapshots concurrently, without locks. Readers copy the published
+/// table, protected by a sequence counter, and retry in the rare case the
+/// table is modified while being copied.
+///
+/// Example:
+/// @code
+/// nmea::gsv_aggregator aggregator;
+///
+/// // thread reading sentences
+/// aggregator.add(*nmea::make_sentence(raw));
+///
+/// // any other thread
+/// nmea::gsv_aggregator::snapshot s;
+/// if (aggregator.get(nmea::talker::global_positioning_system, s)) {
+///     for (std::size_t i = 0; i < s.size; ++i)
+///         process(s.satellites[i]);
+/// }
+/// @endcode
+class gsv_aggregator
+{
+public:
+	/// Maximum number of talkers, tracked independently.
+	static constexpr std::size_t max_talkers = 8;
+
+	/// Maximum number of satellites per talker, the maximum number of
+	/// sentences of a cycle (9) with 4 satellites each.
+	static constexpr std::size_t max_satellites = 36;
+
+	/// A complete constellation of a talker.
+	struct snapshot {
+		talker talk = talker::none;
+		uint64_t cycle = 0; ///< Number of the cycle, starting with 1.
+		uint32_t n_satellites_in_view = 0;
+		std::size_t size = 0; ///< Number of valid entries in `satellites`.
+		std::array<gsv::satellite_info, max_satellites> satellites;
+	};
+
+	/// Counters of the writing thread.
+	struct stats {
+		uint64_t sentences = 0; ///< GSV sentences processed.
+		uint64_t cycles = 0; ///< Complete cycles published.
+		uint64_t incomplete = 0; ///< Cycles discarded, missing sentences.
+		uint64_t overflows = 0; ///< Sentences discarded, too many talkers.
+	};
+
+	gsv_aggregator() = default;
+
+	gsv_aggregator(const gsv_aggregator &) = delete;
+	gsv_aggregator & operator=(const gsv_aggregator &) = delete;
+
+	gsv_aggregator(gsv_aggregator &&) = delete;
+	gsv_aggregator & operator=(gsv_aggregator &&) = delete;
+
+	bool add(const sentence & s);
+	bool add(const gsv & s);
+
+	bool get(talker t, snapshot & s) const noexcept;
+
+	/// Returns the counters, to be called by the writing thread only.
+	const stats & get_stats() const noexcept { return stats_; }
+
+private:
+	/// Number of values per satellite.
+	static constexpr std::size_t values = 4;
+
+	/// Table of satellites, all data is atomic to be read while written.
+	struct buffer {
+		/// Sequence counter, odd while the buffer is written.
+		std::atomic<uint32_t> seq{0};
+		std::atomic<uint64_t> cycle{0};
+		std::atomic<uint32_t> n_satellites_in_view{0};
+		std::atomic<uint32_t> size{0};
+		std::array<std::atomic<uint32_t>, max_satellites * values> data;
+	};
+
+	struct table {
+		std::atomic<int> talk{static_cast<int>(talker::none)};
+		std::atomic<uint32_t> front{0};
+		buffer buffers[2];
+
+		// state of the writing thread
+		uint32_t expected = 0; ///< Next message number, zero if none.
+		uint32_t size = 0;
+		uint64_t cycles = 0;
+	};
+
+	table * find(talker t) noexcept;
+	const table * find(talker t) const noexcept;
+
+	std::array<table, max_talkers> tables_;
+	stats stats_;
+};
+}
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef MARNAV__NMEA__LAZY_SENTENCE__HPP
+#define MARNAV__NMEA__LAZY_SENTENCE__HPP
+
+#include <marnav/nmea/checksum_enum.hpp>
+#include <marnav/nmea/io.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/utils/optional.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @brief A sentence which is decoded only as far as necessary.
+///
+/// At construction, the raw sentence is validated and the positions of the
+/// fields are recorded. ID and talker are available immediately, no field is
+/// converted. Single fields are converted on request (`read_field`), the
+/// complete sentence object is created on first access (`as`) and kept for
+/// later accesses.
+///
+/// This suits applications which look at many sentences, but only at
+/// a few fields of them, e.g. routers and filters.
+///
+/// @note Instances are not thread safe, `as` modifies the internal cache.
+///
+/// Example:
+/// @code
+/// nmea::lazy_sentence s{"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17"};
+/// if (s.id() == nmea::sentence_id::RMC) {
+///     const auto lat = s.as<nmea::rmc>().get_lat(); // parses the sentence
+///     const auto lon = s.as<nmea::rmc>().get_lon(); // already parsed
+/// }
+/// @endcode
+class lazy_sentence
+{
+public:
+	explicit lazy_sentence(
+		const std::string & s, checksum_handling chksum = checksum_handling::check);
+	explicit lazy_sentence(std::string && s, checksum_handling chksum = checksum_handling::check);
+
+	lazy_sentence(const lazy_sentence &) = delete;
+	lazy_sentence(lazy_sentence &&) = default;
+
+	lazy_sentence & operator=(const lazy_sentence &) = delete;
+	lazy_sentence & operator=(lazy_sentence &&) = default;
+
+	sentence_id id() const noexcept { return id_; }
+	talker get_talker() const noexcept { return talker_; }
+	std::string tag() const;
+	std::string get_tag_block() const;
+
+	/// Returns the raw sentence.
+	const std::string & get_raw() const noexcept { return raw_; }
+
+	/// Returns the number of data fields, the address is not counted.
+	std::size_t size() const noexcept { return fields_.size() - 1; }
+
+	std::string field(std::size_t index) const;
+
+	/// Converts the specified data field, using the same functions as the
+	/// sentences do. Empty fields result in an empty optional.
+	///
+	/// @exception std::out_of_range The index is out of range.
+	/// @exception std::invalid_argument The field cannot be converted.
+	template <class T>
+	utils::optional<T> read_field(std::size_t index, data_format fmt = data_format::dec) const
+	{
+		utils::optional<T> value;
+		nmea::read(field(index), value, fmt);
+		return value;
+	}
+
+	/// Returns the sentence object, it is created on the first call.
+	///
+	/// @tparam T Type of the sentence, must match the ID.
+	/// @exception std::bad_cast The sentence is not of the specified type.
+	/// @exception std::invalid_argument The fields are not valid for the sentence.
+	template <class T> const T & as() const
+	{
+		if (id_ != T::ID)
+			throw std::bad_cast{};
+		if (!sentence_) {
+			const auto f = get_fields();
+			std::unique_ptr<sentence> s
+				= detail::factory::parse<T>(talker_, std::begin(f), std::end(f));
+			s->set_tag_block(get_tag_block());
+			sentence_ = std::move(s);
+		}
+		return static_cast<const T &>(*sentence_);
+	}
+
+	/// Returns true if the sentence object was already created.
+	bool is_parsed() const noexcept { return sentence_ != nullptr; }
+
+private:
+	void init(checksum_handling chksum);
+	sentence::fields get_fields() const;
+
+	std::string raw_;
+	sentence_id id_ = sentence_id::NONE;
+	talker talker_ = talker::none;
+	uint32_t address_ = 0;
+
+	/// Start positions of the data fields, the last entry is the position
+	/// after the end token.
+	std::vector<uint32_t> fields_;
+
+	mutable std::unique_ptr<sentence> sentence_;
+};
+}
+}
+
+#endif
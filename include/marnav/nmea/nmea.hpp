@@ -3,6 +3,7 @@
 
 #include <marnav/nmea/sentence_id.hpp>
 #include <marnav/nmea/checksum_enum.hpp>
+#include <marnav/nmea/talker_id.hpp>
 #include <memory>
 #include <string>
 #include <stdexcept>
@@ -65,12 +66,45 @@ public:
 };
 
 class sentence; // forward declaration
+class sentence_filter; // forward declaration
 
 std::unique_ptr<sentence> make_sentence(
 	const std::string & s, checksum_handling chksum = checksum_handling::check);
+std::unique_ptr<sentence> make_sentence(const std::string & s, const sentence_filter & filter,
+	checksum_handling chksum = checksum_handling::check);
 
 sentence_id extract_id(const std::string & s);
 
+/// Outcome of `validate_sentence`.
+enum class validation {
+	ok, ///< The sentence is well formed and the checksum is correct.
+	empty, ///< The string is empty.
+	start_token, ///< Start token of the sentence is missing.
+	tag_block, ///< Tag block is not terminated or its checksum is wrong.
+	address, ///< Address is missing or contains invalid characters.
+	field_count, ///< Too many fields.
+	character, ///< Non printable character within the sentence.
+	checksum_format, ///< Checksum is missing or malformed.
+	checksum, ///< Checksum is wrong.
+};
+
+/// Result of `validate_sentence`.
+///
+/// Positions are relative to the beginning of the validated string.
+struct validation_result {
+	validation status = validation::ok;
+	sentence_id id = sentence_id::NONE; ///< `NONE` if the sentence is not supported.
+	talker talk = talker::none; ///< `none` for proprietary or unknown talkers.
+	std::size_t address = 0; ///< Position of the address.
+	std::size_t address_size = 0; ///< Length of the address.
+	std::size_t fields = 0; ///< Number of data fields, without the address.
+
+	explicit operator bool() const noexcept { return status == validation::ok; }
+};
+
+validation_result validate_sentence(const char * s, std::size_t size) noexcept;
+validation_result validate_sentence(const std::string & s) noexcept;
+
 std::vector<std::string> get_supported_sentences_str();
 std::vector<sentence_id> get_supported_sentences_id();
 std::string to_string(sentence_id id);
@@ -61,6 +61,7 @@ public:
 
 protected:
 	rmc(talker talk, fields::const_iterator first, fields::const_iterator last);
+	rmc(talker talk, detail::binary_fields & f);
 	virtual void append_data_to(std::string &) const override;
 
 private:
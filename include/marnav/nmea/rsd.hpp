@@ -49,6 +49,7 @@ public:
 
 protected:
 	rsd(talker talk, fields::const_iterator first, fields::const_iterator last);
+	rsd(talker talk, detail::binary_fields & f);
 	virtual void append_data_to(std::string &) const override;
 
 private:
@@ -4,6 +4,7 @@
 #include <marnav/nmea/constants.hpp>
 #include <marnav/nmea/talker_id.hpp>
 #include <marnav/nmea/sentence_id.hpp>
+#include <marnav/nmea/tag_block.hpp>
 #include <marnav/nmea/detail.hpp>
 #include <functional>
 #include <memory>
@@ -27,6 +28,10 @@ public:
 	using parse_function = std::function<std::unique_ptr<sentence>(
 		talker, fields::const_iterator, fields::const_iterator)>;
 
+	/// This signature is used by subclasses which are able to read their
+	/// data directly from binary records, see `decode_binary`.
+	using binary_parse_function = std::unique_ptr<sentence> (*)(talker, detail::binary_fields &);
+
 	/// Maximum length of a NMEA sentence (raw format as string).
 	constexpr static int max_length = 82;
 
@@ -64,14 +69,21 @@ public:
 	///   talker ID explicitly.
 	void set_talker(const talker & t) { talker_ = t; }
 
-	/// Sets the tag block. This overwrites a possibly existent block.
-	void set_tag_block(const std::string & t) { tag_block_ = t; }
+	void set_tag_block(const std::string & t);
+	void set_tag_block(std::string && t);
 
 	/// Returns the raw tag block string. Since tag blocks are not common
 	/// at the moment, its handling is separated, @see tag_block.
 	const std::string & get_tag_block() const { return tag_block_; }
 
+	/// Returns the values of the tag block, decoded when it was set.
+	///
+	/// The view is valid as long as the sentence exists and its tag block
+	/// remains unchanged.
+	tag_block_view get_tag_block_view() const noexcept { return {tag_block_, tag_values_}; }
+
 	friend std::string to_string(const sentence &);
+	friend void encode_binary(std::vector<uint8_t> &, const sentence &);
 
 protected:
 	sentence(sentence_id id, const std::string & tag, talker t);
@@ -100,6 +112,7 @@ private:
 	std::string tag_;
 	talker talker_;
 	std::string tag_block_;
+	tag_block_values tag_values_;
 };
 
 // Class `sentence` must be an abstract class, this protectes
@@ -141,6 +154,15 @@ public:
 		return std::unique_ptr<T>(new T{talk, first, last});
 	}
 
+	/// Function to create sentences from binary records, used by the NMEA registry
+	/// for sentences which provide a constructor reading binary fields.
+	template <class T,
+		typename std::enable_if<std::is_base_of<sentence, T>::value, int>::type = 0>
+	static std::unique_ptr<sentence> parse_binary(talker talk, binary_fields & f)
+	{
+		return std::unique_ptr<T>(new T{talk, f});
+	}
+
 	/// Helper function to parse a specific sentence.
 	///
 	/// @note Only to be used in unit tests.
@@ -174,7 +196,7 @@ public:
 		std::vector<std::string> fields;
 		std::tie(talk, tag, tag_block, fields) = detail::extract_sentence_information(s);
 		T result{talk, std::next(std::begin(fields)), std::prev(std::end(fields))};
-		result.set_tag_block(tag_block);
+		result.set_tag_block(std::move(tag_block));
 		return result;
 	}
 };
@@ -0,0 +1,82 @@
+#ifndef MARNAV__NMEA__SENTENCE_FILTER__HPP
+#define MARNAV__NMEA__SENTENCE_FILTER__HPP
+
+#include <marnav/nmea/sentence_id.hpp>
+#include <marnav/nmea/talker_id.hpp>
+#include <bitset>
+#include <initializer_list>
+#include <string>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @brief Selects sentences by ID and talker, using only the address of
+///   the raw sentence.
+///
+/// The check needs neither the fields nor the checksum of the sentence. It
+/// does not allocate and its cost does not depend on the selection, it consists
+/// of a lookup in the (sorted) supported sentences and tests of bitsets.
+/// Therefore sentences of no interest can be discarded before they are parsed.
+///
+/// A default constructed filter accepts everything. Adding the first sentence
+/// ID restricts the filter to the added IDs, the same applies for talkers.
+/// Talkers apply to regular sentences only, proprietary sentences have none.
+///
+/// Raw sentences which cannot be classified (malformed or unknown addresses)
+/// are accepted if all sentences are accepted, otherwise rejected.
+///
+/// Example:
+/// @code
+/// nmea::sentence_filter filter{nmea::sentence_id::RMC, nmea::sentence_id::GGA};
+/// filter.add(nmea::talker::global_positioning_system);
+///
+/// auto s = nmea::make_sentence(raw, filter);
+/// if (!s)
+///     return; // not of interest
+/// @endcode
+class sentence_filter
+{
+public:
+	sentence_filter() = default;
+	sentence_filter(std::initializer_list<sentence_id> ids);
+
+	sentence_filter(const sentence_filter &) = default;
+	sentence_filter(sentence_filter &&) = default;
+
+	sentence_filter & operator=(const sentence_filter &) = default;
+	sentence_filter & operator=(sentence_filter &&) = default;
+
+	sentence_filter & add(sentence_id id);
+	sentence_filter & remove(sentence_id id);
+	sentence_filter & add(talker t);
+	sentence_filter & remove(talker t);
+
+	sentence_filter & accept_all() noexcept;
+	sentence_filter & accept_all_talkers() noexcept;
+	sentence_filter & reject_all() noexcept;
+
+	bool accepts(sentence_id id) const noexcept;
+	bool accepts(talker t) const noexcept;
+	bool accepts_address(const char * address, std::size_t size) const noexcept;
+	bool accepts(const char * s, std::size_t size) const noexcept;
+	bool accepts(const std::string & s) const noexcept;
+
+private:
+	/// Number of characters valid within an address, `A`..`Z` and `0`..`9`.
+	static constexpr std::size_t symbols = 36;
+
+	static constexpr std::size_t max_ids = 256;
+	static constexpr std::size_t max_talkers = 128;
+
+	bool all_sentences_ = true;
+	bool all_talkers_ = true;
+	std::bitset<max_ids> ids_;
+	std::bitset<max_talkers> talker_ids_;
+	std::bitset<symbols * symbols * symbols> tags_;
+	std::bitset<symbols * symbols> talkers_;
+};
+}
+}
+
+#endif
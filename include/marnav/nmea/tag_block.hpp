@@ -1,6 +1,7 @@
 #ifndef MARNAV__NMEA__TAG_BLOCK__HPP
 #define MARNAV__NMEA__TAG_BLOCK__HPP
 
+#include <cstdint>
 #include <string>
 
 namespace marnav
@@ -88,9 +89,102 @@ private:
 	std::string text_;
 };
 
+/// Values of a tag block, decoded in one pass without copying any text.
+///
+/// Texts are referenced by their position within the raw tag block, they
+/// are truncated to 15 characters like in `tag_block`.
+struct tag_block_values {
+	/// Position and size of a text within the raw tag block.
+	struct span {
+		uint16_t pos = 0;
+		uint16_t size = 0;
+	};
+
+	int64_t unix_time = 0;
+	tag_block::sentence_group group;
+	int32_t line_count = 0;
+	int32_t relative_time = 0;
+	span destination;
+	span source;
+	span text;
+
+	/// True if the tag block was decoded successfully.
+	bool valid = false;
+};
+
+/// Read only access to the decoded tag block of a sentence.
+///
+/// The texts refer to the raw tag block, the view is valid as long as the
+/// sentence exists and its tag block remains unchanged.
+class tag_block_view
+{
+public:
+	/// Characters within the raw tag block, not null terminated.
+	struct text {
+		const char * data;
+		std::size_t size;
+
+		text(const char * d, std::size_t n) noexcept
+			: data(d)
+			, size(n)
+		{
+		}
+
+		bool empty() const noexcept { return size == 0; }
+		std::string str() const { return empty() ? std::string{} : std::string(data, size); }
+	};
+
+	tag_block_view(const std::string & raw, const tag_block_values & values) noexcept
+		: raw_(&raw)
+		, values_(&values)
+	{
+	}
+
+	/// Returns true if there is a tag block and it was decoded successfully.
+	bool is_valid() const noexcept { return values_->valid; }
+
+	bool is_unix_time_valid() const noexcept { return values_->unix_time > 0; }
+	bool is_line_count_valid() const noexcept { return values_->line_count > 0; }
+	bool is_relative_time_valid() const noexcept { return values_->relative_time > 0; }
+	bool is_destination_valid() const noexcept { return values_->destination.size > 0; }
+	bool is_source_valid() const noexcept { return values_->source.size > 0; }
+	bool is_text_valid() const noexcept { return values_->text.size > 0; }
+	bool is_group_valid() const noexcept { return values_->group.is_valid(); }
+
+	int64_t get_unix_time() const noexcept { return values_->unix_time; }
+	int get_line_count() const noexcept { return values_->line_count; }
+	int get_relative_time() const noexcept { return values_->relative_time; }
+	tag_block::sentence_group get_group() const noexcept { return values_->group; }
+	text get_destination() const noexcept { return get(values_->destination); }
+	text get_source() const noexcept { return get(values_->source); }
+	text get_text() const noexcept { return get(values_->text); }
+
+	tag_block to_tag_block() const;
+
+private:
+	const std::string * raw_;
+	const tag_block_values * values_;
+
+	text get(const tag_block_values::span & s) const noexcept
+	{
+		return {raw_->data() + s.pos, s.size};
+	}
+};
+
 tag_block make_tag_block(const std::string & s);
 std::string to_string(const tag_block::sentence_group & g);
 std::string to_string(const tag_block & b);
+
+/// @cond DEV
+namespace detail
+{
+/// Result of decoding a tag block.
+enum class tag_block_status { ok, empty, malformed, invalid_field, checksum };
+
+tag_block_status decode_tag_block(
+	const char * s, std::size_t size, tag_block_values & values) noexcept;
+}
+/// @endcond
 }
 }
 
@@ -0,0 +1,57 @@
+#ifndef MARNAV__NMEA__TIMESTAMP__HPP
+#define MARNAV__NMEA__TIMESTAMP__HPP
+
+#include <marnav/nmea/date.hpp>
+#include <marnav/nmea/time.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace marnav
+{
+namespace nmea
+{
+/// Point in time, milliseconds since the epoch (1970-01-01 00:00:00 UTC).
+using timestamp
+	= std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+uint32_t full_year(uint32_t year) noexcept;
+int64_t days_since_epoch(uint32_t year, uint32_t mon, uint32_t day) noexcept;
+timestamp to_timestamp(const date & d, const time & t) noexcept;
+
+/// @brief Converts dates and times of sentences (e.g. RMC, ZDA) into time stamps.
+///
+/// The converter keeps the midnight of the last date converted. As long as
+/// the date does not change, which is true for all sentences of a day, the
+/// conversion needs only a few integer operations.
+///
+/// Years of two digits, as parsed from `DDMMYY` fields, are interpreted as
+/// years 1970..2069, see `full_year`.
+///
+/// Example:
+/// @code
+/// nmea::timestamp_converter converter;
+/// const auto rmc = nmea::sentence_cast<nmea::rmc>(s);
+/// if (rmc->get_date() && rmc->get_time_utc())
+///     store(converter.convert(*rmc->get_date(), *rmc->get_time_utc()));
+/// @endcode
+class timestamp_converter
+{
+public:
+	timestamp convert(const date & d, const time & t) noexcept;
+	bool convert(const char * date_field, std::size_t date_size, const char * time_field,
+		std::size_t time_size, timestamp & result) noexcept;
+	bool convert(const std::string & date_field, const std::string & time_field,
+		timestamp & result) noexcept;
+
+private:
+	int64_t midnight(uint32_t year, uint32_t mon, uint32_t day) noexcept;
+
+	uint32_t key_ = 0; ///< Date of the cached midnight (`YYYYMMDD`), zero if none.
+	int64_t midnight_ = 0; ///< Milliseconds since epoch.
+	uint32_t field_ = 0; ///< Date field (`DDMMYY`) of the cached midnight, zero if none.
+};
+}
+}
+
+#endif
@@ -41,6 +41,7 @@ public:
 
 protected:
 	vlw(talker talk, fields::const_iterator first, fields::const_iterator last);
+	vlw(talker talk, detail::binary_fields & f);
 	virtual void append_data_to(std::string &) const override;
 
 private:
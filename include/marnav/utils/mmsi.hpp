@@ -48,9 +48,15 @@ public:
 	value_type coastal_id() const;
 	value_type auxiliary_mid() const;
 	value_type auxiliary_id() const;
+	value_type ais_aids_mid() const;
+	value_type ais_aids_id() const;
 	value_type mob_mid() const;
 	value_type mob_id() const;
 	value_type sar_mid() const;
+	value_type sart_mid() const;
+	value_type sart_id() const;
+	value_type epirb_mid() const;
+	value_type epirb_id() const;
 
 	bool is_regular() const;
 	bool is_group() const;
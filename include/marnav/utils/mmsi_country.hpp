@@ -1,7 +1,10 @@
 #ifndef MARNAV__UTILS__MMSI_COUNTRY__HPP
 #define MARNAV__UTILS__MMSI_COUNTRY__HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace marnav
 {
@@ -16,6 +19,32 @@ struct mmsi_country_info {
 };
 
 mmsi_country_info mmsi_country(const mmsi & m);
+const mmsi_country_info * find_mmsi_country(uint32_t mid) noexcept;
+
+/// Structure of a MMSI, see the corresponding `is_...` functions of `mmsi`.
+enum class mmsi_type : uint8_t {
+	unknown,
+	regular,
+	group,
+	coastal,
+	auxiliary,
+	ais_aids,
+	sar_aircraft,
+	sart,
+	mob,
+	epirb_ais,
+};
+
+/// Result of the classification of a MMSI.
+struct mmsi_classification {
+	mmsi_type type;
+	uint32_t mid; ///< The MID, `mmsi::initial_value` if there is none.
+	const mmsi_country_info * country; ///< The country of the MID, `nullptr` if unknown.
+};
+
+mmsi_classification classify_mmsi(const mmsi & m) noexcept;
+void classify_mmsi(const mmsi * m, std::size_t n, mmsi_classification * result) noexcept;
+std::vector<mmsi_classification> classify_mmsi(const std::vector<mmsi> & m);
 }
 }
 
@@ -0,0 +1,174 @@
+#ifndef MARNAV__UTILS__SPSC_RING__HPP
+#define MARNAV__UTILS__SPSC_RING__HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace marnav
+{
+namespace utils
+{
+/// @brief Lock-free bounded ring buffer with one producer and one consumer.
+///
+/// The ring consists of a fixed number of slots (a power of two), which are
+/// allocated at construction time. Elements are moved into and out of the
+/// slots, no memory is allocated by the ring itself while pushing or popping.
+///
+/// Every slot carries a sequence number, which tells whether the slot is
+/// free or occupied. This allows the producer to discard the oldest element
+/// of a full ring (`push_drop_oldest`), even while the consumer is reading.
+///
+/// The type `T` must be default constructible and move assignable.
+///
+/// Example:
+/// @code
+/// utils::spsc_ring<int> ring{1024};
+/// std::thread producer{[&ring]() {
+///     for (int i = 0; i < 100; ++i)
+///         while (!ring.try_push(std::move(i)))
+///             std::this_thread::yield();
+/// }};
+/// int value;
+/// for (int n = 0; n < 100;)
+///     if (ring.try_pop(value))
+///         ++n;
+/// producer.join();
+/// @endcode
+template <class T> class spsc_ring
+{
+public:
+	using value_type = T;
+
+	/// Initializes the ring.
+	///
+	/// @param[in] capacity Minimum number of elements, rounded up to the next
+	///   power of two.
+	/// @exception std::invalid_argument Capacity of zero.
+	explicit spsc_ring(std::size_t capacity)
+	{
+		if (capacity == 0)
+			throw std::invalid_argument{"invalid capacity for ring"};
+
+		std::size_t n = 1;
+		while (n < capacity)
+			n <<= 1;
+
+		capacity_ = n;
+		mask_ = n - 1;
+		slots_.reset(new slot[n]);
+		for (std::size_t i = 0; i < n; ++i)
+			slots_[i].seq.store(i, std::memory_order_relaxed);
+	}
+
+	spsc_ring(const spsc_ring &) = delete;
+	spsc_ring(spsc_ring &&) = delete;
+
+	spsc_ring & operator=(const spsc_ring &) = delete;
+	spsc_ring & operator=(spsc_ring &&) = delete;
+
+	/// Appends the element. Must be called by the producer only.
+	///
+	/// @param[in] value The element to append, it is moved only on success.
+	/// @retval true Success.
+	/// @retval false The ring is full.
+	bool try_push(T && value)
+	{
+		const std::size_t t = tail_.load(std::memory_order_relaxed);
+		slot & s = slots_[t & mask_];
+		if (s.seq.load(std::memory_order_acquire) != t)
+			return false;
+		s.value = std::move(value);
+		s.seq.store(t + 1, std::memory_order_release);
+		tail_.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Appends the element, discards the oldest elements if the ring is full.
+	/// Must be called by the producer only.
+	///
+	/// @param[in] value The element to append.
+	/// @return Number of discarded elements.
+	std::size_t push_drop_oldest(T && value)
+	{
+		std::size_t dropped = 0;
+		while (!try_push(std::move(value))) {
+			if (size() < capacity_) {
+				// the consumer is just reading the slot, it will be free soon
+				std::this_thread::yield();
+				continue;
+			}
+			T t;
+			if (try_pop(t))
+				++dropped;
+		}
+		return dropped;
+	}
+
+	/// Removes the oldest element. Normally called by the consumer, the
+	/// producer may call it to discard elements.
+	///
+	/// @param[out] value The removed element.
+	/// @retval true Success.
+	/// @retval false The ring is empty.
+	bool try_pop(T & value)
+	{
+		std::size_t h = head_.load(std::memory_order_relaxed);
+		for (;;) {
+			slot & s = slots_[h & mask_];
+			const std::size_t seq = s.seq.load(std::memory_order_acquire);
+			const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(h + 1);
+			if (diff < 0)
+				return false;
+			if (diff > 0) {
+				h = head_.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (head_.compare_exchange_weak(h, h + 1, std::memory_order_relaxed)) {
+				value = std::move(s.value);
+				s.seq.store(h + capacity_, std::memory_order_release);
+				return true;
+			}
+		}
+	}
+
+	/// Returns the number of elements. This is only a snapshot if
+	/// producer or consumer are active at the same time.
+	std::size_t size() const noexcept
+	{
+		const std::size_t h = head_.load(std::memory_order_acquire);
+		const std::size_t t = tail_.load(std::memory_order_acquire);
+		return (t > h) ? (t - h) : 0u;
+	}
+
+	bool empty() const noexcept { return size() == 0; }
+
+	/// Returns the maximum number of elements.
+	std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+	struct slot {
+		std::atomic<std::size_t> seq;
+		T value;
+	};
+
+	std::size_t capacity_ = 0;
+	std::size_t mask_ = 0;
+	std::unique_ptr<slot[]> slots_;
+
+	// separate cache lines, to avoid false sharing between producer and consumer.
+	// padding instead of alignment, over-aligned types are not supported by
+	// `new` prior to C++17.
+	static constexpr std::size_t cache_line = 64;
+	char pad0_[cache_line];
+	std::atomic<std::size_t> head_{0};
+	char pad1_[cache_line - sizeof(std::atomic<std::size_t>)];
+	std::atomic<std::size_t> tail_{0};
+	char pad2_[cache_line - sizeof(std::atomic<std::size_t>)];
+};
+}
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef MARNAV__UTILS__VARINT__HPP
+#define MARNAV__UTILS__VARINT__HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace marnav
+{
+namespace utils
+{
+/// Maximum number of bytes of an encoded 64 bit value.
+constexpr std::size_t max_varint_size = 10;
+
+/// Appends the value as variable length integer to the buffer (LEB128):
+/// seven bits per byte, least significant first, the most significant bit
+/// of a byte is set if more bytes follow.
+inline void append_varint(std::vector<uint8_t> & buffer, uint64_t value)
+{
+	while (value >= 0x80) {
+		buffer.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<uint8_t>(value));
+}
+
+/// Reads a variable length integer, see `append_varint`.
+///
+/// @param[in] data The data to read from.
+/// @param[in] size Number of bytes of the data.
+/// @param[in,out] pos Position to read from, advanced past the value.
+/// @param[out] value The value read.
+/// @retval true Success.
+/// @retval false The data is truncated or the value does not fit into 64 bits,
+///   `pos` remains unchanged.
+inline bool read_varint(
+	const uint8_t * data, std::size_t size, std::size_t & pos, uint64_t & value) noexcept
+{
+	uint64_t result = 0;
+	for (std::size_t i = 0; (i < max_varint_size) && (pos + i < size); ++i) {
+		const uint8_t b = data[pos + i];
+		if ((i == max_varint_size - 1) && (b > 1))
+			return false;
+		result |= static_cast<uint64_t>(b & 0x7f) << (7 * i);
+		if (!(b & 0x80)) {
+			pos += i + 1;
+			value = result;
+			return true;
+		}
+	}
+	return false;
+}
+}
+}
+
+#endif
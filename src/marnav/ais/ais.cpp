@@ -139,7 +139,20 @@ static std::function<std::unique_ptr<message>(const raw &)> instantiate_message(
 ///   the message.
 std::unique_ptr<message> make_message(const std::vector<std::pair<std::string, uint32_t>> & v)
 {
-	auto bits = collect(v);
+	return make_message(collect(v));
+}
+
+/// Creates the AIS message from its payload bits, e.g. from a binary record.
+///
+/// @param[in] bits The payload of the message, without armoring and padding.
+/// @return The constructed AIS message.
+/// @exception unknown_message Will be thrown if the AIS message is not supported.
+/// @exception std::invalid_argument Error has been occurred during parsing of
+///   the message.
+std::unique_ptr<message> make_message(const raw & bits)
+{
+	if (bits.size() < 6)
+		throw std::invalid_argument{"not enough data in ais/make_message"};
 	message_id type = static_cast<message_id>(bits.get<uint8_t>(0, 6));
 	return instantiate_message(type, bits.size())(bits);
 }
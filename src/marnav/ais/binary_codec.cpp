@@ -0,0 +1,90 @@
+#include <marnav/ais/binary_codec.hpp>
+#include <marnav/ais/ais.hpp>
+#include <marnav/nmea/binary_codec.hpp>
+#include <marnav/utils/varint.hpp>
+#include <stdexcept>
+
+namespace marnav
+{
+namespace ais
+{
+/// Appends the binary record of the AIS message to the buffer, see
+/// `nmea::encode_binary` for the header of records.
+///
+/// The data of a message:
+/// - varint: number of bits of the payload
+/// - the payload, eight bits per byte, most significant bit first
+///
+/// Reading the message needs neither NMEA sentences, nor the assembly
+/// of fragments, nor decoding of the armoring.
+///
+/// @param[out] buffer The buffer to append the record to.
+/// @param[in] msg The message to encode.
+/// @exception std::invalid_argument The message is not able to encode.
+void encode_binary(std::vector<uint8_t> & buffer, const message & msg)
+{
+	const auto bits = msg.get_data();
+	if (bits.size() == 0)
+		throw std::invalid_argument{"message not able to encode"};
+
+	const auto start
+		= nmea::detail::begin_binary_record(buffer, nmea::binary_record::ais_message);
+	utils::append_varint(buffer, bits.size());
+	const auto n = (bits.size() + 7) / 8;
+	buffer.insert(buffer.end(), bits.data_begin(), bits.data_begin() + n);
+	nmea::detail::end_binary_record(buffer, start);
+}
+
+/// Returns the binary record of the AIS message.
+std::vector<uint8_t> encode_binary(const message & msg)
+{
+	std::vector<uint8_t> result;
+	result.reserve(64);
+	encode_binary(result, msg);
+	return result;
+}
+
+/// Decodes the AIS message of the binary record at the specified position.
+///
+/// @param[in] data The data.
+/// @param[in] size Number of bytes of the data.
+/// @param[in,out] pos Position of the record, advanced to the next record.
+/// @return The decoded message.
+/// @exception std::invalid_argument The record is malformed or not an AIS message.
+/// @exception unknown_message The message is not supported.
+std::unique_ptr<message> decode_binary(
+	const uint8_t * data, std::size_t size, std::size_t & pos)
+{
+	const auto h = nmea::read_binary_header(data, size, pos);
+	if (h.kind != nmea::binary_record::ais_message)
+		throw std::invalid_argument{"not an AIS message in ais/decode_binary"};
+
+	const std::size_t end = pos + h.size;
+	std::size_t p = pos + h.body;
+	uint64_t n = 0;
+	if (!utils::read_varint(data, end, p, n) || (n > 8 * (end - p)) || ((n + 7) / 8 != end - p))
+		throw std::invalid_argument{"invalid record size in ais/decode_binary"};
+
+	// complete bytes are taken as they are, the remaining bits are appended
+	const auto full = static_cast<std::size_t>(n / 8);
+	raw bits{raw::container(data + p, data + p + full)};
+	const auto rest = static_cast<raw::size_type>(n % 8);
+	if (rest > 0)
+		bits.append(static_cast<uint8_t>(data[p + full] >> (8 - rest)), rest);
+
+	auto result = make_message(bits);
+	pos = end;
+	return result;
+}
+
+/// Decodes the AIS message of a buffer containing exactly one record.
+std::unique_ptr<message> decode_binary(const std::vector<uint8_t> & data)
+{
+	std::size_t pos = 0;
+	auto result = decode_binary(data.data(), data.size(), pos);
+	if (pos != data.size())
+		throw std::invalid_argument{"unexpected data in ais/decode_binary"};
+	return result;
+}
+}
+}
@@ -0,0 +1,238 @@
+#include <marnav/ais/target_predictor.hpp>
+#include <marnav/ais/message_01.hpp>
+#include <marnav/ais/message_18.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace marnav
+{
+namespace ais
+{
+/// @cond DEV
+namespace
+{
+/// semi-major axis according to WGS84
+static constexpr const double earth_semi_major_axis = 6378137.0; // [m]
+
+/// first eccentricity squared according to WGS84
+static constexpr const double earth_eccentricity_sqr = 6.69437999014e-3;
+
+static constexpr const double pi = 3.14159265358979323846;
+
+static double to_seconds(const target_predictor::time_point & t)
+{
+	return std::chrono::duration<double>(t.time_since_epoch()).count();
+}
+
+static double speed_of(const utils::optional<units::knots> & sog)
+{
+	if (!sog)
+		return 0.0;
+	return units::velocity{*sog}.get<units::meters_per_second>().value();
+}
+
+static double rot_of(const rate_of_turn & rot)
+{
+	if (!rot.available() || rot.is_more_5deg30s_left() || rot.is_more_5deg30s_right())
+		return 0.0;
+	return rot.value();
+}
+}
+/// @endcond
+
+constexpr std::chrono::seconds target_predictor::default_horizon;
+
+/// Initializes an empty predictor.
+///
+/// @param[in] horizon Maximum time for which positions are extrapolated. Beyond
+///   this time, the positions stay at the position reached at the horizon.
+target_predictor::target_predictor(std::chrono::seconds horizon)
+	: horizon_(static_cast<double>(horizon.count()))
+{
+}
+
+/// Updates the target using a position report of class A vessels.
+///
+/// @param[in] m The position report.
+/// @param[in] t Time of the fix.
+/// @retval true Target was updated.
+/// @retval false The report does not contain a position, target remains as it was.
+bool target_predictor::update(const message_01 & m, time_point t)
+{
+	const auto lat = m.get_lat();
+	const auto lon = m.get_lon();
+	if (!lat || !lon)
+		return false;
+
+	const auto cog = m.get_cog();
+	update(m.get_mmsi(), {*lat, *lon}, cog ? speed_of(m.get_sog()) : 0.0, cog ? *cog : 0.0,
+		rot_of(m.get_rot()), t);
+	return true;
+}
+
+/// Updates the target using a position report of class B vessels, which
+/// do not report a rate of turn.
+///
+/// @param[in] m The position report.
+/// @param[in] t Time of the fix.
+/// @retval true Target was updated.
+/// @retval false The report does not contain a position, target remains as it was.
+bool target_predictor::update(const message_18 & m, time_point t)
+{
+	const auto lat = m.get_lat();
+	const auto lon = m.get_lon();
+	if (!lat || !lon)
+		return false;
+
+	const auto cog = m.get_cog();
+	update(m.get_mmsi(), {*lat, *lon}, cog ? speed_of(m.get_sog()) : 0.0, cog ? *cog : 0.0,
+		0.0, t);
+	return true;
+}
+
+/// Updates or adds the target.
+///
+/// @param[in] m MMSI of the target.
+/// @param[in] pos Position of the fix.
+/// @param[in] sog Speed over ground in meters per second.
+/// @param[in] cog Course over ground in degrees true north.
+/// @param[in] rot Rate of turn in degrees per minute, positive to starboard.
+/// @param[in] t Time of the fix.
+void target_predictor::update(const utils::mmsi & m, const geo::position & pos, double sog,
+	double cog, double rot, time_point t)
+{
+	auto i = index_.find(m);
+	if (i == index_.end()) {
+		i = index_.emplace(m, mmsi_.size()).first;
+		mmsi_.push_back(m);
+		time_.push_back(0.0);
+		lat_.push_back(0.0);
+		lon_.push_back(0.0);
+		lat_scale_.push_back(0.0);
+		lon_scale_.push_back(0.0);
+		vn_.push_back(0.0);
+		ve_.push_back(0.0);
+		rot_.push_back(0.0);
+	}
+	const std::size_t k = i->second;
+
+	// radii of curvature of the ellipsoid at the position of the fix
+	const double phi = pos.lat() * pi / 180.0;
+	const double w = 1.0 - earth_eccentricity_sqr * std::sin(phi) * std::sin(phi);
+	const double meridian = earth_semi_major_axis * (1.0 - earth_eccentricity_sqr)
+		/ (w * std::sqrt(w));
+	const double normal = earth_semi_major_axis / std::sqrt(w);
+
+	time_[k] = to_seconds(t);
+	lat_[k] = pos.lat();
+	lon_[k] = pos.lon();
+	lat_scale_[k] = 180.0 / (pi * meridian);
+	lon_scale_[k] = 180.0 / (pi * normal * std::max(1.0e-9, std::cos(phi)));
+	vn_[k] = sog * std::cos(cog * pi / 180.0);
+	ve_[k] = sog * std::sin(cog * pi / 180.0);
+	rot_[k] = rot * pi / (180.0 * 60.0);
+}
+
+/// Removes the target, unknown targets are ignored.
+void target_predictor::remove(const utils::mmsi & m)
+{
+	const auto i = index_.find(m);
+	if (i == index_.end())
+		return;
+
+	const std::size_t k = i->second;
+	const std::size_t last = mmsi_.size() - 1;
+	index_.erase(i);
+	if (k != last) {
+		index_[mmsi_[last]] = k;
+		mmsi_[k] = mmsi_[last];
+		time_[k] = time_[last];
+		lat_[k] = lat_[last];
+		lon_[k] = lon_[last];
+		lat_scale_[k] = lat_scale_[last];
+		lon_scale_[k] = lon_scale_[last];
+		vn_[k] = vn_[last];
+		ve_[k] = ve_[last];
+		rot_[k] = rot_[last];
+	}
+	mmsi_.pop_back();
+	time_.pop_back();
+	lat_.pop_back();
+	lon_.pop_back();
+	lat_scale_.pop_back();
+	lon_scale_.pop_back();
+	vn_.pop_back();
+	ve_.pop_back();
+	rot_.pop_back();
+}
+
+/// Removes all targets with a last fix before the specified time.
+void target_predictor::expire(time_point t)
+{
+	const double limit = to_seconds(t);
+	std::size_t k = 0;
+	while (k < mmsi_.size()) {
+		if (time_[k] < limit)
+			remove(utils::mmsi{mmsi_[k]});
+		else
+			++k;
+	}
+}
+
+/// Extrapolates the position of target `i` to the time `t` [s].
+///
+/// The velocity vector rotates with the rate of turn, which results in
+/// an arc. Without turning, this degrades to a straight line.
+geo::position target_predictor::advance(std::size_t i, double t) const
+{
+	const double dt = std::max(0.0, std::min(horizon_, t - time_[i]));
+	const double w = rot_[i];
+
+	double s = dt; // sin(w * dt) / w
+	double c = 0.0; // (1 - cos(w * dt)) / w
+	if (std::abs(w * dt) > 1.0e-9) {
+		s = std::sin(w * dt) / w;
+		c = (1.0 - std::cos(w * dt)) / w;
+	}
+
+	const double dn = vn_[i] * s - ve_[i] * c;
+	const double de = ve_[i] * s + vn_[i] * c;
+
+	const double lat = std::max(-90.0, std::min(90.0, lat_[i] + dn * lat_scale_[i]));
+	double lon = lon_[i] + de * lon_scale_[i];
+	if (lon > 180.0)
+		lon -= 360.0;
+	else if (lon < -180.0)
+		lon += 360.0;
+	return {lat, lon};
+}
+
+/// Returns the extrapolated position of the target at the specified time.
+/// Times before the last fix result in the position of the fix.
+///
+/// @param[in] m MMSI of the target.
+/// @param[in] t Time of the prediction.
+/// @return The predicted position, or nothing if the target is unknown.
+utils::optional<geo::position> target_predictor::predict(
+	const utils::mmsi & m, time_point t) const
+{
+	const auto i = index_.find(m);
+	if (i == index_.end())
+		return {};
+	return advance(i->second, to_seconds(t));
+}
+
+/// Extrapolates all targets to the specified time. The result is cleared first.
+///
+/// @param[in] t Time of the prediction.
+/// @param[out] result Predicted positions of all targets.
+void target_predictor::advance_all(time_point t, std::vector<prediction> & result) const
+{
+	const double ts = to_seconds(t);
+	result.clear();
+	result.reserve(mmsi_.size());
+	for (std::size_t i = 0; i < mmsi_.size(); ++i)
+		result.push_back({utils::mmsi{mmsi_[i]}, advance(i, ts)});
+}
+}
+}
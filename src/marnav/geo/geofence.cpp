@@ -0,0 +1,335 @@
+#include <marnav/geo/geofence.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace marnav
+{
+namespace geo
+{
+/// @cond DEV
+namespace
+{
+/// Returns true if the edge from `a` to `b` possibly touches the rectangle.
+/// The test is conservative, it may report edges which pass close by
+/// the rectangle, which is harmless.
+static bool touches(double ax, double ay, double bx, double by, double x0, double y0, double x1,
+	double y1)
+{
+	if ((std::max(ax, bx) < x0) || (std::min(ax, bx) > x1) || (std::max(ay, by) < y0)
+		|| (std::min(ay, by) > y1))
+		return false;
+
+	// all corners strictly on the same side of the line: no intersection
+	const double dx = bx - ax;
+	const double dy = by - ay;
+	const double s0 = dx * (y0 - ay) - dy * (x0 - ax);
+	const double s1 = dx * (y0 - ay) - dy * (x1 - ax);
+	const double s2 = dx * (y1 - ay) - dy * (x0 - ax);
+	const double s3 = dx * (y1 - ay) - dy * (x1 - ax);
+	if ((s0 > 0.0) && (s1 > 0.0) && (s2 > 0.0) && (s3 > 0.0))
+		return false;
+	if ((s0 < 0.0) && (s1 < 0.0) && (s2 < 0.0) && (s3 < 0.0))
+		return false;
+	return true;
+}
+
+template <class Function> static void for_each_edge(const polygon & p, Function f)
+{
+	const auto edges_of = [&f](const polygon::ring & r) {
+		for (std::size_t i = 0, j = r.size() - 1; i < r.size(); j = i++)
+			f(r[i].lon(), r[i].lat(), r[j].lon(), r[j].lat());
+	};
+
+	edges_of(p.outer());
+	for (auto const & hole : p.holes())
+		edges_of(hole);
+}
+}
+/// @endcond
+
+constexpr double geofence::default_cell_size;
+
+/// Initializes an empty geofence.
+///
+/// @param[in] cell_size Size of the grid cells in degrees. Smaller cells need
+///   more memory but fewer edges have to be tested per query.
+/// @exception std::invalid_argument The cell size is not positive or too large.
+geofence::geofence(double cell_size)
+	: cell_size_(cell_size)
+{
+	if (!(cell_size_ > 0.0) || (cell_size_ > 90.0))
+		throw std::invalid_argument{"invalid cell size for geofence"};
+}
+
+int64_t geofence::row_of(double lat) const
+{
+	return static_cast<int64_t>(std::floor((lat + 90.0) / cell_size_));
+}
+
+int64_t geofence::col_of(double lon) const
+{
+	return static_cast<int64_t>(std::floor((lon + 180.0) / cell_size_));
+}
+
+geofence::cell_key geofence::make_key(int64_t row, int64_t col)
+{
+	return (static_cast<cell_key>(row) << 32) | static_cast<cell_key>(col & 0xffffffff);
+}
+
+geofence::cell_key geofence::key_of(const position & p) const
+{
+	return make_key(row_of(p.lat()), col_of(p.lon()));
+}
+
+position geofence::center_of(cell_key key) const
+{
+	const auto row = static_cast<int64_t>(key >> 32);
+	const auto col = static_cast<int64_t>(key & 0xffffffff);
+	return {(static_cast<double>(row) + 0.5) * cell_size_ - 90.0,
+		(static_cast<double>(col) + 0.5) * cell_size_ - 180.0};
+}
+
+const geofence::cell * geofence::find_cell(cell_key key) const
+{
+	const auto i = cells_.find(key);
+	return (i == cells_.end()) ? nullptr : &i->second;
+}
+
+/// Adds the polygon as a new zone and returns its identifier. Identifiers are
+/// assigned in ascending order, starting at zero.
+///
+/// The effort is proportional to the number of cells covered by the bounding
+/// box of the polygon times the number of its edges per row of cells.
+///
+/// @param[in] p The zone to add.
+/// @return The identifier of the new zone.
+geofence::zone_id geofence::add_zone(const polygon & p)
+{
+	const auto id = static_cast<zone_id>(zones_.size());
+	zones_.push_back(p);
+
+	const int64_t row0 = row_of(p.bottom());
+	const int64_t row1 = row_of(p.top());
+	const int64_t col0 = col_of(p.left());
+	const int64_t col1 = col_of(p.right());
+
+	// edges per cell, every edge is registered in all cells it touches
+	std::unordered_map<cell_key, std::vector<edge>> edges;
+	const double margin = cell_size_ * 1.0e-9;
+	for_each_edge(p, [&](double ax, double ay, double bx, double by) {
+		const int64_t r0 = std::max(row0, row_of(std::min(ay, by) - margin));
+		const int64_t r1 = std::min(row1, row_of(std::max(ay, by) + margin));
+		const int64_t c0 = std::max(col0, col_of(std::min(ax, bx) - margin));
+		const int64_t c1 = std::min(col1, col_of(std::max(ax, bx) + margin));
+		for (int64_t row = r0; row <= r1; ++row) {
+			const double y0 = static_cast<double>(row) * cell_size_ - 90.0 - margin;
+			const double y1 = static_cast<double>(row + 1) * cell_size_ - 90.0 + margin;
+			for (int64_t col = c0; col <= c1; ++col) {
+				const double x0 = static_cast<double>(col) * cell_size_ - 180.0 - margin;
+				const double x1 = static_cast<double>(col + 1) * cell_size_ - 180.0 + margin;
+				if (touches(ax, ay, bx, by, x0, y0, x1, y1))
+					edges[make_key(row, col)].push_back({ax, ay, bx, by});
+			}
+		}
+	});
+
+	// state of the cell centers, row by row using the same rule as `polygon::inside`
+	std::vector<double> xs;
+	for (int64_t row = row0; row <= row1; ++row) {
+		const double cy = center_of(make_key(row, col0)).lat();
+
+		xs.clear();
+		for_each_edge(p, [&](double ax, double ay, double bx, double by) {
+			if ((ay > cy) != (by > cy))
+				xs.push_back((bx - ax) * (cy - ay) / (by - ay) + ax);
+		});
+		std::sort(begin(xs), end(xs));
+
+		auto xi = xs.begin();
+		for (int64_t col = col0; col <= col1; ++col) {
+			const auto key = make_key(row, col);
+			const double cx = center_of(key).lon();
+
+			// number of crossings east of the center (x < xint) decides
+			while ((xi != xs.end()) && !(cx < *xi))
+				++xi;
+			const bool center_inside = (std::distance(xi, xs.end()) % 2) == 1;
+
+			auto e = edges.find(key);
+			const bool has_edges = (e != edges.end());
+			if (!has_edges && !center_inside)
+				continue;
+
+			auto & c = cells_[key];
+			c.entries.push_back({id, center_inside, {}});
+			if (has_edges) {
+				c.entries.back().edges = std::move(e->second);
+				c.has_edges = true;
+			}
+		}
+	}
+
+	return id;
+}
+
+/// Returns the zone with the specified identifier.
+///
+/// @exception std::out_of_range There is no zone with this identifier.
+const polygon & geofence::get_zone(zone_id id) const
+{
+	return zones_.at(id);
+}
+
+/// Tests the position against a zone entry of the cell the position is in.
+///
+/// The state of the cell center is known. The state of the position is
+/// determined by counting the crossings of the edges in the cell with the path
+/// from the center horizontally to the longitude of the position, then
+/// vertically to the position. This is consistent with the half-open
+/// rules of `polygon::inside`.
+bool geofence::inside(const entry & e, cell_key key, const position & p) const
+{
+	if (e.edges.empty())
+		return e.center_inside;
+
+	const auto c = center_of(key);
+	const double cx = c.lon();
+	const double cy = c.lat();
+	const double px = p.lon();
+	const double py = p.lat();
+	const double x0 = std::min(cx, px);
+	const double x1 = std::max(cx, px);
+	const double y0 = std::min(cy, py);
+	const double y1 = std::max(cy, py);
+
+	bool result = e.center_inside;
+	for (auto const & s : e.edges) {
+		if ((s.ay > cy) != (s.by > cy)) {
+			const double x = (s.bx - s.ax) * (cy - s.ay) / (s.by - s.ay) + s.ax;
+			if ((x0 < x) && (x <= x1))
+				result = !result;
+		}
+		if ((s.ax > px) != (s.bx > px)) {
+			// the position is treated as slightly east of its longitude, crossings
+			// exactly at the ends of the vertical path are decided by the slope of the edge
+			const double y = (s.by - s.ay) * (px - s.ax) / (s.bx - s.ax) + s.ay;
+			const bool rising = (s.by > s.ay) ? (s.bx > s.ax) : ((s.by < s.ay) && (s.bx < s.ax));
+			if (((y > y0) || (rising && !(y < y0))) && ((y < y1) || (!rising && !(y > y1))))
+				result = !result;
+		}
+	}
+	return result;
+}
+
+/// Returns the identifiers of all zones containing the specified position,
+/// in ascending order.
+std::vector<geofence::zone_id> geofence::zones_at(const position & p) const
+{
+	std::vector<zone_id> result;
+	zones_at(p, result);
+	return result;
+}
+
+/// Same as above, but writes the result into the specified container, which
+/// allows to reuse its memory. The container is cleared first.
+void geofence::zones_at(const position & p, std::vector<zone_id> & result) const
+{
+	result.clear();
+	const auto key = key_of(p);
+	const auto c = find_cell(key);
+	if (!c)
+		return;
+	for (auto const & e : c->entries)
+		if (inside(e, key, p))
+			result.push_back(e.zone);
+}
+
+/// Returns true if the position is inside the specified zone.
+///
+/// @exception std::out_of_range There is no zone with this identifier.
+bool geofence::inside(zone_id id, const position & p) const
+{
+	if (id >= zones_.size())
+		throw std::out_of_range{"invalid zone id"};
+
+	const auto key = key_of(p);
+	const auto c = find_cell(key);
+	if (!c)
+		return false;
+	const auto i = std::find_if(begin(c->entries), end(c->entries),
+		[id](const entry & e) { return e.zone == id; });
+	return (i != end(c->entries)) && inside(*i, key, p);
+}
+
+/// Updates the position of a vessel and appends the zone transitions
+/// caused by this update to `events`. Exits are reported before enters
+/// of the same update, both in ascending order of zones.
+///
+/// @param[in] m The vessel.
+/// @param[in] p The new position of the vessel.
+/// @param[out] events Container to which transitions are appended.
+void geofence::update(const utils::mmsi & m, const position & p, std::vector<transition> & events)
+{
+	const auto key = key_of(p);
+	const auto c = find_cell(key);
+
+	// same cell, no boundary within and no zones added since, nothing can have changed
+	auto i = vessels_.find(m);
+	if (i != vessels_.end() && (i->second.key == key) && (!c || !c->has_edges)
+		&& (i->second.generation == zones_.size()))
+		return;
+
+	zones_at(p, scratch_);
+
+	if (i == vessels_.end())
+		i = vessels_.emplace(m, vessel{key, zones_.size(), {}}).first;
+	auto & v = i->second;
+	v.key = key;
+	v.generation = zones_.size();
+
+	auto a = v.zones.begin();
+	auto b = scratch_.begin();
+	while ((a != v.zones.end()) || (b != scratch_.end())) {
+		if ((b == scratch_.end()) || ((a != v.zones.end()) && (*a < *b))) {
+			events.push_back({m, *a, transition_type::exit});
+			++a;
+		} else if ((a == v.zones.end()) || (*b < *a)) {
+			++b;
+		} else {
+			++a;
+			++b;
+		}
+	}
+	for (a = v.zones.begin(), b = scratch_.begin(); b != scratch_.end(); ++b) {
+		while ((a != v.zones.end()) && (*a < *b))
+			++a;
+		if ((a == v.zones.end()) || (*a != *b))
+			events.push_back({m, *b, transition_type::enter});
+	}
+
+	v.zones.swap(scratch_);
+}
+
+/// Removes the vessel from the geofence. For all zones the vessel was in,
+/// an exit transition is appended to `events`.
+void geofence::remove(const utils::mmsi & m, std::vector<transition> & events)
+{
+	const auto i = vessels_.find(m);
+	if (i == vessels_.end())
+		return;
+	for (auto const & zone : i->second.zones)
+		events.push_back({m, zone, transition_type::exit});
+	vessels_.erase(i);
+}
+
+/// Returns the zones the vessel is currently in, in ascending order. Unknown
+/// vessels are not in any zone.
+const std::vector<geofence::zone_id> & geofence::zones_of(const utils::mmsi & m) const
+{
+	static const std::vector<zone_id> none;
+	const auto i = vessels_.find(m);
+	return (i == vessels_.end()) ? none : i->second.zones;
+}
+}
+}
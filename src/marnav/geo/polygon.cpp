@@ -0,0 +1,101 @@
+#include <marnav/geo/polygon.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace marnav
+{
+namespace geo
+{
+/// @cond DEV
+namespace
+{
+static void check_ring(const polygon::ring & r)
+{
+	if (r.size() < 3u)
+		throw std::invalid_argument{"ring of polygon needs at least three points"};
+}
+
+/// Counts the crossings of a ray from the specified point towards east
+/// with the edges of the ring. This is the classic even-odd rule.
+static bool crossings(const polygon::ring & r, const position & p)
+{
+	bool result = false;
+	const double y = p.lat();
+	const double x = p.lon();
+	for (std::size_t i = 0, j = r.size() - 1; i < r.size(); j = i++) {
+		const double ay = r[i].lat();
+		const double ax = r[i].lon();
+		const double by = r[j].lat();
+		const double bx = r[j].lon();
+		if (((ay > y) != (by > y)) && (x < (bx - ax) * (y - ay) / (by - ay) + ax))
+			result = !result;
+	}
+	return result;
+}
+}
+/// @endcond
+
+/// Initializes the polygon with the outer ring only.
+///
+/// @param[in] outer Points of the outer ring, at least three.
+/// @exception std::invalid_argument The ring contains too few points.
+polygon::polygon(const ring & outer)
+	: polygon(outer, {})
+{
+}
+
+/// Initializes the polygon with the outer ring and its holes.
+///
+/// @param[in] outer Points of the outer ring, at least three.
+/// @param[in] holes Rings describing the holes, each at least three points.
+/// @exception std::invalid_argument One of the rings contains too few points.
+polygon::polygon(const ring & outer, const std::vector<ring> & holes)
+	: outer_(outer)
+{
+	check_ring(outer_);
+
+	const auto lat_cmp = [](const position & a, const position & b) { return a.lat() < b.lat(); };
+	const auto lon_cmp = [](const position & a, const position & b) { return a.lon() < b.lon(); };
+
+	const auto lat = std::minmax_element(begin(outer_), end(outer_), lat_cmp);
+	const auto lon = std::minmax_element(begin(outer_), end(outer_), lon_cmp);
+	bottom_ = lat.first->lat();
+	top_ = lat.second->lat();
+	left_ = lon.first->lon();
+	right_ = lon.second->lon();
+
+	for (auto const & hole : holes)
+		add_hole(hole);
+}
+
+/// Adds a hole to the polygon. The hole is expected to be inside the outer ring.
+///
+/// @param[in] hole Points of the hole, at least three.
+/// @exception std::invalid_argument The ring contains too few points.
+void polygon::add_hole(const ring & hole)
+{
+	check_ring(hole);
+	holes_.push_back(hole);
+}
+
+/// Returns true if the specified position is inside the polygon and not
+/// within one of its holes.
+///
+/// This tests all edges of the polygon. If many positions have to be tested
+/// against many polygons, consider to use `geofence`.
+///
+/// @param[in] p Point to test.
+/// @retval true Point is inside the polygon.
+/// @retval false Point is outside the polygon or within a hole.
+bool polygon::inside(const position & p) const
+{
+	if ((p.lat() < bottom_) || (p.lat() > top_) || (p.lon() < left_) || (p.lon() > right_))
+		return false;
+
+	bool result = crossings(outer_, p);
+	for (auto const & hole : holes_)
+		result ^= crossings(hole, p);
+	return result;
+}
+}
+}
@@ -0,0 +1,238 @@
+#include <marnav/geo/track.hpp>
+#include <marnav/geo/geodesic.hpp>
+#include <marnav/utils/varint.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace marnav
+{
+namespace geo
+{
+/// @cond DEV
+namespace
+{
+/// mean radius, used for the spherical cross track computation
+static constexpr const double earth_radius = 6371008.8; // [m]
+
+/// scale of latitude and longitude within the binary format
+static constexpr const double coordinate_scale = 1.0e7;
+
+static constexpr const uint8_t magic[2] = {'M', 'T'};
+
+static uint64_t zigzag_encode(int64_t value)
+{
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t zigzag_decode(uint64_t value)
+{
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1u);
+}
+
+static int64_t to_millis(const std::chrono::system_clock::time_point & t)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+}
+
+/// Reads a variable length integer, advances the specified position.
+///
+/// @exception std::invalid_argument Data ends within the value or the
+///   value is too large.
+static int64_t read_value(const uint8_t * data, std::size_t size, std::size_t & pos)
+{
+	uint64_t value = 0u;
+	if (!utils::read_varint(data, size, pos, value))
+		throw std::invalid_argument{"invalid value in track data"};
+	return zigzag_decode(value);
+}
+}
+/// @endcond
+
+constexpr std::size_t track_simplifier::default_capacity;
+
+/// Initializes the simplifier.
+///
+/// @param[in] tolerance Maximum cross track error in meters.
+/// @param[in] capacity Maximum number of points within the window, at least one.
+/// @exception std::invalid_argument Tolerance is negative or capacity is zero.
+track_simplifier::track_simplifier(double tolerance, std::size_t capacity)
+	: tolerance_(tolerance)
+	, capacity_(capacity)
+{
+	if (!(tolerance_ >= 0.0))
+		throw std::invalid_argument{"invalid tolerance for track simplifier"};
+	if (capacity_ == 0u)
+		throw std::invalid_argument{"invalid capacity for track simplifier"};
+	window_.reserve(capacity_);
+}
+
+track_simplifier::sample track_simplifier::make_sample(const track_point & p) const
+{
+	const auto r = distance_ellipsoid_vincenty(anchor_.pos, p.pos);
+	return {p, r.distance, r.azimuth};
+}
+
+/// Checks whether all points of the window are within the tolerance, regarding
+/// the segment from the anchor to the candidate.
+///
+/// The cross track and along track distances are computed on a sphere, using
+/// the distances and azimuths relative to the anchor. Points before the
+/// anchor or beyond the candidate are measured to the respective end of
+/// the segment.
+bool track_simplifier::within_tolerance(const sample & candidate) const
+{
+	if (std::isnan(candidate.distance))
+		return false;
+
+	for (auto const & s : window_) {
+		double error = s.distance;
+		if (candidate.distance > 0.0) {
+			const double delta = s.azimuth - candidate.azimuth;
+			const double d = s.distance / earth_radius;
+			const double xt = std::asin(std::sin(d) * std::sin(delta));
+			if (std::cos(delta) >= 0.0) {
+				const double at
+					= std::acos(std::max(-1.0, std::min(1.0, std::cos(d) / std::cos(xt))));
+				const double beyond = std::max(0.0, at - candidate.distance / earth_radius);
+				error = earth_radius * std::hypot(xt, beyond);
+			}
+		}
+		if (!(error <= tolerance_))
+			return false;
+	}
+	return true;
+}
+
+/// Pushes the next point of the track. Points which are to be kept
+/// are appended to the result.
+///
+/// The very first point of a track is always kept.
+///
+/// @param[in] p The new point.
+/// @param[out] result Container to which the kept points are appended.
+void track_simplifier::push(const track_point & p, std::vector<track_point> & result)
+{
+	if (!has_anchor_) {
+		anchor_ = p;
+		has_anchor_ = true;
+		result.push_back(p);
+		return;
+	}
+
+	auto candidate = make_sample(p);
+	if ((window_.size() < capacity_) && within_tolerance(candidate)) {
+		window_.push_back(candidate);
+		return;
+	}
+
+	// no previous point to keep (right after the anchor was set), the distance
+	// to the anchor could not be computed. the point itself becomes the anchor.
+	if (window_.empty()) {
+		anchor_ = p;
+		result.push_back(anchor_);
+		return;
+	}
+
+	// the previous point becomes the new anchor, all points between
+	// the old and the new anchor are within the tolerance.
+	anchor_ = window_.back().point;
+	result.push_back(anchor_);
+	window_.clear();
+	window_.push_back(make_sample(p));
+}
+
+/// Appends the last pushed point to the result, if it was not kept already.
+/// The track may be continued afterwards.
+///
+/// @param[out] result Container to which the kept point is appended.
+void track_simplifier::flush(std::vector<track_point> & result)
+{
+	if (window_.empty())
+		return;
+	anchor_ = window_.back().point;
+	result.push_back(anchor_);
+	window_.clear();
+}
+
+/// Discards the state, the next pushed point starts a new track.
+void track_simplifier::reset()
+{
+	has_anchor_ = false;
+	window_.clear();
+}
+
+constexpr uint8_t track_encoder::version;
+
+track_encoder::track_encoder()
+	: data_({magic[0], magic[1], version})
+{
+}
+
+void track_encoder::append_value(int64_t value)
+{
+	utils::append_varint(data_, zigzag_encode(value));
+}
+
+/// Appends the point to the encoded track.
+///
+/// @param[in] p The point to append.
+void track_encoder::append(const track_point & p)
+{
+	const int64_t lat = std::llround(p.pos.lat() * coordinate_scale);
+	const int64_t lon = std::llround(p.pos.lon() * coordinate_scale);
+	const int64_t time = to_millis(p.time);
+
+	append_value(lat - lat_);
+	append_value(lon - lon_);
+	append_value(time - time_);
+
+	lat_ = lat;
+	lon_ = lon;
+	time_ = time;
+	++size_;
+}
+
+/// Decodes a track, encoded by `track_encoder`.
+///
+/// @param[in] data Pointer to the encoded data.
+/// @param[in] size Number of bytes of the encoded data.
+/// @return The decoded points.
+/// @exception std::invalid_argument The data is not a valid track.
+std::vector<track_point> decode_track(const uint8_t * data, std::size_t size)
+{
+	if (!data || (size < 3u) || (data[0] != magic[0]) || (data[1] != magic[1]))
+		throw std::invalid_argument{"invalid track data"};
+	if (data[2] != track_encoder::version)
+		throw std::invalid_argument{"unsupported version of track data"};
+
+	std::size_t pos = 3u;
+
+	std::vector<track_point> result;
+	result.reserve((size - 3u) / 6u);
+
+	int64_t lat = 0;
+	int64_t lon = 0;
+	int64_t time = 0;
+	while (pos != size) {
+		lat += read_value(data, size, pos);
+		lon += read_value(data, size, pos);
+		time += read_value(data, size, pos);
+		result.push_back({{static_cast<double>(lat) / coordinate_scale,
+							  static_cast<double>(lon) / coordinate_scale},
+			std::chrono::system_clock::time_point{
+				std::chrono::duration_cast<std::chrono::system_clock::duration>(
+					std::chrono::milliseconds{time})}});
+	}
+	return result;
+}
+
+/// Decodes a track, encoded by `track_encoder`.
+///
+/// @exception std::invalid_argument The data is not a valid track.
+std::vector<track_point> decode_track(const std::vector<uint8_t> & data)
+{
+	return decode_track(data.data(), data.size());
+}
+}
+}
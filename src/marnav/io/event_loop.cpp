@@ -0,0 +1,310 @@
+#include <marnav/io/event_loop.hpp>
+#include <marnav/io/nmea_framer.hpp>
+#include <marnav/io/seatalk_framer.hpp>
+#include <marnav/io/selectable.hpp>
+#include <marnav/utils/unique.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+/// @cond DEV
+namespace
+{
+/// Maximum number of events processed per call of `epoll_wait`.
+constexpr const int max_events = 64;
+
+/// Size of the buffer for reading from devices.
+constexpr const std::size_t buffer_size = 4096;
+}
+
+/// A device, registered at the event loop, together with its framer.
+class event_loop::source
+{
+public:
+	source(std::unique_ptr<device> && d)
+		: dev_(std::move(d))
+	{
+		if (!dev_)
+			throw std::invalid_argument{"invalid device"};
+		const auto s = dynamic_cast<const selectable *>(dev_.get());
+		if (!s)
+			throw std::invalid_argument{"device is not selectable"};
+		dev_->open();
+		fd_ = s->get_fd();
+		if (fd_ < 0)
+			throw std::runtime_error{"device without file descriptor"};
+	}
+
+	virtual ~source() { dev_->close(); }
+
+	int get_fd() const noexcept { return fd_; }
+	device & get_device() noexcept { return *dev_; }
+
+	virtual void process(const char * data, std::size_t size) = 0;
+
+private:
+	std::unique_ptr<device> dev_;
+	int fd_ = -1;
+};
+
+class event_loop::nmea_source : public event_loop::source
+{
+public:
+	nmea_source(std::unique_ptr<device> && d, nmea_handler h)
+		: source(std::move(d))
+		, handler_(std::move(h))
+	{
+	}
+
+	virtual void process(const char * data, std::size_t size) override
+	{
+		framer_.feed(data, size, handler_);
+	}
+
+private:
+	nmea_framer framer_;
+	nmea_handler handler_;
+};
+
+class event_loop::seatalk_source : public event_loop::source
+{
+public:
+	seatalk_source(std::unique_ptr<device> && d, seatalk_handler h)
+		: source(std::move(d))
+		, handler_(std::move(h))
+	{
+	}
+
+	virtual void process(const char * data, std::size_t size) override
+	{
+		framer_.feed(reinterpret_cast<const uint8_t *>(data), size, handler_);
+	}
+
+private:
+	seatalk_framer framer_;
+	seatalk_handler handler_;
+};
+/// @endcond
+
+/// Initializes the event loop.
+///
+/// @exception std::runtime_error Unable to create the epoll instance.
+event_loop::event_loop()
+	: epfd_(::epoll_create1(EPOLL_CLOEXEC))
+	, buffer_(buffer_size)
+{
+	if (epfd_ < 0)
+		throw std::runtime_error{"unable to create epoll instance"};
+}
+
+/// Closes all devices.
+event_loop::~event_loop()
+{
+	sources_.clear();
+	removed_.clear();
+	::close(epfd_);
+}
+
+event_loop::source_id event_loop::add(std::unique_ptr<source> && s)
+{
+	const source_id id = next_source_++;
+
+	epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.u64 = id;
+	if (::epoll_ctl(epfd_, EPOLL_CTL_ADD, s->get_fd(), &ev) < 0)
+		throw std::runtime_error{"unable to register device"};
+
+	sources_.emplace(id, std::move(s));
+	return id;
+}
+
+/// Adds a device which delivers NMEA sentences. The device will be opened.
+///
+/// @param[in] dev The device, must implement `selectable` as well.
+/// @param[in] handler Called for every received sentence.
+/// @return Identifier of the device within the loop.
+/// @exception std::invalid_argument Device is not valid or not selectable.
+/// @exception std::runtime_error Unable to open or register the device.
+event_loop::source_id event_loop::add_nmea(std::unique_ptr<device> && dev, nmea_handler handler)
+{
+	return add(utils::make_unique<nmea_source>(std::move(dev), std::move(handler)));
+}
+
+/// Adds a device which delivers SeaTalk messages. The device will be opened.
+///
+/// @param[in] dev The device, must implement `selectable` as well.
+/// @param[in] handler Called for every received message.
+/// @return Identifier of the device within the loop.
+/// @exception std::invalid_argument Device is not valid or not selectable.
+/// @exception std::runtime_error Unable to open or register the device.
+event_loop::source_id event_loop::add_seatalk(
+	std::unique_ptr<device> && dev, seatalk_handler handler)
+{
+	return add(utils::make_unique<seatalk_source>(std::move(dev), std::move(handler)));
+}
+
+/// Removes the device from the loop and closes it. Unknown identifiers
+/// are ignored.
+///
+/// This may be called from within handlers.
+void event_loop::remove(source_id id)
+{
+	auto i = sources_.find(id);
+	if (i == sources_.end())
+		return;
+
+	::epoll_ctl(epfd_, EPOLL_CTL_DEL, i->second->get_fd(), nullptr);
+
+	// the source is possibly executing a handler right now, it will be
+	// destroyed at the end of the current iteration.
+	removed_.push_back(std::move(i->second));
+	sources_.erase(i);
+}
+
+/// Adds a timer.
+///
+/// @param[in] interval Time until the timer expires. For repeating timers,
+///   this is the period.
+/// @param[in] handler Called every time the timer expires.
+/// @param[in] repeat Repeat the timer until it is cancelled.
+/// @return Identifier of the timer.
+/// @exception std::invalid_argument Repeating timer with an interval of zero.
+event_loop::timer_id event_loop::add_timer(
+	clock::duration interval, timer_handler handler, bool repeat)
+{
+	if (repeat && (interval <= clock::duration::zero()))
+		throw std::invalid_argument{"invalid interval for repeating timer"};
+
+	const timer_id id = next_timer_++;
+	const auto deadline = clock::now() + interval;
+	timers_.emplace(id, timer{deadline, interval, repeat, std::move(handler)});
+	deadlines_.emplace(deadline, id);
+	return id;
+}
+
+/// Cancels the timer. Unknown identifiers are ignored.
+///
+/// This may be called from within handlers.
+void event_loop::cancel_timer(timer_id id)
+{
+	timers_.erase(id);
+}
+
+/// Returns the time to wait in milliseconds for the next event, considering
+/// the next timer to expire.
+int event_loop::next_timeout(int timeout_ms) const
+{
+	if (deadlines_.empty())
+		return timeout_ms;
+
+	const auto now = clock::now();
+	const auto deadline = deadlines_.top().first;
+	if (deadline <= now)
+		return 0;
+
+	// round up, waking up too early would only cause another iteration
+	const auto t = std::chrono::duration_cast<std::chrono::milliseconds>(
+		deadline - now + std::chrono::milliseconds{1} - clock::duration{1});
+	const int ms = static_cast<int>(std::min<std::chrono::milliseconds::rep>(t.count(), 1000000));
+	return (timeout_ms < 0) ? ms : std::min(ms, timeout_ms);
+}
+
+/// Executes the handlers of all expired timers.
+///
+/// @return Number of executed handlers.
+std::size_t event_loop::process_timers()
+{
+	std::size_t count = 0;
+	const auto now = clock::now();
+	while (!deadlines_.empty() && (deadlines_.top().first <= now)) {
+		const auto entry = deadlines_.top();
+		deadlines_.pop();
+
+		auto i = timers_.find(entry.second);
+		if ((i == timers_.end()) || (i->second.deadline != entry.first))
+			continue; // cancelled
+
+		// the handler may cancel the timer, it must not be executed from
+		// within the container.
+		timer_handler handler;
+		if (i->second.repeat) {
+			auto & t = i->second;
+			t.deadline += t.interval;
+			if (t.deadline <= now)
+				t.deadline = now + t.interval;
+			deadlines_.emplace(t.deadline, entry.second);
+			handler = t.handler;
+		} else {
+			handler = std::move(i->second.handler);
+			timers_.erase(i);
+		}
+
+		++count;
+		if (handler)
+			handler();
+	}
+	return count;
+}
+
+/// Waits for data on any of the devices or an expired timer, and processes
+/// them. Data of a device is read once per call, which is fair to all devices.
+///
+/// @param[in] timeout_ms Maximum time in milliseconds to wait for events.
+///   Negative values wait indefinitely, zero does not wait at all.
+/// @return Number of processed events (reads and timers).
+/// @exception std::runtime_error Error while waiting for events.
+std::size_t event_loop::run_once(int timeout_ms)
+{
+	epoll_event events[max_events];
+	int n = ::epoll_wait(epfd_, events, max_events, next_timeout(timeout_ms));
+	if (n < 0) {
+		if (errno != EINTR)
+			throw std::runtime_error{"unable to wait for events"};
+		n = 0;
+	}
+
+	std::size_t count = 0;
+	for (int i = 0; i < n; ++i) {
+		const source_id id = events[i].data.u64;
+		auto s = sources_.find(id);
+		if (s == sources_.end())
+			continue; // removed by a handler in this iteration
+
+		int rc = -1;
+		try {
+			rc = s->second->get_device().read(buffer_.data(), buffer_.size());
+		} catch (std::runtime_error &) {
+			remove(id);
+			continue;
+		}
+
+		if (rc > 0) {
+			++count;
+			s->second->process(buffer_.data(), static_cast<std::size_t>(rc));
+		} else if ((rc == 0) || ((errno != EAGAIN) && (errno != EINTR))) {
+			remove(id);
+		}
+	}
+
+	count += process_timers();
+	removed_.clear();
+	return count;
+}
+
+/// Runs the loop until it is stopped, or there are no more devices
+/// and timers.
+void event_loop::run()
+{
+	stopped_ = false;
+	while (!stopped_ && (!sources_.empty() || !timers_.empty()))
+		run_once();
+}
+}
+}
@@ -0,0 +1,306 @@
+#include <marnav/io/log_processor.hpp>
+#include <marnav/ais/ais.hpp>
+#include <marnav/io/mapped_file.hpp>
+#include <marnav/io/nmea_framer.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/vdo.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace marnav
+{
+namespace io
+{
+/// @cond DEV
+namespace
+{
+/// Number of chunks parsed ahead of the delivery, per thread.
+constexpr const std::size_t chunks_ahead = 2;
+
+using fragments = std::vector<std::pair<std::string, uint32_t>>;
+
+/// The results of a chunk, together with the state of the AIS fragments
+/// at the beginning and the end of the chunk.
+struct chunk {
+	std::vector<log_processor::result> results;
+
+	/// Indices of the fragments of a group which was started in a previous
+	/// chunk, they are assembled when the chunks are merged.
+	std::vector<std::size_t> leading;
+
+	/// Fragments of a group which is not complete at the end of the chunk.
+	fragments trailing;
+
+	/// True if the state of the fragments at the end of the chunk does not
+	/// depend on previous chunks.
+	bool determined = false;
+
+	bool ready = false;
+	log_processor::stats counters;
+
+	void clear()
+	{
+		results.clear(); // keeps the capacity for the next chunk
+		leading.clear();
+		trailing.clear();
+		determined = false;
+		ready = false;
+		counters = log_processor::stats{};
+	}
+};
+
+/// Returns the VDM/VDO sentence, `nullptr` for all others.
+const nmea::vdm * as_vdm(const nmea::sentence & s)
+{
+	if (s.id() == nmea::sentence_id::VDM)
+		return nmea::sentence_cast<nmea::vdm>(&s);
+	if (s.id() == nmea::sentence_id::VDO)
+		return nmea::sentence_cast<nmea::vdo>(&s);
+	return nullptr;
+}
+
+/// Adds the fragment to the group, assembles the message if the group is complete.
+///
+/// Fragments are expected to arrive in sequence, an incomplete message is
+/// discarded when the first fragment of the next arrives. This is the same
+/// as `pipeline` does.
+void assemble(fragments & group, const nmea::vdm & vdm, log_processor::result & r,
+	log_processor::stats & counters)
+{
+	if (vdm.get_fragment() <= 1)
+		group.clear();
+	group.emplace_back(vdm.get_payload(), vdm.get_n_fill_bits());
+	if (vdm.get_fragment() < vdm.get_n_fragments())
+		return;
+
+	fragments payload;
+	payload.swap(group);
+	try {
+		r.message = ais::make_message(payload);
+		++counters.messages;
+	} catch (std::exception &) {
+		++counters.errors;
+	}
+}
+
+/// Parses all sentences of a chunk. Fragments at the beginning of the chunk
+/// which belong to a group of a previous chunk are only recorded.
+void parse(const char * data, std::size_t size, bool last, const nmea::sentence_filter & filter,
+	nmea_framer & framer, chunk & c)
+{
+	fragments group;
+
+	auto process = [&](const std::string & s) {
+		if (!filter.accepts(s)) {
+			++c.counters.filtered;
+			return;
+		}
+
+		log_processor::result r;
+		try {
+			r.sentence = nmea::make_sentence(s);
+		} catch (std::exception &) {
+			++c.counters.errors;
+			return;
+		}
+		++c.counters.sentences;
+
+		const auto vdm = as_vdm(*r.sentence);
+		if (vdm) {
+			if (!c.determined && (vdm->get_fragment() > 1)) {
+				c.leading.push_back(c.results.size());
+				if (vdm->get_fragment() >= vdm->get_n_fragments())
+					c.determined = true;
+			} else {
+				c.determined = true;
+				assemble(group, *vdm, r, c.counters);
+			}
+		}
+		c.results.push_back(std::move(r));
+	};
+
+	framer.reset();
+	for (std::size_t i = 0; i < size; ++i) {
+		const auto status = framer.feed(data[i]);
+		if (status == nmea_framer::status::complete)
+			process(framer.sentence());
+		else if (status == nmea_framer::status::overflow)
+			++c.counters.overflows;
+	}
+
+	// last line without end of line
+	if (last && (size > 0) && (data[size - 1] != '\n')) {
+		if (framer.feed('\n') == nmea_framer::status::complete)
+			process(framer.sentence());
+	}
+
+	c.trailing = std::move(group);
+	++c.counters.chunks;
+}
+
+void accumulate(log_processor::stats & total, const log_processor::stats & s)
+{
+	total.chunks += s.chunks;
+	total.sentences += s.sentences;
+	total.messages += s.messages;
+	total.overflows += s.overflows;
+	total.errors += s.errors;
+	total.filtered += s.filtered;
+}
+}
+/// @endcond
+
+/// Initializes the processor, the data must be valid until `run` returns.
+///
+/// @param[in] data The recorded data.
+/// @param[in] size Number of bytes.
+/// @param[in] opt The options, see `options`.
+/// @exception std::invalid_argument The chunk size is zero.
+log_processor::log_processor(const char * data, std::size_t size, const options & opt)
+	: data_(data)
+	, size_(data ? size : 0)
+	, opt_(opt)
+{
+	if (opt_.chunk_size == 0)
+		throw std::invalid_argument{"invalid chunk size"};
+	if (opt_.threads == 0)
+		opt_.threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Initializes the processor with the contents of the file, which must be
+/// open and remain open until `run` returns.
+log_processor::log_processor(const mapped_file & file, const options & opt)
+	: log_processor(file.data(), file.size(), opt)
+{
+}
+
+/// Splits the data into chunks of at least the specified size, every chunk
+/// ends after a line feed, except the last one.
+///
+/// @param[in] data The data to split.
+/// @param[in] size Number of bytes.
+/// @param[in] chunk_size Minimum size of a chunk.
+/// @return The positions of the chunks, the last entry is the size of the data.
+///   The data of chunk `i` is in range `[result[i], result[i + 1])`.
+/// @exception std::invalid_argument The chunk size is zero.
+std::vector<std::size_t> log_processor::split(
+	const char * data, std::size_t size, std::size_t chunk_size)
+{
+	if (chunk_size == 0)
+		throw std::invalid_argument{"invalid chunk size"};
+
+	std::vector<std::size_t> result;
+	result.reserve(size / chunk_size + 2);
+	result.push_back(0);
+	std::size_t pos = 0;
+	while (size - pos > chunk_size) {
+		const char * p = data + pos + chunk_size - 1;
+		const auto eol
+			= static_cast<const char *>(std::memchr(p, '\n', size - pos - chunk_size + 1));
+		if (!eol)
+			break;
+		pos = static_cast<std::size_t>(eol - data) + 1;
+		if (pos < size)
+			result.push_back(pos);
+	}
+	if (size > 0)
+		result.push_back(size);
+	return result;
+}
+
+/// Parses all data and delivers the results in order.
+///
+/// @param[in] h The handler for the results, called by the calling thread.
+///   Exceptions thrown by the handler stop the processing and are passed on.
+/// @return The counters of the run.
+log_processor::stats log_processor::run(const handler & h) const
+{
+	const auto bounds = split(data_, size_, opt_.chunk_size);
+	const std::size_t n = bounds.size() - 1;
+	const std::size_t window = opt_.threads * chunks_ahead;
+
+	std::vector<chunk> chunks(window);
+	std::mutex mtx;
+	std::condition_variable cv_work;
+	std::condition_variable cv_ready;
+	std::size_t next = 0;
+	std::size_t delivered = 0;
+	bool abort = false;
+
+	auto work = [&]() {
+		nmea_framer framer;
+		std::unique_lock<std::mutex> lock{mtx};
+		for (;;) {
+			cv_work.wait(lock, [&] { return abort || (next >= n) || (next < delivered + window); });
+			if (abort || (next >= n))
+				return;
+			const std::size_t i = next++;
+			lock.unlock();
+
+			auto & c = chunks[i % window];
+			parse(data_ + bounds[i], bounds[i + 1] - bounds[i], i + 1 == n, filter_, framer, c);
+
+			lock.lock();
+			c.ready = true;
+			cv_ready.notify_one();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(std::min(opt_.threads, n));
+	for (std::size_t i = 0; i < std::min(opt_.threads, n); ++i)
+		threads.emplace_back(work);
+
+	auto stop = [&]() {
+		{
+			std::lock_guard<std::mutex> lock{mtx};
+			abort = true;
+		}
+		cv_work.notify_all();
+		for (auto & t : threads)
+			t.join();
+	};
+
+	stats total;
+	fragments group;
+	try {
+		for (std::size_t i = 0; i < n; ++i) {
+			auto & c = chunks[i % window];
+			{
+				std::unique_lock<std::mutex> lock{mtx};
+				cv_ready.wait(lock, [&c] { return c.ready; });
+			}
+
+			// groups of fragments which were started in the previous chunks
+			for (const auto index : c.leading) {
+				auto & r = c.results[index];
+				assemble(group, *as_vdm(*r.sentence), r, c.counters);
+			}
+			if (c.determined)
+				group = std::move(c.trailing);
+
+			accumulate(total, c.counters);
+			for (auto & r : c.results)
+				h(std::move(r));
+
+			{
+				std::lock_guard<std::mutex> lock{mtx};
+				c.clear();
+				delivered = i + 1;
+			}
+			cv_work.notify_all();
+		}
+	} catch (...) {
+		stop();
+		throw;
+	}
+	stop();
+	return total;
+}
+}
+}
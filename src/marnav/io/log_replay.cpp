@@ -0,0 +1,156 @@
+#include <marnav/io/log_replay.hpp>
+#include <marnav/io/mapped_file.hpp>
+#include <stdexcept>
+#include <thread>
+#include <cstring>
+
+namespace marnav
+{
+namespace io
+{
+/// @cond DEV
+namespace
+{
+/// Time stamps of tag blocks larger than this are considered to be in milliseconds.
+constexpr const double millisecond_threshold = 1.0e11;
+
+/// Extracts the time stamp (parameter `c`) of the tag block, if present.
+///
+/// @param[in] s The sentence, including the tag block.
+/// @param[out] t The time stamp in seconds.
+/// @retval true Time stamp found.
+/// @retval false No tag block or no time stamp.
+static bool tag_block_time(const std::string & s, double & t)
+{
+	if (s.empty() || (s[0] != '\\'))
+		return false;
+
+	const auto end = s.find('\\', 1);
+	if (end == std::string::npos)
+		return false;
+
+	for (std::string::size_type i = 1; i + 2 < end; ++i) {
+		if ((s[i] != 'c') || (s[i + 1] != ':') || ((i > 1) && (s[i - 1] != ',')))
+			continue;
+
+		uint64_t value = 0;
+		std::string::size_type j = i + 2;
+		for (; (j < end) && (s[j] >= '0') && (s[j] <= '9'); ++j)
+			value = value * 10 + static_cast<uint64_t>(s[j] - '0');
+		if (j == i + 2)
+			return false;
+
+		t = static_cast<double>(value);
+		if (t > millisecond_threshold)
+			t /= 1000.0;
+		return true;
+	}
+	return false;
+}
+}
+/// @endcond
+
+/// Initializes the replay.
+///
+/// @param[in] data The recorded data, must outlive the replay.
+/// @param[in] size Number of bytes.
+/// @param[in] speed The speed factor, see class description.
+/// @exception std::invalid_argument Invalid speed factor.
+log_replay::log_replay(const char * data, std::size_t size, double speed)
+	: data_(data)
+	, size_(data ? size : 0u)
+	, speed_(0.0)
+{
+	set_speed(speed);
+}
+
+/// Initializes the replay with the contents of the opened file.
+///
+/// @param[in] file The mapped file, must be opened and must outlive the replay.
+/// @param[in] speed The speed factor, see class description.
+/// @exception std::invalid_argument Invalid speed factor.
+log_replay::log_replay(const mapped_file & file, double speed)
+	: log_replay(file.data(), file.size(), speed)
+{
+}
+
+/// Sets the speed factor, pacing restarts with the next sentence.
+///
+/// @param[in] speed The speed factor, see class description.
+/// @exception std::invalid_argument Negative speed factor.
+void log_replay::set_speed(double speed)
+{
+	if (!(speed >= 0.0))
+		throw std::invalid_argument{"invalid speed factor for replay"};
+	speed_ = speed;
+	started_ = false;
+}
+
+/// Starts the replay from the beginning.
+void log_replay::rewind()
+{
+	pos_ = 0;
+	started_ = false;
+	framer_.reset();
+}
+
+/// Waits until the sentence is due, according to its time stamp.
+void log_replay::pace(const std::string & s)
+{
+	if (speed_ <= 0.0)
+		return;
+
+	double t = 0.0;
+	if (!tag_block_time(s, t))
+		return;
+
+	if (!started_) {
+		started_ = true;
+		first_time_ = t;
+		start_ = std::chrono::steady_clock::now();
+		return;
+	}
+
+	if (t <= first_time_)
+		return;
+
+	const auto due = start_
+		+ std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			  std::chrono::duration<double>((t - first_time_) / speed_));
+	std::this_thread::sleep_until(due);
+}
+
+/// Reads the next sentence, waits if necessary according to the speed factor.
+///
+/// @param[out] s The sentence, including the tag block if present.
+/// @retval true Success.
+/// @retval false End of data.
+bool log_replay::read_sentence(std::string & s)
+{
+	bool received = false;
+	while (!received && (pos_ < size_)) {
+		const char * p = data_ + pos_;
+		const auto eol = static_cast<const char *>(std::memchr(p, '\n', size_ - pos_));
+		const std::size_t n = eol ? static_cast<std::size_t>(eol - p) + 1 : size_ - pos_;
+
+		framer_.feed(p, n, [&s, &received](const std::string & sentence) {
+			s = sentence;
+			received = true;
+		});
+		pos_ += n;
+	}
+
+	// last line without end of line
+	if (!received && (pos_ == size_) && (size_ > 0) && (data_[size_ - 1] != '\n')) {
+		if (framer_.feed('\n') == nmea_framer::status::complete) {
+			s = framer_.sentence();
+			received = true;
+		}
+	}
+
+	if (received)
+		pace(s);
+	return received;
+}
+}
+}
@@ -0,0 +1,155 @@
+#include <marnav/io/mapped_file.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+mapped_file::~mapped_file()
+{
+	close();
+}
+
+/// Initializes the object, does not open the file.
+///
+/// @param[in] filename The file to map.
+mapped_file::mapped_file(const std::string & filename)
+	: filename_(filename)
+{
+}
+
+mapped_file::mapped_file(mapped_file && other) noexcept
+	: filename_(std::move(other.filename_))
+	, data_(other.data_)
+	, size_(other.size_)
+	, pos_(other.pos_)
+	, open_(other.open_)
+{
+	other.data_ = nullptr;
+	other.size_ = 0;
+	other.pos_ = 0;
+	other.open_ = false;
+}
+
+mapped_file & mapped_file::operator=(mapped_file && other) noexcept
+{
+	if (this != &other) {
+		close();
+		filename_ = std::move(other.filename_);
+		data_ = other.data_;
+		size_ = other.size_;
+		pos_ = other.pos_;
+		open_ = other.open_;
+		other.data_ = nullptr;
+		other.size_ = 0;
+		other.pos_ = 0;
+		other.open_ = false;
+	}
+	return *this;
+}
+
+/// Opens and maps the file. Opening an already opened file does nothing.
+///
+/// @exception std::runtime_error Unable to open or map the file.
+void mapped_file::open()
+{
+	if (open_)
+		return;
+
+	const int fd = ::open(filename_.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		throw std::runtime_error{"unable to open file: " + filename_};
+
+	struct stat st;
+	if (::fstat(fd, &st) < 0) {
+		::close(fd);
+		throw std::runtime_error{"unable to determine size of file: " + filename_};
+	}
+
+	const auto size = static_cast<std::size_t>(st.st_size);
+	if (size > 0) {
+		void * p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED) {
+			::close(fd);
+			throw std::runtime_error{"unable to map file: " + filename_};
+		}
+		::madvise(p, size, MADV_SEQUENTIAL);
+		data_ = static_cast<const char *>(p);
+	}
+
+	// the mapping stays valid after closing the file descriptor
+	::close(fd);
+
+	size_ = size;
+	pos_ = 0;
+	open_ = true;
+}
+
+/// Unmaps the file, all pointers to the data become invalid.
+void mapped_file::close()
+{
+	if (!open_)
+		return;
+	if (data_)
+		::munmap(const_cast<char *>(data_), size_);
+	data_ = nullptr;
+	size_ = 0;
+	pos_ = 0;
+	open_ = false;
+}
+
+/// Sets the read position of the device.
+///
+/// @exception std::out_of_range Position beyond the end of the file.
+void mapped_file::seek(std::size_t pos)
+{
+	if (pos > size_)
+		throw std::out_of_range{"position beyond end of file"};
+	pos_ = pos;
+}
+
+/// Copies data from the current position into the buffer.
+///
+/// @param[out] buffer The buffer to hold the data.
+/// @param[in] size The size of the buffer in bytes.
+/// @return Number of read bytes, zero at the end of the file.
+/// @exception std::invalid_argument
+/// @exception std::runtime_error
+int mapped_file::read(char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (!open_)
+		throw std::runtime_error{"device not open"};
+
+	// the result must fit into the return value
+	const std::size_t limit = static_cast<std::size_t>(std::numeric_limits<int>::max());
+	const std::size_t n = std::min({static_cast<std::size_t>(size), size_ - pos_, limit});
+	if (n > 0)
+		std::memcpy(buffer, data_ + pos_, n);
+	pos_ += n;
+	return static_cast<int>(n);
+}
+
+/// Not supported, the file is read only. Behaves like writing to a file
+/// descriptor which is not open for writing.
+///
+/// @return Always -1, `errno` is set to `EBADF`.
+/// @exception std::invalid_argument
+int mapped_file::write(const char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	errno = EBADF;
+	return -1;
+}
+}
+}
@@ -0,0 +1,310 @@
+#include <marnav/io/metrics.hpp>
+#include <marnav/ais/ais.hpp>
+#include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <ostream>
+#include <stdexcept>
+#include <cstdio>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t latency_histogram::num_buckets;
+constexpr std::size_t stream_metrics::num_events;
+constexpr std::size_t stream_metrics::num_sentence_ids;
+constexpr std::size_t stream_metrics::num_message_ids;
+
+/// @cond DEV
+namespace
+{
+static const char * const event_names[stream_metrics::num_events] = {
+	"bytes",
+	"frames",
+	"filtered",
+	"overflows",
+	"checksum_errors",
+	"unknown_sentences",
+	"parse_errors",
+	"ais_errors",
+	"collisions",
+	"bus_errors",
+};
+
+/// Formats seconds for the exposition format, without loss of nanoseconds.
+/// Integer seconds and nanoseconds are formatted separately, trailing zeros
+/// of the fraction are omitted.
+static std::string seconds(std::chrono::nanoseconds d)
+{
+	const auto ns = d.count();
+	const bool negative = ns < 0;
+	const auto abs = negative ? -static_cast<unsigned long long>(ns)
+							  : static_cast<unsigned long long>(ns);
+
+	char buf[32];
+	int n = std::snprintf(buf, sizeof(buf), "%s%llu.%09llu", negative ? "-" : "",
+		abs / 1000000000ull, abs % 1000000000ull);
+	while (buf[n - 1] == '0')
+		--n;
+	if (buf[n - 1] == '.')
+		--n;
+	return std::string(buf, static_cast<std::size_t>(n));
+}
+
+/// Escapes the value of a label, see the Prometheus exposition format.
+static std::string escape(const std::string & s)
+{
+	std::string result;
+	result.reserve(s.size());
+	for (const auto c : s) {
+		switch (c) {
+			case '\\':
+				result += "\\\\";
+				break;
+			case '"':
+				result += "\\\"";
+				break;
+			case '\n':
+				result += "\\n";
+				break;
+			default:
+				result += c;
+				break;
+		}
+	}
+	return result;
+}
+
+static void write_histogram(std::ostream & os, const std::string & name,
+	const std::string & labels, const latency_histogram::snapshot & h)
+{
+	uint64_t cumulative = 0;
+	for (std::size_t i = 0; i < latency_histogram::num_buckets; ++i) {
+		cumulative += h.buckets[i];
+		const auto le = (i + 1 < latency_histogram::num_buckets)
+			? seconds(latency_histogram::upper_bound(i))
+			: std::string{"+Inf"};
+		os << name << "_bucket{" << labels << ",le=\"" << le << "\"} " << cumulative << '\n';
+	}
+	os << name << "_sum{" << labels << "} " << seconds(h.sum) << '\n';
+	os << name << "_count{" << labels << "} " << h.count << '\n';
+}
+}
+/// @endcond
+
+latency_histogram::latency_histogram() noexcept
+{
+	for (auto & b : buckets_)
+		b.store(0, std::memory_order_relaxed);
+	sum_.store(0, std::memory_order_relaxed);
+}
+
+/// Records the duration.
+void latency_histogram::record(std::chrono::nanoseconds d) noexcept
+{
+	const auto ns = (d.count() > 0) ? static_cast<uint64_t>(d.count()) : uint64_t{0};
+	const uint64_t us = (ns + 999) / 1000;
+	std::size_t i = 0;
+	while ((i + 1 < num_buckets) && (us > (uint64_t{1} << i)))
+		++i;
+	buckets_[i].fetch_add(1, std::memory_order_relaxed);
+	sum_.fetch_add(ns, std::memory_order_relaxed);
+}
+
+/// Returns a copy of the buckets.
+latency_histogram::snapshot latency_histogram::get() const noexcept
+{
+	snapshot s;
+	for (std::size_t i = 0; i < num_buckets; ++i) {
+		s.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+		s.count += s.buckets[i];
+	}
+	s.sum = std::chrono::nanoseconds{sum_.load(std::memory_order_relaxed)};
+	return s;
+}
+
+/// Returns the inclusive upper bound of the bucket. The last bucket has no
+/// upper bound, the maximum of the duration is returned.
+std::chrono::nanoseconds latency_histogram::upper_bound(std::size_t bucket) noexcept
+{
+	if (bucket + 1 >= num_buckets)
+		return std::chrono::nanoseconds::max();
+	return std::chrono::microseconds{int64_t{1} << bucket};
+}
+
+stream_metrics::stream_metrics() noexcept
+{
+	for (auto & e : events_)
+		e.store(0, std::memory_order_relaxed);
+}
+
+/// Records a parsed sentence and the time it took to parse it.
+/// Unknown IDs are ignored.
+void stream_metrics::record(nmea::sentence_id id, clock::duration d) noexcept
+{
+	const auto i = static_cast<std::size_t>(id);
+	if (i < num_sentence_ids)
+		sentences_[i].record(d);
+}
+
+/// Records a parsed AIS message and the time it took to parse it.
+/// Unknown types are ignored.
+void stream_metrics::record(ais::message_id id, clock::duration d) noexcept
+{
+	const auto i = static_cast<std::size_t>(id);
+	if (i < num_message_ids)
+		messages_[i].record(d);
+}
+
+/// Returns a copy of all counters, may be called from any thread.
+///
+/// Sentences and AIS messages are contained only, if at least one of them
+/// was recorded.
+stream_metrics::snapshot stream_metrics::get() const
+{
+	snapshot s;
+	s.time = clock::now();
+	for (std::size_t i = 0; i < num_events; ++i)
+		s.events[i] = events_[i].load(std::memory_order_relaxed);
+	for (std::size_t i = 0; i < num_sentence_ids; ++i) {
+		const auto h = sentences_[i].get();
+		if (h.count > 0)
+			s.sentences.push_back({static_cast<nmea::sentence_id>(i), h});
+	}
+	for (std::size_t i = 0; i < num_message_ids; ++i) {
+		const auto h = messages_[i].get();
+		if (h.count > 0)
+			s.messages.push_back({static_cast<ais::message_id>(i), h});
+	}
+	return s;
+}
+
+/// Returns the name of the event, as used in the exposition format.
+std::string to_string(stream_metrics::event e)
+{
+	const auto i = static_cast<std::size_t>(e);
+	return (i < stream_metrics::num_events) ? event_names[i] : "unknown";
+}
+
+/// Returns the rate of the event per second, between two snapshots.
+///
+/// @param[in] from The earlier snapshot.
+/// @param[in] to The later snapshot.
+/// @param[in] e The event, e.g. `stream_metrics::event::bytes`.
+/// @return Events per second, zero if the snapshots are not in order.
+double rate(const stream_metrics::snapshot & from, const stream_metrics::snapshot & to,
+	stream_metrics::event e)
+{
+	const auto dt = std::chrono::duration<double>(to.time - from.time).count();
+	if ((dt <= 0.0) || (to.get(e) < from.get(e)))
+		return 0.0;
+	return static_cast<double>(to.get(e) - from.get(e)) / dt;
+}
+
+/// Parses the sentence, records its ID and parse time or the kind of
+/// failure.
+///
+/// @param[in] s The raw sentence.
+/// @param[in] m The metrics of the stream.
+/// @return The sentence, `nullptr` if it could not be parsed.
+std::unique_ptr<nmea::sentence> parse_sentence(const std::string & s, stream_metrics & m)
+{
+	const auto t0 = stream_metrics::clock::now();
+	try {
+		auto result = nmea::make_sentence(s);
+		m.record(result->id(), stream_metrics::clock::now() - t0);
+		return result;
+	} catch (nmea::checksum_error &) {
+		m.count(stream_metrics::event::checksum_errors);
+	} catch (nmea::unknown_sentence &) {
+		m.count(stream_metrics::event::unknown_sentences);
+	} catch (std::invalid_argument &) {
+		// well formed sentences with unsupported addresses are reported
+		// as invalid arguments too, only failures are examined further.
+		const auto v = nmea::validate_sentence(s);
+		m.count((v && (v.id == nmea::sentence_id::NONE))
+				? stream_metrics::event::unknown_sentences
+				: stream_metrics::event::parse_errors);
+	} catch (std::exception &) {
+		m.count(stream_metrics::event::parse_errors);
+	}
+	return nullptr;
+}
+
+/// Parses the AIS message, records its type and parse time or the failure.
+///
+/// @param[in] payload The payload of all fragments of the message, see `ais::make_message`.
+/// @param[in] m The metrics of the stream.
+/// @return The message, `nullptr` if it could not be parsed.
+std::unique_ptr<ais::message> parse_message(
+	const std::vector<std::pair<std::string, uint32_t>> & payload, stream_metrics & m)
+{
+	const auto t0 = stream_metrics::clock::now();
+	try {
+		auto result = ais::make_message(payload);
+		m.record(result->type(), stream_metrics::clock::now() - t0);
+		return result;
+	} catch (std::exception &) {
+		m.count(stream_metrics::event::ais_errors);
+	}
+	return nullptr;
+}
+
+/// Writes the snapshot of one stream in the Prometheus text exposition format.
+///
+/// @param[in] os The stream to write to.
+/// @param[in] stream Name of the stream, used as label.
+/// @param[in] s The snapshot.
+void write_prometheus(
+	std::ostream & os, const std::string & stream, const stream_metrics::snapshot & s)
+{
+	write_prometheus(os, {{stream, s}});
+}
+
+/// Writes the snapshots of many streams in the Prometheus text exposition
+/// format. Every metric is written once, with the name of the stream as label.
+///
+/// Example of the output:
+/// @code
+/// # TYPE marnav_events_total counter
+/// marnav_events_total{stream="ttyUSB0",event="bytes"} 8152
+/// ...
+/// # TYPE marnav_sentence_parse_seconds histogram
+/// marnav_sentence_parse_seconds_bucket{stream="ttyUSB0",id="GGA",le="1e-06"} 0
+/// ...
+/// @endcode
+void write_prometheus(std::ostream & os,
+	const std::vector<std::pair<std::string, stream_metrics::snapshot>> & streams)
+{
+	os << "# HELP marnav_events_total Events of the stream.\n";
+	os << "# TYPE marnav_events_total counter\n";
+	for (const auto & s : streams) {
+		const auto stream = escape(s.first);
+		for (std::size_t i = 0; i < stream_metrics::num_events; ++i)
+			os << "marnav_events_total{stream=\"" << stream << "\",event=\"" << event_names[i]
+			   << "\"} " << s.second.events[i] << '\n';
+	}
+
+	os << "# HELP marnav_sentence_parse_seconds Time to parse sentences, per ID.\n";
+	os << "# TYPE marnav_sentence_parse_seconds histogram\n";
+	for (const auto & s : streams) {
+		const auto stream = escape(s.first);
+		for (const auto & h : s.second.sentences)
+			write_histogram(os, "marnav_sentence_parse_seconds",
+				"stream=\"" + stream + "\",id=\"" + nmea::to_string(h.id) + "\"", h.latency);
+	}
+
+	os << "# HELP marnav_ais_parse_seconds Time to parse AIS messages, per type.\n";
+	os << "# TYPE marnav_ais_parse_seconds histogram\n";
+	for (const auto & s : streams) {
+		const auto stream = escape(s.first);
+		for (const auto & h : s.second.messages)
+			write_histogram(os, "marnav_ais_parse_seconds",
+				"stream=\"" + stream + "\",type=\""
+					+ std::to_string(static_cast<unsigned int>(h.id)) + "\"",
+				h.latency);
+	}
+}
+}
+}
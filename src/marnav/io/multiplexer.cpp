@@ -0,0 +1,399 @@
+#include <marnav/io/multiplexer.hpp>
+#include <marnav/io/nmea_framer.hpp>
+#include <marnav/io/selectable.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/uio.h>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t multiplexer::default_queue_size;
+
+/// @cond DEV
+namespace
+{
+/// Size of the buffer for reading from devices.
+constexpr const std::size_t buffer_size = 4096;
+
+/// Size of a slot in the queue of an output, including the end of line.
+constexpr const std::size_t slot_size = 256;
+
+/// Maximum length of a sentence, without tag block and end of line.
+constexpr const std::size_t max_sentence_size = nmea::sentence::max_length;
+
+/// Maximum number of sentences written by one system call.
+constexpr const std::size_t max_iov = 64;
+
+/// Extracts talker and tag from the address of a valid sentence.
+///
+/// @param[in] s The raw sentence.
+/// @param[in] v The result of the validation of the sentence.
+/// @param[out] talker The talker, empty for proprietary sentences.
+/// @param[out] tag The tag of the sentence.
+static void split_address(const std::string & s, const nmea::validation_result & v,
+	std::string & talker, std::string & tag)
+{
+	if ((v.address_size == 5) && (s[v.address] != 'P')) {
+		talker.assign(s, v.address, 2);
+		tag.assign(s, v.address + 2, 3);
+	} else {
+		talker.clear();
+		tag.assign(s, v.address, v.address_size);
+	}
+}
+}
+
+/// A device, delivering sentences.
+class multiplexer::input
+{
+public:
+	input(std::unique_ptr<device> && d)
+		: dev_(std::move(d))
+	{
+		if (!dev_)
+			throw std::invalid_argument{"invalid device"};
+		const auto s = dynamic_cast<const selectable *>(dev_.get());
+		if (!s)
+			throw std::invalid_argument{"device is not selectable"};
+		dev_->open();
+		fd_ = s->get_fd();
+		if (fd_ < 0)
+			throw std::runtime_error{"device without file descriptor"};
+	}
+
+	~input() { close(); }
+
+	void close()
+	{
+		if (fd_ < 0)
+			return;
+		dev_->close();
+		fd_ = -1;
+	}
+
+	int get_fd() const noexcept { return fd_; }
+	device & get_device() noexcept { return *dev_; }
+	nmea_framer & get_framer() noexcept { return framer_; }
+
+private:
+	std::unique_ptr<device> dev_;
+	int fd_ = -1;
+	nmea_framer framer_{max_sentence_size, slot_size - 2 - max_sentence_size};
+};
+
+/// A device, receiving sentences, with its queue. The queue consists
+/// of fixed size slots, which are written directly (`writev`).
+class multiplexer::output
+{
+public:
+	output(std::unique_ptr<device> && d, const filter & f, std::size_t queue_size)
+		: dev_(std::move(d))
+		, filter_(f)
+		, data_(queue_size * slot_size)
+		, sizes_(queue_size)
+	{
+		if (!dev_)
+			throw std::invalid_argument{"invalid device"};
+		if (queue_size == 0)
+			throw std::invalid_argument{"invalid queue size"};
+		const auto s = dynamic_cast<const selectable *>(dev_.get());
+		if (!s)
+			throw std::invalid_argument{"device is not selectable"};
+		dev_->open();
+		fd_ = s->get_fd();
+		if (fd_ < 0)
+			throw std::runtime_error{"device without file descriptor"};
+
+		const int flags = ::fcntl(fd_, F_GETFL);
+		if ((flags < 0) || (::fcntl(fd_, F_SETFL, flags | O_NONBLOCK) < 0))
+			throw std::runtime_error{"unable to set device to non-blocking mode"};
+	}
+
+	~output() { dev_->close(); }
+
+	int get_fd() const noexcept { return fd_; }
+	const filter & get_filter() const noexcept { return filter_; }
+	bool empty() const noexcept { return count_ == 0; }
+	std::size_t get_depth() const noexcept { return count_; }
+	const output_stats & get_stats() const noexcept { return stats_; }
+
+	/// Appends the sentence and the end of line to the queue.
+	bool push(const std::string & s)
+	{
+		if ((count_ == sizes_.size()) || (s.size() + 2 > slot_size)) {
+			++stats_.dropped;
+			return false;
+		}
+
+		const std::size_t i = (head_ + count_) % sizes_.size();
+		char * p = data_.data() + i * slot_size;
+		std::memcpy(p, s.data(), s.size());
+		p[s.size()] = '\r';
+		p[s.size() + 1] = '\n';
+		sizes_[i] = s.size() + 2;
+		++count_;
+		stats_.max_depth = std::max(stats_.max_depth, count_);
+		return true;
+	}
+
+	/// Writes as many queued sentences as possible, without blocking.
+	///
+	/// @return Number of completely written sentences.
+	std::size_t flush()
+	{
+		std::size_t total = 0;
+		while (count_ > 0) {
+			iovec iov[max_iov];
+			const std::size_t n = std::min(count_, max_iov);
+			for (std::size_t k = 0; k < n; ++k) {
+				const std::size_t i = (head_ + k) % sizes_.size();
+				const std::size_t skip = (k == 0) ? offset_ : 0;
+				iov[k].iov_base = data_.data() + i * slot_size + skip;
+				iov[k].iov_len = sizes_[i] - skip;
+			}
+
+			const auto rc = ::writev(fd_, iov, static_cast<int>(n));
+			if (rc < 0) {
+				if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+					break;
+				// the queued data is lost
+				++stats_.errors;
+				stats_.dropped += count_;
+				count_ = 0;
+				offset_ = 0;
+				break;
+			}
+			++stats_.writes;
+
+			// consume written data
+			std::size_t written = static_cast<std::size_t>(rc);
+			while (written > 0) {
+				const std::size_t remaining = sizes_[head_] - offset_;
+				if (written < remaining) {
+					offset_ += written;
+					break;
+				}
+				written -= remaining;
+				offset_ = 0;
+				head_ = (head_ + 1) % sizes_.size();
+				--count_;
+				++stats_.sent;
+				++total;
+			}
+
+			// partial write, the device is not able to take more for now
+			if (offset_ > 0)
+				break;
+		}
+		return total;
+	}
+
+private:
+	std::unique_ptr<device> dev_;
+	int fd_ = -1;
+	filter filter_;
+	std::vector<char> data_;
+	std::vector<std::size_t> sizes_;
+	std::size_t head_ = 0;
+	std::size_t count_ = 0;
+	std::size_t offset_ = 0; // already written part of the first sentence
+	output_stats stats_;
+};
+/// @endcond
+
+/// Returns true if the sentence with the specified talker and tag passes the filter.
+bool multiplexer::filter::matches(const std::string & talker, const std::string & tag) const
+{
+	const auto contains = [](const std::vector<std::string> & v, const std::string & s) {
+		return v.empty() || (std::find(v.begin(), v.end(), s) != v.end());
+	};
+	return contains(talkers, talker) && contains(tags, tag);
+}
+
+multiplexer::multiplexer()
+	: buffer_(buffer_size)
+{
+}
+
+/// Closes all devices.
+multiplexer::~multiplexer()
+{
+}
+
+/// Adds a device which delivers NMEA sentences. The device will be opened.
+///
+/// @param[in] dev The device, must implement `selectable` as well.
+/// @return Identifier of the input.
+/// @exception std::invalid_argument Device is not valid or not selectable.
+/// @exception std::runtime_error Unable to open the device.
+multiplexer::input_id multiplexer::add_input(std::unique_ptr<device> && dev)
+{
+	inputs_.push_back(std::unique_ptr<input>(new input(std::move(dev))));
+	return inputs_.size() - 1;
+}
+
+/// Adds a device which receives NMEA sentences. The device will be opened
+/// and set to non-blocking mode.
+///
+/// @param[in] dev The device, must implement `selectable` as well.
+/// @param[in] f The filter for sentences to be sent to this output.
+/// @param[in] queue_size Maximum number of sentences waiting to be written.
+/// @return Identifier of the output.
+/// @exception std::invalid_argument Device is not valid or not selectable,
+///   or the queue size is zero.
+/// @exception std::runtime_error Unable to open the device.
+multiplexer::output_id multiplexer::add_output(
+	std::unique_ptr<device> && dev, const filter & f, std::size_t queue_size)
+{
+	outputs_.push_back(std::unique_ptr<output>(new output(std::move(dev), f, queue_size)));
+	return outputs_.size() - 1;
+}
+
+/// Returns the number of inputs, which are still active.
+std::size_t multiplexer::inputs() const noexcept
+{
+	return static_cast<std::size_t>(std::count_if(inputs_.begin(), inputs_.end(),
+		[](const std::unique_ptr<input> & i) { return i->get_fd() >= 0; }));
+}
+
+/// Validates the sentence and queues it for all outputs with a matching filter.
+/// Nothing is written to the devices, see `flush`.
+///
+/// @param[in] s The raw sentence, without end of line.
+/// @return Number of outputs the sentence was queued for.
+std::size_t multiplexer::dispatch(const std::string & s)
+{
+	const auto v = nmea::validate_sentence(s);
+	if (!v) {
+		++invalid_;
+		return 0;
+	}
+
+	std::string talker;
+	std::string tag;
+	split_address(s, v, talker, tag);
+
+	std::size_t count = 0;
+	for (auto & out : outputs_)
+		if (out->get_filter().matches(talker, tag) && out->push(s))
+			++count;
+	return count;
+}
+
+/// Writes queued sentences to all outputs, without blocking.
+///
+/// @return Number of completely written sentences.
+std::size_t multiplexer::flush()
+{
+	std::size_t count = 0;
+	for (auto & out : outputs_)
+		count += out->flush();
+	return count;
+}
+
+/// Waits for data from inputs, or for outputs to be able to take queued data.
+/// Received sentences are dispatched and written to the outputs immediately.
+///
+/// Inputs which reach the end of file or fail to read are closed.
+///
+/// @param[in] timeout_ms Maximum time in milliseconds to wait for events.
+///   Negative values wait indefinitely, zero does not wait at all.
+/// @return Number of processed events.
+/// @exception std::runtime_error Error while waiting for events.
+std::size_t multiplexer::run_once(int timeout_ms)
+{
+	std::vector<pollfd> fds;
+	fds.reserve(inputs_.size() + outputs_.size());
+	std::vector<input *> active;
+	active.reserve(inputs_.size());
+	for (auto & in : inputs_) {
+		if (in->get_fd() < 0)
+			continue;
+		pollfd p;
+		p.fd = in->get_fd();
+		p.events = POLLIN;
+		p.revents = 0;
+		fds.push_back(p);
+		active.push_back(in.get());
+	}
+	for (auto & out : outputs_) {
+		pollfd p;
+		p.fd = out->empty() ? -1 : out->get_fd(); // negative: ignored by poll
+		p.events = POLLOUT;
+		p.revents = 0;
+		fds.push_back(p);
+	}
+
+	int n = ::poll(fds.data(), fds.size(), timeout_ms);
+	if (n < 0) {
+		if (errno != EINTR)
+			throw std::runtime_error{"unable to wait for events"};
+		return 0;
+	}
+	if (n == 0)
+		return 0;
+
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < active.size(); ++i) {
+		if (fds[i].revents == 0)
+			continue;
+		auto & in = *active[i];
+
+		int rc = -1;
+		try {
+			rc = in.get_device().read(buffer_.data(), static_cast<uint32_t>(buffer_.size()));
+		} catch (std::runtime_error &) {
+			in.close();
+			continue;
+		}
+
+		if (rc > 0) {
+			++count;
+			in.get_framer().feed(buffer_.data(), static_cast<std::size_t>(rc),
+				[this](const std::string & s) { dispatch(s); });
+		} else if ((rc == 0) || ((errno != EAGAIN) && (errno != EINTR))) {
+			in.close();
+		}
+	}
+
+	// write new and pending data, no need to wait for the next iteration
+	for (auto & out : outputs_)
+		if (!out->empty() && (out->flush() > 0))
+			++count;
+
+	return count;
+}
+
+/// Runs the multiplexer until it is stopped, or there are no more inputs.
+/// Remaining queued sentences are written, if possible without blocking.
+void multiplexer::run()
+{
+	stopped_ = false;
+	while (!stopped_ && (inputs() > 0))
+		run_once();
+	flush();
+}
+
+/// Returns the counters of the specified output.
+///
+/// @exception std::out_of_range Unknown output.
+multiplexer::output_stats multiplexer::get_output_stats(output_id id) const
+{
+	if (id >= outputs_.size())
+		throw std::out_of_range{"unknown output"};
+
+	const auto & out = *outputs_[id];
+	output_stats s = out.get_stats();
+	s.depth = out.get_depth();
+	return s;
+}
+}
+}
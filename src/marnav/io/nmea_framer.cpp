@@ -0,0 +1,106 @@
+#include <marnav/io/nmea_framer.hpp>
+#include <marnav/nmea/sentence.hpp>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t nmea_framer::default_max_tag_block_length;
+
+/// Initializes the framer for sentences of the maximum length defined by
+/// the standard, optionally preceded by a tag block.
+nmea_framer::nmea_framer()
+	: nmea_framer(nmea::sentence::max_length, default_max_tag_block_length)
+{
+}
+
+/// Initializes the framer with the specified limits.
+///
+/// @param[in] max_length Maximum number of characters of a sentence,
+///   without tag block and end of line.
+/// @param[in] max_tag_block_length Maximum number of characters of a
+///   tag block, which precedes the sentence. Zero if lines with tag blocks
+///   are limited to `max_length` as well.
+nmea_framer::nmea_framer(std::size_t max_length, std::size_t max_tag_block_length)
+	: max_length_(max_length)
+	, max_tag_block_length_(max_tag_block_length)
+{
+	sentence_.reserve(max_length_ + max_tag_block_length_);
+}
+
+/// Returns the maximum number of characters of the current line, which
+/// depends on whether or not it starts with a tag block.
+std::size_t nmea_framer::limit() const noexcept
+{
+	if (!sentence_.empty() && (sentence_[0] == '\\'))
+		return max_length_ + max_tag_block_length_;
+	return max_length_;
+}
+
+/// Processes a single character.
+///
+/// @param[in] c The character to process.
+/// @retval status::none Nothing special, the character was consumed or ignored.
+/// @retval status::complete The sentence is complete, it is available through
+///   `sentence()` until the next character is fed.
+/// @retval status::overflow Too many characters for a sentence, the partial
+///   sentence was discarded.
+nmea_framer::status nmea_framer::feed(char c)
+{
+	return feed(c, clock::time_point{});
+}
+
+/// Processes a single character, which was received at the specified time.
+///
+/// @param[in] c The character to process.
+/// @param[in] t Time of reception of the character.
+/// @return See `feed(char)`.
+nmea_framer::status nmea_framer::feed(char c, clock::time_point t)
+{
+	if (complete_) {
+		sentence_.clear();
+		complete_ = false;
+	}
+
+	switch (c) {
+		case '\r':
+			return status::none;
+
+		case '\n': // end of sentence
+			if (overflow_) {
+				overflow_ = false;
+				return status::none;
+			}
+			if (sentence_.empty())
+				return status::none;
+			complete_ = true;
+			return status::complete;
+
+		default:
+			// ignore invalid characters. if this makes the sentence incomplete,
+			// the sentence would have been invalid anyway.
+			if (overflow_ || (c <= 32) || (c >= 127))
+				return status::none;
+
+			if (sentence_.size() >= limit()) {
+				sentence_.clear();
+				overflow_ = true;
+				++overflows_;
+				return status::overflow;
+			}
+			if (sentence_.empty())
+				start_ = t;
+			sentence_ += c;
+			return status::none;
+	}
+}
+
+/// Discards the partial sentence, the framer waits for the next sentence.
+void nmea_framer::reset()
+{
+	sentence_.clear();
+	complete_ = false;
+	overflow_ = false;
+}
+}
+}
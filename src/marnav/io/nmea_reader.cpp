@@ -18,7 +18,6 @@ nmea_reader::nmea_reader(std::unique_ptr<device> && d)
 	: raw_(0)
 	, dev_(std::move(d))
 {
-	sentence_.reserve(nmea::sentence::max_length + 1);
 	if (dev_)
 		dev_->open();
 }
@@ -46,6 +45,8 @@ bool nmea_reader::read_data()
 		throw std::runtime_error{"read error"};
 	if (rc != sizeof(raw_))
 		throw std::runtime_error{"read error"};
+	if (metrics_)
+		metrics_->count(stream_metrics::event::bytes);
 	return true;
 }
 
@@ -55,24 +56,21 @@ bool nmea_reader::read_data()
 ///   Maybe the end of line was missed or left out.
 void nmea_reader::process_nmea()
 {
-	switch (raw_) {
-		case '\r':
+	switch (framer_.feed(raw_)) {
+		case nmea_framer::status::none:
 			break;
-		case '\n': // end of sentence
-			process_sentence(sentence_);
-			sentence_.clear();
-			break;
-		default:
-			// ignore invalid characters. if this makes the sentence incomplete,
-			// the sentence would have been invalid anyway. the result will be
-			// an invalid sentence or a std::length_error.
-			if ((raw_ <= 32) || (raw_ >= 127))
-				return;
-
-			if (sentence_.size() > nmea::sentence::max_length)
-				throw std::length_error{"sentence size to large. receiving NMEA data?"};
-			sentence_ += raw_;
+		case nmea_framer::status::complete:
+			if (metrics_)
+				metrics_->count(stream_metrics::event::frames);
+			if (filter_.accepts(framer_.sentence()))
+				process_sentence(framer_.sentence());
+			else if (metrics_)
+				metrics_->count(stream_metrics::event::filtered);
 			break;
+		case nmea_framer::status::overflow:
+			if (metrics_)
+				metrics_->count(stream_metrics::event::overflows);
+			throw std::length_error{"sentence size to large. receiving NMEA data?"};
 	}
 }
 
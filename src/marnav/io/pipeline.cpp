@@ -0,0 +1,437 @@
+#include <marnav/io/pipeline.hpp>
+#include <marnav/ais/ais.hpp>
+#include <marnav/io/nmea_framer.hpp>
+#include <marnav/io/selectable.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/vdo.hpp>
+#include <marnav/utils/spsc_ring.hpp>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+
+namespace marnav
+{
+namespace io
+{
+/// @cond DEV
+namespace
+{
+/// Size of the buffer for reading from devices.
+constexpr const std::size_t buffer_size = 4096;
+
+/// Maximum size of a sentence within a slot of the input ring. This is
+/// larger than the maximum sentence size, to allow tag blocks.
+constexpr const std::size_t max_frame_size = 256;
+
+/// Maximum length of the sentence within a frame, without tag block.
+constexpr const std::size_t max_sentence_size = nmea::sentence::max_length;
+
+/// Time in milliseconds between checks, whether or not the pipeline is
+/// stopped, while waiting for data.
+constexpr const int poll_interval_ms = 100;
+
+/// Number of entries processed from one ring, before switching to the next.
+constexpr const std::size_t batch_size = 64;
+
+/// Number of idle iterations before waiting threads start to sleep.
+constexpr const unsigned int spin_limit = 64;
+
+/// A raw sentence, stored in a fixed size slot.
+struct frame {
+	uint32_t size = 0;
+	char data[max_frame_size];
+};
+
+/// Waits progressively longer, the longer there is nothing to do.
+void backoff(unsigned int & idle)
+{
+	if (idle < spin_limit) {
+		++idle;
+		std::this_thread::yield();
+	} else {
+		std::this_thread::sleep_for(std::chrono::microseconds{100});
+	}
+}
+
+/// Updates the maximum of an atomic counter, which has only one writer.
+void update_max(std::atomic<std::size_t> & m, std::size_t value)
+{
+	if (value > m.load(std::memory_order_relaxed))
+		m.store(value, std::memory_order_relaxed);
+}
+
+/// Atomic counters of a ring, see `pipeline::stage_stats`.
+struct stage_counters {
+	std::atomic<std::size_t> max_depth{0};
+	std::atomic<uint64_t> processed{0};
+	std::atomic<uint64_t> dropped{0};
+};
+
+/// Pushes the value into the ring, according to the backpressure policy.
+///
+/// @retval true Value was queued.
+/// @retval false Value was discarded or the pipeline was stopped.
+template <class T>
+bool push(utils::spsc_ring<T> & ring, T && value, pipeline::backpressure policy,
+	stage_counters & counters, const std::atomic<bool> & running)
+{
+	switch (policy) {
+		case pipeline::backpressure::block: {
+			unsigned int idle = 0;
+			while (!ring.try_push(std::move(value))) {
+				if (!running.load(std::memory_order_acquire)) {
+					counters.dropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				backoff(idle);
+			}
+			break;
+		}
+
+		case pipeline::backpressure::drop_oldest: {
+			const auto n = ring.push_drop_oldest(std::move(value));
+			if (n > 0)
+				counters.dropped.fetch_add(n, std::memory_order_relaxed);
+			break;
+		}
+
+		case pipeline::backpressure::drop_newest:
+			if (!ring.try_push(std::move(value))) {
+				counters.dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			break;
+	}
+	update_max(counters.max_depth, ring.size());
+	return true;
+}
+
+pipeline::stage_stats to_stats(const stage_counters & c, std::size_t depth)
+{
+	pipeline::stage_stats s;
+	s.depth = depth;
+	s.max_depth = c.max_depth.load(std::memory_order_relaxed);
+	s.processed = c.processed.load(std::memory_order_relaxed);
+	s.dropped = c.dropped.load(std::memory_order_relaxed);
+	return s;
+}
+}
+
+/// A device of the pipeline, together with its rings and the state of
+/// the stages.
+class pipeline::source
+{
+public:
+	source(source_id id, std::unique_ptr<device> && d, std::size_t queue_size)
+		: input(queue_size)
+		, output(queue_size)
+		, id_(id)
+		, dev_(std::move(d))
+	{
+		if (!dev_)
+			throw std::invalid_argument{"invalid device"};
+		const auto s = dynamic_cast<const selectable *>(dev_.get());
+		dev_->open();
+		fd_ = s ? s->get_fd() : -1;
+	}
+
+	~source() { dev_->close(); }
+
+	source_id get_id() const noexcept { return id_; }
+	int get_fd() const noexcept { return fd_; }
+	device & get_device() noexcept { return *dev_; }
+
+	// reader stage
+	nmea_framer framer{max_sentence_size, max_frame_size - max_sentence_size};
+	utils::spsc_ring<frame> input;
+	stage_counters input_counters;
+	std::atomic<uint64_t> overflows{0};
+	std::atomic<uint64_t> filtered{0};
+	std::atomic<bool> eof{false};
+	std::shared_ptr<stream_metrics> metrics = std::make_shared<stream_metrics>();
+
+	// parser stage
+	utils::spsc_ring<result> output;
+	stage_counters output_counters;
+	std::atomic<uint64_t> errors{0};
+	std::atomic<uint64_t> ais_errors{0};
+	std::vector<std::pair<std::string, uint32_t>> fragments;
+
+private:
+	source_id id_;
+	std::unique_ptr<device> dev_;
+	int fd_ = -1;
+};
+/// @endcond
+
+/// Initializes the pipeline, no threads are started.
+///
+/// @param[in] opt The options, see `options`.
+/// @exception std::invalid_argument Number of workers or size of rings is zero.
+pipeline::pipeline(const options & opt)
+	: opt_(opt)
+{
+	if (opt_.workers == 0)
+		throw std::invalid_argument{"invalid number of workers"};
+	if (opt_.queue_size == 0)
+		throw std::invalid_argument{"invalid queue size"};
+}
+
+/// Stops the pipeline and closes all devices.
+pipeline::~pipeline()
+{
+	stop();
+}
+
+/// Adds a device which delivers NMEA sentences. The device will be opened.
+///
+/// @param[in] dev The device.
+/// @return Identifier of the device within the pipeline.
+/// @exception std::invalid_argument Device is not valid.
+/// @exception std::logic_error The pipeline is already running.
+/// @exception std::runtime_error Unable to open the device.
+pipeline::source_id pipeline::add(std::unique_ptr<device> && dev)
+{
+	if (!threads_.empty())
+		throw std::logic_error{"pipeline already running"};
+
+	const source_id id = sources_.size();
+	sources_.push_back(std::unique_ptr<source>(new source(id, std::move(dev), opt_.queue_size)));
+	return id;
+}
+
+/// Sets the filter for sentences of all devices.
+///
+/// @exception std::logic_error The pipeline is running, the filter is read
+///   by the threads.
+void pipeline::set_filter(const nmea::sentence_filter & f)
+{
+	if (!threads_.empty())
+		throw std::logic_error{"pipeline already running"};
+	filter_ = f;
+}
+
+/// Starts all threads. Starting a running pipeline does nothing.
+void pipeline::start()
+{
+	if (!threads_.empty())
+		return;
+
+	started_ = true;
+	running_.store(true, std::memory_order_release);
+	active_workers_.store(opt_.workers, std::memory_order_release);
+	for (std::size_t i = 0; i < opt_.workers; ++i)
+		threads_.emplace_back(&pipeline::work_loop, this, i);
+	for (auto & s : sources_)
+		threads_.emplace_back(&pipeline::read_loop, this, std::ref(*s));
+}
+
+/// Stops all threads and waits for them. Results, which are already
+/// queued, are still available through `poll`.
+void pipeline::stop()
+{
+	running_.store(false, std::memory_order_release);
+	for (auto & t : threads_)
+		t.join();
+	threads_.clear();
+}
+
+/// Reader stage, reads data from the device and queues complete sentences.
+void pipeline::read_loop(source & s)
+{
+	std::vector<char> buffer(buffer_size);
+
+	// the framer limits sentences to the size of a frame
+	const auto on_sentence = [this, &s](const std::string & sentence) {
+		s.metrics->count(stream_metrics::event::frames);
+		if (!filter_.accepts(sentence)) {
+			s.filtered.fetch_add(1, std::memory_order_relaxed);
+			s.metrics->count(stream_metrics::event::filtered);
+			return;
+		}
+		frame f;
+		f.size = static_cast<uint32_t>(sentence.size());
+		std::memcpy(f.data, sentence.data(), sentence.size());
+		push(s.input, std::move(f), opt_.policy, s.input_counters, running_);
+	};
+
+	while (running_.load(std::memory_order_acquire)) {
+		if (s.get_fd() >= 0) {
+			pollfd pfd;
+			pfd.fd = s.get_fd();
+			pfd.events = POLLIN;
+			pfd.revents = 0;
+			const int rc = ::poll(&pfd, 1, poll_interval_ms);
+			if (rc == 0)
+				continue;
+			if ((rc < 0) && (errno != EINTR))
+				break;
+		}
+
+		int rc = -1;
+		try {
+			rc = s.get_device().read(buffer.data(), static_cast<uint32_t>(buffer.size()));
+		} catch (std::runtime_error &) {
+			break;
+		}
+
+		if (rc > 0) {
+			const auto overflows = s.framer.get_overflows();
+			s.metrics->count(stream_metrics::event::bytes, static_cast<uint64_t>(rc));
+			s.framer.feed(buffer.data(), static_cast<std::size_t>(rc), on_sentence);
+			if (s.framer.get_overflows() != overflows)
+				s.metrics->count(
+					stream_metrics::event::overflows, s.framer.get_overflows() - overflows);
+			s.overflows.store(s.framer.get_overflows(), std::memory_order_relaxed);
+		} else if ((rc == 0) || ((errno != EAGAIN) && (errno != EINTR))) {
+			break;
+		}
+	}
+
+	s.eof.store(true, std::memory_order_release);
+}
+
+/// Parses the queued sentences of the source.
+///
+/// @retval true At least one sentence was processed.
+/// @retval false Nothing to do.
+bool pipeline::process(source & s)
+{
+	frame f;
+	std::size_t n = 0;
+	for (; (n < batch_size) && s.input.try_pop(f); ++n) {
+		s.input_counters.processed.fetch_add(1, std::memory_order_relaxed);
+
+		result r;
+		r.source = s.get_id();
+		r.sentence = parse_sentence(std::string{f.data, f.size}, *s.metrics);
+		if (!r.sentence) {
+			s.errors.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		const nmea::vdm * vdm = nullptr;
+		if (r.sentence->id() == nmea::sentence_id::VDM)
+			vdm = nmea::sentence_cast<nmea::vdm>(r.sentence.get());
+		else if (r.sentence->id() == nmea::sentence_id::VDO)
+			vdm = nmea::sentence_cast<nmea::vdo>(r.sentence.get());
+
+		if (vdm) {
+			// fragments are expected to arrive in sequence, an incomplete
+			// message is discarded when the first fragment of the next arrives.
+			if (vdm->get_fragment() <= 1)
+				s.fragments.clear();
+			s.fragments.emplace_back(vdm->get_payload(), vdm->get_n_fill_bits());
+			if (vdm->get_fragment() >= vdm->get_n_fragments()) {
+				auto payload = std::move(s.fragments);
+				s.fragments.clear();
+				r.message = parse_message(payload, *s.metrics);
+				if (!r.message)
+					s.ais_errors.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		push(s.output, std::move(r), opt_.policy, s.output_counters, running_);
+	}
+	return n > 0;
+}
+
+/// Parser stage, every worker processes a fixed subset of the sources.
+void pipeline::work_loop(std::size_t index)
+{
+	unsigned int idle = 0;
+	while (running_.load(std::memory_order_acquire)) {
+		bool busy = false;
+		bool finished = true;
+		for (std::size_t i = index; i < sources_.size(); i += opt_.workers) {
+			auto & s = *sources_[i];
+			// end of file must be checked before the ring, the reader
+			// could queue more data in between.
+			const bool eof = s.eof.load(std::memory_order_acquire);
+			busy = process(s) || busy;
+			finished = finished && eof && s.input.empty();
+		}
+
+		if (finished)
+			break;
+		if (busy)
+			idle = 0;
+		else
+			backoff(idle);
+	}
+	active_workers_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+/// Delivers queued results to the handler. Devices are served round robin.
+/// Must not be called from more than one thread at the same time.
+///
+/// @param[in] h The handler to be called for every result.
+/// @param[in] max Maximum number of results to deliver.
+/// @return Number of delivered results.
+std::size_t pipeline::poll(const handler & h, std::size_t max)
+{
+	if (sources_.empty())
+		return 0;
+
+	std::size_t count = 0;
+	std::size_t empty = 0;
+	result r;
+	while ((count < max) && (empty < sources_.size())) {
+		auto & s = *sources_[next_poll_];
+		next_poll_ = (next_poll_ + 1) % sources_.size();
+
+		std::size_t n = 0;
+		for (; (n < batch_size) && (count < max) && s.output.try_pop(r); ++n, ++count) {
+			s.output_counters.processed.fetch_add(1, std::memory_order_relaxed);
+			if (h)
+				h(std::move(r));
+		}
+		empty = (n == 0) ? empty + 1 : 0;
+	}
+	return count;
+}
+
+/// Returns true if all devices reached their end, all sentences are
+/// parsed and all results are delivered.
+bool pipeline::done() const
+{
+	if (!started_ || (active_workers_.load(std::memory_order_acquire) > 0))
+		return false;
+	return std::all_of(sources_.begin(), sources_.end(),
+		[](const std::unique_ptr<source> & s) { return s->output.empty(); });
+}
+
+/// Returns the counters of the specified device.
+///
+/// @exception std::out_of_range Unknown device.
+pipeline::stats pipeline::get_stats(source_id id) const
+{
+	if (id >= sources_.size())
+		throw std::out_of_range{"unknown source"};
+
+	const auto & s = *sources_[id];
+	stats result;
+	result.input = to_stats(s.input_counters, s.input.size());
+	result.output = to_stats(s.output_counters, s.output.size());
+	result.overflows = s.overflows.load(std::memory_order_relaxed);
+	result.errors = s.errors.load(std::memory_order_relaxed);
+	result.ais_errors = s.ais_errors.load(std::memory_order_relaxed);
+	result.filtered = s.filtered.load(std::memory_order_relaxed);
+	return result;
+}
+
+/// Returns the metrics of the specified device. They are updated by the
+/// threads of the pipeline and may be read any time.
+///
+/// @exception std::out_of_range Unknown device.
+std::shared_ptr<const stream_metrics> pipeline::get_metrics(source_id id) const
+{
+	if (id >= sources_.size())
+		throw std::out_of_range{"unknown source"};
+	return sources_[id]->metrics;
+}
+}
+}
@@ -0,0 +1,136 @@
+#include <marnav/io/seatalk_framer.hpp>
+#include <algorithm>
+
+namespace marnav
+{
+namespace io
+{
+seatalk_framer::seatalk_framer()
+{
+	std::fill_n(data_, sizeof(data_), 0);
+	message_.reserve(seatalk::MAX_MESSAGE_SIZE);
+}
+
+uint8_t seatalk_framer::parity(uint8_t a)
+{
+	int c = 0;
+
+	for (int i = 0; i < 8; ++i) {
+		if (a & 0x01)
+			++c;
+		a >>= 1;
+	}
+	return (c % 2) == 0;
+}
+
+void seatalk_framer::write_cmd(uint8_t c)
+{
+	if (remaining_ > 0 && remaining_ < 254) {
+		++collisions_;
+	}
+
+	data_[0] = c;
+	index_ = 1;
+	remaining_ = 254;
+	start_ = current_;
+}
+
+/// Writes data into the buffer, completes the message if all data
+/// was received.
+seatalk_framer::status seatalk_framer::write_data(uint8_t c)
+{
+	if (index_ >= sizeof(data_))
+		return status::none;
+
+	if (remaining_ == 0)
+		return status::none;
+
+	if (remaining_ == 255) // not yet in sync
+		return status::none;
+
+	if (remaining_ == 254) {
+		// attribute byte, -1 because cmd is already consumed
+		remaining_ = 3 + (c & 0x0f) - 1;
+	}
+
+	data_[index_] = c;
+	++index_;
+	--remaining_;
+
+	if (remaining_ > 0)
+		return status::none;
+
+	message_.assign(data_, data_ + index_);
+	return status::complete;
+}
+
+/// Processes a single byte.
+///
+/// This function contains a state machine, which does the handling
+/// of the SeaTalk specific feature: misusing the parity bit as
+/// indicator for command bytes.
+/// Since termios is in use, which provides parity error information
+/// as quoting bytes, a non-trivial implementation is needed to
+/// distinguish between normal and command bytes. Also, collision
+/// detection on this pseudo-bus (SeaTalk) is handled.
+///
+/// Read more about parity error marking here:
+///   http://www.gnu.org/software/libc/manual/html_node/Input-Modes.html
+///
+/// @param[in] c The byte to process.
+/// @retval status::none The byte was consumed.
+/// @retval status::complete The message is complete, it is available through
+///   `message()` until the next byte is fed.
+/// @retval status::error Invalid escape sequence (bus read error).
+seatalk_framer::status seatalk_framer::feed(uint8_t c)
+{
+	return feed(c, clock::time_point{});
+}
+
+/// Processes a single byte, which was received at the specified time.
+///
+/// @param[in] c The byte to process.
+/// @param[in] t Time of reception of the byte.
+/// @return See `feed(uint8_t)`.
+seatalk_framer::status seatalk_framer::feed(uint8_t c, clock::time_point t)
+{
+	switch (state_) {
+		case State::READ:
+			current_ = t;
+			if (c == 0xff) {
+				state_ = State::ESCAPE;
+			} else {
+				if (parity(c)) {
+					write_cmd(c);
+				} else {
+					return write_data(c);
+				}
+			}
+			break;
+
+		case State::ESCAPE:
+			if (c == 0x00) {
+				state_ = State::PARITY;
+			} else if (c == 0xff) {
+				state_ = State::READ;
+				return write_data(c);
+			} else {
+				state_ = State::READ;
+				++errors_;
+				return status::error;
+			}
+			break;
+
+		case State::PARITY:
+			state_ = State::READ;
+			if (parity(c)) {
+				return write_data(c);
+			} else {
+				write_cmd(c);
+			}
+			break;
+	}
+	return status::none;
+}
+}
+}
@@ -1,5 +1,4 @@
 #include <marnav/io/seatalk_reader.hpp>
-#include <algorithm>
 #include <stdexcept>
 
 namespace marnav
@@ -11,13 +10,9 @@ seatalk_reader::~seatalk_reader()
 }
 
 seatalk_reader::seatalk_reader(std::unique_ptr<device> && dv)
-	: dev_(std::move(dv))
+	: raw_(0)
+	, dev_(std::move(dv))
 {
-	std::fill_n(reinterpret_cast<uint8_t *>(&ctx_), sizeof(ctx_), 0);
-
-	ctx_.state = State::READ;
-	ctx_.remaining = 255;
-	ctx_.index = 0;
 }
 
 void seatalk_reader::close()
@@ -27,105 +22,29 @@ void seatalk_reader::close()
 	dev_.reset();
 }
 
-uint8_t seatalk_reader::parity(uint8_t a) const
-{
-	int c = 0;
-
-	for (int i = 0; i < 8; ++i) {
-		if (a & 0x01)
-			++c;
-		a >>= 1;
-	}
-	return (c % 2) == 0;
-}
-
-void seatalk_reader::write_cmd(uint8_t c)
-{
-	if (ctx_.remaining > 0 && ctx_.remaining < 254) {
-		++ctx_.collisions;
-	}
-
-	ctx_.data[0] = c;
-	ctx_.index = 1;
-	ctx_.remaining = 254;
-}
-
-/// Writes data into the read context buffer.
-void seatalk_reader::write_data(uint8_t c)
-{
-	if (ctx_.index >= sizeof(ctx_.data))
-		return;
-
-	if (ctx_.remaining == 0)
-		return;
-
-	if (ctx_.remaining == 255) // not yet in sync
-		return;
-
-	if (ctx_.remaining == 254) {
-		// attribute byte, -1 because cmd is already consumed
-		ctx_.remaining = 3 + (c & 0x0f) - 1;
-	}
-
-	ctx_.data[ctx_.index] = c;
-	++ctx_.index;
-	--ctx_.remaining;
-}
-
 /// Processes SeaTalk data read from the device.
 ///
-/// This function contains a state machine, which does the handling
-/// of the SeaTalk specific feature: misusing the parity bit as
-/// indicator for command bytes.
-/// Since termios is in use, which provides parity error information
-/// as quoting bytes, a non-trivial implementation is needed to
-/// distinguish between normal and command bytes. Also, collision
-/// detection on this pseudo-bus (SeaTalk) is handled.
-///
-/// Read more about parity error marking here:
-///   http://www.gnu.org/software/libc/manual/html_node/Input-Modes.html
-///
 /// @exception std::runtime_error Bus read error.
 void seatalk_reader::process_seatalk()
 {
-	switch (ctx_.state) {
-		case State::READ:
-			if (ctx_.raw == 0xff) {
-				ctx_.state = State::ESCAPE;
-			} else {
-				if (parity(ctx_.raw)) {
-					write_cmd(ctx_.raw);
-				} else {
-					write_data(ctx_.raw);
-					if (ctx_.remaining == 0)
-						emit_message();
-				}
-			}
+	const auto collisions = framer_.get_collisions();
+	const auto status = framer_.feed(raw_);
+	if (metrics_ && (framer_.get_collisions() != collisions))
+		metrics_->count(
+			stream_metrics::event::collisions, framer_.get_collisions() - collisions);
+
+	switch (status) {
+		case seatalk_framer::status::none:
 			break;
-
-		case State::ESCAPE:
-			if (ctx_.raw == 0x00) {
-				ctx_.state = State::PARITY;
-			} else if (ctx_.raw == 0xff) {
-				write_data(ctx_.raw);
-				if (ctx_.remaining == 0)
-					emit_message();
-				ctx_.state = State::READ;
-			} else {
-				throw std::runtime_error{"SeaTalk bus read error."};
-			}
-			break;
-
-		case State::PARITY:
-			if (parity(ctx_.raw)) {
-				write_data(ctx_.raw);
-				if (ctx_.remaining == 0)
-					emit_message();
-			} else {
-				write_cmd(ctx_.raw);
-			}
-			ctx_.state = State::READ;
+		case seatalk_framer::status::complete:
+			if (metrics_)
+				metrics_->count(stream_metrics::event::frames);
+			process_message(framer_.message());
 			break;
+		case seatalk_framer::status::error:
+			if (metrics_)
+				metrics_->count(stream_metrics::event::bus_errors);
+			throw std::runtime_error{"SeaTalk bus read error."};
 	}
 }
 
@@ -138,13 +57,15 @@ bool seatalk_reader::read_data()
 {
 	if (!dev_)
 		throw std::runtime_error{"device invalid"};
-	int rc = dev_->read(reinterpret_cast<char *>(&ctx_.raw), sizeof(ctx_.raw));
+	int rc = dev_->read(reinterpret_cast<char *>(&raw_), sizeof(raw_));
 	if (rc == 0)
 		return false;
 	if (rc < 0)
 		throw std::runtime_error{"read error"};
-	if (rc != sizeof(ctx_.raw))
+	if (rc != sizeof(raw_))
 		throw std::runtime_error{"read error"};
+	if (metrics_)
+		metrics_->count(stream_metrics::event::bytes);
 	return true;
 }
 
@@ -162,10 +83,5 @@ bool seatalk_reader::read()
 	process_seatalk();
 	return true;
 }
-
-void seatalk_reader::emit_message()
-{
-	process_message(std::vector<uint8_t>{ctx_.data, ctx_.data + ctx_.index});
-}
 }
 }
@@ -6,6 +6,11 @@
 #include <termios.h>
 #include <unistd.h>
 
+#if defined(__linux__)
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#endif
+
 namespace marnav
 {
 namespace io
@@ -146,11 +151,55 @@ void serial::open()
 	new_tio.c_oflag = 0;
 	new_tio.c_lflag = 0;
 
-	new_tio.c_cc[VMIN] = 1;
-	new_tio.c_cc[VTIME] = 0;
+	new_tio.c_cc[VMIN] = options_.min_chars;
+	new_tio.c_cc[VTIME] = options_.timeout;
 
 	tcflush(fd, TCIFLUSH);
 	tcsetattr(fd, TCSANOW, &new_tio);
+
+	apply_read_options();
+}
+
+/// Sets the options for reading data. If the device is already open,
+/// the options are applied immediately, otherwise when it is opened.
+///
+/// @param[in] opt The options.
+void serial::set_read_options(const read_options & opt)
+{
+	options_ = opt;
+	if (fd < 0)
+		return;
+
+	termios tio;
+	if (tcgetattr(fd, &tio) == 0) {
+		tio.c_cc[VMIN] = options_.min_chars;
+		tio.c_cc[VTIME] = options_.timeout;
+		tcsetattr(fd, TCSANOW, &tio);
+	}
+	apply_read_options();
+}
+
+/// Applies the non-blocking mode and the low latency flag of the driver
+/// to the opened device.
+void serial::apply_read_options()
+{
+	const int flags = ::fcntl(fd, F_GETFL);
+	if (flags >= 0) {
+		::fcntl(fd, F_SETFL,
+			options_.non_blocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+	}
+
+#if defined(__linux__)
+	// not all drivers support this (e.g. pseudo terminals), which is not an error
+	serial_struct ser;
+	if (::ioctl(fd, TIOCGSERIAL, &ser) == 0) {
+		if (options_.low_latency)
+			ser.flags |= ASYNC_LOW_LATENCY;
+		else
+			ser.flags &= ~ASYNC_LOW_LATENCY;
+		::ioctl(fd, TIOCSSERIAL, &ser);
+	}
+#endif
 }
 
 /// Closes the device, specified by the device handling structure.
@@ -179,6 +228,29 @@ int serial::read(char * buffer, uint32_t size)
 	return ::read(fd, buffer, size);
 }
 
+/// Reads data like `read(char *, uint32_t)`, and provides the time of
+/// reception, taken from a monotonic clock immediately after the data
+/// was read.
+///
+/// The time approximates the reception of the first byte, the error is
+/// determined by the buffering of the driver and the transmission time
+/// of the read bytes. Use `read_options::low_latency` and small values
+/// for `read_options::min_chars` to keep it low.
+///
+/// @param[out] buffer The buffer to hold the data.
+/// @param[in] size The size of the buffer in bytes.
+/// @param[out] t The time of reception, unchanged if nothing was read.
+/// @return Number of read bytes (might be 0).
+/// @exception std::invalid_argument
+/// @exception std::runtime_error
+int serial::read(char * buffer, uint32_t size, clock::time_point & t)
+{
+	const int rc = read(buffer, size);
+	if (rc > 0)
+		t = clock::now();
+	return rc;
+}
+
 /// Writes the speicified buffer to the serial line.
 ///
 /// @param[in] buffer The data to write.
@@ -0,0 +1,143 @@
+#include <marnav/io/tcp_client_device.hpp>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t tcp_client_device::buffer_size;
+
+tcp_client_device::~tcp_client_device()
+{
+	close();
+}
+
+/// Initializes the device, does not connect.
+///
+/// @param[in] host Name or address of the server.
+/// @param[in] port Port of the server.
+tcp_client_device::tcp_client_device(const std::string & host, uint16_t port)
+	: host_(host)
+	, port_(port)
+{
+}
+
+tcp_client_device::tcp_client_device(tcp_client_device && other) noexcept
+	: host_(std::move(other.host_))
+	, port_(other.port_)
+	, fd_(other.fd_)
+	, buffer_(std::move(other.buffer_))
+{
+	other.fd_ = -1;
+}
+
+tcp_client_device & tcp_client_device::operator=(tcp_client_device && other) noexcept
+{
+	if (this != &other) {
+		close();
+		host_ = std::move(other.host_);
+		port_ = other.port_;
+		fd_ = other.fd_;
+		buffer_ = std::move(other.buffer_);
+		other.fd_ = -1;
+	}
+	return *this;
+}
+
+/// Connects to the server, all resolved addresses are tried in turn.
+/// Opening an already opened device does nothing.
+///
+/// @exception std::runtime_error Unable to resolve the host or to connect.
+void tcp_client_device::open()
+{
+	if (fd_ >= 0)
+		return;
+
+	addrinfo hints;
+	std::memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_NUMERICSERV;
+
+	addrinfo * info = nullptr;
+	const std::string service = std::to_string(port_);
+	if (::getaddrinfo(host_.c_str(), service.c_str(), &hints, &info) != 0)
+		throw std::runtime_error{"unable to resolve host: " + host_};
+
+	int fd = -1;
+	for (addrinfo * i = info; i != nullptr; i = i->ai_next) {
+		fd = ::socket(i->ai_family, i->ai_socktype | SOCK_CLOEXEC, i->ai_protocol);
+		if (fd < 0)
+			continue;
+		if (::connect(fd, i->ai_addr, i->ai_addrlen) == 0)
+			break;
+		::close(fd);
+		fd = -1;
+	}
+	::freeaddrinfo(info);
+
+	if (fd < 0)
+		throw std::runtime_error{"unable to connect to: " + host_ + ":" + service};
+
+	buffer_.resize(buffer_size);
+	fd_ = fd;
+}
+
+/// Closes the connection.
+void tcp_client_device::close()
+{
+	if (fd_ < 0)
+		return;
+	::close(fd_);
+	fd_ = -1;
+}
+
+/// Receives data into the internal buffer.
+///
+/// @return Number of received bytes, see `receive`.
+int tcp_client_device::fill()
+{
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	return static_cast<int>(::recv(fd_, buffer_.data(), buffer_.size(), 0));
+}
+
+/// Reads data from the server into the buffer.
+///
+/// @param[out] buffer The buffer to hold the data.
+/// @param[in] size The size of the buffer in bytes.
+/// @return Number of read bytes, zero if the connection was closed by
+///   the server, -1 on error (`errno` is set).
+/// @exception std::invalid_argument
+/// @exception std::runtime_error
+int tcp_client_device::read(char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	return static_cast<int>(::recv(fd_, buffer, size, 0));
+}
+
+/// Writes data to the server.
+///
+/// @param[in] buffer The data to write.
+/// @param[in] size Number of bytes to write.
+/// @return Number of written bytes, -1 on error (`errno` is set).
+/// @exception std::invalid_argument
+/// @exception std::runtime_error
+int tcp_client_device::write(const char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+	return static_cast<int>(::send(fd_, buffer, size, MSG_NOSIGNAL));
+}
+}
+}
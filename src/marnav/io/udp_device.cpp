@@ -0,0 +1,244 @@
+#include <marnav/io/udp_device.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace marnav
+{
+namespace io
+{
+constexpr std::size_t udp_device::batch_size;
+constexpr std::size_t udp_device::max_datagram_size;
+
+udp_device::~udp_device()
+{
+	close();
+}
+
+/// Initializes the device, does not open the socket.
+///
+/// @param[in] address The local address to bind to, empty or `0.0.0.0` to
+///   receive on all interfaces.
+/// @param[in] port The local port, zero to let the system choose one
+///   (see `get_port`).
+udp_device::udp_device(const std::string & address, uint16_t port)
+	: address_(address)
+	, port_(port)
+{
+}
+
+udp_device::udp_device(udp_device && other) noexcept
+	: address_(std::move(other.address_))
+	, port_(other.port_)
+	, fd_(other.fd_)
+	, buffer_(std::move(other.buffer_))
+	, sizes_(std::move(other.sizes_))
+	, count_(other.count_)
+	, next_(other.next_)
+	, offset_(other.offset_)
+	, truncated_(other.truncated_)
+{
+	other.fd_ = -1;
+	other.count_ = 0;
+	other.next_ = 0;
+	other.offset_ = 0;
+}
+
+udp_device & udp_device::operator=(udp_device && other) noexcept
+{
+	if (this != &other) {
+		close();
+		address_ = std::move(other.address_);
+		port_ = other.port_;
+		fd_ = other.fd_;
+		buffer_ = std::move(other.buffer_);
+		sizes_ = std::move(other.sizes_);
+		count_ = other.count_;
+		next_ = other.next_;
+		offset_ = other.offset_;
+		truncated_ = other.truncated_;
+		other.fd_ = -1;
+		other.count_ = 0;
+		other.next_ = 0;
+		other.offset_ = 0;
+	}
+	return *this;
+}
+
+/// Opens the socket and binds it to the local address. Broadcasts are
+/// received, and the port may be shared with other processes.
+/// Opening an already opened device does nothing.
+///
+/// @exception std::runtime_error Unable to resolve the address, open or
+///   bind the socket.
+void udp_device::open()
+{
+	if (fd_ >= 0)
+		return;
+
+	addrinfo hints;
+	std::memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+	hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+
+	addrinfo * info = nullptr;
+	const std::string service = std::to_string(port_);
+	if (::getaddrinfo(address_.empty() ? nullptr : address_.c_str(), service.c_str(), &hints,
+			&info) != 0)
+		throw std::runtime_error{"unable to resolve address: " + address_};
+
+	const int fd = ::socket(info->ai_family, info->ai_socktype | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		::freeaddrinfo(info);
+		throw std::runtime_error{"unable to open socket"};
+	}
+
+	const int on = 1;
+	::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	::setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+
+	const int rc = ::bind(fd, info->ai_addr, info->ai_addrlen);
+	::freeaddrinfo(info);
+	if (rc < 0) {
+		::close(fd);
+		throw std::runtime_error{"unable to bind socket: " + address_ + ":" + service};
+	}
+
+	// determine the port chosen by the system
+	sockaddr_storage addr;
+	socklen_t len = sizeof(addr);
+	if (::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) == 0) {
+		char serv[NI_MAXSERV];
+		if (::getnameinfo(reinterpret_cast<sockaddr *>(&addr), len, nullptr, 0, serv,
+				sizeof(serv), NI_NUMERICSERV)
+			== 0)
+			port_ = static_cast<uint16_t>(std::stoul(serv));
+	}
+
+	buffer_.resize(batch_size * max_datagram_size);
+	sizes_.resize(batch_size);
+	count_ = 0;
+	next_ = 0;
+	offset_ = 0;
+	fd_ = fd;
+}
+
+/// Closes the socket, pending data is discarded.
+void udp_device::close()
+{
+	if (fd_ < 0)
+		return;
+	::close(fd_);
+	fd_ = -1;
+	count_ = 0;
+	next_ = 0;
+	offset_ = 0;
+}
+
+/// Receives a batch of datagrams, if there are no more pending datagrams.
+///
+/// Truncated and empty datagrams are discarded, receiving continues until
+/// at least one datagram remains. Therefore, on a non-blocking socket,
+/// a batch of only discarded datagrams results in an error (`EAGAIN`),
+/// never in zero datagrams, which would be mistaken for the end of file.
+///
+/// @return Number of pending datagrams, or -1 on error.
+int udp_device::fill()
+{
+	if (fd_ < 0)
+		throw std::runtime_error{"device not open"};
+
+	if (next_ < count_)
+		return static_cast<int>(count_ - next_);
+
+	mmsghdr msgs[batch_size];
+	iovec iovs[batch_size];
+
+	std::size_t n = 0;
+	while (n == 0) {
+		std::memset(msgs, 0, sizeof(msgs));
+		for (std::size_t i = 0; i < batch_size; ++i) {
+			iovs[i].iov_base = buffer_.data() + i * max_datagram_size;
+			iovs[i].iov_len = max_datagram_size;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		// blocks (if the socket is blocking) only for the first datagram
+		const int rc = ::recvmmsg(fd_, msgs, batch_size, MSG_WAITFORONE, nullptr);
+		if (rc < 0)
+			return rc;
+
+		// move truncated and empty datagrams out of the way
+		for (int i = 0; i < rc; ++i) {
+			if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+				++truncated_;
+				continue;
+			}
+			if (msgs[i].msg_len == 0)
+				continue;
+			if (n != static_cast<std::size_t>(i))
+				std::memmove(buffer_.data() + n * max_datagram_size,
+					buffer_.data() + i * max_datagram_size, msgs[i].msg_len);
+			sizes_[n] = msgs[i].msg_len;
+			++n;
+		}
+	}
+
+	count_ = n;
+	next_ = 0;
+	offset_ = 0;
+	return static_cast<int>(n);
+}
+
+/// Copies received data into the buffer. Data of several datagrams may
+/// be concatenated, a datagram which does not fit into the buffer is
+/// continued with the next read.
+///
+/// @param[out] buffer The buffer to hold the data.
+/// @param[in] size The size of the buffer in bytes.
+/// @return Number of read bytes, -1 on error (`errno` is set).
+/// @exception std::invalid_argument
+/// @exception std::runtime_error
+int udp_device::read(char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+
+	const int rc = fill();
+	if (rc < 0)
+		return rc;
+
+	std::size_t total = 0;
+	while ((next_ < count_) && (total < size)) {
+		const std::size_t n = std::min(sizes_[next_] - offset_, size - total);
+		std::memcpy(buffer + total, data(next_) + offset_, n);
+		total += n;
+		offset_ += n;
+		if (offset_ == sizes_[next_]) {
+			++next_;
+			offset_ = 0;
+		}
+	}
+	return static_cast<int>(total);
+}
+
+/// Not supported, the device only receives data. Behaves like writing
+/// to a file descriptor which is not open for writing.
+///
+/// @return Always -1, `errno` is set to `EBADF`.
+/// @exception std::invalid_argument
+int udp_device::write(const char * buffer, uint32_t size)
+{
+	if ((buffer == nullptr) || (size == 0))
+		throw std::invalid_argument{"invalid buffer or size"};
+	errno = EBADF;
+	return -1;
+}
+}
+}
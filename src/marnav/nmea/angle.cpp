@@ -1,6 +1,6 @@
 #include <marnav/nmea/angle.hpp>
+#include "convert.hpp"
 #include <stdexcept>
-#include <cmath>
 
 namespace marnav
 {
@@ -17,15 +17,7 @@ static geo::angle parse_angle(const std::string & s)
 	auto tmp = std::stod(s, &pos);
 	if (pos != s.size())
 		throw std::invalid_argument{"invalid string for conversion to geo::angle for NMEA"};
-
-	// adoption of NMEA angle DDDMM.SSS to the one that is used here
-	const double deg = (tmp - fmod(tmp, 100.0)) / 100.0;
-	const double min = (tmp - (deg * 100.0)) / 60.0;
-
-	if (std::abs(min) >= 1.0)
-		throw std::invalid_argument{"invalid format for minutes in geo::angle for NMEA"};
-
-	return geo::angle{deg + min};
+	return convert_angle(tmp);
 }
 }
 /// @endcond
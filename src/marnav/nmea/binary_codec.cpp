@@ -0,0 +1,466 @@
+#include <marnav/nmea/binary_codec.hpp>
+#include "binary_fields.hpp"
+#include "convert.hpp"
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/time.hpp>
+#include <marnav/utils/varint.hpp>
+#include <stdexcept>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @cond DEV
+namespace
+{
+constexpr uint8_t field_empty = 0x00;
+constexpr uint8_t field_text = 0x01;
+constexpr uint8_t field_short_text_first = 0x02;
+constexpr uint8_t field_short_text_last = 0x1f;
+constexpr uint8_t field_char_first = 0x20;
+constexpr uint8_t field_char_last = 0x7e;
+constexpr uint8_t field_number = 0x80;
+constexpr uint8_t field_number_negative = 0x40;
+constexpr uint8_t max_number_digits = 7;
+constexpr uint8_t has_tag_block = 0x80;
+
+static bool is_digit(char c) noexcept
+{
+	return (c >= '0') && (c <= '9');
+}
+
+/// Appends the field as number, if it is one which can be represented.
+static bool append_number(std::vector<uint8_t> & buffer, const char * s, std::size_t n)
+{
+	std::size_t i = 0;
+	const bool negative = (n > 0) && (s[0] == '-');
+	if (negative)
+		++i;
+
+	uint64_t value = 0;
+	uint8_t width = 0;
+	for (; (i < n) && is_digit(s[i]); ++i, ++width)
+		value = value * 10 + static_cast<uint64_t>(s[i] - '0');
+
+	uint8_t frac = 0;
+	if ((i < n) && (s[i] == '.')) {
+		++i;
+		for (; (i < n) && is_digit(s[i]); ++i, ++frac)
+			value = value * 10 + static_cast<uint64_t>(s[i] - '0');
+		if (frac == 0)
+			return false;
+	}
+
+	if ((i != n) || (width + frac == 0) || (width > max_number_digits)
+		|| (frac > max_number_digits))
+		return false;
+
+	buffer.push_back(static_cast<uint8_t>(
+		field_number | (negative ? field_number_negative : 0) | (frac << 3) | width));
+	utils::append_varint(buffer, value);
+	return true;
+}
+
+static void append_field(std::vector<uint8_t> & buffer, const char * s, std::size_t n)
+{
+	if (n == 0) {
+		buffer.push_back(field_empty);
+		return;
+	}
+	if ((n == 1) && (static_cast<uint8_t>(s[0]) >= field_char_first)
+		&& (static_cast<uint8_t>(s[0]) <= field_char_last)) {
+		buffer.push_back(static_cast<uint8_t>(s[0]));
+		return;
+	}
+	if (append_number(buffer, s, n))
+		return;
+	if ((n >= field_short_text_first) && (n <= field_short_text_last)) {
+		buffer.push_back(static_cast<uint8_t>(n));
+	} else {
+		buffer.push_back(field_text);
+		utils::append_varint(buffer, n);
+	}
+	buffer.insert(buffer.end(), s, s + n);
+}
+
+/// Reads a varint, throws if the data is malformed.
+static uint64_t read_size(const uint8_t * data, std::size_t size, std::size_t & pos)
+{
+	uint64_t value = 0;
+	if (!utils::read_varint(data, size, pos, value))
+		throw std::invalid_argument{"invalid varint in nmea/decode_binary"};
+	return value;
+}
+
+/// Reads a string of the specified size, throws if the data is truncated.
+static std::string read_text(
+	const uint8_t * data, std::size_t size, std::size_t & pos, uint64_t n)
+{
+	if (n > size - pos)
+		throw std::invalid_argument{"truncated data in nmea/decode_binary"};
+	const auto p = reinterpret_cast<const char *>(data + pos);
+	pos += static_cast<std::size_t>(n);
+	return std::string(p, p + n);
+}
+
+/// Powers of ten, up to the number of digits of numbers.
+static constexpr uint64_t powers_of_ten[2 * max_number_digits + 1] = {1ull, 10ull, 100ull,
+	1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+	10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull};
+}
+/// @endcond
+
+/// @cond DEV
+namespace detail
+{
+/// Initializes the reader of `n` fields, starting at the specified position.
+binary_fields::binary_fields(
+	const uint8_t * data, std::size_t size, std::size_t pos, std::size_t n)
+	: data_(data)
+	, size_(size)
+	, pos_(pos)
+	, n_(n)
+{
+}
+
+/// Decodes the next field, throws if the data is malformed or there are no more fields.
+void binary_fields::next()
+{
+	if (index_ >= n_)
+		throw std::invalid_argument{"invalid number of fields in nmea/decode_binary"};
+	++index_;
+
+	if (pos_ >= size_)
+		throw std::invalid_argument{"truncated data in nmea/decode_binary"};
+	const uint8_t type = data_[pos_++];
+
+	kind_ = kind::text;
+	num_chars_ = 0;
+	if (type == field_empty) {
+		kind_ = kind::empty;
+	} else if (type == field_text) {
+		num_chars_ = static_cast<std::size_t>(read_size(data_, size_, pos_));
+	} else if ((type >= field_short_text_first) && (type <= field_short_text_last)) {
+		num_chars_ = type;
+	} else if ((type >= field_char_first) && (type <= field_char_last)) {
+		chars_ = reinterpret_cast<const char *>(data_ + pos_ - 1);
+		num_chars_ = 1;
+		return;
+	} else if (type & field_number) {
+		kind_ = kind::number;
+		negative_ = (type & field_number_negative) != 0;
+		width_ = type & 0x07;
+		frac_ = (type >> 3) & 0x07;
+		value_ = read_size(data_, size_, pos_);
+		if (value_ >= powers_of_ten[width_ + frac_])
+			throw std::invalid_argument{"invalid number in nmea/decode_binary"};
+		return;
+	} else {
+		throw std::invalid_argument{"invalid field type in nmea/decode_binary"};
+	}
+
+	if (num_chars_ > size_ - pos_)
+		throw std::invalid_argument{"truncated data in nmea/decode_binary"};
+	chars_ = reinterpret_cast<const char *>(data_ + pos_);
+	pos_ += num_chars_;
+}
+
+bool binary_fields::empty() const noexcept
+{
+	return (kind_ == kind::empty) || ((kind_ == kind::text) && (num_chars_ == 0));
+}
+
+/// Returns true if the current field is a number without sign and fraction.
+bool binary_fields::is_decimal() const noexcept
+{
+	return (kind_ == kind::number) && !negative_ && (frac_ == 0);
+}
+
+/// Returns the value of the current field, which must be a number.
+///
+/// The integer and its scale are both exactly representable, the result of
+/// the division is therefore the same as parsing the text.
+double binary_fields::to_double() const noexcept
+{
+	const double v = static_cast<double>(value_) / static_cast<double>(powers_of_ten[frac_]);
+	return negative_ ? -v : v;
+}
+
+/// Returns the text of the current field, as it was before encoding.
+const std::string & binary_fields::text()
+{
+	text_.clear();
+	if (kind_ == kind::text) {
+		text_.append(chars_, num_chars_);
+	} else if (kind_ == kind::number) {
+		char digits[2 * max_number_digits];
+		const std::size_t n = width_ + frac_;
+		uint64_t v = value_;
+		for (std::size_t i = n; i > 0; --i) {
+			digits[i - 1] = static_cast<char>('0' + v % 10);
+			v /= 10;
+		}
+		if (negative_)
+			text_ += '-';
+		text_.append(digits, width_);
+		if (frac_ > 0) {
+			text_ += '.';
+			text_.append(digits + width_, frac_);
+		}
+	}
+	return text_;
+}
+
+void binary_fields::convert(double & value)
+{
+	if (kind_ != kind::number) {
+		nmea::read(text(), value);
+		return;
+	}
+	value = to_double();
+}
+
+void binary_fields::convert(uint32_t & value)
+{
+	if (!is_decimal()) {
+		nmea::read(text(), value);
+		return;
+	}
+	value = static_cast<uint32_t>(value_);
+}
+
+void binary_fields::convert(geo::latitude & value)
+{
+	if (kind_ != kind::number) {
+		nmea::read(text(), value);
+		return;
+	}
+	value = geo::latitude{convert_angle(to_double())};
+}
+
+void binary_fields::convert(geo::longitude & value)
+{
+	if (kind_ != kind::number) {
+		nmea::read(text(), value);
+		return;
+	}
+	value = geo::longitude{convert_angle(to_double())};
+}
+
+/// Converts the field of the form `HHMMSS[.mmm]`, digits of the fraction
+/// beyond milliseconds are ignored, like they are in text.
+void binary_fields::convert(time & value)
+{
+	if ((kind_ != kind::number) || negative_ || (width_ == 0) || (width_ > 6)) {
+		nmea::read(text(), value);
+		return;
+	}
+
+	const auto t = static_cast<uint32_t>(value_ / powers_of_ten[frac_]);
+	const auto f = value_ % powers_of_ten[frac_];
+	const auto ms = (frac_ <= 3) ? f * powers_of_ten[3 - frac_] : f / powers_of_ten[frac_ - 3];
+	value = time{t / 10000, (t / 100) % 100, t % 100, static_cast<uint32_t>(ms)};
+}
+
+/// Appends the header of a record, the size is written by `end_binary_record`.
+///
+/// @return The position of the record within the buffer.
+std::size_t begin_binary_record(std::vector<uint8_t> & buffer, binary_record kind)
+{
+	const auto start = buffer.size();
+	buffer.push_back(static_cast<uint8_t>((static_cast<uint8_t>(kind) << 4) | binary_version));
+	buffer.push_back(0); // size, most records need only one byte
+	return start;
+}
+
+/// Writes the size of the record, which was started at the specified position.
+void end_binary_record(std::vector<uint8_t> & buffer, std::size_t start)
+{
+	const auto body = start + 2;
+	const uint64_t size = buffer.size() - body;
+	if (size < 0x80) {
+		buffer[start + 1] = static_cast<uint8_t>(size);
+		return;
+	}
+	std::vector<uint8_t> n;
+	utils::append_varint(n, size);
+	buffer[start + 1] = n[0];
+	buffer.insert(
+		buffer.begin() + static_cast<std::ptrdiff_t>(body), std::next(n.begin()), n.end());
+}
+}
+/// @endcond
+
+/// Reads the header of the record at the specified position.
+///
+/// @param[in] data The data.
+/// @param[in] size Number of bytes of the data.
+/// @param[in] pos Position of the record within the data.
+/// @return Information about the record, the next record starts at `pos + size`.
+/// @exception std::invalid_argument The header is malformed or truncated, or of an
+///   unsupported version.
+binary_header read_binary_header(const uint8_t * data, std::size_t size, std::size_t pos)
+{
+	if (!data || (pos >= size))
+		throw std::invalid_argument{"truncated data in nmea/read_binary_header"};
+	const uint8_t format = data[pos];
+	if ((format & 0x0f) != binary_version)
+		throw std::invalid_argument{"unsupported version in nmea/read_binary_header"};
+
+	binary_header h;
+	h.kind = static_cast<binary_record>(format >> 4);
+	std::size_t p = pos + 1;
+	uint64_t body_size = 0;
+	if (!utils::read_varint(data, size, p, body_size))
+		throw std::invalid_argument{"truncated data in nmea/read_binary_header"};
+	if (body_size > size - p)
+		throw std::invalid_argument{"truncated data in nmea/read_binary_header"};
+	h.body = p - pos;
+	h.size = h.body + static_cast<std::size_t>(body_size);
+	return h;
+}
+
+/// Appends the binary record of the sentence to the buffer.
+///
+/// The encoding is considerably smaller than the text and, when read, needs
+/// neither splitting of fields nor checksum verification.
+///
+/// Every record starts with a header:
+/// - one byte: kind of record (high nibble) and version (low nibble)
+/// - varint: size of the data following the header
+///
+/// The data of a sentence:
+/// - one byte: size of the address (bits 0..6), bit 7 is set if there is
+///   a tag block. Followed by the address (e.g. `GPRMC`).
+/// - only with tag block: varint of its size, followed by the tag block
+/// - varint: number of data fields, followed by the fields
+///
+/// Every field starts with a byte, defining its encoding:
+/// - `0x00`: empty field
+/// - `0x01`: text, varint of its size, followed by the characters
+/// - `0x02..0x1f`: text of this size, followed by the characters
+/// - `0x20..0x7e`: field of exactly this one character
+/// - `0x80..0xff`: decimal number, fixed point. Bit 6: negative,
+///   bits 3..5: number of fractional digits, bits 0..2: number of integer
+///   digits, followed by the varint of all digits as integer.
+///
+/// Numbers keep their exact textual representation, including leading
+/// and trailing zeros.
+///
+/// @param[out] buffer The buffer to append the record to.
+/// @param[in] s The sentence to encode.
+void encode_binary(std::vector<uint8_t> & buffer, const sentence & s)
+{
+	const auto start = detail::begin_binary_record(buffer, binary_record::sentence);
+
+	const auto address = to_string(s.get_talker()) + s.tag();
+	const auto & block = s.get_tag_block();
+	buffer.push_back(static_cast<uint8_t>(address.size() | (block.empty() ? 0 : has_tag_block)));
+	buffer.insert(buffer.end(), address.begin(), address.end());
+	if (!block.empty()) {
+		utils::append_varint(buffer, block.size());
+		buffer.insert(buffer.end(), block.begin(), block.end());
+	}
+
+	std::string data;
+	data.reserve(sentence::max_length);
+	s.append_data_to(data);
+
+	// every field is preceded by a delimiter
+	std::size_t n = 0;
+	for (const auto c : data)
+		if (c == sentence::field_delimiter)
+			++n;
+	utils::append_varint(buffer, n);
+
+	std::size_t first = 1;
+	while (first <= data.size()) {
+		auto last = data.find(sentence::field_delimiter, first);
+		if (last == std::string::npos)
+			last = data.size();
+		append_field(buffer, data.data() + first, last - first);
+		first = last + 1;
+	}
+
+	detail::end_binary_record(buffer, start);
+}
+
+/// Returns the binary record of the sentence.
+std::vector<uint8_t> encode_binary(const sentence & s)
+{
+	std::vector<uint8_t> result;
+	result.reserve(sentence::max_length);
+	encode_binary(result, s);
+	return result;
+}
+
+/// Decodes the sentence of the binary record at the specified position.
+///
+/// Sentences which are registered with support of binary records read their
+/// values directly from the fields, numbers are not converted to text and back.
+/// All other sentences are created from the text of their fields.
+///
+/// @param[in] data The data.
+/// @param[in] size Number of bytes of the data.
+/// @param[in,out] pos Position of the record, advanced to the next record.
+/// @return The decoded sentence.
+/// @exception std::invalid_argument The record is malformed or not a sentence.
+/// @exception unknown_sentence The sentence is not supported.
+std::unique_ptr<sentence> decode_binary(
+	const uint8_t * data, std::size_t size, std::size_t & pos)
+{
+	const auto h = read_binary_header(data, size, pos);
+	if (h.kind != binary_record::sentence)
+		throw std::invalid_argument{"not a sentence in nmea/decode_binary"};
+
+	const std::size_t end = pos + h.size;
+	std::size_t p = pos + h.body;
+
+	if (p >= end)
+		throw std::invalid_argument{"truncated data in nmea/decode_binary"};
+	const uint8_t address_size = data[p++];
+	const auto address = read_text(data, end, p, address_size & ~has_tag_block);
+	std::string block;
+	if (address_size & has_tag_block)
+		block = read_text(data, end, p, read_size(data, end, p));
+
+	const auto n = read_size(data, end, p);
+	if (n > end - p) // every field needs at least one byte
+		throw std::invalid_argument{"invalid number of fields in nmea/decode_binary"};
+
+	talker talk;
+	std::string tag;
+	std::tie(talk, tag) = detail::parse_address(address);
+
+	// sentences which are not able to read the binary fields are created from text
+	detail::binary_fields fields{data, end, p, static_cast<std::size_t>(n)};
+	auto result = detail::create_sentence(talk, tag, fields);
+	if (!result) {
+		sentence::fields text(fields.size());
+		for (auto & f : text)
+			fields.read(f);
+		result = detail::create_sentence(talk, tag, text);
+	}
+	if (fields.position() != end)
+		throw std::invalid_argument{"invalid record size in nmea/decode_binary"};
+
+	result->set_tag_block(std::move(block));
+	pos = end;
+	return result;
+}
+
+/// Decodes the sentence of a buffer containing exactly one record.
+std::unique_ptr<sentence> decode_binary(const std::vector<uint8_t> & data)
+{
+	std::size_t pos = 0;
+	auto result = decode_binary(data.data(), data.size(), pos);
+	if (pos != data.size())
+		throw std::invalid_argument{"unexpected data in nmea/decode_binary"};
+	return result;
+}
+}
+}
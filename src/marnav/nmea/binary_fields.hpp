@@ -0,0 +1,108 @@
+#ifndef MARNAV__NMEA__BINARY_FIELDS__HPP
+#define MARNAV__NMEA__BINARY_FIELDS__HPP
+
+#include <marnav/nmea/io.hpp>
+#include <marnav/geo/angle.hpp>
+#include <marnav/utils/optional.hpp>
+#include <cstdint>
+#include <string>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @cond DEV
+namespace detail
+{
+/// Reads the data fields of a binary record (see `encode_binary`) in sequence.
+///
+/// Sentences supporting binary records provide a constructor which reads
+/// its members with this class, in the same order and with the same checks
+/// as from text. Numbers are converted from their fixed point representation
+/// directly into doubles, integers, angles and times. All other values are read
+/// from their text, exactly as `nmea::read` does.
+class binary_fields
+{
+public:
+	binary_fields(const uint8_t * data, std::size_t size, std::size_t pos, std::size_t n);
+
+	binary_fields(const binary_fields &) = delete;
+	binary_fields & operator=(const binary_fields &) = delete;
+
+	/// Returns the number of data fields of the record.
+	std::size_t size() const noexcept { return n_; }
+
+	/// Returns the position within the data after the fields read so far.
+	std::size_t position() const noexcept { return pos_; }
+
+	template <class T> void read(T & value)
+	{
+		next();
+		convert(value);
+	}
+
+	template <class T> void read(utils::optional<T> & value)
+	{
+		next();
+		if (empty()) {
+			value.reset();
+			return;
+		}
+
+		T tmp;
+		convert(tmp);
+		value = tmp;
+	}
+
+private:
+	enum class kind { empty, text, number };
+
+	const uint8_t * data_;
+	std::size_t size_;
+	std::size_t pos_;
+	std::size_t n_;
+	std::size_t index_ = 0;
+
+	// the current field
+	kind kind_ = kind::empty;
+	const char * chars_ = nullptr;
+	std::size_t num_chars_ = 0;
+	bool negative_ = false;
+	uint8_t width_ = 0;
+	uint8_t frac_ = 0;
+	uint64_t value_ = 0;
+
+	std::string text_;
+
+	void next();
+	bool empty() const noexcept;
+	bool is_decimal() const noexcept;
+	double to_double() const noexcept;
+	const std::string & text();
+
+	void convert(double & value);
+	void convert(uint32_t & value);
+	void convert(geo::latitude & value);
+	void convert(geo::longitude & value);
+	void convert(time & value);
+
+	template <class Unit, class Ratio> void convert(units::basic_unit<Unit, Ratio> & value)
+	{
+		if (empty()) {
+			value = units::basic_unit<Unit, Ratio>();
+			return;
+		}
+
+		typename units::basic_unit<Unit, Ratio>::value_type tmp;
+		convert(tmp);
+		value = units::basic_unit<Unit, Ratio>(tmp);
+	}
+
+	template <class T> void convert(T & value) { nmea::read(text(), value); }
+};
+}
+/// @endcond
+}
+}
+
+#endif
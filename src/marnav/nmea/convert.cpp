@@ -1,11 +1,27 @@
 #include "convert.hpp"
 #include <stdexcept>
 #include <cassert>
+#include <cmath>
 
 namespace marnav
 {
 namespace nmea
 {
+/// Converts an angle of the NMEA form `DDDMM.MMMM`, read as number, to degrees.
+///
+/// @exception std::invalid_argument The minutes are out of range.
+geo::angle convert_angle(double v)
+{
+	// adoption of NMEA angle DDDMM.SSS to the one that is used here
+	const double deg = (v - fmod(v, 100.0)) / 100.0;
+	const double min = (v - (deg * 100.0)) / 60.0;
+
+	if (std::abs(min) >= 1.0)
+		throw std::invalid_argument{"invalid format for minutes in geo::angle for NMEA"};
+
+	return geo::angle{deg + min};
+}
+
 direction convert_hemisphere(const geo::latitude & p) noexcept
 {
 	switch (p.hem()) {
@@ -9,6 +9,8 @@ namespace marnav
 {
 namespace nmea
 {
+geo::angle convert_angle(double v);
+
 direction convert_hemisphere(const geo::latitude & p) noexcept;
 direction convert_hemisphere(const geo::longitude & p) noexcept;
 geo::latitude::hemisphere convert_hemisphere_lat(direction t);
@@ -1,4 +1,5 @@
 #include <marnav/nmea/date.hpp>
+#include "time_fields.hpp"
 #include <stdexcept>
 
 namespace marnav
@@ -99,15 +100,10 @@ std::string to_string(const date & d)
 
 date date::parse(const std::string & str)
 {
-	try {
-		std::size_t pos = 0;
-		uint32_t t = std::stoul(str, &pos);
-		if (pos != str.size())
-			throw std::invalid_argument{"invalid format for date"};
-		return date{t % 100, static_cast<month>((t / 100) % 100), (t / 10000) % 100};
-	} catch (std::invalid_argument &) {
+	uint32_t t = 0;
+	if (!detail::parse_date_field(str.data(), str.size(), t))
 		throw std::invalid_argument{"invalid date format, 'DDMMYY' expected"};
-	}
+	return date{t % 100, static_cast<month>((t / 100) % 100), (t / 10000) % 100};
 }
 }
 }
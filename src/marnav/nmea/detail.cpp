@@ -41,13 +41,14 @@ extract_sentence_information(const std::string & s, checksum_handling chksum)
 	}
 
 	// extract all fields, skip start token
-	std::vector<std::string> fields = detail::parse_fields(s, search_pos);
+	scan_result info;
+	std::vector<std::string> fields = detail::parse_fields(s, search_pos, info);
 	if (fields.size() < 2) // at least address and checksum must be present
 		throw std::invalid_argument{"malformed sentence in nmea/make_sentence"};
 
 	if (chksum == checksum_handling::check) {
 		// check checksum from next character on, ignoring the start token.
-		detail::ensure_checksum(s, fields.back(), search_pos);
+		detail::ensure_checksum(info, s.size() - search_pos, fields.back());
 	}
 
 	// extract address and posibly talker_id and tag.
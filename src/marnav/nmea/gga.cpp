@@ -1,4 +1,5 @@
 #include <marnav/nmea/gga.hpp>
+#include "binary_fields.hpp"
 #include "checks.hpp"
 #include "convert.hpp"
 #include <marnav/nmea/io.hpp>
@@ -47,6 +48,38 @@ gga::gga(talker talk, fields::const_iterator first, fields::const_iterator last)
 	lon_ = correct_hemisphere(lon_, lon_hem_);
 }
 
+gga::gga(talker talk, detail::binary_fields & f)
+	: sentence(ID, TAG, talk)
+{
+	if (f.size() != 14)
+		throw std::invalid_argument{"invalid number of fields in gga"};
+
+	utils::optional<unit::distance> altitude_unit;
+	utils::optional<unit::distance> geodial_separation_unit;
+
+	f.read(time_);
+	f.read(lat_);
+	f.read(lat_hem_);
+	f.read(lon_);
+	f.read(lon_hem_);
+	f.read(quality_indicator_);
+	f.read(n_satellites_);
+	f.read(hor_dilution_);
+	f.read(altitude_);
+	f.read(altitude_unit);
+	f.read(geodial_separation_);
+	f.read(geodial_separation_unit);
+	f.read(dgps_age_);
+	f.read(dgps_ref_);
+
+	check_value(altitude_unit, {unit::distance::meter}, "altitude unit");
+	check_value(geodial_separation_unit, {unit::distance::meter}, "geodial separation unit");
+
+	// instead of reading data into temporary lat/lon, let's correct values afterwards
+	lat_ = correct_hemisphere(lat_, lat_hem_);
+	lon_ = correct_hemisphere(lon_, lon_hem_);
+}
+
 utils::optional<geo::longitude> gga::get_lon() const
 {
 	return (lon_ && lon_hem_) ? lon_ : utils::optional<geo::longitude>{};
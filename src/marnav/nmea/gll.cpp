@@ -1,4 +1,5 @@
 #include <marnav/nmea/gll.hpp>
+#include "binary_fields.hpp"
 #include "checks.hpp"
 #include "convert.hpp"
 #include <marnav/nmea/io.hpp>
@@ -41,6 +42,31 @@ gll::gll(talker talk, fields::const_iterator first, fields::const_iterator last)
 	lon_ = correct_hemisphere(lon_, lon_hem_);
 }
 
+gll::gll(talker talk, detail::binary_fields & f)
+	: sentence(ID, TAG, talk)
+{
+	// older version has no 'mode_indicator'
+	const auto size = f.size();
+	if ((size < 6) || (size > 7))
+		throw std::invalid_argument{
+			std::string{"invalid number of fields in gll: expected 6, got "}
+			+ std::to_string(size)};
+
+	f.read(lat_);
+	f.read(lat_hem_);
+	f.read(lon_);
+	f.read(lon_hem_);
+	f.read(time_utc_);
+	f.read(data_valid_);
+
+	if (size > 6)
+		f.read(mode_ind_);
+
+	// instead of reading data into temporary lat/lon, let's correct values afterwards
+	lat_ = correct_hemisphere(lat_, lat_hem_);
+	lon_ = correct_hemisphere(lon_, lon_hem_);
+}
+
 utils::optional<geo::longitude> gll::get_lon() const
 {
 	return (lon_ && lon_hem_) ? lon_ : utils::optional<geo::longitude>{};
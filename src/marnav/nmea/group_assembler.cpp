@@ -0,0 +1,200 @@
+#include <marnav/nmea/group_assembler.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace marnav
+{
+namespace nmea
+{
+constexpr std::size_t group_assembler::max_source_size;
+
+/// Initializes the assembler with default options.
+group_assembler::group_assembler()
+	: group_assembler(options{})
+{
+}
+
+/// Initializes the assembler, all memory for pending groups is allocated.
+///
+/// @param[in] opt The options, see `options`.
+/// @exception std::invalid_argument The capacity or the maximum group size is zero.
+group_assembler::group_assembler(const options & opt)
+	: opt_(opt)
+{
+	if ((opt_.capacity == 0) || (opt_.max_group_size == 0))
+		throw std::invalid_argument{"invalid options in nmea/group_assembler"};
+
+	slots_.resize(opt_.capacity);
+	for (auto & s : slots_)
+		s.sentences.reserve(opt_.max_group_size);
+	group_.reserve(opt_.max_group_size);
+}
+
+/// Adds the sentence, received now. See `add(std::unique_ptr<sentence>, clock::time_point)`.
+group_assembler::status group_assembler::add(std::unique_ptr<sentence> s)
+{
+	return add(std::move(s), clock::now());
+}
+
+/// Adds the sentence to its group. Pending groups, which are expired at the
+/// specified time, are removed before.
+///
+/// @param[in] s The sentence to add.
+/// @param[in] t The time of reception of the sentence.
+/// @retval status::none The group of the sentence is not yet complete.
+/// @retval status::complete The group is complete, see `group`.
+/// @retval status::ungrouped The sentence has no group, it is provided as
+///   only sentence by `group`.
+/// @retval status::error The sentence was discarded, its group is invalid or larger
+///   than the maximum group size. This includes `nullptr`.
+group_assembler::status group_assembler::add(std::unique_ptr<sentence> s, clock::time_point t)
+{
+	group_.clear();
+	expire(t);
+
+	if (!s) {
+		++stats_.errors;
+		return status::error;
+	}
+
+	const auto block = s->get_tag_block_view();
+	const auto g = block.get_group();
+	if (!g.is_valid()) {
+		++stats_.ungrouped;
+		group_.push_back(std::move(s));
+		return status::ungrouped;
+	}
+	if ((g.number > g.total_number)
+		|| (static_cast<std::size_t>(g.total_number) > opt_.max_group_size)) {
+		++stats_.errors;
+		return status::error;
+	}
+	if (g.total_number == 1) {
+		++stats_.completed;
+		group_.push_back(std::move(s));
+		return status::complete;
+	}
+
+	const auto total = static_cast<std::size_t>(g.total_number);
+	const auto index = static_cast<std::size_t>(g.number - 1);
+	const auto source = block.get_source();
+
+	slot * p = find(source.data, source.size, g.id);
+	if (p && ((p->sentences.size() != total) || p->sentences[index])) {
+		// duplicate sentence or different group with the same ID
+		++stats_.dropped;
+		release(*p);
+		p = nullptr;
+	}
+	if (!p) {
+		p = &acquire();
+		std::copy_n(source.data, source.size, p->source);
+		p->source_size = source.size;
+		p->id = g.id;
+		p->start = t;
+		p->sentences.resize(total);
+		next_expiry_ = std::min(next_expiry_, t + opt_.timeout);
+	}
+
+	if (g.number != p->received + 1)
+		p->out_of_order = true;
+	p->sentences[index] = std::move(s);
+	++p->received;
+	if (p->received < g.total_number)
+		return status::none;
+
+	++stats_.completed;
+	if (p->out_of_order)
+		++stats_.out_of_order;
+	group_.swap(p->sentences);
+	release(*p);
+	return status::complete;
+}
+
+/// Removes all pending groups, which are not complete at the specified time.
+///
+/// This is done automatically when sentences are added, it is necessary to be
+/// called explicitly only if no sentences arrive.
+///
+/// @param[in] t The current time.
+/// @return Number of expired groups.
+std::size_t group_assembler::expire(clock::time_point t)
+{
+	if (t < next_expiry_)
+		return 0;
+
+	std::size_t n = 0;
+	next_expiry_ = clock::time_point::max();
+	for (auto & s : slots_) {
+		if (!s.used)
+			continue;
+		const auto expiry = s.start + opt_.timeout;
+		if (expiry <= t) {
+			release(s);
+			++n;
+		} else {
+			next_expiry_ = std::min(next_expiry_, expiry);
+		}
+	}
+	stats_.expired += n;
+	return n;
+}
+
+/// Discards all pending groups and the last complete group. The statistics
+/// remain unchanged.
+void group_assembler::reset()
+{
+	for (auto & s : slots_)
+		if (s.used)
+			release(s);
+	group_.clear();
+	next_expiry_ = clock::time_point::max();
+}
+
+group_assembler::slot * group_assembler::find(
+	const char * source, std::size_t source_size, int id) noexcept
+{
+	if (pending_ == 0)
+		return nullptr;
+	for (auto & s : slots_) {
+		if (s.used && (s.id == id) && (s.source_size == source_size)
+			&& (std::memcmp(s.source, source, source_size) == 0))
+			return &s;
+	}
+	return nullptr;
+}
+
+/// Returns an unused slot, drops the oldest pending group if there is none.
+group_assembler::slot & group_assembler::acquire()
+{
+	slot * oldest = nullptr;
+	for (auto & s : slots_) {
+		if (!s.used) {
+			s.used = true;
+			++pending_;
+			return s;
+		}
+		if (!oldest || (s.start < oldest->start))
+			oldest = &s;
+	}
+
+	++stats_.dropped;
+	release(*oldest);
+	oldest->used = true;
+	++pending_;
+	return *oldest;
+}
+
+void group_assembler::release(slot & s) noexcept
+{
+	s.used = false;
+	s.out_of_order = false;
+	s.source_size = 0;
+	s.received = 0;
+	s.sentences.clear(); // keeps the capacity
+	--pending_;
+}
+}
+}
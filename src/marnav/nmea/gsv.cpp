@@ -48,7 +48,10 @@ gsv::gsv(talker talk, fields::const_iterator first, fields::const_iterator last)
 	const int num_satellite_info = std::min(4, static_cast<int>((size - 3) / 4));
 	int index = 3;
 	for (int id = 0; id < num_satellite_info; ++id, index += 4) {
-		satellite_info info;
+		// unused satellite information consists of empty fields
+		if ((first + index)->empty())
+			continue;
+		satellite_info info{0, 0, 0, 0};
 		read(*(first + index + 0), info.id);
 		read(*(first + index + 1), info.elevation);
 		read(*(first + index + 2), info.azimuth);
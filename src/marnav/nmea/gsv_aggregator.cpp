@@ -0,0 +1,164 @@
+#include <marnav/nmea/gsv_aggregator.hpp>
+#include <algorithm>
+
+namespace marnav
+{
+namespace nmea
+{
+constexpr std::size_t gsv_aggregator::max_talkers;
+constexpr std::size_t gsv_aggregator::max_satellites;
+constexpr std::size_t gsv_aggregator::values;
+
+/// Adds the sentence, if it is a GSV sentence. All other sentences are ignored.
+///
+/// @param[in] s The sentence to add.
+/// @retval true A cycle was completed and published.
+/// @retval false The sentence was not the last one of a cycle, or not a GSV sentence.
+bool gsv_aggregator::add(const sentence & s)
+{
+	if (s.id() != gsv::ID)
+		return false;
+	return add(*sentence_cast<gsv>(&s));
+}
+
+/// Adds the satellites of the sentence to the cycle of its talker.
+///
+/// A cycle starts with the first message and must be continued with all
+/// following messages in sequence. If a message is missing, the cycle is
+/// discarded and the published snapshot remains unchanged.
+///
+/// @param[in] s The sentence to add.
+/// @retval true The cycle was completed and published.
+/// @retval false The cycle is not yet complete or was discarded.
+bool gsv_aggregator::add(const gsv & s)
+{
+	++stats_.sentences;
+	if (s.get_talker() == talker::none)
+		return false;
+
+	table * p = find(s.get_talker());
+	if (!p) {
+		p = find(talker::none);
+		if (!p) {
+			++stats_.overflows;
+			return false;
+		}
+		p->talk.store(static_cast<int>(s.get_talker()), std::memory_order_release);
+	}
+
+	const uint32_t number = s.get_message_number();
+	const uint32_t n = s.get_n_messages();
+	buffer & b = p->buffers[1u - p->front.load(std::memory_order_relaxed)];
+
+	if (number == 1) {
+		if (p->expected != 0)
+			++stats_.incomplete;
+		const auto seq = b.seq.load(std::memory_order_relaxed);
+		if (!(seq & 1u)) {
+			b.seq.store(seq + 1u, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+		p->expected = 1;
+		p->size = 0;
+	} else if (number != p->expected) {
+		if (p->expected != 0)
+			++stats_.incomplete;
+		p->expected = 0;
+		return false;
+	}
+
+	for (int i = 0; i < 4; ++i) {
+		const auto sat = s.get_sat(i);
+		if (!sat || (p->size >= max_satellites))
+			continue;
+		auto * data = &b.data[p->size * values];
+		data[0].store(sat->id, std::memory_order_relaxed);
+		data[1].store(sat->elevation, std::memory_order_relaxed);
+		data[2].store(sat->azimuth, std::memory_order_relaxed);
+		data[3].store(sat->snr, std::memory_order_relaxed);
+		++p->size;
+	}
+
+	if (number < n) {
+		++p->expected;
+		return false;
+	}
+
+	b.size.store(p->size, std::memory_order_relaxed);
+	b.n_satellites_in_view.store(s.get_n_satellites_in_view(), std::memory_order_relaxed);
+	b.cycle.store(++p->cycles, std::memory_order_relaxed);
+	b.seq.store(b.seq.load(std::memory_order_relaxed) + 1u, std::memory_order_release);
+	p->front.store(1u - p->front.load(std::memory_order_relaxed), std::memory_order_release);
+	p->expected = 0;
+	++stats_.cycles;
+	return true;
+}
+
+/// Copies the last complete cycle of the talker.
+///
+/// This does not lock and may be called concurrently to `add`, from any thread.
+///
+/// @param[in] t The talker.
+/// @param[out] s The snapshot, unchanged if there is none.
+/// @retval true Success.
+/// @retval false There was no complete cycle of this talker yet.
+bool gsv_aggregator::get(talker t, snapshot & s) const noexcept
+{
+	if (t == talker::none)
+		return false;
+	const table * p = find(t);
+	if (!p)
+		return false;
+
+	for (;;) {
+		const buffer & b = p->buffers[p->front.load(std::memory_order_acquire)];
+		const auto seq = b.seq.load(std::memory_order_acquire);
+		if (seq & 1u)
+			continue; // buffer was reused since reading `front`
+
+		const auto cycle = b.cycle.load(std::memory_order_relaxed);
+		const auto in_view = b.n_satellites_in_view.load(std::memory_order_relaxed);
+		std::size_t size = b.size.load(std::memory_order_relaxed);
+		if (size > max_satellites)
+			size = max_satellites;
+		std::array<gsv::satellite_info, max_satellites> satellites;
+		for (std::size_t i = 0; i < size; ++i) {
+			const auto * data = &b.data[i * values];
+			satellites[i].id = data[0].load(std::memory_order_relaxed);
+			satellites[i].elevation = data[1].load(std::memory_order_relaxed);
+			satellites[i].azimuth = data[2].load(std::memory_order_relaxed);
+			satellites[i].snr = data[3].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (b.seq.load(std::memory_order_relaxed) != seq)
+			continue;
+
+		if (cycle == 0)
+			return false;
+		s.talk = t;
+		s.cycle = cycle;
+		s.n_satellites_in_view = in_view;
+		s.size = size;
+		std::copy_n(satellites.begin(), size, s.satellites.begin());
+		return true;
+	}
+}
+
+gsv_aggregator::table * gsv_aggregator::find(talker t) noexcept
+{
+	for (auto & p : tables_)
+		if (p.talk.load(std::memory_order_acquire) == static_cast<int>(t))
+			return &p;
+	return nullptr;
+}
+
+const gsv_aggregator::table * gsv_aggregator::find(talker t) const noexcept
+{
+	for (const auto & p : tables_)
+		if (p.talk.load(std::memory_order_acquire) == static_cast<int>(t))
+			return &p;
+	return nullptr;
+}
+}
+}
@@ -12,6 +12,18 @@ inline constexpr char hex_digit(unsigned int t) noexcept
 {
 	return "0123456789ABCDEF"[t & 0xf];
 }
+
+/// Returns the value of the hex digit, or -1 if the character is not a hex digit.
+inline int hex_value(char c) noexcept
+{
+	if ((c >= '0') && (c <= '9'))
+		return c - '0';
+	if ((c >= 'A') && (c <= 'F'))
+		return c - 'A' + 10;
+	if ((c >= 'a') && (c <= 'f'))
+		return c - 'a' + 10;
+	return -1;
+}
 }
 /// @endcond
 }
@@ -0,0 +1,107 @@
+#include <marnav/nmea/lazy_sentence.hpp>
+#include "scan.hpp"
+#include <marnav/nmea/nmea.hpp>
+#include <stdexcept>
+
+namespace marnav
+{
+namespace nmea
+{
+/// Validates the sentence and records the positions of its fields.
+///
+/// @param[in] s The raw sentence, optionally with tag block.
+/// @param[in] chksum Checksum handling strategy.
+/// @exception checksum_error The checksum is wrong.
+/// @exception std::invalid_argument The sentence is malformed.
+/// @exception unknown_sentence The sentence is not supported.
+lazy_sentence::lazy_sentence(const std::string & s, checksum_handling chksum)
+	: raw_(s)
+{
+	init(chksum);
+}
+
+/// Same as above, the string is moved into the object.
+lazy_sentence::lazy_sentence(std::string && s, checksum_handling chksum)
+	: raw_(std::move(s))
+{
+	init(chksum);
+}
+
+void lazy_sentence::init(checksum_handling chksum)
+{
+	const auto v = validate_sentence(raw_);
+	if (v.status == validation::checksum) {
+		if (chksum == checksum_handling::check) {
+			const auto size = raw_.size() - v.address;
+			detail::ensure_checksum(detail::scan(raw_.data() + v.address, size, nullptr), size,
+				raw_.substr(raw_.size() - 2));
+		}
+	} else if (!v) {
+		throw std::invalid_argument{"malformed sentence in nmea/lazy_sentence"};
+	}
+
+	if (v.id == sentence_id::NONE)
+		throw unknown_sentence{"unknown sentence in nmea/lazy_sentence: " + raw_};
+
+	id_ = v.id;
+	talker_ = v.talk;
+	address_ = static_cast<uint32_t>(v.address);
+
+	// positions of the delimiters, the address is already known
+	const auto first = v.address + v.address_size;
+	const auto size = raw_.size() - first;
+	uint64_t local_mask[detail::scan_mask_size(sentence::max_length)];
+	std::vector<uint64_t> heap_mask;
+	uint64_t * mask = local_mask;
+	if (detail::scan_mask_size(size) > detail::scan_mask_size(sentence::max_length)) {
+		heap_mask.resize(detail::scan_mask_size(size));
+		mask = heap_mask.data();
+	}
+	const auto info = detail::scan(raw_.data() + first, size, mask);
+
+	fields_.reserve(v.fields + 1);
+	for (std::size_t w = 0; w < detail::scan_mask_size(size); ++w) {
+		for (uint64_t bits = mask[w]; bits; bits &= bits - 1) {
+			const auto p = w * 64 + static_cast<std::size_t>(detail::scan_ctz(bits));
+			if (p > info.end)
+				break;
+			fields_.push_back(static_cast<uint32_t>(first + p + 1));
+		}
+	}
+}
+
+/// Returns the tag of the sentence, for proprietary sentences the complete address.
+std::string lazy_sentence::tag() const
+{
+	return to_string(id_);
+}
+
+/// Returns the raw tag block, empty if there is none.
+std::string lazy_sentence::get_tag_block() const
+{
+	if (raw_[0] != sentence::tag_block_token)
+		return {};
+	return raw_.substr(1, address_ - 3);
+}
+
+/// Returns the raw content of the specified data field.
+///
+/// @param[in] index Index of the data field, the address is not a data field.
+/// @exception std::out_of_range The index is out of range.
+std::string lazy_sentence::field(std::size_t index) const
+{
+	if (index >= size())
+		throw std::out_of_range{"index out of range in nmea/lazy_sentence::field"};
+	return raw_.substr(fields_[index], fields_[index + 1] - fields_[index] - 1);
+}
+
+sentence::fields lazy_sentence::get_fields() const
+{
+	sentence::fields result;
+	result.reserve(size());
+	for (std::size_t i = 0; i < size(); ++i)
+		result.push_back(field(i));
+	return result;
+}
+}
+}
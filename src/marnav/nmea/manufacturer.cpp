@@ -1,6 +1,7 @@
 #include <marnav/nmea/manufacturer.hpp>
 #include <marnav/nmea/sentence.hpp>
 #include <algorithm>
+#include <array>
 #include <vector>
 
 namespace marnav
@@ -10,27 +11,19 @@ namespace nmea
 /// @cond DEV
 namespace
 {
-struct entry final {
-	~entry() noexcept;
-
+struct entry {
 	manufacturer_id id;
-	std::string tag;
-	std::string name;
+	const char * tag;
+	const char * name;
 };
 
-entry::~entry() noexcept
-{
-}
-
-using manufacturer_map = std::vector<entry>;
-
 #define MANUFACTURER(id, tag, text)    \
 	{                                  \
 		manufacturer_id::id, tag, text \
 	}
 
 // clang-format off
-static const manufacturer_map manufacturers = {
+static constexpr entry manufacturers[] = {
 	MANUFACTURER(_3SN, "3SN", "3-S NAVIGATION"),
 	MANUFACTURER( AAR, "AAR", "ASIAN AMERICAN RESOURCES"),
 	MANUFACTURER( ACE, "ACE", "AUTO-COMM ENGINEERING CORP."),
@@ -577,16 +570,76 @@ static const manufacturer_map manufacturers = {
 
 #undef MANUFACTURER
 
-static manufacturer_map::const_iterator find_manufacturer(const std::string & tag)
+constexpr std::size_t num_manufacturers = sizeof(manufacturers) / sizeof(manufacturers[0]);
+
+/// Value of the first manufacturer ID, all IDs before are not real manufacturers.
+constexpr std::size_t first_manufacturer = static_cast<std::size_t>(manufacturer_id::_3SN);
+
+/// Returns true if the entries of the range are in the order of their IDs,
+/// which makes the lookup by ID a simple indexing. Divides the range to keep
+/// the recursion depth within the limits of constant expressions.
+static constexpr bool ordered_by_id(std::size_t first, std::size_t last)
+{
+	return (last - first == 1)
+		? (static_cast<std::size_t>(manufacturers[first].id) == first_manufacturer + first)
+		: (ordered_by_id(first, first + (last - first) / 2)
+			  && ordered_by_id(first + (last - first) / 2, last));
+}
+
+static_assert(ordered_by_id(0, num_manufacturers),
+	"manufacturers must be in the same order as manufacturer_id");
+
+/// Packs the three characters of a manufacturer tag into an integer, preserving
+/// their lexicographical order.
+static constexpr uint32_t pack(const char * s)
+{
+	return (static_cast<uint32_t>(static_cast<unsigned char>(s[0])) << 16)
+		| (static_cast<uint32_t>(static_cast<unsigned char>(s[1])) << 8)
+		| static_cast<uint32_t>(static_cast<unsigned char>(s[2]));
+}
+
+struct tag_index_entry {
+	uint32_t key;
+	uint32_t index;
+};
+
+using tag_index = std::array<tag_index_entry, num_manufacturers>;
+
+static bool operator<(const tag_index_entry & a, const tag_index_entry & b) noexcept
+{
+	return a.key < b.key;
+}
+
+/// Returns the index of all manufacturers, sorted by their packed tags.
+///
+/// The table is built only once, at its first use. C++11 does not allow
+/// to sort within constant expressions.
+static const tag_index & get_tag_index()
+{
+	static const tag_index index = [] {
+		tag_index t;
+		for (std::size_t i = 0; i < num_manufacturers; ++i)
+			t[i] = {pack(manufacturers[i].tag), static_cast<uint32_t>(i)};
+		std::sort(t.begin(), t.end());
+		return t;
+	}();
+	return index;
+}
+
+static const entry * find_manufacturer(const char * tag) noexcept
 {
-	return std::find_if(begin(manufacturers), end(manufacturers),
-		[tag](const manufacturer_map::value_type & m) { return m.tag == tag; });
+	const auto & index = get_tag_index();
+	const tag_index_entry key = {pack(tag), 0};
+	const auto i = std::lower_bound(index.begin(), index.end(), key);
+	return ((i == index.end()) || (i->key != key.key)) ? nullptr : &manufacturers[i->index];
 }
 
-static manufacturer_map::const_iterator find_manufacturer(manufacturer_id id)
+static const entry * find_manufacturer(manufacturer_id id) noexcept
 {
-	return std::find_if(begin(manufacturers), end(manufacturers),
-		[id](const manufacturer_map::value_type & m) { return m.id == id; });
+	const auto i = static_cast<std::size_t>(id);
+	if ((i < first_manufacturer) || (i >= first_manufacturer + num_manufacturers))
+		return nullptr;
+	return &manufacturers[i - first_manufacturer];
 }
 
 static bool is_nmea(const std::string & tag)
@@ -615,8 +668,8 @@ manufacturer_id get_manufacturer_id(const std::string & tag)
 	if (is_unkown(tag))
 		return manufacturer_id::UNKNOWN;
 
-	const auto it = find_manufacturer(tag.substr(1, 3));
-	return (it == manufacturers.cend()) ? manufacturer_id::UNKNOWN : it->id;
+	const auto m = find_manufacturer(tag.data() + 1);
+	return m ? m->id : manufacturer_id::UNKNOWN;
 }
 
 /// Returns the ID of the manufacturer of the specified sentence.
@@ -631,8 +684,8 @@ manufacturer_id get_manufacturer_id(const sentence & s)
 /// Returns the tag of the manufacturer specified by the ID.
 std::string get_manufacturer_tag(manufacturer_id id)
 {
-	const auto it = find_manufacturer(id);
-	return (it == manufacturers.cend()) ? std::string{} : it->tag;
+	const auto m = find_manufacturer(id);
+	return m ? std::string{m->tag} : std::string{};
 }
 
 /// Returns the name of the manufacturer specified by the ID.
@@ -643,15 +696,15 @@ std::string get_manufacturer_name(manufacturer_id id)
 	if (id == manufacturer_id::UNKNOWN)
 		return "UNKNOWN";
 
-	const auto it = find_manufacturer(id);
-	return (it == manufacturers.cend()) ? std::string{} : it->name;
+	const auto m = find_manufacturer(id);
+	return m ? std::string{m->name} : std::string{};
 }
 
 /// Returns a container of all supported manufacturer IDs.
 std::vector<manufacturer_id> get_supported_manufacturer_id()
 {
 	std::vector<manufacturer_id> v;
-	v.reserve(manufacturers.size());
+	v.reserve(num_manufacturers);
 
 	for (const auto & m : manufacturers) {
 		v.push_back(m.id);
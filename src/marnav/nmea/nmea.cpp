@@ -1,9 +1,12 @@
 #include <marnav/nmea/nmea.hpp>
+#include "hex_digit.hpp"
+#include "scan.hpp"
 #include <marnav/nmea/angle.hpp>
 #include <marnav/nmea/checksum.hpp>
 #include <marnav/nmea/date.hpp>
 #include <marnav/nmea/detail.hpp>
 #include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/sentence_filter.hpp>
 #include <marnav/nmea/time.hpp>
 #include <marnav/nmea/aam.hpp>
 #include <marnav/nmea/alm.hpp>
@@ -88,6 +91,7 @@
 #include <marnav/nmea/stalk.hpp>
 #include <algorithm>
 #include <string>
+#include <cstring>
 
 /// @example parse_nmea.cpp
 /// This is an example on how to parse and handle NMEA sentences from a string.
@@ -100,15 +104,22 @@ namespace nmea
 namespace
 {
 // local macro, used for convenience while registering sentences
-#define REGISTER_SENTENCE(s)                     \
-	{                                            \
-		s::TAG, s::ID, detail::factory::parse<s> \
+#define REGISTER_SENTENCE(s)                              \
+	{                                                     \
+		s::TAG, s::ID, detail::factory::parse<s>, nullptr \
+	}
+
+// local macro, registers sentences which are able to read binary records as well
+#define REGISTER_BINARY_SENTENCE(s)                                                \
+	{                                                                              \
+		s::TAG, s::ID, detail::factory::parse<s>, detail::factory::parse_binary<s> \
 	}
 
 struct entry {
 	const char * TAG;
 	const sentence_id ID;
 	const sentence::parse_function parse;
+	const sentence::binary_parse_function parse_binary;
 };
 static const std::vector<entry> known_sentences = {
 	// regular
@@ -117,8 +128,8 @@ static const std::vector<entry> known_sentences = {
 	REGISTER_SENTENCE(bwc), REGISTER_SENTENCE(bwr), REGISTER_SENTENCE(bww),
 	REGISTER_SENTENCE(dbk), REGISTER_SENTENCE(dbt), REGISTER_SENTENCE(dpt),
 	REGISTER_SENTENCE(dsc), REGISTER_SENTENCE(dse), REGISTER_SENTENCE(dtm),
-	REGISTER_SENTENCE(fsi), REGISTER_SENTENCE(gbs), REGISTER_SENTENCE(gga),
-	REGISTER_SENTENCE(glc), REGISTER_SENTENCE(gll), REGISTER_SENTENCE(grs),
+	REGISTER_SENTENCE(fsi), REGISTER_SENTENCE(gbs), REGISTER_BINARY_SENTENCE(gga),
+	REGISTER_SENTENCE(glc), REGISTER_BINARY_SENTENCE(gll), REGISTER_SENTENCE(grs),
 	REGISTER_SENTENCE(gns), REGISTER_SENTENCE(gsa), REGISTER_SENTENCE(gst),
 	REGISTER_SENTENCE(gsv), REGISTER_SENTENCE(gtd), REGISTER_SENTENCE(hdg),
 	REGISTER_SENTENCE(hfb), REGISTER_SENTENCE(hdm), REGISTER_SENTENCE(hdt),
@@ -126,14 +137,14 @@ static const std::vector<entry> known_sentences = {
 	REGISTER_SENTENCE(mob), REGISTER_SENTENCE(msk), REGISTER_SENTENCE(mss),
 	REGISTER_SENTENCE(mtw), REGISTER_SENTENCE(mwd), REGISTER_SENTENCE(mwv),
 	REGISTER_SENTENCE(osd), REGISTER_SENTENCE(r00), REGISTER_SENTENCE(rma),
-	REGISTER_SENTENCE(rmb), REGISTER_SENTENCE(rmc), REGISTER_SENTENCE(rot),
-	REGISTER_SENTENCE(rpm), REGISTER_SENTENCE(rsa), REGISTER_SENTENCE(rsd),
+	REGISTER_SENTENCE(rmb), REGISTER_BINARY_SENTENCE(rmc), REGISTER_SENTENCE(rot),
+	REGISTER_SENTENCE(rpm), REGISTER_SENTENCE(rsa), REGISTER_BINARY_SENTENCE(rsd),
 	REGISTER_SENTENCE(rte), REGISTER_SENTENCE(sfi), REGISTER_SENTENCE(stn),
 	REGISTER_SENTENCE(tds), REGISTER_SENTENCE(tfi), REGISTER_SENTENCE(tll),
 	REGISTER_SENTENCE(tpc), REGISTER_SENTENCE(tpr), REGISTER_SENTENCE(tpt),
 	REGISTER_SENTENCE(ttm), REGISTER_SENTENCE(vbw), REGISTER_SENTENCE(vdm),
 	REGISTER_SENTENCE(vdo), REGISTER_SENTENCE(vdr), REGISTER_SENTENCE(vhw),
-	REGISTER_SENTENCE(vlw), REGISTER_SENTENCE(vpw), REGISTER_SENTENCE(vtg),
+	REGISTER_BINARY_SENTENCE(vlw), REGISTER_SENTENCE(vpw), REGISTER_SENTENCE(vtg),
 	REGISTER_SENTENCE(vwr), REGISTER_SENTENCE(wcv), REGISTER_SENTENCE(wnc),
 	REGISTER_SENTENCE(wpl), REGISTER_SENTENCE(xdr), REGISTER_SENTENCE(xte),
 	REGISTER_SENTENCE(xtr), REGISTER_SENTENCE(zda), REGISTER_SENTENCE(zdl),
@@ -143,6 +154,7 @@ static const std::vector<entry> known_sentences = {
 	REGISTER_SENTENCE(pgrme), REGISTER_SENTENCE(pgrmm), REGISTER_SENTENCE(pgrmz),
 	REGISTER_SENTENCE(stalk)};
 #undef REGISTER_SENTENCE
+#undef REGISTER_BINARY_SENTENCE
 }
 
 /// @endcond
@@ -150,11 +162,76 @@ static const std::vector<entry> known_sentences = {
 /// @cond DEV
 namespace detail
 {
+/// Maximum size of tags, which are packed into integers, together with
+/// their size.
+static constexpr std::size_t max_tag_size = sizeof(uint64_t) - 1;
+
+/// Packs the size and the characters of a tag into an integer, unique for
+/// every tag of up to `max_tag_size` characters, including ones containing
+/// NUL characters.
+static uint64_t pack_tag(const char * tag, std::size_t size) noexcept
+{
+	uint64_t key = size;
+	for (std::size_t i = 0; i < size; ++i)
+		key = (key << 8) | static_cast<unsigned char>(tag[i]);
+	return key;
+}
+
+struct tag_index_entry {
+	uint64_t key;
+	std::size_t index;
+};
+
+static bool operator<(const tag_index_entry & a, const tag_index_entry & b) noexcept
+{
+	return a.key < b.key;
+}
+
+/// Returns the index of the known sentences, sorted by their packed tags.
+static std::vector<tag_index_entry> make_tag_index()
+{
+	std::vector<tag_index_entry> t;
+	t.reserve(known_sentences.size());
+	for (std::size_t i = 0; i < known_sentences.size(); ++i) {
+		const auto tag = known_sentences[i].TAG;
+		t.push_back({pack_tag(tag, std::strlen(tag)), i});
+	}
+	std::sort(t.begin(), t.end());
+	return t;
+}
+
+/// Index of the known sentences. It is initialized together with the known
+/// sentences, not at its first use, lookups therefore never allocate.
+static const std::vector<tag_index_entry> tag_index = make_tag_index();
+
+/// Searches in the known sentences for the entry carrying the specified tag,
+/// without allocation.
+static std::vector<entry>::const_iterator find_tag(const char * tag, std::size_t size) noexcept
+{
+	if ((size == 0) || (size > max_tag_size))
+		return std::end(known_sentences);
+
+	const tag_index_entry key = {pack_tag(tag, size), 0};
+	const auto i = std::lower_bound(tag_index.begin(), tag_index.end(), key);
+	if ((i == tag_index.end()) || (i->key != key.key))
+		return std::end(known_sentences);
+	return std::begin(known_sentences) + static_cast<std::ptrdiff_t>(i->index);
+}
+
 /// Searches in the known sentences for the entry carrying the specified tag.
 static std::vector<entry>::const_iterator find_tag(const std::string & tag)
 {
-	return std::find_if(std::begin(known_sentences), std::end(known_sentences),
-		[tag](const entry & e) { return e.TAG == tag; });
+	return find_tag(tag.data(), tag.size());
+}
+
+/// Returns the ID of the supported sentence with the specified tag, without
+/// allocation. Proprietary sentences are found by their complete address.
+///
+/// @return The ID of the sentence or sentence_id::NONE if unknown.
+sentence_id find_sentence_id(const char * tag, std::size_t size) noexcept
+{
+	const auto i = find_tag(tag, size);
+	return (i != std::end(known_sentences)) ? i->ID : sentence_id::NONE;
 }
 
 /// Returns the parse function of a particular sentence.
@@ -206,6 +283,40 @@ std::tuple<talker, std::string> parse_address(const std::string & address)
 	return make_tuple(make_talker(address.substr(0, 2)), tag);
 }
 
+/// Creates the sentence of the specified tag from its data fields.
+///
+/// @param[in] talk The talker of the sentence.
+/// @param[in] tag The tag of the sentence, e.g. `RMC` or `PGRME`.
+/// @param[in] fields The data fields, without address.
+/// @return The object of the corresponding type.
+/// @exception unknown_sentence The sentence is not supported.
+/// @exception std::invalid_argument The fields are not valid for the sentence.
+std::unique_ptr<sentence> create_sentence(
+	talker talk, const std::string & tag, const std::vector<std::string> & fields)
+{
+	return find_parse_func(tag)(talk, std::begin(fields), std::end(fields));
+}
+
+/// Creates the sentence of the specified tag from the fields of a binary record.
+///
+/// @param[in] talk The talker of the sentence.
+/// @param[in] tag The tag of the sentence, e.g. `RMC` or `PGRME`.
+/// @param[in] fields The data fields of the record.
+/// @return The object of the corresponding type, `nullptr` if the sentence
+///   is not able to read binary fields. In this case no fields were read.
+/// @exception unknown_sentence The sentence is not supported.
+/// @exception std::invalid_argument The fields are not valid for the sentence.
+std::unique_ptr<sentence> create_sentence(
+	talker talk, const std::string & tag, binary_fields & fields)
+{
+	const auto i = find_tag(tag);
+	if (i == std::end(known_sentences))
+		throw unknown_sentence{"unknown sentence in nmea/create_sentence: " + tag};
+	if (!i->parse_binary)
+		return nullptr;
+	return i->parse_binary(talk, fields);
+}
+
 /// Computes and checks the checksum of the specified sentence against the
 /// expected checksum.
 ///
@@ -225,15 +336,10 @@ std::tuple<talker, std::string> parse_address(const std::string & address)
 void ensure_checksum(
 	const std::string & s, const std::string & expected, std::string::size_type start_pos)
 {
-	const auto end_pos = s.find_first_of(sentence::end_token, start_pos);
-	if (end_pos == std::string::npos) // end token not found
-		throw std::invalid_argument{"invalid format in nmea/ensure_checksum"};
-	if (s.size() != end_pos + 3) // short or no checksum
+	if (start_pos > s.size())
 		throw std::invalid_argument{"invalid format in nmea/ensure_checksum"};
-	const uint8_t expected_checksum = static_cast<uint8_t>(std::stoul(expected, nullptr, 16));
-	const uint8_t sum = checksum(begin(s) + start_pos, begin(s) + end_pos);
-	if (expected_checksum != sum)
-		throw checksum_error{expected_checksum, sum};
+	ensure_checksum(scan(s.data() + start_pos, s.size() - start_pos, nullptr),
+		s.size() - start_pos, expected);
 }
 
 /// @note This function must be defined here, not in the file detail.cpp,
@@ -325,10 +431,38 @@ std::unique_ptr<sentence> make_sentence(const std::string & s, checksum_handling
 	std::tie(talk, tag, tag_block, fields) = detail::extract_sentence_information(s, chksum);
 	auto result = detail::find_parse_func(tag)(
 		talk, std::next(std::begin(fields)), std::prev(std::end(fields)));
-	result->set_tag_block(tag_block);
+	result->set_tag_block(std::move(tag_block));
 	return result;
 }
 
+/// Parses the string and returns the corresponding sentence, if the filter
+/// accepts it. The filter is checked before the sentence is split into
+/// fields, rejected sentences cost neither parsing nor allocation.
+///
+/// @param[in] s The sentence to parse.
+/// @param[in] filter The filter to check the sentence against.
+/// @param[in] chksum Checksum handling strategy.
+/// @return The object of the corresponding type, `nullptr` if the sentence
+///   was rejected by the filter.
+/// @exception checksum_error Will be thrown if the checksum is wrong.
+/// @exception std::invalid_argument Will be thrown if the specified string
+///   is not a NMEA sentence (malformed).
+/// @exception unknown_sentence Will be thrown if the sentence is not supported.
+///
+/// Example:
+/// @code
+///   const nmea::sentence_filter filter{nmea::sentence_id::MTW};
+///   auto s = nmea::make_sentence("$IIVWR,084.0,R,10.4,N,5.4,M,19.3,K*4A", filter);
+///   // s == nullptr
+/// @endcode
+std::unique_ptr<sentence> make_sentence(
+	const std::string & s, const sentence_filter & filter, checksum_handling chksum)
+{
+	if (!filter.accepts(s))
+		return nullptr;
+	return make_sentence(s, chksum);
+}
+
 /// Extracts and returns the sentence ID of the specified raw NMEA sentence.
 ///
 /// This function does not check the checksum.
@@ -360,5 +494,168 @@ sentence_id extract_id(const std::string & s)
 
 	return tag_to_id(tag);
 }
+
+/// @cond DEV
+namespace
+{
+/// Maximum number of data fields accepted by `validate_sentence`. A field needs at
+/// least its separator, a standard conforming sentence cannot have more.
+constexpr const std::size_t max_fields = sentence::max_length;
+
+/// Maximum size of the address field (e.g. `GPRMC`, `PGRME`, `STALK`).
+constexpr const std::size_t max_address_size = 8;
+
+/// Returns the checksum written as two hex digits at the specified position,
+/// or -1 if they are not hex digits.
+static int read_checksum(const char * s) noexcept
+{
+	const int hi = detail::hex_value(s[0]);
+	const int lo = detail::hex_value(s[1]);
+	if ((hi < 0) || (lo < 0))
+		return -1;
+	return (hi << 4) | lo;
+}
+
+static bool is_address_char(char c) noexcept
+{
+	return ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9'));
+}
+
+static bool is_printable(char c) noexcept
+{
+	return (c >= 0x20) && (c <= 0x7e);
+}
+}
+/// @endcond
+
+/// Checks the structure and the checksum of a raw sentence, without parsing
+/// the data fields and without allocation.
+///
+/// The following is checked:
+/// - optional tag block, terminated, with a correct checksum if it has one
+/// - start token
+/// - address, upper case letters and digits only
+/// - number of fields
+/// - printable characters only
+/// - checksum
+///
+/// Well formed sentences which are not supported by `make_sentence` are valid,
+/// their ID is `sentence_id::NONE`. If only the checksum is wrong, ID, talker and
+/// positions are provided nevertheless.
+///
+/// This is meant for applications which forward or filter sentences and do not
+/// need the data. It is a small fraction of the cost of `make_sentence`.
+///
+/// @param[in] s The raw sentence, optionally with tag block, without end of line.
+/// @param[in] size Number of characters of the sentence.
+/// @return The result of the validation, convertible to `bool`.
+///
+/// Example:
+/// @code
+///   const auto r = nmea::validate_sentence("$IIMTW,9.5,C*2F");
+///   if (r && (r.id == nmea::sentence_id::MTW)) {
+///       // ...
+///   }
+/// @endcode
+validation_result validate_sentence(const char * s, std::size_t size) noexcept
+{
+	validation_result result;
+
+	if (!s || (size == 0)) {
+		result.status = validation::empty;
+		return result;
+	}
+
+	std::size_t i = 0;
+
+	// tag block, the checksum is optional
+	if (s[0] == sentence::tag_block_token) {
+		const auto p = static_cast<const char *>(
+			std::memchr(s + 1, sentence::tag_block_token, size - 1));
+		if (!p) {
+			result.status = validation::tag_block;
+			return result;
+		}
+		const auto end = static_cast<std::size_t>(p - s);
+		if ((end >= 4) && (s[end - 3] == sentence::end_token)
+			&& (read_checksum(s + end - 2) != checksum(s + 1, s + end - 3))) {
+			result.status = validation::tag_block;
+			return result;
+		}
+		i = end + 1;
+	}
+
+	if ((i >= size)
+		|| ((s[i] != sentence::start_token) && (s[i] != sentence::start_token_ais))) {
+		result.status = validation::start_token;
+		return result;
+	}
+	const std::size_t start = ++i;
+
+	// address
+	while ((i < size) && (s[i] != ',') && (s[i] != sentence::end_token)) {
+		if (!is_address_char(s[i])) {
+			result.status = validation::address;
+			return result;
+		}
+		++i;
+	}
+	const std::size_t address_size = i - start;
+	if ((address_size == 0) || (address_size > max_address_size)) {
+		result.status = validation::address;
+		return result;
+	}
+
+	// fields
+	std::size_t fields = 0;
+	while ((i < size) && (s[i] != sentence::end_token)) {
+		if (s[i] == ',') {
+			if (++fields > max_fields) {
+				result.status = validation::field_count;
+				return result;
+			}
+		} else if (!is_printable(s[i])) {
+			result.status = validation::character;
+			return result;
+		}
+		++i;
+	}
+
+	// checksum
+	if ((i == size) || (size != i + 3)) {
+		result.status = validation::checksum_format;
+		return result;
+	}
+	const int expected = read_checksum(s + i + 1);
+	if (expected < 0) {
+		result.status = validation::checksum_format;
+		return result;
+	}
+	result.address = start;
+	result.address_size = address_size;
+	result.fields = fields;
+
+	// identification, same rules as `make_sentence`
+	const auto e = detail::find_tag(s + start, address_size);
+	if (e != std::end(known_sentences)) {
+		result.id = e->ID;
+	} else if (address_size == 5u) {
+		const auto r = detail::find_tag(s + start + 2, 3);
+		if (r != std::end(known_sentences))
+			result.id = r->ID;
+		result.talk = detail::find_talker(s[start], s[start + 1]);
+	}
+
+	if (expected != checksum(s + start, s + i))
+		result.status = validation::checksum;
+
+	return result;
+}
+
+/// Convenience overload of `validate_sentence(const char *, std::size_t)`.
+validation_result validate_sentence(const std::string & s) noexcept
+{
+	return validate_sentence(s.data(), s.size());
+}
 }
 }
@@ -1,4 +1,5 @@
 #include <marnav/nmea/rmc.hpp>
+#include "binary_fields.hpp"
 #include "checks.hpp"
 #include "convert.hpp"
 #include <marnav/nmea/io.hpp>
@@ -45,6 +46,35 @@ rmc::rmc(talker talk, fields::const_iterator first, fields::const_iterator last)
 	lon_ = correct_hemisphere(lon_, lon_hem_);
 }
 
+rmc::rmc(talker talk, detail::binary_fields & f)
+	: sentence(ID, TAG, talk)
+{
+	// before and after NMEA 2.3
+	const auto size = f.size();
+	if ((size < 11) || (size > 12))
+		throw std::invalid_argument{"invalid number of fields in rmc"};
+
+	f.read(time_utc_);
+	f.read(status_);
+	f.read(lat_);
+	f.read(lat_hem_);
+	f.read(lon_);
+	f.read(lon_hem_);
+	f.read(sog_);
+	f.read(heading_);
+	f.read(date_);
+	f.read(mag_);
+	f.read(mag_hem_);
+
+	// NMEA 2.3 or newer
+	if (size > 11)
+		f.read(mode_ind_);
+
+	// instead of reading data into temporary lat/lon, let's correct values afterwards
+	lat_ = correct_hemisphere(lat_, lat_hem_);
+	lon_ = correct_hemisphere(lon_, lon_hem_);
+}
+
 utils::optional<geo::longitude> rmc::get_lon() const
 {
 	return (lon_ && lon_hem_) ? lon_ : utils::optional<geo::longitude>{};
@@ -1,4 +1,5 @@
 #include <marnav/nmea/rsd.hpp>
+#include "binary_fields.hpp"
 #include <marnav/nmea/io.hpp>
 #include <stdexcept>
 
@@ -35,6 +36,27 @@ rsd::rsd(talker talk, fields::const_iterator first, fields::const_iterator last)
 	read(*(first + 12), display_rotation_);
 }
 
+rsd::rsd(talker talk, detail::binary_fields & f)
+	: sentence(ID, TAG, talk)
+{
+	if (f.size() != 13)
+		throw std::invalid_argument{"invalid number of fields in rsd"};
+
+	f.read(origin_range_1);
+	f.read(origin_bearing_1);
+	f.read(variable_range_marker_1);
+	f.read(bearing_line_1);
+	f.read(origin_range_2);
+	f.read(origin_bearing_2);
+	f.read(variable_range_marker_2);
+	f.read(bearing_line_2);
+	f.read(cursor_range_);
+	f.read(cursor_bearing_);
+	f.read(range_scale_);
+	f.read(range_unit_);
+	f.read(display_rotation_);
+}
+
 void rsd::set_cursor(double range, double bearing) noexcept
 {
 	cursor_range_ = range;
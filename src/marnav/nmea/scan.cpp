@@ -0,0 +1,255 @@
+#include "scan.hpp"
+#include "hex_digit.hpp"
+#include <marnav/nmea/checksum.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+	#define MARNAV_NMEA_SCAN_X86
+	#include <immintrin.h>
+#endif
+
+namespace marnav
+{
+namespace nmea
+{
+/// @cond DEV
+namespace detail
+{
+constexpr std::size_t scan_result::npos;
+
+namespace
+{
+static void clear_mask(uint64_t * mask, std::size_t size) noexcept
+{
+	if (mask)
+		std::fill_n(mask, scan_mask_size(size), uint64_t{0});
+}
+}
+
+/// Scans the specified characters for delimiters (`,` and `*`) and computes the
+/// checksum, in one pass.
+///
+/// The implementation is selected once at runtime, depending on the capabilities
+/// of the CPU (AVX2, SSE2, scalar).
+///
+/// @param[in] s The characters to scan, for sentences without start token.
+/// @param[in] size Number of characters.
+/// @param[out] mask Delimiter mask, bit `i % 64` of word `i / 64` is set if the
+///   character at position `i` is a delimiter. Must provide `scan_mask_size(size)`
+///   words, may be `nullptr` if only the checksum is of interest.
+/// @return The checksum and the position of the end token.
+scan_result scan(const char * s, std::size_t size, uint64_t * mask) noexcept
+{
+	static const scan_function f = scan_avx2_supported()
+		? scan_avx2
+		: (scan_sse2_supported() ? scan_sse2 : scan_scalar);
+	return f(s, size, mask);
+}
+
+/// Returns the name of the implementation used by `scan`.
+const char * scan_implementation() noexcept
+{
+	if (scan_avx2_supported())
+		return "avx2";
+	if (scan_sse2_supported())
+		return "sse2";
+	return "scalar";
+}
+
+/// Checks the checksum of a scanned sentence against the expected checksum.
+///
+/// @param[in] info The result of `scan` over the sentence, without start token.
+/// @param[in] size Number of scanned characters.
+/// @param[in] expected The expected checksum, two hex digits.
+/// @exception checksum_error Thrown if the checksum does not match.
+/// @exception std::invalid_argument The end token or the checksum is missing
+///   or malformed.
+void ensure_checksum(const scan_result & info, std::size_t size, const std::string & expected)
+{
+	if (info.end == scan_result::npos) // end token not found
+		throw std::invalid_argument{"invalid format in nmea/ensure_checksum"};
+	if (size != info.end + 3) // short or no checksum
+		throw std::invalid_argument{"invalid format in nmea/ensure_checksum"};
+	const int hi = (expected.size() == 2) ? hex_value(expected[0]) : -1;
+	const int lo = (expected.size() == 2) ? hex_value(expected[1]) : -1;
+	if ((hi < 0) || (lo < 0))
+		throw std::invalid_argument{"invalid checksum in nmea/ensure_checksum"};
+	const auto expected_checksum = static_cast<uint8_t>((hi << 4) | lo);
+	if (expected_checksum != info.sum)
+		throw checksum_error{expected_checksum, info.sum};
+}
+
+/// Portable implementation of `scan`, one character at a time.
+scan_result scan_scalar(const char * s, std::size_t size, uint64_t * mask) noexcept
+{
+	scan_result result;
+	clear_mask(mask, size);
+	for (std::size_t i = 0; i < size; ++i) {
+		const char c = s[i];
+		if ((c == ',') || (c == '*')) {
+			if (mask)
+				mask[i / 64] |= uint64_t{1} << (i % 64);
+			if ((c == '*') && (result.end == scan_result::npos))
+				result.end = i;
+		}
+		if (result.end == scan_result::npos)
+			result.sum ^= static_cast<uint8_t>(c);
+		else if (!mask)
+			break;
+	}
+	return result;
+}
+
+#if defined(MARNAV_NMEA_SCAN_X86)
+
+bool scan_sse2_supported() noexcept
+{
+	return __builtin_cpu_supports("sse2");
+}
+
+bool scan_avx2_supported() noexcept
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+/// SSE2 implementation of `scan`, 16 characters at a time. The remaining
+/// characters are copied into a zero padded block, zeros neither change the
+/// checksum nor are they delimiters.
+__attribute__((target("sse2"))) scan_result scan_sse2(
+	const char * s, std::size_t size, uint64_t * mask) noexcept
+{
+	static constexpr std::size_t width = 16;
+
+	scan_result result;
+	clear_mask(mask, size);
+
+	const __m128i comma = _mm_set1_epi8(',');
+	const __m128i star = _mm_set1_epi8('*');
+	const __m128i index
+		= _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	__m128i sum = _mm_setzero_si128();
+
+	for (std::size_t i = 0; i < size; i += width) {
+		__m128i v;
+		if (size - i >= width) {
+			v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+		} else {
+			char tail[width] = {};
+			std::memcpy(tail, s + i, size - i);
+			v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tail));
+		}
+
+		const __m128i is_star = _mm_cmpeq_epi8(v, star);
+		const auto d = static_cast<uint32_t>(
+			_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, comma), is_star)));
+		if (mask && d)
+			mask[i / 64] |= static_cast<uint64_t>(d) << (i % 64);
+
+		if (result.end == scan_result::npos) {
+			const auto stars = static_cast<uint32_t>(_mm_movemask_epi8(is_star));
+			if (stars) {
+				const auto first = __builtin_ctz(stars);
+				result.end = i + first;
+				v = _mm_and_si128(
+					v, _mm_cmplt_epi8(index, _mm_set1_epi8(static_cast<char>(first))));
+			}
+			sum = _mm_xor_si128(sum, v);
+		} else if (!mask) {
+			break;
+		}
+	}
+
+	sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 8));
+	sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 4));
+	sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 2));
+	sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 1));
+	result.sum = static_cast<uint8_t>(_mm_cvtsi128_si32(sum) & 0xff);
+	return result;
+}
+
+/// AVX2 implementation of `scan`, 32 characters at a time, otherwise the same
+/// as `scan_sse2`.
+__attribute__((target("avx2"))) scan_result scan_avx2(
+	const char * s, std::size_t size, uint64_t * mask) noexcept
+{
+	static constexpr std::size_t width = 32;
+
+	scan_result result;
+	clear_mask(mask, size);
+
+	const __m256i comma = _mm256_set1_epi8(',');
+	const __m256i star = _mm256_set1_epi8('*');
+	const __m256i index = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+		14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+	__m256i sum = _mm256_setzero_si256();
+
+	for (std::size_t i = 0; i < size; i += width) {
+		__m256i v;
+		if (size - i >= width) {
+			v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+		} else {
+			char tail[width] = {};
+			std::memcpy(tail, s + i, size - i);
+			v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail));
+		}
+
+		const __m256i is_star = _mm256_cmpeq_epi8(v, star);
+		const auto d = static_cast<uint32_t>(
+			_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, comma), is_star)));
+		if (mask && d)
+			mask[i / 64] |= static_cast<uint64_t>(d) << (i % 64);
+
+		if (result.end == scan_result::npos) {
+			const auto stars = static_cast<uint32_t>(_mm256_movemask_epi8(is_star));
+			if (stars) {
+				const auto first = __builtin_ctz(stars);
+				result.end = i + first;
+				v = _mm256_and_si256(
+					v, _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(first)), index));
+			}
+			sum = _mm256_xor_si256(sum, v);
+		} else if (!mask) {
+			break;
+		}
+	}
+
+	__m128i h = _mm_xor_si128(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	h = _mm_xor_si128(h, _mm_srli_si128(h, 8));
+	h = _mm_xor_si128(h, _mm_srli_si128(h, 4));
+	h = _mm_xor_si128(h, _mm_srli_si128(h, 2));
+	h = _mm_xor_si128(h, _mm_srli_si128(h, 1));
+	result.sum = static_cast<uint8_t>(_mm_cvtsi128_si32(h) & 0xff);
+	return result;
+}
+
+#else
+
+bool scan_sse2_supported() noexcept
+{
+	return false;
+}
+
+bool scan_avx2_supported() noexcept
+{
+	return false;
+}
+
+/// Not available on this platform, falls back to `scan_scalar`.
+scan_result scan_sse2(const char * s, std::size_t size, uint64_t * mask) noexcept
+{
+	return scan_scalar(s, size, mask);
+}
+
+/// Not available on this platform, falls back to `scan_scalar`.
+scan_result scan_avx2(const char * s, std::size_t size, uint64_t * mask) noexcept
+{
+	return scan_scalar(s, size, mask);
+}
+
+#endif
+}
+/// @endcond
+}
+}
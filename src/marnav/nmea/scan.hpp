@@ -0,0 +1,65 @@
+#ifndef MARNAV__NMEA__SCAN__HPP
+#define MARNAV__NMEA__SCAN__HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @cond DEV
+namespace detail
+{
+/// Result of scanning a sentence, see `scan`.
+struct scan_result {
+	/// XOR of all characters in front of the end token, or of all characters
+	/// if there is no end token.
+	uint8_t sum = 0u;
+
+	/// Position of the first end token (`*`), `npos` if there is none.
+	std::size_t end = npos;
+
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+};
+
+/// Returns the number of 64 bit words needed for the delimiter mask of
+/// the specified number of characters.
+inline constexpr std::size_t scan_mask_size(std::size_t size) noexcept
+{
+	return (size + 63u) / 64u;
+}
+
+/// Returns the number of trailing zero bits, `x` must not be zero.
+inline int scan_ctz(uint64_t x) noexcept
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(x);
+#else
+	int n = 0;
+	for (; !(x & 1u); x >>= 1)
+		++n;
+	return n;
+#endif
+}
+
+/// Signature of the scan kernels.
+using scan_function = scan_result (*)(const char *, std::size_t, uint64_t *);
+
+scan_result scan(const char * s, std::size_t size, uint64_t * mask) noexcept;
+scan_result scan_scalar(const char * s, std::size_t size, uint64_t * mask) noexcept;
+scan_result scan_sse2(const char * s, std::size_t size, uint64_t * mask) noexcept;
+scan_result scan_avx2(const char * s, std::size_t size, uint64_t * mask) noexcept;
+
+bool scan_sse2_supported() noexcept;
+bool scan_avx2_supported() noexcept;
+const char * scan_implementation() noexcept;
+
+void ensure_checksum(const scan_result & info, std::size_t size, const std::string & expected);
+}
+/// @endcond
+}
+}
+
+#endif
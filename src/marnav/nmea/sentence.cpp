@@ -1,6 +1,7 @@
 #include <marnav/nmea/sentence.hpp>
 #include <marnav/nmea/checksum.hpp>
 #include <algorithm>
+#include <utility>
 
 namespace marnav
 {
@@ -22,6 +23,23 @@ sentence::sentence(sentence_id id, const std::string & tag, talker t)
 {
 }
 
+/// Sets the tag block. This overwrites a possibly existent block.
+///
+/// The tag block is decoded once, its values are accessible through
+/// `get_tag_block_view`. A malformed tag block is kept, but provides no values.
+void sentence::set_tag_block(const std::string & t)
+{
+	tag_block_ = t;
+	detail::decode_tag_block(tag_block_.data(), tag_block_.size(), tag_values_);
+}
+
+/// Sets the tag block, see `set_tag_block(const std::string &)`.
+void sentence::set_tag_block(std::string && t)
+{
+	tag_block_ = std::move(t);
+	detail::decode_tag_block(tag_block_.data(), tag_block_.size(), tag_values_);
+}
+
 /// Creates a raw string from the specified sentence.
 ///
 /// If the sentence contains a tag block, it will be inserted in front
@@ -29,7 +47,7 @@ sentence::sentence(sentence_id id, const std::string & tag, talker t)
 std::string to_string(const sentence & s)
 {
 	std::string result;
-	const std::string block = s.get_tag_block();
+	const std::string & block = s.get_tag_block();
 	if (block.size() != 0u) {
 		result.reserve(sentence::max_length + block.size() + 2u);
 		result += sentence::tag_block_token;
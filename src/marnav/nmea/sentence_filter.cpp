@@ -0,0 +1,244 @@
+#include <marnav/nmea/sentence_filter.hpp>
+#include <marnav/nmea/detail.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <cstring>
+#include <stdexcept>
+
+namespace marnav
+{
+namespace nmea
+{
+constexpr std::size_t sentence_filter::symbols;
+constexpr std::size_t sentence_filter::max_ids;
+constexpr std::size_t sentence_filter::max_talkers;
+
+/// @cond DEV
+namespace
+{
+/// Returns the index of an address character, -1 if it is not valid.
+static int symbol(char c) noexcept
+{
+	if ((c >= 'A') && (c <= 'Z'))
+		return c - 'A';
+	if ((c >= '0') && (c <= '9'))
+		return c - '0' + 26;
+	return -1;
+}
+
+/// Returns the index of a sequence of address characters, -1 if invalid.
+static int symbols_index(const char * s, std::size_t n) noexcept
+{
+	int index = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		const int c = symbol(s[i]);
+		if (c < 0)
+			return -1;
+		index = index * 36 + c;
+	}
+	return index;
+}
+}
+/// @endcond
+
+/// Initializes the filter to accept only the specified sentences,
+/// of all talkers.
+sentence_filter::sentence_filter(std::initializer_list<sentence_id> ids)
+{
+	reject_all();
+	for (const auto id : ids)
+		add(id);
+}
+
+/// Adds a sentence to the filter. The first sentence added to a filter,
+/// which accepts all sentences, restricts it to the added sentence.
+///
+/// @exception unknown_sentence The sentence is not supported.
+sentence_filter & sentence_filter::add(sentence_id id)
+{
+	const auto tag = to_string(id);
+	const auto index = static_cast<std::size_t>(id);
+	if (index >= max_ids)
+		throw std::invalid_argument{"invalid sentence id in sentence_filter"};
+
+	if (all_sentences_) {
+		all_sentences_ = false;
+		ids_.reset();
+		tags_.reset();
+	}
+
+	ids_.set(index);
+	if (tag.size() == 3)
+		tags_.set(static_cast<std::size_t>(symbols_index(tag.data(), 3)));
+	return *this;
+}
+
+/// Removes a sentence from the filter. Has no effect if all sentences are accepted.
+sentence_filter & sentence_filter::remove(sentence_id id)
+{
+	if (all_sentences_)
+		return *this;
+
+	const auto index = static_cast<std::size_t>(id);
+	if (index >= max_ids)
+		return *this;
+
+	ids_.reset(index);
+	const auto tag = to_string(id);
+	if (tag.size() == 3)
+		tags_.reset(static_cast<std::size_t>(symbols_index(tag.data(), 3)));
+	return *this;
+}
+
+/// Adds a talker to the filter. The first talker added to a filter, which
+/// accepts all talkers, restricts it to the added talker.
+///
+/// @exception std::invalid_argument The talker has no two character ID.
+sentence_filter & sentence_filter::add(talker t)
+{
+	const auto id = to_string(t);
+	const auto index = static_cast<std::size_t>(t);
+	if ((id.size() != 2) || (index >= max_talkers))
+		throw std::invalid_argument{"invalid talker in sentence_filter"};
+
+	if (all_talkers_) {
+		all_talkers_ = false;
+		talker_ids_.reset();
+		talkers_.reset();
+	}
+
+	talker_ids_.set(index);
+	talkers_.set(static_cast<std::size_t>(symbols_index(id.data(), 2)));
+	return *this;
+}
+
+/// Removes a talker from the filter. Has no effect if all talkers are accepted.
+sentence_filter & sentence_filter::remove(talker t)
+{
+	if (all_talkers_)
+		return *this;
+
+	const auto id = to_string(t);
+	const auto index = static_cast<std::size_t>(t);
+	if ((id.size() != 2) || (index >= max_talkers))
+		return *this;
+
+	talker_ids_.reset(index);
+	talkers_.reset(static_cast<std::size_t>(symbols_index(id.data(), 2)));
+	return *this;
+}
+
+/// Accepts all sentences and all talkers.
+sentence_filter & sentence_filter::accept_all() noexcept
+{
+	all_sentences_ = true;
+	return accept_all_talkers();
+}
+
+/// Accepts all talkers, the selection of sentences remains.
+sentence_filter & sentence_filter::accept_all_talkers() noexcept
+{
+	all_talkers_ = true;
+	talker_ids_.reset();
+	talkers_.reset();
+	return *this;
+}
+
+/// Rejects all sentences, until sentences are added.
+sentence_filter & sentence_filter::reject_all() noexcept
+{
+	all_sentences_ = false;
+	ids_.reset();
+	tags_.reset();
+	return *this;
+}
+
+bool sentence_filter::accepts(sentence_id id) const noexcept
+{
+	if (all_sentences_)
+		return true;
+	const auto index = static_cast<std::size_t>(id);
+	return (index < max_ids) && ids_.test(index);
+}
+
+bool sentence_filter::accepts(talker t) const noexcept
+{
+	if (all_talkers_)
+		return true;
+	const auto index = static_cast<std::size_t>(t);
+	return (index < max_talkers) && talker_ids_.test(index);
+}
+
+/// Checks the address of a sentence (e.g. `GPRMC`, `PGRME`).
+///
+/// @param[in] address Start of the address, without start token.
+/// @param[in] size Size of the address.
+/// @retval true The sentence is accepted.
+/// @retval false The sentence is rejected.
+bool sentence_filter::accepts_address(const char * address, std::size_t size) const noexcept
+{
+	if (all_sentences_ && all_talkers_)
+		return true;
+
+	// supported sentences without talker (e.g. `PGRME`, `STALK`) are known
+	// by their complete address, regular ones only by their tag.
+	if (size != 3) {
+		const auto id = detail::find_sentence_id(address, size);
+		if (id != sentence_id::NONE)
+			return accepts(id);
+	}
+
+	if (size != 5)
+		return all_sentences_;
+
+	const int tag = symbols_index(address + 2, 3);
+	const int talk = symbols_index(address, 2);
+	if ((tag < 0) || (talk < 0))
+		return all_sentences_;
+
+	if (!all_sentences_ && !tags_.test(static_cast<std::size_t>(tag)))
+		return false;
+	if (!all_talkers_ && !talkers_.test(static_cast<std::size_t>(talk)))
+		return false;
+	return true;
+}
+
+/// Checks the raw sentence, optionally with tag block. Only the address is
+/// examined, neither fields nor checksum.
+///
+/// @param[in] s The raw sentence.
+/// @param[in] size Size of the raw sentence.
+/// @retval true The sentence is accepted.
+/// @retval false The sentence is rejected.
+bool sentence_filter::accepts(const char * s, std::size_t size) const noexcept
+{
+	if (all_sentences_ && all_talkers_)
+		return true;
+	if (!s || (size == 0))
+		return all_sentences_;
+
+	std::size_t i = 0;
+	if (s[0] == sentence::tag_block_token) {
+		const auto p = static_cast<const char *>(
+			std::memchr(s + 1, sentence::tag_block_token, size - 1));
+		if (!p)
+			return all_sentences_;
+		i = static_cast<std::size_t>(p - s) + 1;
+	}
+
+	if ((i >= size) || ((s[i] != sentence::start_token) && (s[i] != sentence::start_token_ais)))
+		return all_sentences_;
+
+	const std::size_t start = ++i;
+	while ((i < size) && (s[i] != sentence::field_delimiter) && (s[i] != sentence::end_token))
+		++i;
+	return accepts_address(s + start, i - start);
+}
+
+/// Convenience overload of `accepts(const char *, std::size_t)`.
+bool sentence_filter::accepts(const std::string & s) const noexcept
+{
+	return accepts(s.data(), s.size());
+}
+}
+}
@@ -19,19 +19,57 @@ namespace detail
 std::vector<std::string> parse_fields(
 	const std::string & s, const std::string::size_type start_pos)
 {
+	scan_result info;
+	return parse_fields(s, start_pos, info);
+}
+
+/// Parses the fields from the specified string, same as the function above.
+/// The delimiters are found by `scan`, which computes the checksum at the same
+/// time, the result is provided for further checks.
+///
+/// @param[in] s The string to parse.
+/// @param[in] start_pos The position witin the string to start the parsing of the
+///   fields.
+/// @param[out] info Result of the scan, starting at `start_pos`.
+/// @return Container with separate fields.
+std::vector<std::string> parse_fields(
+	const std::string & s, const std::string::size_type start_pos, scan_result & info)
+{
+	info = scan_result{};
+
 	if (s.size() < 1)
 		return std::vector<std::string>{};
+	if (start_pos >= s.size())
+		return std::vector<std::string>{s.substr(start_pos)};
+
+	// enough for sentences with tag blocks, larger ones are rare
+	static constexpr std::size_t local_mask_size = scan_mask_size(256);
+
+	const auto data = s.data() + start_pos;
+	const auto size = s.size() - start_pos;
+	const auto mask_size = scan_mask_size(size);
+
+	uint64_t local_mask[local_mask_size];
+	std::vector<uint64_t> heap_mask;
+	uint64_t * mask = local_mask;
+	if (mask_size > local_mask_size) {
+		heap_mask.resize(mask_size);
+		mask = heap_mask.data();
+	}
+
+	info = scan(data, size, mask);
 
-	static constexpr const char * DELIMITERS = ",*";
 	std::vector<std::string> result;
 	result.reserve(14); // number of fields in RMC, fairly common case
-	for (std::string::size_type p = start_pos;; ++p) {
-		const auto last = p;
-		p = s.find_first_of(DELIMITERS, last);
-		result.push_back(s.substr(last, p - last));
-		if (p == std::string::npos) // test before increment
-			break;
+	std::size_t last = 0;
+	for (std::size_t w = 0; w < mask_size; ++w) {
+		for (uint64_t bits = mask[w]; bits; bits &= bits - 1) {
+			const std::size_t p = w * 64 + static_cast<std::size_t>(scan_ctz(bits));
+			result.emplace_back(data + last, p - last);
+			last = p + 1;
+		}
 	}
+	result.emplace_back(data + last, size - last);
 	return result;
 }
 }
@@ -1,6 +1,7 @@
 #ifndef MARNAV__NMEA__SPLIT__HPP
 #define MARNAV__NMEA__SPLIT__HPP
 
+#include "scan.hpp"
 #include <string>
 #include <vector>
 
@@ -13,6 +14,9 @@ namespace detail
 {
 std::vector<std::string> parse_fields(
 	const std::string & s, const std::string::size_type start_pos = 1u);
+
+std::vector<std::string> parse_fields(
+	const std::string & s, const std::string::size_type start_pos, scan_result & info);
 }
 /// @endcond
 }
@@ -1,8 +1,8 @@
 #include <marnav/nmea/tag_block.hpp>
-#include "split.hpp"
+#include "hex_digit.hpp"
 #include <marnav/nmea/checksum.hpp>
-#include <marnav/nmea/detail.hpp>
 #include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <type_traits>
 
@@ -13,39 +13,103 @@ namespace nmea
 /// @cond DEV
 namespace
 {
-static tag_block::sentence_group extract_group(const std::string & s)
-{
-	constexpr static char DELIMITER = '-';
-
-	tag_block::sentence_group group;
+/// Maximum number of characters of texts within a tag block.
+constexpr std::size_t max_text_size = 15;
 
-	std::string::size_type first = 2;
-	std::string::size_type last = 0;
+/// Maximum size of a tag block, positions of texts are stored in 16 bits.
+constexpr std::size_t max_tag_block_size = 0xffff;
 
-	last = s.find(DELIMITER, first);
-	group.number = std::stoi(s.substr(first, last - first));
-
-	first = last + 1u;
-	last = s.find(DELIMITER, first);
-	group.total_number = std::stoi(s.substr(first, last - first));
+/// Parses an integer, optionally negative, which must fill the entire range.
+static bool parse_integer(const char * s, std::size_t n, int64_t max, int64_t & value) noexcept
+{
+	std::size_t i = 0;
+	const bool negative = (n > 0) && (s[0] == '-');
+	if (negative)
+		++i;
+	if (i == n)
+		return false;
 
-	first = last + 1u;
-	last = s.find(DELIMITER, first);
-	group.id = std::stoi(s.substr(first, last - first));
+	int64_t result = 0;
+	for (; i < n; ++i) {
+		if ((s[i] < '0') || (s[i] > '9'))
+			return false;
+		const int64_t d = s[i] - '0';
+		if (result > (max - d) / 10)
+			return false;
+		result = result * 10 + d;
+	}
+	value = negative ? -result : result;
+	return true;
+}
 
-	return group;
+static bool parse_int(const char * s, std::size_t n, int & value) noexcept
+{
+	int64_t t = 0;
+	if (!parse_integer(s, n, std::numeric_limits<int>::max(), t))
+		return false;
+	value = static_cast<int>(t);
+	return true;
 }
 
-/// Extracts a string of max size 15 characters, ignoring the first two.
-static std::string extract_string(const std::string & s)
+/// Parses a group of the form `1-2-3`.
+static bool parse_group(
+	const char * s, std::size_t n, tag_block::sentence_group & group) noexcept
 {
-	return s.substr(2, std::min(std::string::size_type{15u}, s.size() - 2u));
+	constexpr static char DELIMITER = '-';
+
+	int * values[] = {&group.number, &group.total_number, &group.id};
+	std::size_t first = 0;
+	for (std::size_t k = 0; k < 3; ++k) {
+		std::size_t last = first;
+		while ((last < n) && (s[last] != DELIMITER))
+			++last;
+		if ((last == first) || !parse_int(s + first, last - first, *values[k]))
+			return false;
+		if ((k < 2) && (last == n))
+			return false;
+		first = last + 1;
+	}
+	return first > n;
 }
 
-/// Extracts an int, ignoring the first two.
-static int extract_int(const std::string & s)
+/// Decodes the field in range `[first, last)` of the tag block.
+///
+/// It is assumed, each field has the form "x:yyy" with 'x' as the field type
+/// (1 character), a delimiter of one colon (':', 1 character), followed by the data.
+static bool decode_field(
+	const char * s, std::size_t first, std::size_t last, tag_block_values & v) noexcept
 {
-	return std::stoi(s.substr(2, std::string::npos));
+	if (last - first < 3u)
+		return true;
+
+	const char * data = s + first + 2;
+	const std::size_t n = last - first - 2;
+	tag_block_values::span text;
+	text.pos = static_cast<uint16_t>(first + 2);
+	text.size = static_cast<uint16_t>(std::min(n, max_text_size));
+
+	switch (s[first]) {
+		case 'c':
+			return parse_integer(data, n, std::numeric_limits<int64_t>::max(), v.unix_time);
+		case 'd':
+			v.destination = text;
+			return true;
+		case 'g':
+			return parse_group(data, n, v.group);
+		case 'n':
+			return parse_int(data, n, v.line_count);
+		case 'r':
+			return parse_int(data, n, v.relative_time);
+		case 's':
+			v.source = text;
+			return true;
+		case 't':
+			v.text = text;
+			return true;
+		default:
+			break;
+	}
+	return false;
 }
 }
 /// @endcond
@@ -54,51 +118,33 @@ static_assert(std::is_default_constructible<tag_block>::value, "");
 
 constexpr char tag_block::end_token;
 
+/// Parses the tag block, without start and end tokens.
+///
+/// @param[in] s The tag block, e.g. `g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A`.
+/// @exception std::invalid_argument The tag block is empty, malformed or contains
+///   unknown fields.
+/// @exception checksum_error The checksum of the tag block is wrong.
 tag_block::tag_block(const std::string & s)
 {
-	if (s.empty())
-		throw std::invalid_argument{"invalid argument in nmea/tag_block"};
-
-	const auto fields = detail::parse_fields(s, 0u);
-	if (fields.size() < 1u)
-		throw std::invalid_argument{"malformed tag block in nmea/tag_block"};
-
-	detail::ensure_checksum(s, fields.back(), 0u);
-
-	// it is assumed, each field has the form "x:yyy" with 'x' as the field type (1 character),
-	// a delimiter of one colon (':', 1 character), followed by the data.
-
-	// all fields, except the checksum
-	for (auto i = std::begin(fields); i != std::prev(std::end(fields)); ++i) {
-		const std::string & t = *i;
-		if (t.size() < 3u)
-			continue;
-		switch (t[0]) {
-			case 'c':
-				unix_time_ = std::stoll(t.substr(2, std::string::npos));
-				break;
-			case 'd':
-				destination_ = extract_string(t);
-				break;
-			case 'g':
-				group_ = extract_group(t);
-				break;
-			case 'n':
-				line_count_ = extract_int(t);
-				break;
-			case 'r':
-				relative_time_ = extract_int(t);
-				break;
-			case 's':
-				source_ = extract_string(t);
-				break;
-			case 't':
-				text_ = extract_string(t);
-				break;
-			default:
-				throw std::invalid_argument{"invalid field in nmea/tag_block"};
+	tag_block_values v;
+	switch (detail::decode_tag_block(s.data(), s.size(), v)) {
+		case detail::tag_block_status::ok:
+			break;
+		case detail::tag_block_status::empty:
+			throw std::invalid_argument{"invalid argument in nmea/tag_block"};
+		case detail::tag_block_status::invalid_field:
+			throw std::invalid_argument{"invalid field in nmea/tag_block"};
+		case detail::tag_block_status::checksum: {
+			// the decoder verified the format, the checksum follows the end token
+			const auto i = s.find(end_token);
+			const auto expected = static_cast<uint8_t>(
+				(detail::hex_value(s[i + 1]) << 4) | detail::hex_value(s[i + 2]));
+			throw checksum_error{expected, checksum(s.begin(), s.begin() + i)};
 		}
+		default:
+			throw std::invalid_argument{"malformed tag block in nmea/tag_block"};
 	}
+	*this = tag_block_view{s, v}.to_tag_block();
 }
 
 void tag_block::set_destination(const std::string & t)
@@ -116,6 +162,20 @@ void tag_block::set_text(const std::string & t)
 	text_ = (t.size() <= 15u) ? t : t.substr(0, 15);
 }
 
+/// Returns a copy of all values of the tag block.
+tag_block tag_block_view::to_tag_block() const
+{
+	tag_block result;
+	result.set_unix_time(get_unix_time());
+	result.set_line_count(get_line_count());
+	result.set_relative_time(get_relative_time());
+	result.set_group(get_group());
+	result.set_destination(get_destination().str());
+	result.set_source(get_source().str());
+	result.set_text(get_text().str());
+	return result;
+}
+
 /// Parses the specified string and returns the tag block from it.
 tag_block make_tag_block(const std::string & s)
 {
@@ -178,5 +238,57 @@ std::string to_string(const tag_block & b)
 
 	return result;
 }
+/// @cond DEV
+namespace detail
+{
+/// Decodes the tag block in a single pass, without allocating memory.
+///
+/// Fields are decoded while the checksum is calculated, texts are not copied
+/// but referenced by their position within the tag block.
+///
+/// @param[in] s The tag block, without start and end tokens.
+/// @param[in] size Number of characters.
+/// @param[out] values The decoded values, all invalid if the tag block is not `ok`.
+/// @return The result of the decoding.
+tag_block_status decode_tag_block(
+	const char * s, std::size_t size, tag_block_values & values) noexcept
+{
+	values = tag_block_values{};
+	if (!s || (size == 0))
+		return tag_block_status::empty;
+	if (size > max_tag_block_size)
+		return tag_block_status::malformed;
+
+	tag_block_values v;
+	uint8_t sum = 0;
+	std::size_t first = 0;
+	for (std::size_t i = 0; i < size; ++i) {
+		const char c = s[i];
+		if ((c != ',') && (c != tag_block::end_token)) {
+			sum ^= static_cast<uint8_t>(c);
+			continue;
+		}
+		if (!decode_field(s, first, i, v))
+			return tag_block_status::invalid_field;
+		if (c == tag_block::end_token) {
+			if (size - i != 3)
+				return tag_block_status::malformed;
+			const int hi = hex_value(s[i + 1]);
+			const int lo = hex_value(s[i + 2]);
+			if ((hi < 0) || (lo < 0))
+				return tag_block_status::malformed;
+			if (((hi << 4) | lo) != sum)
+				return tag_block_status::checksum;
+			v.valid = true;
+			values = v;
+			return tag_block_status::ok;
+		}
+		sum ^= static_cast<uint8_t>(c);
+		first = i + 1;
+	}
+	return tag_block_status::malformed;
+}
+}
+/// @endcond
 }
 }
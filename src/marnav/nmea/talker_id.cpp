@@ -1,5 +1,6 @@
 #include <marnav/nmea/talker_id.hpp>
-#include <algorithm>
+#include <marnav/nmea/detail.hpp>
+#include <array>
 #include <stdexcept>
 
 namespace marnav
@@ -80,13 +81,58 @@ static constexpr const struct entry {
 	{talker::ais_physical_shore_station,           "SA"},
 	// clang-format on
 };
+
+constexpr std::size_t num_entries = sizeof(entries) / sizeof(entries[0]);
+
+/// Returns true if the entries of the range are in the order of the enumeration,
+/// which makes the lookup of the string of a talker a simple indexing.
+static constexpr bool ordered_by_talker(std::size_t first, std::size_t last)
+{
+	return (last - first == 1)
+		? (static_cast<std::size_t>(entries[first].t) == first)
+		: (ordered_by_talker(first, first + (last - first) / 2)
+			  && ordered_by_talker(first + (last - first) / 2, last));
+}
+
+static_assert(
+	ordered_by_talker(0, num_entries), "talker entries must be in the order of talker");
+
+/// Talker IDs consist of two upper case letters.
+constexpr std::size_t num_letters = 26;
+
+using talker_table = std::array<talker, num_letters * num_letters>;
+
+/// Returns the table of all talkers, indexed by their two letters.
+///
+/// The table is built only once, at its first use.
+static const talker_table & get_talker_table()
+{
+	static const talker_table table = [] {
+		talker_table t;
+		t.fill(talker::none);
+		for (const auto & e : entries)
+			if (e.id[0] != '\0')
+				t[(e.id[0] - 'A') * num_letters + (e.id[1] - 'A')] = e.t;
+		return t;
+	}();
+	return table;
+}
+
+/// Returns the talker of the specified two characters, without allocation.
+///
+/// @return The corresponding talker or talker::none if unknown.
+talker find_talker(char a, char b) noexcept
+{
+	if ((a < 'A') || (a > 'Z') || (b < 'A') || (b > 'Z'))
+		return talker::none;
+	return get_talker_table()[(a - 'A') * num_letters + (b - 'A')];
+}
 }
 
 std::string to_string(talker t)
 {
-	auto i = std::find_if(std::begin(detail::entries), std::end(detail::entries),
-		[&](const detail::entry & e) { return t == e.t; });
-	return (i == std::end(detail::entries)) ? "-" : i->id;
+	const auto i = static_cast<std::size_t>(t);
+	return (i < detail::num_entries) ? detail::entries[i].id : "-";
 }
 
 /// Returns a talker from the specified string.
@@ -102,9 +148,7 @@ talker make_talker(const std::string & s)
 {
 	if (s.size() != 2)
 		throw std::invalid_argument{"invalid talker in make_talker: " + s};
-	auto i = std::find_if(std::begin(detail::entries), std::end(detail::entries),
-		[&](const detail::entry & e) { return s == e.id; });
-	return (i == std::end(detail::entries)) ? talker::none : i->t;
+	return detail::find_talker(s[0], s[1]);
 }
 }
 }
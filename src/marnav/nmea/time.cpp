@@ -1,4 +1,5 @@
 #include <marnav/nmea/time.hpp>
+#include "time_fields.hpp"
 #include <stdexcept>
 
 namespace marnav
@@ -11,20 +12,13 @@ namespace
 {
 template <class T> static T parse_time(const std::string & str)
 {
-	try {
-		std::size_t pos = 0;
-		double t = std::stod(str, &pos);
-		if (pos != str.size())
-			throw std::invalid_argument{"invalid format for 'double'"};
-
-		const uint32_t h = static_cast<uint32_t>(t / 10000) % 100;
-		const uint32_t m = static_cast<uint32_t>(t / 100) % 100;
-		const uint32_t s = static_cast<uint32_t>(t) % 100;
-		const uint32_t ms = static_cast<uint32_t>(t * 1000) % 1000;
-		return T{h, m, s, ms};
-	} catch (std::invalid_argument &) {
+	uint32_t h = 0;
+	uint32_t m = 0;
+	uint32_t s = 0;
+	uint32_t ms = 0;
+	if (!detail::parse_time_field(str.data(), str.size(), h, m, s, ms))
 		throw std::invalid_argument{"invalid format, 'HHMMSS[.mmm]' expected"};
-	}
+	return T{h, m, s, ms};
 }
 }
 /// @endcond
@@ -0,0 +1,91 @@
+#ifndef MARNAV__NMEA__TIME_FIELDS__HPP
+#define MARNAV__NMEA__TIME_FIELDS__HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace marnav
+{
+namespace nmea
+{
+/// @cond DEV
+namespace detail
+{
+/// Parses the digits of the range as unsigned integer.
+///
+/// @return Number of digits parsed, parsing stops at the first non-digit
+///   or after `max_digits`.
+inline std::size_t parse_digits(
+	const char * s, std::size_t n, std::size_t max_digits, uint32_t & value) noexcept
+{
+	uint32_t result = 0;
+	std::size_t i = 0;
+	for (; (i < n) && (i < max_digits) && (s[i] >= '0') && (s[i] <= '9'); ++i)
+		result = result * 10 + static_cast<uint32_t>(s[i] - '0');
+	value = result;
+	return i;
+}
+
+/// Parses a time field of the form `HHMMSS[.mmm]` without any conversions
+/// to floating point or copies of strings. Leading zeros may be omitted,
+/// fractions of seconds may have any number of digits, digits beyond
+/// milliseconds are ignored.
+///
+/// The components are not checked for their ranges.
+///
+/// @param[in] s The field.
+/// @param[in] n Number of characters.
+/// @param[out] h Hours.
+/// @param[out] m Minutes.
+/// @param[out] sec Seconds.
+/// @param[out] ms Milliseconds.
+/// @retval true Success.
+/// @retval false The field is malformed.
+inline bool parse_time_field(const char * s, std::size_t n, uint32_t & h, uint32_t & m,
+	uint32_t & sec, uint32_t & ms) noexcept
+{
+	uint32_t t = 0;
+	std::size_t i = parse_digits(s, n, 6, t);
+	if (i == 0)
+		return false;
+
+	uint32_t frac = 0;
+	if ((i < n) && (s[i] == '.')) {
+		++i;
+		const auto k = parse_digits(s + i, n - i, 3, frac);
+		for (std::size_t j = k; j < 3; ++j)
+			frac *= 10;
+		i += k;
+		while ((i < n) && (s[i] >= '0') && (s[i] <= '9'))
+			++i;
+	}
+	if (i != n)
+		return false;
+
+	h = t / 10000;
+	m = (t / 100) % 100;
+	sec = t % 100;
+	ms = frac;
+	return true;
+}
+
+/// Parses a date field of the form `DDMMYY`, leading zeros may be omitted.
+///
+/// The components are not checked for their ranges.
+///
+/// @param[in] s The field.
+/// @param[in] n Number of characters.
+/// @param[out] value The date as number `DDMMYY`.
+/// @retval true Success.
+/// @retval false The field is malformed.
+inline bool parse_date_field(const char * s, std::size_t n, uint32_t & value) noexcept
+{
+	const auto i = parse_digits(s, n, 6, value);
+	return (i > 0) && (i == n);
+}
+}
+/// @endcond
+}
+}
+
+#endif
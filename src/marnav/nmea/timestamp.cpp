@@ -0,0 +1,134 @@
+#include <marnav/nmea/timestamp.hpp>
+#include "time_fields.hpp"
+
+namespace marnav
+{
+namespace nmea
+{
+/// @cond DEV
+namespace
+{
+constexpr int64_t ms_per_day = 86400000;
+
+static int64_t ms_of_day(uint32_t h, uint32_t m, uint32_t s, uint32_t ms) noexcept
+{
+	return ((static_cast<int64_t>(h) * 60 + m) * 60 + s) * 1000 + ms;
+}
+
+static bool is_valid_date(uint32_t year, uint32_t mon, uint32_t day) noexcept
+{
+	static constexpr uint32_t days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	if ((mon < 1) || (mon > 12) || (day < 1))
+		return false;
+	if ((mon == 2) && date::is_leap_year(year))
+		return day <= 29;
+	return day <= days[mon - 1];
+}
+}
+/// @endcond
+
+/// Returns the year with century. Years of two digits (as in `DDMMYY` fields)
+/// are interpreted as 1970..2069, all others are returned unchanged.
+uint32_t full_year(uint32_t year) noexcept
+{
+	if (year >= 100)
+		return year;
+	return (year >= 70) ? 1900 + year : 2000 + year;
+}
+
+/// Returns the number of days since the epoch (1970-01-01) of the specified
+/// date of the gregorian calendar.
+///
+/// @param[in] year The year, with century.
+/// @param[in] mon The month, 1..12.
+/// @param[in] day The day of the month, 1..31.
+/// @return Number of days, negative for dates before the epoch.
+int64_t days_since_epoch(uint32_t year, uint32_t mon, uint32_t day) noexcept
+{
+	// see http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+	const int64_t y = static_cast<int64_t>(year) - ((mon <= 2) ? 1 : 0);
+	const int64_t era = ((y >= 0) ? y : y - 399) / 400;
+	const int64_t yoe = y - era * 400;
+	const int64_t m = mon;
+	const int64_t doy = (153 * (m + ((m > 2) ? -3 : 9)) + 2) / 5 + day - 1;
+	const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + doe - 719468;
+}
+
+/// Returns the time stamp of the date and time. This is equivalent to
+/// `timestamp_converter::convert`, without keeping the midnight.
+timestamp to_timestamp(const date & d, const time & t) noexcept
+{
+	const auto days = days_since_epoch(full_year(d.year()), to_numeric(d.mon()), d.day());
+	return timestamp{std::chrono::milliseconds{days * ms_per_day
+		+ ms_of_day(t.hour(), t.minutes(), t.seconds(), t.milliseconds())}};
+}
+
+int64_t timestamp_converter::midnight(uint32_t year, uint32_t mon, uint32_t day) noexcept
+{
+	const uint32_t key = year * 10000 + mon * 100 + day;
+	if (key != key_) {
+		key_ = key;
+		field_ = 0;
+		midnight_ = days_since_epoch(year, mon, day) * ms_per_day;
+	}
+	return midnight_;
+}
+
+/// Returns the time stamp of the date and time.
+timestamp timestamp_converter::convert(const date & d, const time & t) noexcept
+{
+	const auto m = midnight(full_year(d.year()), to_numeric(d.mon()), d.day());
+	return timestamp{std::chrono::milliseconds{
+		m + ms_of_day(t.hour(), t.minutes(), t.seconds(), t.milliseconds())}};
+}
+
+/// Converts the raw fields of date and time directly, without constructing
+/// `date` and `time` objects.
+///
+/// @param[in] date_field The date, `DDMMYY`.
+/// @param[in] date_size Number of characters of the date.
+/// @param[in] time_field The time, `HHMMSS[.mmm]`.
+/// @param[in] time_size Number of characters of the time.
+/// @param[out] result The time stamp, unchanged on failure.
+/// @retval true Success.
+/// @retval false Date or time are malformed or invalid.
+bool timestamp_converter::convert(const char * date_field, std::size_t date_size,
+	const char * time_field, std::size_t time_size, timestamp & result) noexcept
+{
+	uint32_t h = 0;
+	uint32_t m = 0;
+	uint32_t s = 0;
+	uint32_t ms = 0;
+	if (!detail::parse_time_field(time_field, time_size, h, m, s, ms))
+		return false;
+	if ((h > 23) || (m > 59) || (s > 59))
+		return false;
+
+	uint32_t field = 0;
+	if (!detail::parse_date_field(date_field, date_size, field))
+		return false;
+	if ((field == 0) || (field != field_)) {
+		const uint32_t day = field / 10000;
+		const uint32_t mon = (field / 100) % 100;
+		const uint32_t year = full_year(field % 100);
+		if (!is_valid_date(year, mon, day))
+			return false;
+		midnight(year, mon, day);
+		field_ = field;
+	}
+
+	result = timestamp{std::chrono::milliseconds{midnight_ + ms_of_day(h, m, s, ms)}};
+	return true;
+}
+
+/// Converts the raw fields of date and time, see
+/// `convert(const char *, std::size_t, const char *, std::size_t, timestamp &)`.
+bool timestamp_converter::convert(const std::string & date_field,
+	const std::string & time_field, timestamp & result) noexcept
+{
+	return convert(
+		date_field.data(), date_field.size(), time_field.data(), time_field.size(), result);
+}
+}
+}
@@ -1,4 +1,5 @@
 #include <marnav/nmea/vlw.hpp>
+#include "binary_fields.hpp"
 #include <marnav/nmea/io.hpp>
 #include "checks.hpp"
 
@@ -32,6 +33,24 @@ vlw::vlw(talker talk, fields::const_iterator first, fields::const_iterator last)
 	check_value(distance_reset_unit, {unit::distance::nm}, "distance_reset_unit");
 }
 
+vlw::vlw(talker talk, detail::binary_fields & f)
+	: sentence(ID, TAG, talk)
+{
+	if (f.size() != 4)
+		throw std::invalid_argument{"invalid number of fields in vlw"};
+
+	utils::optional<unit::distance> distance_cum_unit;
+	utils::optional<unit::distance> distance_reset_unit;
+
+	f.read(distance_cum_);
+	f.read(distance_cum_unit);
+	f.read(distance_reset_);
+	f.read(distance_reset_unit);
+
+	check_value(distance_cum_unit, {unit::distance::nm}, "distance_cum_unit");
+	check_value(distance_reset_unit, {unit::distance::nm}, "distance_reset_unit");
+}
+
 void vlw::set_distance_cum_nm(units::length t) noexcept
 {
 	distance_cum_ = t.get<units::nautical_miles>();
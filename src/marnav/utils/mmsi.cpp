@@ -30,10 +30,16 @@ mmsi::value_type mmsi::mid() const
 		return coastal_mid();
 	if (is_auxiliary())
 		return auxiliary_mid();
+	if (is_ais_aids())
+		return ais_aids_mid();
 	if (is_sar_aircraft())
 		return sar_mid();
+	if (is_sart())
+		return sart_mid();
 	if (is_mob())
 		return mob_mid();
+	if (is_epirb_ais())
+		return epirb_mid();
 	return initial_value;
 }
 
@@ -93,6 +99,20 @@ mmsi::value_type mmsi::auxiliary_id() const
 	return value_ % 10000;
 }
 
+mmsi::value_type mmsi::ais_aids_mid() const
+{
+	if (!is_ais_aids())
+		return initial_value;
+	return (value_ / 10000) % 1000;
+}
+
+mmsi::value_type mmsi::ais_aids_id() const
+{
+	if (!is_ais_aids())
+		return initial_value;
+	return value_ % 10000;
+}
+
 mmsi::value_type mmsi::mob_mid() const
 {
 	if (!is_mob())
@@ -114,6 +134,34 @@ mmsi::value_type mmsi::sar_mid() const
 	return (value_ / 1000) % 1000;
 }
 
+mmsi::value_type mmsi::sart_mid() const
+{
+	if (!is_sart())
+		return initial_value;
+	return (value_ / 1000) % 1000;
+}
+
+mmsi::value_type mmsi::sart_id() const
+{
+	if (!is_sart())
+		return initial_value;
+	return value_ % 1000;
+}
+
+mmsi::value_type mmsi::epirb_mid() const
+{
+	if (!is_epirb_ais())
+		return initial_value;
+	return (value_ / 1000) % 1000;
+}
+
+mmsi::value_type mmsi::epirb_id() const
+{
+	if (!is_epirb_ais())
+		return initial_value;
+	return value_ % 1000;
+}
+
 /// True if MIDxxxxxx
 bool mmsi::is_regular() const
 {
@@ -1,16 +1,21 @@
 #include <marnav/utils/mmsi_country.hpp>
 #include <marnav/utils/mmsi.hpp>
-#include <algorithm>
-#include <vector>
 
 namespace marnav
 {
 namespace utils
 {
+/// @cond DEV
 namespace
 {
+struct entry {
+	uint32_t mid;
+	const char * code;
+	const char * name;
+};
+
 // clang-format off
-static const std::vector<mmsi_country_info> country_list = {
+static constexpr entry country_list[] = {
 	{ 201, "AL", "Albania" },
 	{ 202, "AD", "Andorra" },
 	{ 203, "AT", "Austria" },
@@ -304,23 +309,192 @@ static const std::vector<mmsi_country_info> country_list = {
 	{ 775, "VE", "Venezuela" },
 };
 // clang-format on
+
+constexpr std::size_t num_countries = sizeof(country_list) / sizeof(country_list[0]);
+
+/// Number of MIDs, they consist of three digits.
+constexpr std::size_t num_mids = 1000;
+
+/// Slot of MIDs without a country.
+constexpr uint16_t no_country = 0xffff;
+
+/// Returns true if the entries of the range are strictly ordered by their MIDs.
+static constexpr bool ordered_by_mid(std::size_t first, std::size_t last)
+{
+	return (last - first < 2)
+		? true
+		: ((country_list[first + (last - first) / 2 - 1].mid
+			   < country_list[first + (last - first) / 2].mid)
+			  && ordered_by_mid(first, first + (last - first) / 2)
+			  && ordered_by_mid(first + (last - first) / 2, last));
+}
+
+static_assert(ordered_by_mid(0, num_countries), "country_list must be ordered by MID");
+static_assert(num_countries < no_country, "too many countries");
+
+/// Returns the index of the country of the MID, binary search within the range.
+static constexpr uint16_t find_slot(std::size_t mid, std::size_t first, std::size_t last)
+{
+	return (first >= last)
+		? no_country
+		: (country_list[first + (last - first) / 2].mid == mid)
+			? static_cast<uint16_t>(first + (last - first) / 2)
+			: (country_list[first + (last - first) / 2].mid < mid)
+				? find_slot(mid, first + (last - first) / 2 + 1, last)
+				: find_slot(mid, first, first + (last - first) / 2);
+}
+
+template <std::size_t... Is> struct index_list {
+};
+
+template <class A, class B> struct concat_index_list;
+
+template <std::size_t... A, std::size_t... B>
+struct concat_index_list<index_list<A...>, index_list<B...>> {
+	using type = index_list<A..., (sizeof...(A) + B)...>;
+};
+
+/// Creates `index_list<0, ..., N-1>`, with a recursion depth of `log2(N)`.
+template <std::size_t N> struct make_index_list {
+	using type = typename concat_index_list<typename make_index_list<N / 2>::type,
+		typename make_index_list<N - N / 2>::type>::type;
+};
+
+template <> struct make_index_list<0> {
+	using type = index_list<>;
+};
+
+template <> struct make_index_list<1> {
+	using type = index_list<0>;
+};
+
+/// Index into `country_list` for every MID.
+struct mid_table {
+	uint16_t slot[num_mids];
+};
+
+template <std::size_t... Is> static constexpr mid_table make_mid_table(index_list<Is...>)
+{
+	return mid_table{{find_slot(Is, 0, num_countries)...}};
+}
+
+/// The table is generated at compile time from `country_list`.
+static constexpr mid_table mid_slots = make_mid_table(make_index_list<num_mids>::type{});
+
+/// Returns the information of all countries, in the order of `country_list`.
+///
+/// The information is built at the first use, not during static initialization,
+/// therefore it is available to static initializers of other translation units.
+static const std::vector<mmsi_country_info> & country_infos()
+{
+	static const std::vector<mmsi_country_info> infos = [] {
+		std::vector<mmsi_country_info> result;
+		result.reserve(num_countries);
+		for (const auto & e : country_list)
+			result.push_back({e.mid, e.code, e.name});
+		return result;
+	}();
+	return infos;
+}
+
+static mmsi_classification classify(mmsi::value_type v) noexcept
+{
+	mmsi_classification result{mmsi_type::unknown, mmsi::initial_value, nullptr};
+
+	const mmsi::value_type p3 = (v / 1000000) % 1000;
+	const mmsi::value_type p2 = v / 10000000;
+	if ((p3 >= 200) && (p3 < 900)) {
+		result.type = mmsi_type::regular;
+		result.mid = p3;
+	} else if ((v / 100000000 == 0) && ((v / 100000) % 1000 >= 100)) {
+		result.type = mmsi_type::group;
+		result.mid = (v / 100000) % 1000;
+	} else if (p2 == 0) {
+		result.type = mmsi_type::coastal;
+		result.mid = (v / 10000) % 1000;
+	} else if (p2 == 98) {
+		result.type = mmsi_type::auxiliary;
+		result.mid = (v / 10000) % 1000;
+	} else if (p2 == 99) {
+		result.type = mmsi_type::ais_aids;
+		result.mid = (v / 10000) % 1000;
+	} else if (p3 == 111) {
+		result.type = mmsi_type::sar_aircraft;
+		result.mid = (v / 1000) % 1000;
+	} else if (p3 == 970) {
+		result.type = mmsi_type::sart;
+		result.mid = (v / 1000) % 1000;
+	} else if (p3 == 972) {
+		result.type = mmsi_type::mob;
+		result.mid = (v / 1000) % 1000;
+	} else if (p3 == 974) {
+		result.type = mmsi_type::epirb_ais;
+		result.mid = (v / 1000) % 1000;
+	}
+
+	const auto slot = mid_slots.slot[result.mid];
+	if (slot != no_country)
+		result.country = &country_infos()[slot];
+	return result;
+}
+}
+/// @endcond
+
+/// Returns country information for the specified MID.
+///
+/// @param[in] mid The MID.
+/// @return The country, `nullptr` if the MID is not assigned to a country.
+const mmsi_country_info * find_mmsi_country(uint32_t mid) noexcept
+{
+	if (mid >= num_mids)
+		return nullptr;
+	const auto slot = mid_slots.slot[mid];
+	return (slot == no_country) ? nullptr : &country_infos()[slot];
 }
 
 /// Returns country information for the specified MMSI.
 ///
+/// Only regular MMSI and the ones of SAR aircrafts are considered, use
+/// `classify_mmsi` for all others.
+///
 /// If unknown, strings will be empty.
 mmsi_country_info mmsi_country(const mmsi & m)
 {
-	const auto i = std::find_if(
-		std::begin(country_list), std::end(country_list), [m](const mmsi_country_info & info) {
-			return (m.is_regular() && m.regular_mid() == info.mid)
-				|| (m.is_sar_aircraft() && m.sar_mid() == info.mid);
-		});
-
-	if (i == std::end(country_list))
+	const auto mid = m.is_regular()
+		? m.regular_mid()
+		: (m.is_sar_aircraft() ? m.sar_mid() : mmsi::initial_value);
+	const auto info = find_mmsi_country(mid);
+	if (!info)
 		return {mmsi::initial_value, "", ""};
+	return *info;
+}
+
+/// Returns the type, MID and country of the specified MMSI.
+mmsi_classification classify_mmsi(const mmsi & m) noexcept
+{
+	return classify(m);
+}
 
-	return *i;
+/// Classifies all MMSI of the specified array in one pass.
+///
+/// The type is determined in the same order as `mmsi::mid`, the country
+/// is derived from the MID of all types, e.g. coast stations and AIS AtoN.
+///
+/// @param[in] m The MMSIs to classify.
+/// @param[in] n Number of MMSIs.
+/// @param[out] result Array of at least `n` elements, receives the classifications.
+void classify_mmsi(const mmsi * m, std::size_t n, mmsi_classification * result) noexcept
+{
+	for (std::size_t i = 0; i < n; ++i)
+		result[i] = classify(m[i]);
+}
+
+/// Classifies all MMSI of the specified container in one pass.
+std::vector<mmsi_classification> classify_mmsi(const std::vector<mmsi> & m)
+{
+	std::vector<mmsi_classification> result(m.size());
+	classify_mmsi(m.data(), m.size(), result.data());
+	return result;
 }
 }
 }
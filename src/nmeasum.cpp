@@ -1,19 +1,568 @@
+// Statistics of logged NMEA and AIS data.
+//
+// The files are mapped into memory and split into chunks, which are
+// processed in parallel. Sentences are only validated (address and
+// checksum), AIS messages are not decoded except the message type and
+// the MMSI. Memory usage is bounded and independent of the size of the
+// files, the number of tracked MMSIs is limited (option --max-mmsi).
+//
+// Reported are:
+// - sentences per ID and talker
+// - invalid sentences, per kind of error, and the rate of checksum errors
+// - AIS messages per type, MMSIs per type and the most frequent MMSIs
+// - time coverage of tag blocks (`c:` UNIX time), and gaps
+//
+// Usage, statistics of log files:
+//
+//   nmeasum log-1.txt log-2.txt
+//
+// Usage, statistics with 4 threads, gaps of more than 5 minutes:
+//
+//   nmeasum -j 4 -g 300 log.txt
+//
+// Usage, checksum of a sentence (without start/end token):
+//
+//   nmeasum -c "GPRMC,201126,A,4702.3944,N,00818.3381,E,0.0,328.4,260807,0.6,E,A"
+//
+
+#include <marnav/ais/ais.hpp>
+#include <marnav/io/mapped_file.hpp>
 #include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/tag_block.hpp>
+#include <marnav/nmea/talker_id.hpp>
+#include <marnav/utils/mmsi.hpp>
+#include <marnav/utils/mmsi_country.hpp>
+
+#include <cxxopts.hpp>
+
+#include <fmt/format.h>
+#include <fmt/printf.h>
+
 #include <algorithm>
-#include <cstdio>
-#include <cstdlib>
-#include <cstdint>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <cstring>
+#include <ctime>
+
+namespace nmeasum
+{
+static struct {
+	struct {
+		std::string checksum;
+		std::vector<std::string> files;
+		unsigned int jobs = 0;
+		int64_t gap = 60;
+		std::size_t top = 20;
+		std::size_t max_mmsi = 100000;
+	} config;
+} global;
+
+static bool parse_options(int argc, char ** argv)
+{
+	// clang-format off
+	cxxopts::Options options{argv[0], "NMEA Statistics"};
+	options.positional_help("file [file ...]");
+	options.add_options()
+		("h,help",
+			"Shows help information.")
+		("c,checksum",
+			"Prints the checksum of the sentence (without start/end token) and exits.",
+			cxxopts::value<std::string>(global.config.checksum))
+		("j,jobs",
+			"Number of threads, default: number of processors.",
+			cxxopts::value<unsigned int>(global.config.jobs))
+		("g,gap",
+			"Minimum gap of time stamps in seconds, default: 60.",
+			cxxopts::value<int64_t>(global.config.gap))
+		("t,top",
+			"Number of most frequent MMSIs to show, default: 20.",
+			cxxopts::value<std::size_t>(global.config.top))
+		("max-mmsi",
+			"Maximum number of distinct MMSIs tracked per thread, default: 100000.",
+			cxxopts::value<std::size_t>(global.config.max_mmsi))
+		("files",
+			"Files to process.",
+			cxxopts::value<std::vector<std::string>>(global.config.files))
+		;
+	// clang-format on
+
+	options.parse_positional({"files"});
+	const auto args = options.parse(argc, argv);
+
+	if (args.count("help")) {
+		fmt::printf("%s\n", options.help());
+		return true;
+	}
+
+	// validation
+
+	if (!args.count("checksum") && global.config.files.empty())
+		throw std::runtime_error{"no files specified"};
+	if (global.config.gap < 1)
+		throw std::runtime_error{"invalid gap"};
+
+	if (global.config.jobs == 0)
+		global.config.jobs = std::max(1u, std::thread::hardware_concurrency());
+
+	return false;
+}
+
+/// Part of a file, consisting of complete lines.
+struct chunk {
+	const char * data;
+	std::size_t size;
+};
+
+static constexpr std::size_t chunk_size = 64 * 1024 * 1024;
+
+/// Splits the data into chunks of about `chunk_size` bytes, at line boundaries.
+static void split(const char * data, std::size_t size, std::vector<chunk> & chunks)
+{
+	std::size_t ofs = 0;
+	while (ofs < size) {
+		std::size_t end = std::min(ofs + chunk_size, size);
+		if (end < size) {
+			const auto p = static_cast<const char *>(std::memchr(data + end, '\n', size - end));
+			end = p ? static_cast<std::size_t>(p - data) + 1 : size;
+		}
+		chunks.push_back({data + ofs, end - ofs});
+		ofs = end;
+	}
+}
+
+namespace
+{
+static constexpr std::size_t num_validations
+	= static_cast<std::size_t>(marnav::nmea::validation::checksum) + 1;
+static constexpr std::size_t num_ids
+	= static_cast<std::size_t>(marnav::nmea::sentence_id::STALK) + 1;
+static constexpr std::size_t num_talkers
+	= static_cast<std::size_t>(marnav::nmea::talker::ais_physical_shore_station) + 1;
+static constexpr std::size_t num_ais_types = 64;
+static constexpr std::size_t num_mmsi_types
+	= static_cast<std::size_t>(marnav::utils::mmsi_type::epirb_ais) + 1;
+}
+
+/// Counters of one thread, merged after processing all chunks.
+struct counters {
+	uint64_t lines = 0;
+	uint64_t bytes = 0;
+	std::array<uint64_t, num_validations> status = {{}};
+	std::vector<uint64_t> sentences = std::vector<uint64_t>(num_ids * num_talkers, 0);
+	uint64_t fragments = 0;
+	std::array<uint64_t, num_ais_types> ais_types = {{}};
+	std::array<uint64_t, num_mmsi_types> mmsi_types = {{}};
+	std::unordered_map<uint32_t, uint64_t> mmsi;
+	uint64_t untracked = 0; ///< Messages of MMSIs not tracked, because of the limit.
+
+	void count_mmsi(uint32_t m, uint64_t n = 1)
+	{
+		auto i = mmsi.find(m);
+		if (i != mmsi.end()) {
+			i->second += n;
+		} else if (mmsi.size() < global.config.max_mmsi) {
+			mmsi.emplace(m, n);
+		} else {
+			untracked += n;
+		}
+	}
+
+	void merge(const counters & other)
+	{
+		lines += other.lines;
+		bytes += other.bytes;
+		for (std::size_t i = 0; i < status.size(); ++i)
+			status[i] += other.status[i];
+		for (std::size_t i = 0; i < sentences.size(); ++i)
+			sentences[i] += other.sentences[i];
+		fragments += other.fragments;
+		for (std::size_t i = 0; i < ais_types.size(); ++i)
+			ais_types[i] += other.ais_types[i];
+		for (std::size_t i = 0; i < mmsi_types.size(); ++i)
+			mmsi_types[i] += other.mmsi_types[i];
+		for (const auto & m : other.mmsi)
+			count_mmsi(m.first, m.second);
+		untracked += other.untracked;
+	}
+};
+
+/// Coverage of time, by the UNIX time of tag blocks, in seconds.
+struct coverage {
+	uint64_t stamped = 0; ///< Number of lines with time.
+	int64_t first = 0;
+	int64_t last = 0;
+	int64_t min = 0;
+	int64_t max = 0;
+	uint64_t gaps = 0;
+	int64_t gap_time = 0;
+	int64_t largest_gap = 0;
+	int64_t largest_gap_begin = 0;
+	uint64_t reversals = 0; ///< Number of time stamps earlier than their predecessors.
+
+	void add(int64_t t)
+	{
+		if (stamped++ == 0) {
+			first = last = min = max = t;
+			return;
+		}
+		step(t);
+		min = std::min(min, t);
+		max = std::max(max, t);
+	}
+
+	/// Merges the coverage of the chunk following this one.
+	void merge(const coverage & next)
+	{
+		if (next.stamped == 0)
+			return;
+		if (stamped == 0) {
+			*this = next;
+			return;
+		}
+		step(next.first);
+		stamped += next.stamped;
+		last = next.last;
+		min = std::min(min, next.min);
+		max = std::max(max, next.max);
+		gaps += next.gaps;
+		gap_time += next.gap_time;
+		reversals += next.reversals;
+		if (next.largest_gap > largest_gap) {
+			largest_gap = next.largest_gap;
+			largest_gap_begin = next.largest_gap_begin;
+		}
+	}
+
+private:
+	void step(int64_t t)
+	{
+		const auto d = t - last;
+		if (d < 0) {
+			++reversals;
+		} else if (d > global.config.gap) {
+			++gaps;
+			gap_time += d;
+			if (d > largest_gap) {
+				largest_gap = d;
+				largest_gap_begin = last;
+			}
+		}
+		last = t;
+	}
+};
+
+/// Counts the AIS message type and MMSI, decoded directly from the
+/// payload of the first fragment.
+///
+/// @param[in] p Begin of the fields, after the address.
+/// @param[in] end End of the fields, position of the end token.
+static void process_ais(const char * p, const char * end, counters & c)
+{
+	using marnav::ais::decode_armoring;
+
+	// fields: number of fragments, fragment, sequence, channel, payload, fill bits
+	std::array<const char *, 6> field;
+	std::size_t n = 0;
+	for (; (p < end) && (n < field.size()); ++p)
+		if (*p == ',')
+			field[n++] = p + 1;
+	if (n < field.size())
+		return;
+
+	++c.fragments;
+	if ((field[1][0] != '1') || (field[1][1] != ','))
+		return;
+
+	const char * payload = field[4];
+	const auto size = static_cast<std::size_t>(field[5] - 1 - payload);
+	if (size == 0)
+		return;
+	++c.ais_types[decode_armoring(payload[0])];
+
+	// message type (6 bits), repeat indicator (2 bits), MMSI (30 bits)
+	if (size < 7)
+		return;
+	uint64_t bits = 0;
+	for (std::size_t i = 0; i < 7; ++i)
+		bits = (bits << 6) | decode_armoring(payload[i]);
+	const auto m = static_cast<uint32_t>((bits >> 4) & 0x3fffffff);
+
+	const auto k = marnav::utils::classify_mmsi(marnav::utils::mmsi{m});
+	++c.mmsi_types[static_cast<std::size_t>(k.type)];
+	c.count_mmsi(m);
+}
+
+/// Time stamps of more than 11 digits are considered milliseconds.
+static int64_t to_seconds(int64_t t) noexcept
+{
+	return (t > 99999999999) ? t / 1000 : t;
+}
+
+static void process_line(const char * s, std::size_t n, counters & c, coverage & t)
+{
+	using namespace marnav;
+
+	++c.lines;
+	const auto r = nmea::validate_sentence(s, n);
+	++c.status[static_cast<std::size_t>(r.status)];
+
+	if ((s[0] == nmea::sentence::tag_block_token) && (r.status != nmea::validation::tag_block)) {
+		const auto e = static_cast<const char *>(std::memchr(s + 1, s[0], n - 1));
+		nmea::tag_block_values values;
+		if (e
+			&& (nmea::detail::decode_tag_block(s + 1, static_cast<std::size_t>(e - s - 1), values)
+				== nmea::detail::tag_block_status::ok)
+			&& (values.unix_time > 0))
+			t.add(to_seconds(values.unix_time));
+	}
+
+	if (!r)
+		return;
+
+	++c.sentences[static_cast<std::size_t>(r.id) * num_talkers
+		+ static_cast<std::size_t>(r.talk)];
+
+	if ((r.id == nmea::sentence_id::VDM) || (r.id == nmea::sentence_id::VDO))
+		process_ais(s + r.address + r.address_size, s + n - 3, c);
+}
+
+static void process_chunk(const chunk & k, counters & c, coverage & t)
+{
+	const char * p = k.data;
+	const char * end = k.data + k.size;
+	c.bytes += k.size;
+	while (p < end) {
+		auto e = static_cast<const char *>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+		if (!e)
+			e = end;
+		auto n = static_cast<std::size_t>(e - p);
+		if ((n > 0) && (p[n - 1] == '\r'))
+			--n;
+		if ((n > 0) && (p[0] != '#'))
+			process_line(p, n, c, t);
+		p = e + 1;
+	}
+}
+
+static std::string percent(uint64_t a, uint64_t b)
+{
+	return (b > 0)
+		? fmt::sprintf("%.3f %%", 100.0 * static_cast<double>(a) / static_cast<double>(b))
+		: std::string{"-"};
+}
+
+static std::string render_time(int64_t t)
+{
+	const auto tt = static_cast<std::time_t>(t);
+	std::tm tm;
+	if (!::gmtime_r(&tt, &tm))
+		return std::to_string(t);
+	char buf[32];
+	std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &tm);
+	return buf;
+}
+
+static std::string render_id(std::size_t id)
+{
+	if (id == 0)
+		return "unknown";
+	try {
+		return marnav::nmea::to_string(static_cast<marnav::nmea::sentence_id>(id));
+	} catch (std::exception &) {
+		return "unknown";
+	}
+}
+
+static void print(const std::string & name, const std::string & value)
+{
+	fmt::printf("\t%-30s : %s\n", name, value);
+}
+
+static void print(const std::string & title)
+{
+	fmt::printf("%s\n", title);
+}
+
+static void print_summary(const counters & c, std::chrono::duration<double> dt)
+{
+	using marnav::nmea::validation;
+
+	static const char * const status_names[num_validations] = {"ok", "empty",
+		"start token", "tag block", "address", "field count", "character",
+		"checksum format", "checksum"};
+
+	const auto ok = c.status[static_cast<std::size_t>(validation::ok)];
+	const auto s = dt.count();
+
+	print("Summary");
+	print("Files", std::to_string(global.config.files.size()));
+	print("Bytes", std::to_string(c.bytes));
+	print("Lines", std::to_string(c.lines));
+	print("Valid", fmt::sprintf("%u (%s)", ok, percent(ok, c.lines)));
+	for (std::size_t i = 1; i < num_validations; ++i)
+		if (c.status[i] > 0)
+			print(fmt::sprintf("Invalid: %s", status_names[i]),
+				fmt::sprintf("%u (%s)", c.status[i], percent(c.status[i], c.lines)));
+	print("Checksum Error Rate",
+		percent(c.status[static_cast<std::size_t>(validation::checksum)], c.lines));
+	print("Time", fmt::sprintf("%.3f s", s));
+	if (s > 0.0)
+		print("Throughput",
+			fmt::sprintf("%.1f MB/s, %.0f lines/s", static_cast<double>(c.bytes) / s * 1.0e-6,
+				static_cast<double>(c.lines) / s));
+	fmt::printf("\n");
+}
+
+static void print_sentences(const counters & c)
+{
+	std::vector<std::size_t> index;
+	for (std::size_t i = 0; i < c.sentences.size(); ++i)
+		if (c.sentences[i] > 0)
+			index.push_back(i);
+	std::sort(index.begin(), index.end(), [&c](std::size_t a, std::size_t b) {
+		return c.sentences[a] > c.sentences[b];
+	});
+
+	print("Sentences (ID x Talker)");
+	for (const auto i : index) {
+		const auto talk = static_cast<marnav::nmea::talker>(i % num_talkers);
+		const auto t = (talk == marnav::nmea::talker::none) ? std::string{"-"}
+															: marnav::nmea::to_string(talk);
+		print(fmt::sprintf("%-8s %s", render_id(i / num_talkers), t),
+			std::to_string(c.sentences[i]));
+	}
+	fmt::printf("\n");
+}
+
+static void print_ais(const counters & c)
+{
+	static const char * const mmsi_type_names[num_mmsi_types] = {"unknown", "regular",
+		"group", "coastal", "auxiliary", "ais aids", "sar aircraft", "sart", "mob",
+		"epirb ais"};
+
+	print("AIS");
+	print("Fragments", std::to_string(c.fragments));
+	for (std::size_t i = 0; i < num_ais_types; ++i)
+		if (c.ais_types[i] > 0)
+			print(fmt::sprintf("Message Type %u", i), std::to_string(c.ais_types[i]));
+	fmt::printf("\n");
+
+	print("MMSI");
+	print("Distinct", std::to_string(c.mmsi.size()));
+	if (c.untracked > 0)
+		print("Messages of untracked MMSI", std::to_string(c.untracked));
+	for (std::size_t i = 0; i < num_mmsi_types; ++i)
+		if (c.mmsi_types[i] > 0)
+			print(fmt::sprintf("Type: %s", mmsi_type_names[i]), std::to_string(c.mmsi_types[i]));
+
+	std::vector<std::pair<uint32_t, uint64_t>> top(c.mmsi.begin(), c.mmsi.end());
+	const auto n = std::min(global.config.top, top.size());
+	std::partial_sort(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(n), top.end(),
+		[](const std::pair<uint32_t, uint64_t> & a, const std::pair<uint32_t, uint64_t> & b) {
+			return (a.second > b.second) || ((a.second == b.second) && (a.first < b.first));
+		});
+	for (std::size_t i = 0; i < n; ++i) {
+		const auto k = marnav::utils::classify_mmsi(marnav::utils::mmsi{top[i].first});
+		print(fmt::sprintf("%09u %s", top[i].first, k.country ? k.country->code : "--"),
+			std::to_string(top[i].second));
+	}
+	fmt::printf("\n");
+}
+
+static void print_coverage(const coverage & t, uint64_t lines)
+{
+	print("Time Coverage (tag blocks)");
+	print("Lines with Time", fmt::sprintf("%u (%s)", t.stamped, percent(t.stamped, lines)));
+	if (t.stamped == 0) {
+		fmt::printf("\n");
+		return;
+	}
+	const auto span = t.max - t.min;
+	print("Begin", render_time(t.min));
+	print("End", render_time(t.max));
+	print("Duration", fmt::sprintf("%d s", span));
+	print(fmt::sprintf("Gaps > %d s", global.config.gap),
+		fmt::sprintf("%u, %d s", t.gaps, t.gap_time));
+	if (t.gaps > 0)
+		print("Largest Gap",
+			fmt::sprintf("%d s, from %s", t.largest_gap, render_time(t.largest_gap_begin)));
+	if (span > 0)
+		print("Coverage", fmt::sprintf("%.3f %%",
+			100.0 * static_cast<double>(span - t.gap_time) / static_cast<double>(span)));
+	print("Time Reversals", std::to_string(t.reversals));
+	fmt::printf("\n");
+}
+
+static void process()
+{
+	const auto t0 = std::chrono::steady_clock::now();
+
+	std::vector<marnav::io::mapped_file> files;
+	std::vector<chunk> chunks;
+	files.reserve(global.config.files.size());
+	for (const auto & name : global.config.files) {
+		files.emplace_back(name);
+		files.back().open();
+		split(files.back().data(), files.back().size(), chunks);
+	}
+
+	const auto num_workers
+		= std::max<std::size_t>(1, std::min<std::size_t>(global.config.jobs, chunks.size()));
+	std::vector<counters> results(num_workers);
+	std::vector<coverage> times(chunks.size());
+	std::atomic<std::size_t> next{0};
+	std::vector<std::thread> workers;
+	for (std::size_t w = 0; w < num_workers; ++w) {
+		workers.emplace_back([&, w] {
+			for (auto i = next++; i < chunks.size(); i = next++)
+				process_chunk(chunks[i], results[w], times[i]);
+		});
+	}
+	for (auto & w : workers)
+		w.join();
+
+	// chunks are in order of files and offsets
+	for (std::size_t i = 1; i < results.size(); ++i)
+		results[0].merge(results[i]);
+	for (std::size_t i = 1; i < times.size(); ++i)
+		times[0].merge(times[i]);
+
+	const auto dt = std::chrono::steady_clock::now() - t0;
+
+	print_summary(results[0], dt);
+	print_sentences(results[0]);
+	print_ais(results[0]);
+	print_coverage(times.empty() ? coverage{} : times[0], results[0].lines);
+}
+}
 
 int main(int argc, char ** argv)
 {
-	if (argc != 2) {
-		printf("usage: %s \"sentence\" (sentence without start/end token)\n", argv[0]);
+	using namespace nmeasum;
+
+	try {
+		if (parse_options(argc, argv))
+			return EXIT_SUCCESS;
+
+		if (!global.config.checksum.empty()) {
+			const auto & s = global.config.checksum;
+			fmt::printf("%02X : '%s'\n",
+				static_cast<unsigned int>(marnav::nmea::checksum(s.begin(), s.end())), s);
+			return EXIT_SUCCESS;
+		}
+
+		process();
+	} catch (std::exception & e) {
+		fmt::fprintf(stderr, "error: %s\n", e.what());
 		return EXIT_FAILURE;
 	}
 
-	printf(
-		"%02X : '%s'\n", marnav::nmea::checksum(argv[1], argv[1] + strlen(argv[1])), argv[1]);
-
 	return EXIT_SUCCESS;
 }
@@ -1,5 +1,7 @@
+#include "allocation_counter.hpp"
 #include <benchmark/benchmark.h>
 #include <marnav/ais/ais.hpp>
+#include <marnav/ais/binary_codec.hpp>
 
 namespace
 {
@@ -39,12 +41,41 @@ static void all_messages(benchmark::internal::Benchmark * b)
 static void Benchmark_make_message(benchmark::State & state)
 {
 	state.SetLabel(messages[state.range(0)].label);
+	const auto before = marnav_test::allocations_of_thread();
 	while (state.KeepRunning()) {
 		auto tmp = marnav::ais::make_message(messages[state.range(0)].data);
 		benchmark::DoNotOptimize(tmp);
 	}
+	marnav_test::set_allocation_counters(state, marnav_test::allocations_of_thread() - before);
 }
 
 BENCHMARK(Benchmark_make_message)->Apply(all_messages);
 
+static void Benchmark_encode_message(benchmark::State & state)
+{
+	state.SetLabel(messages[state.range(0)].label);
+	const auto m = marnav::ais::make_message(messages[state.range(0)].data);
+	const auto before = marnav_test::allocations_of_thread();
+	while (state.KeepRunning()) {
+		auto tmp = marnav::ais::encode_message(*m);
+		benchmark::DoNotOptimize(tmp);
+	}
+	marnav_test::set_allocation_counters(state, marnav_test::allocations_of_thread() - before);
+}
+
+BENCHMARK(Benchmark_encode_message)->Apply(all_messages);
+
+static void Benchmark_decode_binary(benchmark::State & state)
+{
+	state.SetLabel(messages[state.range(0)].label);
+	const auto data
+		= marnav::ais::encode_binary(*marnav::ais::make_message(messages[state.range(0)].data));
+	while (state.KeepRunning()) {
+		auto tmp = marnav::ais::decode_binary(data);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_decode_binary)->Apply(all_messages);
+
 BENCHMARK_MAIN()
@@ -0,0 +1,114 @@
+#include "allocation_counter.hpp"
+#include <gtest/gtest.h>
+#include <marnav/ais/ais.hpp>
+#include <marnav/ais/message_01.hpp>
+#include <marnav/ais/message_02.hpp>
+#include <marnav/ais/message_03.hpp>
+#include <marnav/ais/message_04.hpp>
+#include <marnav/ais/message_05.hpp>
+#include <marnav/ais/message_06.hpp>
+#include <marnav/ais/message_07.hpp>
+#include <marnav/ais/message_08.hpp>
+#include <marnav/ais/message_09.hpp>
+#include <marnav/ais/message_10.hpp>
+#include <marnav/ais/message_11.hpp>
+#include <marnav/ais/message_12.hpp>
+#include <marnav/ais/message_13.hpp>
+#include <marnav/ais/message_14.hpp>
+#include <marnav/ais/message_17.hpp>
+#include <marnav/ais/message_18.hpp>
+#include <marnav/ais/message_19.hpp>
+#include <marnav/ais/message_20.hpp>
+#include <marnav/ais/message_21.hpp>
+#include <marnav/ais/message_22.hpp>
+#include <marnav/ais/message_23.hpp>
+#include <marnav/ais/message_24.hpp>
+#include <functional>
+
+namespace
+{
+using namespace marnav;
+
+/// Maximum number of allocations to encode and to decode a message,
+/// see `Test_nmea_allocations` for sentences.
+struct budget {
+	std::function<std::unique_ptr<ais::message>()> create;
+	uint64_t encode_message;
+	uint64_t make_message;
+};
+
+#define BUDGET(m, encode, decode)                                                \
+	{                                                                            \
+		[] { return std::unique_ptr<ais::message>{new ais::m}; }, encode, decode \
+	}
+
+// clang-format off
+static const std::vector<budget> budgets = {
+	BUDGET(message_01, 4, 2),
+	BUDGET(message_02, 4, 2),
+	BUDGET(message_03, 4, 2),
+	BUDGET(message_04, 4, 2),
+	BUDGET(message_05, 6, 8),
+	BUDGET(message_06, 2, 2),
+	BUDGET(message_07, 2, 2),
+	BUDGET(message_08, 2, 2),
+	BUDGET(message_09, 4, 2),
+	BUDGET(message_10, 2, 2),
+	BUDGET(message_11, 4, 2),
+	BUDGET(message_12, 2, 2),
+	BUDGET(message_13, 2, 2),
+	BUDGET(message_14, 2, 2),
+	BUDGET(message_17, 2, 2),
+	BUDGET(message_18, 4, 2),
+	BUDGET(message_19, 5, 5),
+	BUDGET(message_20, 2, 2),
+	BUDGET(message_21, 5, 5),
+	BUDGET(message_22, 4, 2),
+	BUDGET(message_23, 4, 2),
+	BUDGET(message_24, 4, 5),
+};
+// clang-format on
+
+#undef BUDGET
+
+class Test_ais_allocations : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		if (!marnav_test::allocation_counting_enabled())
+			GTEST_SKIP() << "allocation counting not enabled, see ENABLE_ALLOCATION_COUNTING";
+	}
+
+	/// Counts the allocations of the function, after a first call to
+	/// exclude initialization of static data.
+	template <class Function> static marnav_test::allocations count(Function f)
+	{
+		f();
+		return marnav_test::count_allocations(f);
+	}
+};
+
+TEST_F(Test_ais_allocations, encode_message)
+{
+	for (const auto & b : budgets) {
+		const auto m = b.create();
+		const auto a = count([&] { ais::encode_message(*m); });
+		EXPECT_GE(b.encode_message, a.count)
+			<< "type " << static_cast<int>(m->type()) << ": " << a.count << " allocations, "
+			<< a.bytes << " bytes";
+	}
+}
+
+TEST_F(Test_ais_allocations, make_message)
+{
+	for (const auto & b : budgets) {
+		const auto m = b.create();
+		const auto payload = ais::encode_message(*m);
+		const auto a = count([&] { ais::make_message(payload); });
+		EXPECT_GE(b.make_message, a.count)
+			<< "type " << static_cast<int>(m->type()) << ": " << a.count << " allocations, "
+			<< a.bytes << " bytes";
+	}
+}
+}
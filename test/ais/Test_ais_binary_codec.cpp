@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <marnav/ais/ais.hpp>
+#include <marnav/ais/binary_codec.hpp>
+#include <marnav/nmea/binary_codec.hpp>
+
+namespace
+{
+
+using namespace marnav;
+
+class Test_ais_binary_codec : public ::testing::Test
+{
+public:
+	using payload = std::vector<std::pair<std::string, uint32_t>>;
+
+	static const std::vector<payload> MESSAGES;
+};
+
+// clang-format off
+const std::vector<Test_ais_binary_codec::payload> Test_ais_binary_codec::MESSAGES = {
+	{{"133m@ogP00PD;88MD5MTDww@2D7k", 0}},
+	{{"233m@ogP00PD;88MD5MTDww@2D7k", 0}},
+	{{"333m@ogP00PD;88MD5MTDww@2D7k", 0}},
+	{{"4020ssAuho;N?PeNwjOAp<70089A", 0}},
+	{{"55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53", 0}, {"1@0000000000000", 2}},
+	{{"6h2E:p66B2SR04<0@00000000000", 0}},
+	{{"702R5`hwCjq8", 0}},
+	{{"91b55vRAQwOnDE<M05ICOp0208CM", 0}},
+	{{":81:Jf1D02J0", 0}},
+	{{";020ssAuho;N?PeNwjOAp<70089A", 0}},
+	{{"=39UOj0jFs9R", 0}},
+	{{"B000000000H0htY08D41qwv00000", 0}},
+	{{"C000000000H0htY08D41qwv0000000000000000000000000000@", 0}},
+	{{"D030p8@2tN?b<`O6DmQO6D0", 2}},
+	{{"E000000000000000000000000000000000000000000000", 0}},
+	{{"F000000000000000000000000000", 0}},
+	{{"G00000000000000000000000000", 2}},
+	{{"H000000000000000000000000000", 0}},
+};
+// clang-format on
+
+TEST_F(Test_ais_binary_codec, round_trip)
+{
+	for (const auto & p : MESSAGES) {
+		const auto m = ais::make_message(p);
+
+		const auto data = ais::encode_binary(*m);
+		const auto d = ais::decode_binary(data);
+
+		ASSERT_NE(nullptr, d) << p[0].first;
+		EXPECT_EQ(m->type(), d->type()) << p[0].first;
+		EXPECT_EQ(ais::encode_message(*m), ais::encode_message(*d)) << p[0].first;
+	}
+}
+
+TEST_F(Test_ais_binary_codec, not_larger_than_payload)
+{
+	for (const auto & p : MESSAGES) {
+		std::size_t n = 0;
+		for (const auto & f : p)
+			n += f.first.size();
+
+		EXPECT_LE(ais::encode_binary(*ais::make_message(p)).size(), n) << p[0].first;
+	}
+}
+
+TEST_F(Test_ais_binary_codec, header)
+{
+	const auto data = ais::encode_binary(*ais::make_message(MESSAGES[0]));
+
+	const auto h = nmea::read_binary_header(data.data(), data.size(), 0);
+
+	EXPECT_EQ(nmea::binary_record::ais_message, h.kind);
+	EXPECT_EQ(data.size(), h.size);
+	EXPECT_EQ(2u, h.body);
+}
+
+TEST_F(Test_ais_binary_codec, malformed)
+{
+	const auto data = ais::encode_binary(*ais::make_message(MESSAGES[0]));
+
+	for (std::size_t n = 0; n < data.size(); ++n) {
+		std::size_t pos = 0;
+		EXPECT_ANY_THROW(ais::decode_binary(data.data(), n, pos)) << n;
+	}
+
+	// wrong number of bits
+	auto v = data;
+	v[2] = static_cast<uint8_t>(v[2] + 8);
+	EXPECT_ANY_THROW(ais::decode_binary(v));
+
+	// wrong kind of record
+	v = data;
+	v[0] = static_cast<uint8_t>(
+		(static_cast<uint8_t>(nmea::binary_record::sentence) << 4) | nmea::binary_version);
+	EXPECT_ANY_THROW(ais::decode_binary(v));
+}
+}
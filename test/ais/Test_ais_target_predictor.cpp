@@ -0,0 +1,168 @@
+#include <marnav/ais/target_predictor.hpp>
+#include <marnav/ais/message_01.hpp>
+#include <marnav/ais/message_18.hpp>
+#include <marnav/geo/geodesic.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace
+{
+using namespace marnav;
+using ais::target_predictor;
+
+class Test_ais_target_predictor : public ::testing::Test
+{
+public:
+	static target_predictor::time_point make_time(int seconds)
+	{
+		return target_predictor::time_point{} + std::chrono::seconds{1500000000 + seconds};
+	}
+
+	static ais::message_01 make_message_01(uint32_t mmsi, double lat, double lon, double sog,
+		double cog, ais::rate_of_turn rot = ais::rate_of_turn{})
+	{
+		ais::message_01 m;
+		m.set_mmsi(utils::mmsi{mmsi});
+		m.set_lat(lat);
+		m.set_lon(lon);
+		m.set_sog(units::knots{sog});
+		m.set_cog(cog);
+		m.set_rot(rot);
+		return m;
+	}
+};
+
+TEST_F(Test_ais_target_predictor, construction)
+{
+	target_predictor p;
+
+	EXPECT_EQ(0u, p.size());
+	EXPECT_FALSE(p.predict(utils::mmsi{123456789}, make_time(0)));
+}
+
+TEST_F(Test_ais_target_predictor, update_without_position)
+{
+	target_predictor p;
+	ais::message_01 m;
+	m.set_mmsi(utils::mmsi{123456789});
+
+	EXPECT_FALSE(p.update(m, make_time(0)));
+	EXPECT_EQ(0u, p.size());
+}
+
+TEST_F(Test_ais_target_predictor, stationary)
+{
+	target_predictor p;
+	ais::message_18 m;
+	m.set_mmsi(utils::mmsi{123456789});
+	m.set_lat(47.5);
+	m.set_lon(8.5);
+
+	EXPECT_TRUE(p.update(m, make_time(0)));
+
+	const auto pos = p.predict(utils::mmsi{123456789}, make_time(120));
+	ASSERT_TRUE(pos);
+	EXPECT_NEAR(47.5, pos->lat(), 1e-5);
+	EXPECT_NEAR(8.5, pos->lon(), 1e-5);
+}
+
+TEST_F(Test_ais_target_predictor, straight_same_as_vincenty)
+{
+	target_predictor p;
+	p.update(make_message_01(123456789, 47.5, 8.5, 12.0, 45.0), make_time(0));
+
+	const auto pos = p.predict(utils::mmsi{123456789}, make_time(180));
+	ASSERT_TRUE(pos);
+
+	double alpha2 = 0.0;
+	const auto expected = geo::point_ellipsoid_vincenty(
+		geo::position{47.5, 8.5}, 12.0 * 1852.0 / 3600.0 * 180.0, 45.0 * M_PI / 180.0, alpha2);
+	EXPECT_LT(geo::distance_ellipsoid_vincenty(expected, *pos).distance, 1.0);
+}
+
+TEST_F(Test_ais_target_predictor, before_fix)
+{
+	target_predictor p;
+	p.update(make_message_01(123456789, 47.5, 8.5, 12.0, 45.0), make_time(60));
+
+	const auto pos = p.predict(utils::mmsi{123456789}, make_time(0));
+	ASSERT_TRUE(pos);
+	EXPECT_NEAR(47.5, pos->lat(), 1e-5);
+	EXPECT_NEAR(8.5, pos->lon(), 1e-5);
+}
+
+TEST_F(Test_ais_target_predictor, horizon)
+{
+	target_predictor p{std::chrono::seconds{60}};
+	p.update(make_message_01(123456789, 0.0, 0.0, 10.0, 90.0), make_time(0));
+
+	const auto p0 = p.predict(utils::mmsi{123456789}, make_time(60));
+	const auto p1 = p.predict(utils::mmsi{123456789}, make_time(600));
+	ASSERT_TRUE(p0);
+	ASSERT_TRUE(p1);
+	EXPECT_NEAR(p0->lon(), p1->lon(), 1e-9);
+}
+
+TEST_F(Test_ais_target_predictor, turning_full_circle)
+{
+	const ais::rate_of_turn rot{10.0};
+	const int period = static_cast<int>(std::round(360.0 / rot.value() * 60.0));
+
+	target_predictor p{std::chrono::seconds{3600}};
+	p.update(make_message_01(123456789, 47.5, 8.5, 8.0, 0.0, rot), make_time(0));
+
+	const auto half = p.predict(utils::mmsi{123456789}, make_time(period / 2));
+	const auto full = p.predict(utils::mmsi{123456789}, make_time(period));
+	ASSERT_TRUE(half);
+	ASSERT_TRUE(full);
+
+	// turning to starboard: half a circle later the target is east of the start
+	const double radius = 8.0 * 1852.0 / 3600.0 / (rot.value() * M_PI / 180.0 / 60.0);
+	EXPECT_NEAR(
+		2.0 * radius, geo::distance_ellipsoid_vincenty({47.5, 8.5}, *half).distance, 5.0);
+	EXPECT_GT(half->lon(), 8.5);
+	EXPECT_LT(geo::distance_ellipsoid_vincenty({47.5, 8.5}, *full).distance, 5.0);
+}
+
+TEST_F(Test_ais_target_predictor, advance_all)
+{
+	target_predictor p;
+	p.update(make_message_01(111111111, 10.0, 10.0, 10.0, 0.0), make_time(0));
+	p.update(make_message_01(222222222, 20.0, 20.0, 10.0, 180.0), make_time(0));
+	p.update(make_message_01(333333333, 30.0, 30.0, 0.0, 0.0), make_time(0));
+
+	std::vector<target_predictor::prediction> result;
+	p.advance_all(make_time(60), result);
+
+	ASSERT_EQ(3u, result.size());
+	for (auto const & r : result) {
+		const auto pos = p.predict(r.mmsi, make_time(60));
+		ASSERT_TRUE(pos);
+		EXPECT_EQ(*pos, r.pos);
+	}
+	EXPECT_GT(result[0].pos.lat(), 10.0);
+	EXPECT_LT(result[1].pos.lat(), 20.0);
+}
+
+TEST_F(Test_ais_target_predictor, remove_and_expire)
+{
+	target_predictor p;
+	p.update(make_message_01(111111111, 10.0, 10.0, 10.0, 0.0), make_time(0));
+	p.update(make_message_01(222222222, 20.0, 20.0, 10.0, 0.0), make_time(100));
+	p.update(make_message_01(333333333, 30.0, 30.0, 10.0, 0.0), make_time(200));
+	EXPECT_EQ(3u, p.size());
+
+	p.remove(utils::mmsi{111111111});
+	EXPECT_EQ(2u, p.size());
+	EXPECT_FALSE(p.predict(utils::mmsi{111111111}, make_time(0)));
+
+	const auto pos = p.predict(utils::mmsi{333333333}, make_time(200));
+	ASSERT_TRUE(pos);
+	EXPECT_NEAR(30.0, pos->lat(), 1e-9);
+
+	p.expire(make_time(150));
+	EXPECT_EQ(1u, p.size());
+	EXPECT_FALSE(p.predict(utils::mmsi{222222222}, make_time(0)));
+	EXPECT_TRUE(p.predict(utils::mmsi{333333333}, make_time(0)));
+}
+}
@@ -0,0 +1,93 @@
+#include "allocation_counter.hpp"
+#include <new>
+#include <cstdlib>
+
+namespace marnav_test
+{
+namespace
+{
+static thread_local allocations counter;
+}
+
+/// Returns `true` if the allocations are counted.
+bool allocation_counting_enabled() noexcept
+{
+#if defined(MARNAV_ALLOCATION_COUNTING)
+	return true;
+#else
+	return false;
+#endif
+}
+
+/// Returns the allocations done by the current thread since its start.
+allocations allocations_of_thread() noexcept
+{
+	return counter;
+}
+
+#if defined(MARNAV_ALLOCATION_COUNTING)
+/// @cond DEV
+namespace
+{
+static void * allocate(std::size_t size)
+{
+	++counter.count;
+	counter.bytes += size;
+	if (void * p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc{};
+}
+}
+/// @endcond
+#endif
+}
+
+#if defined(MARNAV_ALLOCATION_COUNTING)
+void * operator new(std::size_t size)
+{
+	return marnav_test::allocate(size);
+}
+
+void * operator new[](std::size_t size)
+{
+	return marnav_test::allocate(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+	try {
+		return marnav_test::allocate(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+	try {
+		return marnav_test::allocate(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void operator delete(void * p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void * p, const std::nothrow_t &) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void * p, const std::nothrow_t &) noexcept
+{
+	std::free(p);
+}
+#endif
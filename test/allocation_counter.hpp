@@ -0,0 +1,68 @@
+#ifndef TEST__ALLOCATION_COUNTER__HPP
+#define TEST__ALLOCATION_COUNTER__HPP
+
+#include <cstdint>
+
+/// Counting of allocations for tests and benchmarks.
+///
+/// The counting is done by replacing the global `operator new` and `operator delete`,
+/// which is only enabled with the build option `ENABLE_ALLOCATION_COUNTING`
+/// (compile definition `MARNAV_ALLOCATION_COUNTING`). Without it, all counts are zero.
+///
+/// Counts are per thread, allocations of other threads (e.g. of the test framework)
+/// do not interfere with measurements.
+///
+/// Example:
+/// @code
+/// const auto a = marnav_test::count_allocations([&] { nmea::make_sentence(text); });
+/// EXPECT_GE(2u, a.count);
+/// @endcode
+namespace marnav_test
+{
+struct allocations {
+	uint64_t count = 0; ///< Number of calls to `operator new`.
+	uint64_t bytes = 0; ///< Number of bytes requested.
+
+	allocations & operator+=(const allocations & other) noexcept
+	{
+		count += other.count;
+		bytes += other.bytes;
+		return *this;
+	}
+};
+
+inline allocations operator-(const allocations & a, const allocations & b) noexcept
+{
+	allocations result;
+	result.count = a.count - b.count;
+	result.bytes = a.bytes - b.bytes;
+	return result;
+}
+
+bool allocation_counting_enabled() noexcept;
+allocations allocations_of_thread() noexcept;
+
+/// Returns the allocations of the current thread done by the function.
+template <class Function> allocations count_allocations(Function f)
+{
+	const auto before = allocations_of_thread();
+	f();
+	return allocations_of_thread() - before;
+}
+
+/// Sets the counters `allocs` and `alloc_bytes` per iteration of a benchmark,
+/// nothing is set if counting is not enabled.
+///
+/// @param[in] state The state of the benchmark (`benchmark::State`).
+/// @param[in] a The allocations of all iterations.
+template <class State> void set_allocation_counters(State & state, const allocations & a)
+{
+	if (!allocation_counting_enabled() || (state.iterations() == 0))
+		return;
+	const auto n = static_cast<double>(state.iterations());
+	state.counters["allocs"] = static_cast<double>(a.count) / n;
+	state.counters["alloc_bytes"] = static_cast<double>(a.bytes) / n;
+}
+}
+
+#endif
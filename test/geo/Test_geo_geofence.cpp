@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <marnav/geo/geofence.hpp>
+#include <cmath>
+#include <random>
+
+namespace
+{
+
+using namespace marnav::geo;
+using marnav::utils::mmsi;
+
+class Test_geo_geofence : public ::testing::Test
+{
+public:
+	static polygon create_star(double lat, double lon, double r0, double r1, int n)
+	{
+		polygon::ring r;
+		for (int i = 0; i < 2 * n; ++i) {
+			const double a = i * 3.14159265358979323846 / n;
+			const double d = (i % 2) ? r0 : r1;
+			r.push_back({lat + d * std::sin(a), lon + d * std::cos(a)});
+		}
+		return polygon{r};
+	}
+};
+
+TEST_F(Test_geo_geofence, construction_invalid_cell_size)
+{
+	EXPECT_ANY_THROW(geofence{0.0});
+	EXPECT_ANY_THROW(geofence{-1.0});
+}
+
+TEST_F(Test_geo_geofence, empty)
+{
+	geofence g;
+
+	EXPECT_EQ(0u, g.size());
+	EXPECT_TRUE(g.zones_at({10.0, 10.0}).empty());
+}
+
+TEST_F(Test_geo_geofence, get_zone_invalid_id)
+{
+	geofence g;
+
+	EXPECT_ANY_THROW(g.get_zone(0));
+	EXPECT_ANY_THROW(g.inside(0, {0.0, 0.0}));
+}
+
+TEST_F(Test_geo_geofence, zone_ids_ascending)
+{
+	geofence g;
+
+	EXPECT_EQ(0u, g.add_zone(create_star(0.0, 0.0, 0.5, 1.0, 5)));
+	EXPECT_EQ(1u, g.add_zone(create_star(0.0, 0.0, 0.5, 1.0, 7)));
+	EXPECT_EQ(2u, g.size());
+}
+
+TEST_F(Test_geo_geofence, zones_at_overlapping)
+{
+	geofence g{0.1};
+	g.add_zone(polygon{{{1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {0.0, 0.0}}});
+	g.add_zone(polygon{{{1.5, 0.5}, {1.5, 1.5}, {0.5, 1.5}, {0.5, 0.5}}});
+
+	EXPECT_EQ((std::vector<geofence::zone_id>{0}), g.zones_at({0.25, 0.25}));
+	EXPECT_EQ((std::vector<geofence::zone_id>{0, 1}), g.zones_at({0.75, 0.75}));
+	EXPECT_EQ((std::vector<geofence::zone_id>{1}), g.zones_at({1.25, 1.25}));
+	EXPECT_TRUE(g.zones_at({1.75, 1.75}).empty());
+}
+
+TEST_F(Test_geo_geofence, same_as_polygon)
+{
+	const std::vector<polygon> zones = {
+		create_star(47.0, 8.0, 0.13, 0.41, 9),
+		create_star(47.1, 8.2, 0.05, 0.3, 23),
+		create_star(46.8, 7.9, 0.2, 0.25, 4),
+		polygon{{{47.3, 7.6}, {47.3, 8.4}, {46.7, 8.4}, {46.7, 7.6}},
+			{{{47.2, 7.7}, {47.2, 7.8}, {47.1, 7.8}, {47.1, 7.7}}}},
+	};
+
+	for (auto cell_size : {0.01, 0.05, 0.1, 1.0}) {
+		geofence g{cell_size};
+		for (auto const & z : zones)
+			g.add_zone(z);
+
+		std::mt19937 gen{4711};
+		std::uniform_real_distribution<double> lat{46.5, 47.5};
+		std::uniform_real_distribution<double> lon{7.5, 8.5};
+		for (int i = 0; i < 20000; ++i) {
+			const position p{lat(gen), lon(gen)};
+			std::vector<geofence::zone_id> expected;
+			for (geofence::zone_id id = 0; id < zones.size(); ++id)
+				if (zones[id].inside(p))
+					expected.push_back(id);
+
+			ASSERT_EQ(expected, g.zones_at(p)) << "cell_size=" << cell_size << " lat=" << p.lat()
+											   << " lon=" << p.lon();
+		}
+	}
+}
+
+TEST_F(Test_geo_geofence, same_as_polygon_on_grid)
+{
+	// vertices and positions exactly on cell boundaries
+	const polygon z{{{0.5, 0.0}, {1.0, 0.5}, {0.5, 1.0}, {0.0, 0.5}, {0.25, 0.5}}};
+
+	for (auto cell_size : {0.0625, 0.125, 0.25}) {
+		geofence g{cell_size};
+		g.add_zone(z);
+
+		for (int i = 0; i <= 40; ++i) {
+			for (int j = 0; j <= 40; ++j) {
+				const position p{i * 0.03125 - 0.125, j * 0.03125 - 0.125};
+				EXPECT_EQ(z.inside(p), g.inside(0, p))
+					<< "cell_size=" << cell_size << " lat=" << p.lat() << " lon=" << p.lon();
+			}
+		}
+	}
+}
+
+TEST_F(Test_geo_geofence, update_transitions)
+{
+	geofence g{0.1};
+	g.add_zone(polygon{{{1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {0.0, 0.0}}});
+	g.add_zone(polygon{{{1.5, 0.5}, {1.5, 1.5}, {0.5, 1.5}, {0.5, 0.5}}});
+
+	const mmsi m{211000000};
+	std::vector<geofence::transition> events;
+
+	g.update(m, {-0.5, -0.5}, events);
+	EXPECT_TRUE(events.empty());
+	EXPECT_TRUE(g.zones_of(m).empty());
+
+	g.update(m, {0.25, 0.25}, events);
+	ASSERT_EQ(1u, events.size());
+	EXPECT_EQ(m, events[0].mmsi);
+	EXPECT_EQ(0u, events[0].zone);
+	EXPECT_EQ(geofence::transition_type::enter, events[0].type);
+
+	events.clear();
+	g.update(m, {0.75, 0.75}, events);
+	ASSERT_EQ(1u, events.size());
+	EXPECT_EQ(1u, events[0].zone);
+	EXPECT_EQ(geofence::transition_type::enter, events[0].type);
+	EXPECT_EQ((std::vector<geofence::zone_id>{0, 1}), g.zones_of(m));
+
+	events.clear();
+	g.update(m, {0.76, 0.76}, events);
+	EXPECT_TRUE(events.empty());
+
+	events.clear();
+	g.update(m, {1.25, 1.25}, events);
+	ASSERT_EQ(1u, events.size());
+	EXPECT_EQ(0u, events[0].zone);
+	EXPECT_EQ(geofence::transition_type::exit, events[0].type);
+
+	events.clear();
+	g.remove(m, events);
+	ASSERT_EQ(1u, events.size());
+	EXPECT_EQ(1u, events[0].zone);
+	EXPECT_EQ(geofence::transition_type::exit, events[0].type);
+	EXPECT_TRUE(g.zones_of(m).empty());
+}
+
+TEST_F(Test_geo_geofence, update_within_boundary_cell)
+{
+	geofence g{1.0};
+	g.add_zone(polygon{{{0.5, 0.0}, {0.5, 0.5}, {0.0, 0.5}, {0.0, 0.0}}});
+
+	const mmsi m{211000000};
+	std::vector<geofence::transition> events;
+
+	g.update(m, {0.25, 0.25}, events);
+	ASSERT_EQ(1u, events.size());
+	EXPECT_EQ(geofence::transition_type::enter, events[0].type);
+
+	// same cell, but crossing the boundary
+	events.clear();
+	g.update(m, {0.75, 0.75}, events);
+	ASSERT_EQ(1u, events.size());
+	EXPECT_EQ(geofence::transition_type::exit, events[0].type);
+}
+
+TEST_F(Test_geo_geofence, update_after_zone_added)
+{
+	geofence g{0.1};
+
+	const mmsi m{211000000};
+	std::vector<geofence::transition> events;
+
+	g.update(m, {0.25, 0.25}, events);
+	EXPECT_TRUE(events.empty());
+
+	// zone covers the cell of the vessel completely, no boundary within
+	const auto id = g.add_zone(polygon{{{1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {0.0, 0.0}}});
+
+	g.update(m, {0.25, 0.25}, events);
+	ASSERT_EQ(1u, events.size());
+	EXPECT_EQ(id, events[0].zone);
+	EXPECT_EQ(geofence::transition_type::enter, events[0].type);
+	EXPECT_EQ((std::vector<geofence::zone_id>{id}), g.zones_of(m));
+}
+
+TEST_F(Test_geo_geofence, remove_unknown_vessel)
+{
+	geofence g;
+	std::vector<geofence::transition> events;
+
+	g.remove(mmsi{211000000}, events);
+	EXPECT_TRUE(events.empty());
+}
+}
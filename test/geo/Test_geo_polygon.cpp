@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <marnav/geo/polygon.hpp>
+
+namespace
+{
+
+using namespace marnav::geo;
+
+class Test_geo_polygon : public ::testing::Test
+{
+public:
+	static polygon create_square()
+	{
+		return polygon{{{1.0, 1.0}, {1.0, 2.0}, {0.0, 2.0}, {0.0, 1.0}}};
+	}
+};
+
+TEST_F(Test_geo_polygon, construction_too_few_points)
+{
+	EXPECT_ANY_THROW(polygon({{1.0, 1.0}, {1.0, 2.0}}));
+}
+
+TEST_F(Test_geo_polygon, construction_hole_too_few_points)
+{
+	auto p = create_square();
+	EXPECT_ANY_THROW(p.add_hole({{0.6, 1.4}, {0.6, 1.6}}));
+}
+
+TEST_F(Test_geo_polygon, bounding_box)
+{
+	const auto p = create_square();
+
+	EXPECT_NEAR(1.0, p.top(), 1e-9);
+	EXPECT_NEAR(0.0, p.bottom(), 1e-9);
+	EXPECT_NEAR(1.0, p.left(), 1e-9);
+	EXPECT_NEAR(2.0, p.right(), 1e-9);
+}
+
+TEST_F(Test_geo_polygon, inside_square)
+{
+	const auto p = create_square();
+
+	EXPECT_TRUE(p.inside({0.5, 1.5}));
+	EXPECT_TRUE(p.inside({0.1, 1.9}));
+	EXPECT_FALSE(p.inside({1.5, 1.5}));
+	EXPECT_FALSE(p.inside({0.5, 2.5}));
+	EXPECT_FALSE(p.inside({-0.5, 1.5}));
+	EXPECT_FALSE(p.inside({0.5, 0.5}));
+}
+
+TEST_F(Test_geo_polygon, inside_concave)
+{
+	// U-shape, opening to the north
+	const polygon p{{{0.0, 0.0}, {0.0, 3.0}, {3.0, 3.0}, {3.0, 2.0}, {1.0, 2.0}, {1.0, 1.0},
+		{3.0, 1.0}, {3.0, 0.0}}};
+
+	EXPECT_TRUE(p.inside({0.5, 1.5}));
+	EXPECT_TRUE(p.inside({2.5, 0.5}));
+	EXPECT_TRUE(p.inside({2.5, 2.5}));
+	EXPECT_FALSE(p.inside({2.0, 1.5}));
+}
+
+TEST_F(Test_geo_polygon, inside_hole)
+{
+	auto p = create_square();
+	p.add_hole({{0.6, 1.4}, {0.6, 1.6}, {0.4, 1.6}, {0.4, 1.4}});
+
+	EXPECT_TRUE(p.inside({0.8, 1.2}));
+	EXPECT_FALSE(p.inside({0.5, 1.5}));
+}
+
+TEST_F(Test_geo_polygon, inside_southern_western_hemisphere)
+{
+	const polygon p{{{-10.0, -20.0}, {-10.0, -10.0}, {-20.0, -10.0}, {-20.0, -20.0}}};
+
+	EXPECT_TRUE(p.inside({-15.0, -15.0}));
+	EXPECT_FALSE(p.inside({-15.0, -5.0}));
+	EXPECT_FALSE(p.inside({15.0, 15.0}));
+}
+}
@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+#include <marnav/geo/track.hpp>
+#include <marnav/geo/geodesic.hpp>
+#include <cmath>
+
+namespace
+{
+
+using namespace marnav::geo;
+
+class Test_geo_track : public ::testing::Test
+{
+public:
+	static track_point make_point(double lat, double lon, int seconds)
+	{
+		return {{lat, lon},
+			std::chrono::system_clock::time_point{} + std::chrono::seconds{1500000000 + seconds}};
+	}
+
+	/// Circle of about 1km radius, one point every 2 degrees.
+	static std::vector<track_point> create_circle()
+	{
+		std::vector<track_point> track;
+		for (int i = 0; i < 180; ++i) {
+			const double a = i * 2.0 * 3.14159265358979323846 / 180.0;
+			track.push_back(make_point(47.0 + 0.009 * std::sin(a), 8.0 + 0.013 * std::cos(a), i));
+		}
+		return track;
+	}
+
+	/// Spherical distance of a point to the segment from `a` to `b`, brute force.
+	static double distance_to_segment(const position & p, const position & a, const position & b)
+	{
+		double result = distance_sphere(p, a).distance;
+		for (int i = 1; i <= 1000; ++i) {
+			const double f = i / 1000.0;
+			const position q{a.lat() + f * (b.lat() - a.lat()), a.lon() + f * (b.lon() - a.lon())};
+			result = std::min(result, distance_sphere(p, q).distance);
+		}
+		return result;
+	}
+};
+
+TEST_F(Test_geo_track, construction_invalid)
+{
+	EXPECT_ANY_THROW(track_simplifier(-1.0));
+	EXPECT_ANY_THROW(track_simplifier(10.0, 0));
+}
+
+TEST_F(Test_geo_track, simplify_empty)
+{
+	track_simplifier s{10.0};
+	std::vector<track_point> result;
+
+	s.flush(result);
+	EXPECT_TRUE(result.empty());
+}
+
+TEST_F(Test_geo_track, simplify_single_point)
+{
+	track_simplifier s{10.0};
+	std::vector<track_point> result;
+
+	s.push(make_point(47.0, 8.0, 0), result);
+	EXPECT_EQ(1u, result.size());
+	s.flush(result);
+	EXPECT_EQ(1u, result.size());
+}
+
+TEST_F(Test_geo_track, simplify_nearly_antipodal)
+{
+	// the distance does not converge for nearly antipodal points
+	ASSERT_TRUE(std::isnan(distance_ellipsoid_vincenty({0.0, 0.0}, {0.5, 179.7}).distance));
+
+	track_simplifier s{10.0};
+	std::vector<track_point> result;
+
+	s.push(make_point(0.0, 0.0, 0), result);
+	s.push(make_point(0.5, 179.7, 1), result);
+	s.push(make_point(0.5, 179.7001, 2), result);
+	s.flush(result);
+
+	ASSERT_EQ(3u, result.size());
+	EXPECT_NEAR(179.7, result[1].pos.lon(), 1e-9);
+	EXPECT_NEAR(179.7001, result[2].pos.lon(), 1e-9);
+}
+
+TEST_F(Test_geo_track, simplify_push_after_flush)
+{
+	track_simplifier s{10.0};
+	std::vector<track_point> result;
+
+	s.push(make_point(0.0, 0.0, 0), result);
+	s.push(make_point(0.0, 0.001, 1), result);
+	s.flush(result);
+	ASSERT_EQ(2u, result.size());
+
+	// continues from the flushed point
+	s.push(make_point(0.0, 0.002, 2), result);
+	s.push(make_point(0.0, 0.003, 3), result);
+	s.flush(result);
+	ASSERT_EQ(3u, result.size());
+	EXPECT_NEAR(0.003, result[2].pos.lon(), 1e-9);
+
+	// not converging distance to the flushed point
+	s.push(make_point(0.5, 179.7, 4), result);
+	s.flush(result);
+	ASSERT_EQ(4u, result.size());
+	EXPECT_NEAR(179.7, result[3].pos.lon(), 1e-9);
+}
+
+TEST_F(Test_geo_track, simplify_straight_line)
+{
+	track_simplifier s{1.0};
+	std::vector<track_point> result;
+
+	for (int i = 0; i < 50; ++i)
+		s.push(make_point(47.0 + i * 0.0001, 8.0, i), result);
+	s.flush(result);
+
+	ASSERT_EQ(2u, result.size());
+	EXPECT_NEAR(47.0, result[0].pos.lat(), 1e-9);
+	EXPECT_NEAR(47.0049, result[1].pos.lat(), 1e-9);
+}
+
+TEST_F(Test_geo_track, simplify_capacity_bounded)
+{
+	track_simplifier s{1.0, 10};
+	std::vector<track_point> result;
+
+	for (int i = 0; i < 50; ++i)
+		s.push(make_point(47.0 + i * 0.0001, 8.0, i), result);
+	s.flush(result);
+
+	EXPECT_EQ(6u, result.size());
+}
+
+TEST_F(Test_geo_track, simplify_turn_back)
+{
+	track_simplifier s{5.0};
+	std::vector<track_point> result;
+
+	for (int i = 0; i < 10; ++i)
+		s.push(make_point(47.0 + i * 0.0001, 8.0, i), result);
+	for (int i = 0; i < 5; ++i)
+		s.push(make_point(47.0009 - i * 0.0001, 8.0, 10 + i), result);
+	s.flush(result);
+
+	ASSERT_EQ(3u, result.size());
+	EXPECT_NEAR(47.0009, result[1].pos.lat(), 1e-9);
+	EXPECT_NEAR(47.0005, result[2].pos.lat(), 1e-9);
+}
+
+TEST_F(Test_geo_track, simplify_circle_within_tolerance)
+{
+	const auto track = create_circle();
+
+	for (auto tolerance : {2.0, 10.0, 50.0}) {
+		track_simplifier s{tolerance};
+		std::vector<track_point> result;
+		for (auto const & p : track)
+			s.push(p, result);
+		s.flush(result);
+
+		EXPECT_LT(result.size(), track.size());
+		EXPECT_EQ(track.front().time, result.front().time);
+		EXPECT_EQ(track.back().time, result.back().time);
+
+		// every original point must be within the tolerance of its segment
+		std::size_t k = 0;
+		for (auto const & p : track) {
+			while (result[k + 1].time < p.time)
+				++k;
+			const double d = distance_to_segment(p.pos, result[k].pos, result[k + 1].pos);
+			EXPECT_LT(d, tolerance * 1.01) << "tolerance=" << tolerance;
+		}
+	}
+}
+
+TEST_F(Test_geo_track, encode_empty)
+{
+	track_encoder e;
+
+	EXPECT_EQ(0u, e.size());
+	EXPECT_EQ(3u, e.data().size());
+	EXPECT_TRUE(decode_track(e.data()).empty());
+}
+
+TEST_F(Test_geo_track, encode_decode)
+{
+	const auto track = create_circle();
+
+	track_encoder e;
+	for (auto const & p : track)
+		e.append(p);
+	EXPECT_EQ(track.size(), e.size());
+	EXPECT_GT(10u * track.size(), e.data().size());
+
+	const auto result = decode_track(e.data());
+	ASSERT_EQ(track.size(), result.size());
+	for (std::size_t i = 0; i < track.size(); ++i) {
+		EXPECT_NEAR(track[i].pos.lat(), result[i].pos.lat(), 1e-7);
+		EXPECT_NEAR(track[i].pos.lon(), result[i].pos.lon(), 1e-7);
+		EXPECT_EQ(track[i].time, result[i].time);
+	}
+}
+
+TEST_F(Test_geo_track, encode_decode_negative)
+{
+	track_encoder e;
+	e.append(make_point(-33.9, -179.99, 0));
+	e.append(make_point(-34.0, 179.99, 10));
+
+	const auto result = decode_track(e.data());
+	ASSERT_EQ(2u, result.size());
+	EXPECT_NEAR(-33.9, result[0].pos.lat(), 1e-7);
+	EXPECT_NEAR(-179.99, result[0].pos.lon(), 1e-7);
+	EXPECT_NEAR(-34.0, result[1].pos.lat(), 1e-7);
+	EXPECT_NEAR(179.99, result[1].pos.lon(), 1e-7);
+}
+
+TEST_F(Test_geo_track, decode_invalid)
+{
+	EXPECT_ANY_THROW(decode_track(nullptr, 0));
+	EXPECT_ANY_THROW(decode_track(std::vector<uint8_t>{'M', 'T'}));
+	EXPECT_ANY_THROW(decode_track(std::vector<uint8_t>{'X', 'T', 1}));
+	EXPECT_ANY_THROW(decode_track(std::vector<uint8_t>{'M', 'T', 99}));
+}
+
+TEST_F(Test_geo_track, decode_truncated)
+{
+	track_encoder e;
+	e.append(make_point(47.0, 8.0, 0));
+	auto data = e.data();
+	data.pop_back();
+
+	EXPECT_ANY_THROW(decode_track(data));
+}
+
+TEST_F(Test_geo_track, decode_too_large)
+{
+	// value of more than 64 bits, overflow within the 10th byte
+	std::vector<uint8_t> data{'M', 'T', track_encoder::version};
+	data.insert(data.end(), 9, 0xff);
+	data.push_back(0x02);
+	data.insert(data.end(), {0x00, 0x00});
+
+	EXPECT_ANY_THROW(decode_track(data));
+}
+
+TEST_F(Test_geo_track, decode_out_of_range)
+{
+	// latitude of 200 degrees
+	track_encoder e;
+	e.append(make_point(47.0, 8.0, 0));
+	auto data = e.data();
+	const auto valid = data;
+	data.resize(3);
+	data.insert(data.end(), {0x80, 0xd0, 0xac, 0xf3, 0x0e, 0x00, 0x00});
+
+	EXPECT_NO_THROW(decode_track(valid));
+	EXPECT_ANY_THROW(decode_track(data));
+}
+}
@@ -0,0 +1,283 @@
+#include "allocation_counter.hpp"
+#include <benchmark/benchmark.h>
+#include <marnav/ais/ais.hpp>
+#include <marnav/ais/message_01.hpp>
+#include <marnav/ais/message_05.hpp>
+#include <marnav/ais/message_18.hpp>
+#include <marnav/io/nmea_framer.hpp>
+#include <marnav/nmea/gga.hpp>
+#include <marnav/nmea/gsv.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/rmc.hpp>
+#include <marnav/nmea/vdm.hpp>
+#include <marnav/nmea/vdo.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// End to end benchmarks, processing the sample corpora through the full path:
+// framing, parsing of sentences, reassembly and parsing of AIS messages and
+// access to some of the data.
+//
+// Reported counters, besides bytes and sentences per second:
+// - allocs_per_sentence: calls of `operator new` per sentence
+// - allocations, sentences: per iteration, JSON output contains only integers
+// - p50_ns, p99_ns: latency per sentence, of the last iteration
+// - errors: sentences or messages failed to parse, per iteration
+//
+// Allocations are always counted by this benchmark, see `allocation_counter.hpp`.
+//
+// Run with `--benchmark_out=file.json` to compare results, see `bin/test-benchmark`.
+
+namespace
+{
+using namespace marnav;
+
+#ifndef MARNAV_BENCHMARK_DATA_DIR
+	#define MARNAV_BENCHMARK_DATA_DIR "."
+#endif
+
+static std::string load(const std::string & name)
+{
+	std::ifstream ifs{std::string{MARNAV_BENCHMARK_DATA_DIR} + "/" + name};
+	std::ostringstream os;
+	os << ifs.rdbuf();
+	return os.str();
+}
+
+static std::vector<std::string> lines(const std::string & s)
+{
+	std::vector<std::string> result;
+	std::istringstream is{s};
+	std::string line;
+	while (std::getline(is, line))
+		result.push_back(line);
+	return result;
+}
+
+static const std::string & ais_corpus()
+{
+	static const std::string data = load("ais-sample.txt");
+	return data;
+}
+
+static const std::string & nmea_corpus()
+{
+	static const std::string data = load("nmea-sample.txt");
+	return data;
+}
+
+/// Mixed traffic: one sentence of the NMEA corpus, followed by four lines
+/// of the AIS corpus (starting with a complete message), cycling through
+/// the NMEA corpus.
+static const std::string & mixed_corpus()
+{
+	static const std::string data = [] {
+		const auto ais = lines(ais_corpus());
+		const auto nmea = lines(nmea_corpus());
+		std::string s;
+		if (ais.empty() || nmea.empty())
+			return s;
+		std::size_t k = 0;
+		for (std::size_t i = 0; i < std::min<std::size_t>(ais.size(), 20000); ++k) {
+			s += nmea[k % nmea.size()] + '\n';
+			for (std::size_t j = 0; (j < 4) && (i < ais.size()); ++j, ++i)
+				s += ais[i] + '\n';
+			// keep fragments of AIS messages together
+			while ((i < ais.size()) && (ais[i].compare(0, 9, "!AIVDM,2,") == 0)
+				&& (ais[i].compare(9, 2, "2,") == 0))
+				s += ais[i++] + '\n';
+		}
+		return s;
+	}();
+	return data;
+}
+
+/// Processes sentences and AIS messages, accessing some of their data.
+class processor
+{
+public:
+	void operator()(const std::string & raw)
+	{
+		std::unique_ptr<nmea::sentence> s;
+		try {
+			s = nmea::make_sentence(raw);
+		} catch (std::exception &) {
+			++errors;
+			return;
+		}
+
+		try {
+			access(*s);
+		} catch (std::exception &) {
+			++errors;
+		}
+	}
+
+	uint64_t errors = 0;
+	double sum = 0.0;
+
+private:
+	std::vector<std::pair<std::string, uint32_t>> fragments_;
+
+	template <class T> void access(const utils::optional<T> & value)
+	{
+		if (value)
+			sum += value->get();
+	}
+
+	void access(const nmea::sentence & s)
+	{
+		switch (s.id()) {
+			case nmea::sentence_id::RMC:
+				access(nmea::sentence_cast<nmea::rmc>(&s)->get_lat());
+				break;
+			case nmea::sentence_id::GGA:
+				access(nmea::sentence_cast<nmea::gga>(&s)->get_lat());
+				break;
+			case nmea::sentence_id::GSV:
+				sum += nmea::sentence_cast<nmea::gsv>(&s)->get_n_satellites_in_view();
+				break;
+			case nmea::sentence_id::VDM:
+				assemble(*nmea::sentence_cast<nmea::vdm>(&s));
+				break;
+			case nmea::sentence_id::VDO:
+				assemble(*nmea::sentence_cast<nmea::vdo>(&s));
+				break;
+			default:
+				break;
+		}
+	}
+
+	void assemble(const nmea::vdm & vdm)
+	{
+		if (vdm.get_fragment() <= 1)
+			fragments_.clear();
+		fragments_.emplace_back(vdm.get_payload(), vdm.get_n_fill_bits());
+		if (vdm.get_fragment() < vdm.get_n_fragments())
+			return;
+
+		// messages may contain invalid data, which throw on access
+		try {
+			const auto m = ais::make_message(fragments_);
+			fragments_.clear();
+			access(*m);
+		} catch (std::exception &) {
+			++errors;
+		}
+	}
+
+	void access(const ais::message & m)
+	{
+		switch (m.type()) {
+			case ais::message_id::position_report_class_a:
+			case ais::message_id::position_report_class_a_assigned_schedule:
+			case ais::message_id::position_report_class_a_response_to_interrogation: {
+				const auto & p = static_cast<const ais::message_01 &>(m);
+				sum += p.get_mmsi();
+				access(p.get_lat());
+				break;
+			}
+			case ais::message_id::static_and_voyage_related_data:
+				sum += static_cast<double>(
+					ais::message_cast<ais::message_05>(&m)->get_shipname().size());
+				break;
+			case ais::message_id::standard_class_b_cs_position_report:
+				access(ais::message_cast<ais::message_18>(&m)->get_lat());
+				break;
+			default:
+				break;
+		}
+	}
+};
+
+static uint64_t percentile(std::vector<uint64_t> & v, double p)
+{
+	if (v.empty())
+		return 0;
+	const auto n = static_cast<std::size_t>(p * static_cast<double>(v.size() - 1));
+	std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(n), v.end());
+	return v[n];
+}
+
+static void run(benchmark::State & state, const std::string & data)
+{
+	using clock = std::chrono::steady_clock;
+
+	if (data.empty()) {
+		state.SkipWithError("corpus not found");
+		return;
+	}
+
+	std::size_t num_sentences = 0;
+	{
+		io::nmea_framer framer;
+		framer.feed(data.data(), data.size(), [&](const std::string &) { ++num_sentences; });
+	}
+
+	std::vector<uint64_t> latencies(num_sentences);
+	uint64_t errors = 0;
+	double sum = 0.0;
+	const auto allocations = marnav_test::allocations_of_thread();
+
+	while (state.KeepRunning()) {
+		io::nmea_framer framer;
+		processor process;
+		std::size_t i = 0;
+		auto t0 = clock::now();
+		for (std::size_t ofs = 0; ofs < data.size(); ++ofs) {
+			if (framer.feed(data[ofs]) != io::nmea_framer::status::complete)
+				continue;
+			process(framer.sentence());
+			const auto t1 = clock::now();
+			latencies[i++]
+				= static_cast<uint64_t>(std::chrono::nanoseconds{t1 - t0}.count());
+			t0 = t1;
+		}
+		errors = process.errors;
+		sum += process.sum;
+	}
+	benchmark::DoNotOptimize(sum);
+
+	const auto total = static_cast<int64_t>(state.iterations())
+		* static_cast<int64_t>(num_sentences);
+	state.SetBytesProcessed(
+		static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(data.size()));
+	state.SetItemsProcessed(total);
+	const auto allocated
+		= static_cast<double>((marnav_test::allocations_of_thread() - allocations).count);
+	state.counters["allocs_per_sentence"]
+		= (total > 0) ? allocated / static_cast<double>(total) : 0.0;
+	state.counters["allocations"] = (state.iterations() > 0)
+		? allocated / static_cast<double>(state.iterations())
+		: 0.0;
+	state.counters["sentences"] = static_cast<double>(num_sentences);
+	state.counters["p50_ns"] = static_cast<double>(percentile(latencies, 0.50));
+	state.counters["p99_ns"] = static_cast<double>(percentile(latencies, 0.99));
+	state.counters["errors"] = static_cast<double>(errors);
+}
+
+static void benchmark_end_to_end_ais(benchmark::State & state)
+{
+	run(state, ais_corpus());
+}
+
+static void benchmark_end_to_end_nmea(benchmark::State & state)
+{
+	run(state, nmea_corpus());
+}
+
+static void benchmark_end_to_end_mixed(benchmark::State & state)
+{
+	run(state, mixed_corpus());
+}
+}
+
+BENCHMARK(benchmark_end_to_end_ais)->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmark_end_to_end_nmea)->Unit(benchmark::kMicrosecond);
+BENCHMARK(benchmark_end_to_end_mixed)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN()
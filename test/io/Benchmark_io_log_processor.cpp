@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <marnav/io/log_processor.hpp>
+#include <string>
+
+namespace
+{
+// clang-format off
+static const std::string BLOCK
+	= {"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17\r\n"
+	   "!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13\r\n"
+	   "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E\r\n"
+	   "!AIVDM,2,2,3,B,1@0000000000000,2*55\r\n"};
+// clang-format on
+
+static const std::string & data()
+{
+	static const std::string d = [] {
+		std::string s;
+		for (int i = 0; i < 20000; ++i)
+			s += BLOCK;
+		return s;
+	}();
+	return d;
+}
+
+static void Benchmark_io_log_processor(benchmark::State & state)
+{
+	const auto & d = data();
+	marnav::io::log_processor p{d.data(), d.size(),
+		{static_cast<std::size_t>(state.range(0)), 64 * 1024}};
+	while (state.KeepRunning()) {
+		std::size_t n = 0;
+		p.run([&n](marnav::io::log_processor::result &&) { ++n; });
+		benchmark::DoNotOptimize(n);
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(d.size()));
+}
+}
+
+BENCHMARK(Benchmark_io_log_processor)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN()
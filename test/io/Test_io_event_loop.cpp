@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <marnav/io/event_loop.hpp>
+#include <marnav/io/selectable.hpp>
+#include <marnav/utils/unique.hpp>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+/// Read end of a pipe, the write end is kept by the test.
+class pipe_device : public io::device, virtual public io::selectable
+{
+public:
+	pipe_device(int fd)
+		: fd(fd)
+	{
+	}
+
+	virtual ~pipe_device() { close(); }
+
+	void open() override {}
+
+	void close() override
+	{
+		if (fd < 0)
+			return;
+		::close(fd);
+		fd = -1;
+	}
+
+	virtual int read(char * buffer, uint32_t size) override
+	{
+		if (fd < 0)
+			throw std::runtime_error{"pipe not open"};
+		return ::read(fd, buffer, size);
+	}
+
+	virtual int write(const char *, uint32_t) override
+	{
+		throw std::runtime_error{"operation not supported"};
+	}
+
+	virtual int get_fd() const override { return fd; }
+
+private:
+	int fd;
+};
+
+class not_selectable_device : public io::device
+{
+public:
+	void open() override {}
+	void close() override {}
+	virtual int read(char *, uint32_t) override { return 0; }
+	virtual int write(const char *, uint32_t) override { return 0; }
+};
+
+class Test_io_event_loop : public ::testing::Test
+{
+public:
+	/// Creates a pipe, returns the device for the read end and the
+	/// file descriptor of the write end.
+	static std::unique_ptr<io::device> make_pipe(int & write_fd)
+	{
+		int fds[2];
+		if (::pipe2(fds, O_CLOEXEC) < 0)
+			throw std::runtime_error{"pipe"};
+		write_fd = fds[1];
+		return utils::make_unique<pipe_device>(fds[0]);
+	}
+
+	static void write(int fd, const std::string & data)
+	{
+		ASSERT_EQ(static_cast<ssize_t>(data.size()), ::write(fd, data.data(), data.size()));
+	}
+};
+
+TEST_F(Test_io_event_loop, add_invalid_device)
+{
+	io::event_loop loop;
+
+	EXPECT_THROW(loop.add_nmea(nullptr, [](const std::string &) {}), std::invalid_argument);
+	EXPECT_THROW(loop.add_nmea(utils::make_unique<not_selectable_device>(),
+					 [](const std::string &) {}),
+		std::invalid_argument);
+	EXPECT_EQ(0u, loop.size());
+}
+
+TEST_F(Test_io_event_loop, nmea_sentences_from_many_devices)
+{
+	io::event_loop loop;
+
+	std::vector<int> fds(8);
+	std::vector<std::vector<std::string>> received(fds.size());
+	for (std::size_t i = 0; i < fds.size(); ++i) {
+		loop.add_nmea(make_pipe(fds[i]),
+			[&received, i](const std::string & s) { received[i].push_back(s); });
+	}
+	EXPECT_EQ(fds.size(), loop.size());
+
+	for (std::size_t i = 0; i < fds.size(); ++i)
+		write(fds[i], "$GPXXX," + std::to_string(i) + "*00\r\n$GPXX");
+	while (loop.run_once(0) > 0)
+		;
+	for (std::size_t i = 0; i < fds.size(); ++i)
+		write(fds[i], "Y*00\r\n");
+	while (loop.run_once(0) > 0)
+		;
+
+	for (std::size_t i = 0; i < fds.size(); ++i) {
+		ASSERT_EQ(2u, received[i].size());
+		EXPECT_EQ("$GPXXX," + std::to_string(i) + "*00", received[i][0]);
+		EXPECT_EQ("$GPXXY*00", received[i][1]);
+		::close(fds[i]);
+	}
+}
+
+TEST_F(Test_io_event_loop, seatalk_messages)
+{
+	io::event_loop loop;
+	int fd = -1;
+	std::vector<seatalk::raw> received;
+	loop.add_seatalk(
+		make_pipe(fd), [&received](const seatalk::raw & m) { received.push_back(m); });
+
+	write(fd, std::string{"\x27\x01\x64\xff\x00\x00", 6});
+	loop.run_once(0);
+
+	ASSERT_EQ(1u, received.size());
+	EXPECT_EQ((seatalk::raw{0x27, 0x01, 0x64, 0x00}), received[0]);
+	::close(fd);
+}
+
+TEST_F(Test_io_event_loop, end_of_file_removes_device)
+{
+	io::event_loop loop;
+	int fd = -1;
+	int count = 0;
+	loop.add_nmea(make_pipe(fd), [&count](const std::string &) { ++count; });
+
+	write(fd, "$GPXXX*00\r\n");
+	::close(fd);
+
+	loop.run(); // terminates, no more devices
+	EXPECT_EQ(1, count);
+	EXPECT_EQ(0u, loop.size());
+}
+
+TEST_F(Test_io_event_loop, remove_from_handler)
+{
+	io::event_loop loop;
+	int fd = -1;
+	int count = 0;
+	io::event_loop::source_id id = 0;
+	id = loop.add_nmea(make_pipe(fd), [&](const std::string &) {
+		++count;
+		loop.remove(id);
+	});
+
+	write(fd, "$GPXXX*00\r\n$GPXXX*00\r\n");
+	loop.run_once(0);
+	EXPECT_EQ(0u, loop.size());
+	EXPECT_EQ(2, count); // rest of the chunk is still processed
+	::close(fd);
+}
+
+TEST_F(Test_io_event_loop, timer_single_shot)
+{
+	io::event_loop loop;
+	int count = 0;
+	loop.add_timer(std::chrono::milliseconds{1}, [&count]() { ++count; }, false);
+
+	loop.run();
+	EXPECT_EQ(1, count);
+}
+
+TEST_F(Test_io_event_loop, timer_repeat_and_stop)
+{
+	io::event_loop loop;
+	int count = 0;
+	loop.add_timer(std::chrono::milliseconds{1}, [&]() {
+		if (++count == 5)
+			loop.stop();
+	});
+
+	loop.run();
+	EXPECT_EQ(5, count);
+}
+
+TEST_F(Test_io_event_loop, timer_cancel_from_handler)
+{
+	io::event_loop loop;
+	int count = 0;
+	io::event_loop::timer_id id = 0;
+	id = loop.add_timer(std::chrono::milliseconds{1}, [&]() {
+		++count;
+		loop.cancel_timer(id);
+	});
+
+	loop.run();
+	EXPECT_EQ(1, count);
+}
+
+TEST_F(Test_io_event_loop, timer_invalid_interval)
+{
+	io::event_loop loop;
+
+	EXPECT_THROW(loop.add_timer(std::chrono::milliseconds{0}, []() {}), std::invalid_argument);
+}
+
+TEST_F(Test_io_event_loop, run_once_timeout)
+{
+	io::event_loop loop;
+	int fd = -1;
+	loop.add_nmea(make_pipe(fd), [](const std::string &) {});
+
+	const auto t0 = std::chrono::steady_clock::now();
+	EXPECT_EQ(0u, loop.run_once(10));
+	EXPECT_GE(std::chrono::steady_clock::now() - t0, std::chrono::milliseconds{9});
+	::close(fd);
+}
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include <marnav/io/log_processor.hpp>
+#include <marnav/nmea/rmc.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace marnav;
+
+static const std::string BLOCK
+	= {"!AIVDM,2,2,3,B,1@0000000000000,2*55\r\n"
+	   "$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17\r\n"
+	   "!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13\r\n"
+	   "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E\r\n"
+	   "$GPXXX*00\r\n"
+	   "!AIVDM,2,2,3,B,1@0000000000000,2*55\r\n"
+	   "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E\r\n"};
+
+class Test_io_log_processor : public ::testing::Test
+{
+public:
+	struct entry {
+		nmea::sentence_id id;
+		bool message;
+
+		bool operator==(const entry & other) const
+		{
+			return (id == other.id) && (message == other.message);
+		}
+	};
+
+	static std::vector<entry> run(const io::log_processor & p, io::log_processor::stats & s)
+	{
+		std::vector<entry> result;
+		s = p.run([&result](io::log_processor::result && r) {
+			result.push_back({r.sentence->id(), r.message != nullptr});
+		});
+		return result;
+	}
+
+	static std::string repeat(const std::string & s, std::size_t n)
+	{
+		std::string result;
+		for (std::size_t i = 0; i < n; ++i)
+			result += s;
+		return result;
+	}
+};
+
+TEST_F(Test_io_log_processor, invalid_chunk_size)
+{
+	EXPECT_ANY_THROW(io::log_processor(BLOCK.data(), BLOCK.size(), {1, 0}));
+	EXPECT_ANY_THROW(io::log_processor::split(BLOCK.data(), BLOCK.size(), 0));
+}
+
+TEST_F(Test_io_log_processor, default_threads)
+{
+	io::log_processor p{BLOCK.data(), BLOCK.size()};
+
+	EXPECT_LT(0u, p.get_threads());
+}
+
+TEST_F(Test_io_log_processor, split_empty)
+{
+	const auto bounds = io::log_processor::split(nullptr, 0, 16);
+
+	ASSERT_EQ(1u, bounds.size());
+	EXPECT_EQ(0u, bounds[0]);
+}
+
+TEST_F(Test_io_log_processor, split_one_chunk)
+{
+	const auto bounds = io::log_processor::split(BLOCK.data(), BLOCK.size(), BLOCK.size());
+
+	ASSERT_EQ(2u, bounds.size());
+	EXPECT_EQ(0u, bounds[0]);
+	EXPECT_EQ(BLOCK.size(), bounds[1]);
+}
+
+TEST_F(Test_io_log_processor, split_aligned_to_lines)
+{
+	static const std::string data = "abc\ndefgh\ni\n\njklm";
+
+	const auto bounds = io::log_processor::split(data.data(), data.size(), 2);
+
+	const std::vector<std::size_t> expected = {0, 4, 10, 12, data.size()};
+	EXPECT_EQ(expected, bounds);
+}
+
+TEST_F(Test_io_log_processor, split_no_end_of_line)
+{
+	static const std::string data = "abcdefghijklmnop";
+
+	const auto bounds = io::log_processor::split(data.data(), data.size(), 4);
+
+	ASSERT_EQ(2u, bounds.size());
+	EXPECT_EQ(data.size(), bounds[1]);
+}
+
+TEST_F(Test_io_log_processor, split_chunk_ends_at_line_feed)
+{
+	static const std::string data = "abc\ndef\n";
+
+	const auto bounds = io::log_processor::split(data.data(), data.size(), 4);
+
+	const std::vector<std::size_t> expected = {0, 4, data.size()};
+	EXPECT_EQ(expected, bounds);
+}
+
+TEST_F(Test_io_log_processor, run_empty)
+{
+	io::log_processor p{nullptr, 0, {2, 16}};
+	io::log_processor::stats s;
+
+	const auto result = run(p, s);
+
+	EXPECT_TRUE(result.empty());
+	EXPECT_EQ(0u, s.chunks);
+	EXPECT_EQ(0u, s.sentences);
+}
+
+TEST_F(Test_io_log_processor, run_single_chunk)
+{
+	io::log_processor p{BLOCK.data(), BLOCK.size(), {1, BLOCK.size()}};
+	io::log_processor::stats s;
+
+	const auto result = run(p, s);
+
+	EXPECT_EQ(1u, s.chunks);
+	EXPECT_EQ(6u, s.sentences);
+	EXPECT_EQ(2u, s.messages);
+	ASSERT_EQ(6u, result.size());
+	EXPECT_EQ(nmea::sentence_id::RMC, result[1].id);
+	EXPECT_TRUE(result[2].message);
+	EXPECT_FALSE(result[3].message);
+	EXPECT_TRUE(result[4].message);
+	EXPECT_FALSE(result[5].message);
+}
+
+TEST_F(Test_io_log_processor, fragments_spanning_chunks)
+{
+	// every line is a chunk of its own
+	const auto data = repeat(BLOCK, 3);
+	io::log_processor p{data.data(), data.size(), {3, 1}};
+	io::log_processor::stats s;
+
+	const auto result = run(p, s);
+
+	EXPECT_EQ(21u, s.chunks);
+	EXPECT_EQ(18u, s.sentences);
+	ASSERT_EQ(18u, result.size());
+
+	// the last fragment of every block completes the group of the previous block
+	EXPECT_EQ(2u + 3u + 3u, s.messages);
+	EXPECT_TRUE(result[6].message);
+	EXPECT_TRUE(result[12].message);
+}
+
+TEST_F(Test_io_log_processor, long_tag_block)
+{
+	const std::string data
+		= "\\s:r003669945,c:1241544035,g:1-1-4242,d:STATION1,t:TEST*65\\"
+		  "!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13\r\n";
+	ASSERT_LT(100u, data.size());
+
+	io::log_processor p{data.data(), data.size(), {1, data.size()}};
+	io::log_processor::stats s;
+
+	const auto result = run(p, s);
+
+	EXPECT_EQ(0u, s.overflows);
+	EXPECT_EQ(1u, s.sentences);
+	EXPECT_EQ(1u, s.messages);
+	ASSERT_EQ(1u, result.size());
+	EXPECT_TRUE(result[0].message);
+}
+
+TEST_F(Test_io_log_processor, same_results_as_one_chunk)
+{
+	const auto data = repeat(BLOCK, 50);
+
+	io::log_processor::stats expected_stats;
+	const auto expected = run(io::log_processor{data.data(), data.size(), {1, data.size()}},
+		expected_stats);
+
+	for (const std::size_t threads : {1u, 2u, 4u}) {
+		for (const std::size_t chunk_size : {1u, 37u, 100u, 1000u}) {
+			io::log_processor p{data.data(), data.size(), {threads, chunk_size}};
+			io::log_processor::stats s;
+
+			const auto result = run(p, s);
+
+			EXPECT_TRUE(expected == result) << "threads=" << threads << " chunk=" << chunk_size;
+			EXPECT_EQ(expected_stats.sentences, s.sentences);
+			EXPECT_EQ(expected_stats.messages, s.messages);
+			EXPECT_EQ(expected_stats.errors, s.errors);
+		}
+	}
+}
+
+TEST_F(Test_io_log_processor, last_line_without_end_of_line)
+{
+	const std::string data
+		= "$GPXXX*00\r\n$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17";
+	io::log_processor p{data.data(), data.size(), {2, 4}};
+	io::log_processor::stats s;
+
+	const auto result = run(p, s);
+
+	EXPECT_EQ(2u, s.chunks);
+	EXPECT_EQ(1u, s.errors);
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ(nmea::sentence_id::RMC, result[0].id);
+}
+
+TEST_F(Test_io_log_processor, filter)
+{
+	const auto data = repeat(BLOCK, 4);
+	io::log_processor p{data.data(), data.size(), {2, 64}};
+	p.set_filter(nmea::sentence_filter{nmea::sentence_id::RMC});
+	io::log_processor::stats s;
+
+	const auto result = run(p, s);
+
+	EXPECT_EQ(4u, s.sentences);
+	EXPECT_EQ(0u, s.messages);
+	EXPECT_EQ(24u, s.filtered);
+	ASSERT_EQ(4u, result.size());
+	EXPECT_EQ(nmea::sentence_id::RMC, result[0].id);
+}
+
+TEST_F(Test_io_log_processor, handler_exception)
+{
+	const auto data = repeat(BLOCK, 20);
+	io::log_processor p{data.data(), data.size(), {2, 16}};
+	std::size_t n = 0;
+
+	EXPECT_THROW(p.run([&n](io::log_processor::result &&) {
+		if (++n == 10)
+			throw std::runtime_error{"stop"};
+	}),
+		std::runtime_error);
+	EXPECT_EQ(10u, n);
+}
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <marnav/io/log_replay.hpp>
+#include <vector>
+
+namespace
+{
+
+using namespace marnav;
+
+static const std::string DATA
+	= {"\\s:r003669945,c:1241544035*4A\\!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13\r\n"
+	   "\\s:r003669945,c:1241544035*4A\\!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13\r\n"
+	   "$GPXXX*00\r\n"
+	   "\\c:1241544036000*4A\\!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13\r\n"
+	   "\\s:r003669945,c:1241544037*4A\\!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13"};
+
+class Test_io_log_replay : public ::testing::Test
+{
+public:
+	static std::vector<std::string> read_all(io::log_replay & replay)
+	{
+		std::vector<std::string> result;
+		std::string s;
+		while (replay.read_sentence(s))
+			result.push_back(s);
+		return result;
+	}
+};
+
+TEST_F(Test_io_log_replay, empty)
+{
+	io::log_replay replay{nullptr, 0};
+	std::string s;
+
+	EXPECT_FALSE(replay.read_sentence(s));
+}
+
+TEST_F(Test_io_log_replay, invalid_speed)
+{
+	EXPECT_THROW(io::log_replay(DATA.data(), DATA.size(), -1.0), std::invalid_argument);
+}
+
+TEST_F(Test_io_log_replay, as_fast_as_possible)
+{
+	io::log_replay replay{DATA.data(), DATA.size()};
+
+	const auto t0 = std::chrono::steady_clock::now();
+	const auto result = read_all(replay);
+	EXPECT_LT(std::chrono::steady_clock::now() - t0, std::chrono::milliseconds{500});
+
+	ASSERT_EQ(5u, result.size());
+	EXPECT_EQ("$GPXXX*00", result[2]);
+	EXPECT_EQ(DATA.size(), replay.tell());
+}
+
+TEST_F(Test_io_log_replay, paced)
+{
+	// two seconds of recorded data, replayed 50 times faster
+	io::log_replay replay{DATA.data(), DATA.size(), 50.0};
+
+	const auto t0 = std::chrono::steady_clock::now();
+	const auto result = read_all(replay);
+	const auto elapsed = std::chrono::steady_clock::now() - t0;
+
+	EXPECT_EQ(5u, result.size());
+	EXPECT_GE(elapsed, std::chrono::milliseconds{39});
+	EXPECT_LT(elapsed, std::chrono::milliseconds{1000});
+}
+
+TEST_F(Test_io_log_replay, rewind)
+{
+	io::log_replay replay{DATA.data(), DATA.size()};
+
+	EXPECT_EQ(5u, read_all(replay).size());
+	replay.rewind();
+	EXPECT_EQ(5u, read_all(replay).size());
+}
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <marnav/io/mapped_file.hpp>
+#include <marnav/io/nmea_framer.hpp>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+static const std::string DATA
+	= {"$GPRMC,202451,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*19\r\n"
+	   "$GPRMC,202452,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1a\r\n"
+	   "$GPRMC,202453,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1b\r\n"};
+
+class Test_io_mapped_file : public ::testing::Test
+{
+public:
+	virtual void SetUp() override
+	{
+		char name[] = "/tmp/marnav-mapped-file-XXXXXX";
+		const int fd = ::mkstemp(name);
+		ASSERT_GE(fd, 0);
+		::close(fd);
+		filename = name;
+	}
+
+	virtual void TearDown() override { ::unlink(filename.c_str()); }
+
+	void create(const std::string & data)
+	{
+		std::ofstream ofs{filename, std::ios::binary};
+		ofs << data;
+	}
+
+	std::string filename;
+};
+
+TEST_F(Test_io_mapped_file, open_not_existing)
+{
+	io::mapped_file file{filename + "-does-not-exist"};
+
+	EXPECT_THROW(file.open(), std::runtime_error);
+}
+
+TEST_F(Test_io_mapped_file, empty_file)
+{
+	create("");
+	io::mapped_file file{filename};
+	file.open();
+
+	EXPECT_EQ(nullptr, file.data());
+	EXPECT_EQ(0u, file.size());
+
+	char c;
+	EXPECT_EQ(0, file.read(&c, 1));
+}
+
+TEST_F(Test_io_mapped_file, data)
+{
+	create(DATA);
+	io::mapped_file file{filename};
+	file.open();
+
+	ASSERT_EQ(DATA.size(), file.size());
+	EXPECT_EQ(DATA, std::string(file.data(), file.size()));
+}
+
+TEST_F(Test_io_mapped_file, feed_framer)
+{
+	create(DATA);
+	io::mapped_file file{filename};
+	file.open();
+
+	io::nmea_framer framer;
+	int count = 0;
+	framer.feed(file.data(), file.size(), [&count](const std::string &) { ++count; });
+	EXPECT_EQ(3, count);
+}
+
+TEST_F(Test_io_mapped_file, read_as_device)
+{
+	create(DATA);
+	io::mapped_file file{filename};
+	file.open();
+
+	std::string result;
+	char buffer[50];
+	int rc;
+	while ((rc = file.read(buffer, sizeof(buffer))) > 0)
+		result.append(buffer, rc);
+
+	EXPECT_EQ(DATA, result);
+	EXPECT_EQ(DATA.size(), file.tell());
+}
+
+TEST_F(Test_io_mapped_file, seek)
+{
+	create(DATA);
+	io::mapped_file file{filename};
+	file.open();
+
+	file.seek(70);
+	char buffer[6];
+	ASSERT_EQ(6, file.read(buffer, sizeof(buffer)));
+	EXPECT_EQ("$GPRMC", std::string(buffer, sizeof(buffer)));
+	EXPECT_THROW(file.seek(DATA.size() + 1), std::out_of_range);
+}
+
+TEST_F(Test_io_mapped_file, read_not_open)
+{
+	io::mapped_file file{filename};
+	char c;
+
+	EXPECT_THROW(file.read(&c, 1), std::runtime_error);
+}
+
+TEST_F(Test_io_mapped_file, write_not_supported)
+{
+	create(DATA);
+	io::mapped_file file{filename};
+	file.open();
+
+	EXPECT_EQ(-1, file.write("x", 1));
+}
+
+TEST_F(Test_io_mapped_file, close)
+{
+	create(DATA);
+	io::mapped_file file{filename};
+	file.open();
+	file.close();
+
+	EXPECT_EQ(nullptr, file.data());
+	EXPECT_EQ(0u, file.size());
+}
+
+TEST_F(Test_io_mapped_file, move)
+{
+	create(DATA);
+	io::mapped_file file{filename};
+	file.open();
+
+	io::mapped_file other{std::move(file)};
+	EXPECT_EQ(nullptr, file.data());
+	EXPECT_EQ(DATA.size(), other.size());
+}
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <marnav/io/metrics.hpp>
+#include <marnav/ais/ais.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+using namespace marnav;
+using event = io::stream_metrics::event;
+
+class Test_io_metrics : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_metrics, histogram_upper_bounds)
+{
+	EXPECT_EQ(std::chrono::microseconds{1}, io::latency_histogram::upper_bound(0));
+	EXPECT_EQ(std::chrono::microseconds{2}, io::latency_histogram::upper_bound(1));
+	EXPECT_EQ(std::chrono::microseconds{16384}, io::latency_histogram::upper_bound(14));
+	EXPECT_EQ(std::chrono::nanoseconds::max(), io::latency_histogram::upper_bound(15));
+}
+
+TEST_F(Test_io_metrics, histogram_record)
+{
+	io::latency_histogram h;
+	h.record(std::chrono::nanoseconds{0});
+	h.record(std::chrono::nanoseconds{1000});
+	h.record(std::chrono::nanoseconds{1001});
+	h.record(std::chrono::microseconds{3});
+	h.record(std::chrono::seconds{1});
+
+	const auto s = h.get();
+	EXPECT_EQ(5u, s.count);
+	EXPECT_EQ(2u, s.buckets[0]);
+	EXPECT_EQ(1u, s.buckets[1]);
+	EXPECT_EQ(1u, s.buckets[2]);
+	EXPECT_EQ(1u, s.buckets[15]);
+	EXPECT_EQ(std::chrono::nanoseconds{1000005001}, s.sum);
+}
+
+TEST_F(Test_io_metrics, initially_empty)
+{
+	io::stream_metrics m;
+	const auto s = m.get();
+
+	for (const auto e : s.events)
+		EXPECT_EQ(0u, e);
+	EXPECT_TRUE(s.sentences.empty());
+	EXPECT_TRUE(s.messages.empty());
+}
+
+TEST_F(Test_io_metrics, count_events)
+{
+	io::stream_metrics m;
+	m.count(event::bytes, 100);
+	m.count(event::frames);
+	m.count(event::frames);
+
+	const auto s = m.get();
+	EXPECT_EQ(100u, s.get(event::bytes));
+	EXPECT_EQ(2u, s.get(event::frames));
+	EXPECT_EQ(0u, s.get(event::filtered));
+}
+
+TEST_F(Test_io_metrics, event_names)
+{
+	EXPECT_STREQ("bytes", io::to_string(event::bytes).c_str());
+	EXPECT_STREQ("bus_errors", io::to_string(event::bus_errors).c_str());
+}
+
+TEST_F(Test_io_metrics, rate)
+{
+	io::stream_metrics::snapshot a;
+	io::stream_metrics::snapshot b;
+	b.time = a.time + std::chrono::seconds{2};
+	a.events[static_cast<std::size_t>(event::bytes)] = 100;
+	b.events[static_cast<std::size_t>(event::bytes)] = 500;
+
+	EXPECT_DOUBLE_EQ(200.0, io::rate(a, b, event::bytes));
+	EXPECT_DOUBLE_EQ(0.0, io::rate(b, a, event::bytes));
+	EXPECT_DOUBLE_EQ(0.0, io::rate(a, a, event::bytes));
+}
+
+TEST_F(Test_io_metrics, parse_sentence)
+{
+	io::stream_metrics m;
+
+	EXPECT_TRUE(io::parse_sentence("$IIMTW,9.5,C*2F", m) != nullptr);
+	EXPECT_TRUE(io::parse_sentence("$IIMTW,9.5,C*2F", m) != nullptr);
+	EXPECT_TRUE(io::parse_sentence("$IIMTW,9.5,C*00", m) == nullptr);
+	EXPECT_TRUE(io::parse_sentence("$IIYYY*59", m) == nullptr);
+	EXPECT_TRUE(io::parse_sentence("garbage", m) == nullptr);
+
+	const auto s = m.get();
+	EXPECT_EQ(1u, s.get(event::checksum_errors));
+	EXPECT_EQ(1u, s.get(event::unknown_sentences));
+	EXPECT_EQ(1u, s.get(event::parse_errors));
+	ASSERT_EQ(1u, s.sentences.size());
+	EXPECT_EQ(nmea::sentence_id::MTW, s.sentences[0].id);
+	EXPECT_EQ(2u, s.sentences[0].latency.count);
+}
+
+TEST_F(Test_io_metrics, parse_message)
+{
+	io::stream_metrics m;
+
+	const std::vector<std::pair<std::string, uint32_t>> payload
+		= {{"133m@ogP00PD;88MD5MTDww@2D7k", 0}};
+	EXPECT_TRUE(io::parse_message(payload, m) != nullptr);
+	EXPECT_TRUE(io::parse_message({{"", 0}}, m) == nullptr);
+
+	const auto s = m.get();
+	EXPECT_EQ(1u, s.get(event::ais_errors));
+	ASSERT_EQ(1u, s.messages.size());
+	EXPECT_EQ(ais::message_id::position_report_class_a, s.messages[0].id);
+	EXPECT_EQ(1u, s.messages[0].latency.count);
+}
+
+TEST_F(Test_io_metrics, write_prometheus)
+{
+	io::stream_metrics m;
+	m.count(event::bytes, 17);
+	m.record(nmea::sentence_id::MTW, std::chrono::microseconds{3});
+	m.record(ais::message_id::base_station_report, std::chrono::microseconds{100});
+	m.record(nmea::sentence_id::RMC, std::chrono::nanoseconds{12345678901});
+
+	std::ostringstream os;
+	io::write_prometheus(os, "dev\"0", m.get());
+	const auto text = os.str();
+
+	EXPECT_NE(std::string::npos, text.find("# TYPE marnav_events_total counter\n"));
+	EXPECT_NE(std::string::npos,
+		text.find("marnav_events_total{stream=\"dev\\\"0\",event=\"bytes\"} 17\n"));
+	EXPECT_NE(std::string::npos,
+		text.find("marnav_sentence_parse_seconds_bucket{stream=\"dev\\\"0\",id=\"MTW\","
+				  "le=\"0.000002\"} 0\n"));
+	EXPECT_NE(std::string::npos,
+		text.find("marnav_sentence_parse_seconds_bucket{stream=\"dev\\\"0\",id=\"MTW\","
+				  "le=\"0.000004\"} 1\n"));
+	EXPECT_NE(std::string::npos,
+		text.find("marnav_sentence_parse_seconds_bucket{stream=\"dev\\\"0\",id=\"MTW\","
+				  "le=\"+Inf\"} 1\n"));
+	EXPECT_NE(std::string::npos,
+		text.find("marnav_sentence_parse_seconds_sum{stream=\"dev\\\"0\",id=\"MTW\"} 0.000003\n"));
+	EXPECT_NE(std::string::npos,
+		text.find("marnav_ais_parse_seconds_count{stream=\"dev\\\"0\",type=\"4\"} 1\n"));
+	EXPECT_NE(std::string::npos,
+		text.find(
+			"marnav_sentence_parse_seconds_sum{stream=\"dev\\\"0\",id=\"RMC\"} 12.345678901\n"));
+}
+
+TEST_F(Test_io_metrics, write_prometheus_many_streams_type_once)
+{
+	io::stream_metrics m;
+
+	std::ostringstream os;
+	io::write_prometheus(os, {{"a", m.get()}, {"b", m.get()}});
+	const auto text = os.str();
+
+	const std::string type = "# TYPE marnav_events_total counter\n";
+	const auto pos = text.find(type);
+	ASSERT_NE(std::string::npos, pos);
+	EXPECT_EQ(std::string::npos, text.find(type, pos + 1));
+	EXPECT_NE(std::string::npos, text.find("{stream=\"a\",event=\"frames\"} 0\n"));
+	EXPECT_NE(std::string::npos, text.find("{stream=\"b\",event=\"frames\"} 0\n"));
+}
+
+TEST_F(Test_io_metrics, concurrent_snapshots)
+{
+	io::stream_metrics m;
+	const uint64_t n = 100000;
+
+	std::thread writer([&m, n] {
+		for (uint64_t i = 0; i < n; ++i) {
+			m.count(event::frames);
+			m.record(nmea::sentence_id::GGA, std::chrono::microseconds{1});
+		}
+	});
+
+	uint64_t last = 0;
+	for (int i = 0; i < 100; ++i) {
+		const auto s = m.get();
+		EXPECT_LE(last, s.get(event::frames));
+		last = s.get(event::frames);
+	}
+	writer.join();
+
+	const auto s = m.get();
+	EXPECT_EQ(n, s.get(event::frames));
+	ASSERT_EQ(1u, s.sentences.size());
+	EXPECT_EQ(n, s.sentences[0].latency.count);
+}
+}
@@ -0,0 +1,323 @@
+#include <gtest/gtest.h>
+#include <marnav/io/multiplexer.hpp>
+#include <marnav/io/selectable.hpp>
+#include <marnav/utils/unique.hpp>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+/// One end of a pipe, the other end is kept by the test.
+class pipe_device : public io::device, virtual public io::selectable
+{
+public:
+	pipe_device(int fd)
+		: fd(fd)
+	{
+	}
+
+	virtual ~pipe_device() { close(); }
+
+	void open() override {}
+
+	void close() override
+	{
+		if (fd < 0)
+			return;
+		::close(fd);
+		fd = -1;
+	}
+
+	virtual int read(char * buffer, uint32_t size) override
+	{
+		return static_cast<int>(::read(fd, buffer, size));
+	}
+
+	virtual int write(const char * buffer, uint32_t size) override
+	{
+		return static_cast<int>(::write(fd, buffer, size));
+	}
+
+	virtual int get_fd() const override { return fd; }
+
+private:
+	int fd;
+};
+
+class not_selectable_device : public io::device
+{
+public:
+	void open() override {}
+	void close() override {}
+	virtual int read(char *, uint32_t) override { return 0; }
+	virtual int write(const char *, uint32_t) override { return 0; }
+};
+
+class Test_io_multiplexer : public ::testing::Test
+{
+public:
+	void TearDown() override
+	{
+		for (auto fd : fds)
+			::close(fd);
+	}
+
+	/// Returns the read end of a pipe as device, the write end is kept.
+	std::unique_ptr<io::device> make_input(int & write_fd)
+	{
+		int p[2];
+		if (::pipe2(p, O_CLOEXEC) < 0)
+			throw std::runtime_error{"pipe"};
+		write_fd = p[1];
+		fds.push_back(p[1]);
+		return utils::make_unique<pipe_device>(p[0]);
+	}
+
+	/// Returns the write end of a pipe as device, the read end is kept
+	/// and is non-blocking.
+	std::unique_ptr<io::device> make_output(int & read_fd)
+	{
+		int p[2];
+		if (::pipe2(p, O_CLOEXEC | O_NONBLOCK) < 0)
+			throw std::runtime_error{"pipe"};
+		read_fd = p[0];
+		fds.push_back(p[0]);
+		return utils::make_unique<pipe_device>(p[1]);
+	}
+
+	static std::string read_all(int fd)
+	{
+		std::string result;
+		char buffer[4096];
+		for (;;) {
+			const auto rc = ::read(fd, buffer, sizeof(buffer));
+			if (rc <= 0)
+				break;
+			result.append(buffer, rc);
+		}
+		return result;
+	}
+
+	static void write(int fd, const std::string & data)
+	{
+		ASSERT_EQ(static_cast<ssize_t>(data.size()), ::write(fd, data.data(), data.size()));
+	}
+
+	std::vector<int> fds;
+};
+
+static const std::string RMC
+	= "$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17";
+static const std::string MTW = "$IIMTW,9.5,C*2F";
+static const std::string VDM = "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C";
+static const std::string PROPRIETARY = "$PGRME,22.0,M,52.9,M,51.0,M*14";
+
+TEST_F(Test_io_multiplexer, add_invalid_devices)
+{
+	io::multiplexer mux;
+
+	EXPECT_THROW(mux.add_input(nullptr), std::invalid_argument);
+	EXPECT_THROW(mux.add_input(utils::make_unique<not_selectable_device>()),
+		std::invalid_argument);
+	EXPECT_THROW(mux.add_output(nullptr), std::invalid_argument);
+	EXPECT_THROW(mux.add_output(utils::make_unique<not_selectable_device>()),
+		std::invalid_argument);
+
+	int fd = -1;
+	EXPECT_THROW(mux.add_output(make_output(fd), {}, 0), std::invalid_argument);
+	EXPECT_EQ(0u, mux.inputs());
+	EXPECT_EQ(0u, mux.outputs());
+}
+
+TEST_F(Test_io_multiplexer, unknown_output_stats)
+{
+	io::multiplexer mux;
+	EXPECT_THROW(mux.get_output_stats(0), std::out_of_range);
+}
+
+TEST_F(Test_io_multiplexer, filter)
+{
+	io::multiplexer::filter all;
+	EXPECT_TRUE(all.matches("GP", "RMC"));
+	EXPECT_TRUE(all.matches("", "PGRME"));
+
+	io::multiplexer::filter f{{"GP", "II"}, {"RMC", "MTW"}};
+	EXPECT_TRUE(f.matches("GP", "RMC"));
+	EXPECT_TRUE(f.matches("II", "MTW"));
+	EXPECT_FALSE(f.matches("AI", "RMC"));
+	EXPECT_FALSE(f.matches("GP", "GGA"));
+	EXPECT_FALSE(f.matches("", "PGRME"));
+}
+
+TEST_F(Test_io_multiplexer, dispatch_invalid_sentences)
+{
+	io::multiplexer mux;
+	int fd = -1;
+	mux.add_output(make_output(fd));
+
+	EXPECT_EQ(0u, mux.dispatch(""));
+	EXPECT_EQ(0u, mux.dispatch("garbage"));
+	EXPECT_EQ(0u, mux.dispatch("$IIMTW,9.5,C*00")); // wrong checksum
+	EXPECT_EQ(0u, mux.dispatch("$IIMTW,9.5,C*2")); // short checksum
+	EXPECT_EQ(0u, mux.dispatch("#IIMTW,9.5,C*2F")); // start token
+	EXPECT_EQ(0u, mux.dispatch("\\c:1*00$IIMTW,9.5,C*2F")); // incomplete tag block
+	EXPECT_EQ(6u, mux.get_invalid());
+	EXPECT_EQ(0u, mux.get_output_stats(0).depth);
+}
+
+TEST_F(Test_io_multiplexer, dispatch_and_flush_coalesced)
+{
+	io::multiplexer mux;
+	int fd = -1;
+	mux.add_output(make_output(fd));
+
+	EXPECT_EQ(1u, mux.dispatch(RMC));
+	EXPECT_EQ(1u, mux.dispatch(MTW));
+	EXPECT_EQ(1u, mux.dispatch("\\s:r003669959,c:1241544035*74\\" + VDM));
+	EXPECT_EQ(3u, mux.get_output_stats(0).depth);
+
+	EXPECT_EQ(3u, mux.flush());
+	EXPECT_EQ(RMC + "\r\n" + MTW + "\r\n\\s:r003669959,c:1241544035*74\\" + VDM + "\r\n",
+		read_all(fd));
+
+	const auto s = mux.get_output_stats(0);
+	EXPECT_EQ(0u, s.depth);
+	EXPECT_EQ(3u, s.max_depth);
+	EXPECT_EQ(3u, s.sent);
+	EXPECT_EQ(1u, s.writes);
+	EXPECT_EQ(0u, s.dropped);
+}
+
+TEST_F(Test_io_multiplexer, routing_by_filter)
+{
+	io::multiplexer mux;
+	int fd_all = -1;
+	int fd_gps = -1;
+	int fd_ais = -1;
+	int fd_prop = -1;
+	mux.add_output(make_output(fd_all));
+	mux.add_output(make_output(fd_gps), {{"GP"}, {}});
+	mux.add_output(make_output(fd_ais), {{}, {"VDM", "VDO"}});
+	mux.add_output(make_output(fd_prop), {{}, {"PGRME"}});
+
+	EXPECT_EQ(2u, mux.dispatch(RMC));
+	EXPECT_EQ(1u, mux.dispatch(MTW));
+	EXPECT_EQ(2u, mux.dispatch(VDM));
+	EXPECT_EQ(2u, mux.dispatch(PROPRIETARY));
+	mux.flush();
+
+	EXPECT_EQ(RMC + "\r\n" + MTW + "\r\n" + VDM + "\r\n" + PROPRIETARY + "\r\n", read_all(fd_all));
+	EXPECT_EQ(RMC + "\r\n", read_all(fd_gps));
+	EXPECT_EQ(VDM + "\r\n", read_all(fd_ais));
+	EXPECT_EQ(PROPRIETARY + "\r\n", read_all(fd_prop));
+}
+
+TEST_F(Test_io_multiplexer, full_queue_drops)
+{
+	io::multiplexer mux;
+	int fd_small = -1;
+	int fd_large = -1;
+	mux.add_output(make_output(fd_small), {}, 2);
+	mux.add_output(make_output(fd_large), {}, 16);
+
+	for (int i = 0; i < 5; ++i)
+		mux.dispatch(MTW);
+
+	EXPECT_EQ(2u, mux.get_output_stats(0).depth);
+	EXPECT_EQ(3u, mux.get_output_stats(0).dropped);
+	EXPECT_EQ(5u, mux.get_output_stats(1).depth);
+	EXPECT_EQ(0u, mux.get_output_stats(1).dropped);
+
+	mux.flush();
+	EXPECT_EQ(2u * (MTW.size() + 2), read_all(fd_small).size());
+	EXPECT_EQ(5u * (MTW.size() + 2), read_all(fd_large).size());
+}
+
+TEST_F(Test_io_multiplexer, slow_output_does_not_stall_others)
+{
+	io::multiplexer mux;
+	int fd_slow = -1;
+	int fd_fast = -1;
+	mux.add_output(make_output(fd_slow), {}, 1024);
+	mux.add_output(make_output(fd_fast), {}, 1024);
+
+	// nobody reads the slow output, the pipe gets full eventually
+	const std::size_t n = 4000;
+	std::size_t received = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		mux.dispatch(MTW);
+		mux.flush();
+		received += read_all(fd_fast).size();
+	}
+
+	EXPECT_EQ(n * (MTW.size() + 2), received);
+	const auto slow = mux.get_output_stats(0);
+	EXPECT_LT(0u, slow.depth);
+	EXPECT_EQ(n, slow.sent + slow.depth + slow.dropped);
+	EXPECT_EQ(0u, mux.get_output_stats(1).dropped);
+
+	// the slow output catches up
+	std::size_t slow_received = 0;
+	while (mux.get_output_stats(0).depth > 0) {
+		mux.flush();
+		slow_received += read_all(fd_slow).size();
+	}
+	slow_received += read_all(fd_slow).size();
+	EXPECT_EQ((n - mux.get_output_stats(0).dropped) * (MTW.size() + 2), slow_received);
+}
+
+TEST_F(Test_io_multiplexer, run_from_inputs)
+{
+	io::multiplexer mux;
+	int in0 = -1;
+	int in1 = -1;
+	int out = -1;
+	mux.add_input(make_input(in0));
+	mux.add_input(make_input(in1));
+	mux.add_output(make_output(out));
+	EXPECT_EQ(2u, mux.inputs());
+
+	write(in0, RMC + "\r\n$IIMTW,9.5,C*00\r\n");
+	write(in1, MTW + "\r\n");
+	::close(in0);
+	::close(in1);
+	fds.clear();
+
+	mux.run();
+
+	EXPECT_EQ(0u, mux.inputs());
+	EXPECT_EQ(1u, mux.get_invalid());
+	const auto data = read_all(out);
+	EXPECT_NE(std::string::npos, data.find(RMC + "\r\n"));
+	EXPECT_NE(std::string::npos, data.find(MTW + "\r\n"));
+	EXPECT_EQ(RMC.size() + MTW.size() + 4, data.size());
+	::close(out);
+}
+
+TEST_F(Test_io_multiplexer, run_long_tag_block)
+{
+	const std::string tagged = "\\s:r003669945,c:1241544035,g:1-1-4242,d:STATION1,t:TEST*65\\"
+							   "!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13";
+	ASSERT_LT(100u, tagged.size());
+
+	io::multiplexer mux;
+	int in = -1;
+	int out = -1;
+	mux.add_input(make_input(in));
+	mux.add_output(make_output(out));
+
+	write(in, tagged + "\r\n");
+	::close(in);
+	fds.clear();
+
+	mux.run();
+
+	EXPECT_EQ(0u, mux.get_invalid());
+	EXPECT_EQ(tagged + "\r\n", read_all(out));
+	::close(out);
+}
+}
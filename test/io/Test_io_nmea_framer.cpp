@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <marnav/io/nmea_framer.hpp>
+#include <vector>
+
+namespace
+{
+
+using namespace marnav;
+
+static const std::string DATA_COMPLETE
+	= {"$GPRMC,202451,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*19\r\n"
+	   "$GPRMC,202452,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1a\r\n"
+	   "$GPRMC,202453,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1b\r\n"};
+
+static const std::string DATA_MISSING_EOL
+	= {"$GPRMC,202452,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1a"
+	   "$GPRMC,202453,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1b\r\n"
+	   "$GPRMC,202453,A,4702.3966,N,00818.3287,E,0.0,312.3,260711,0.6,E,A*1b\r\n"};
+
+/// Tag block and sentence, more than 100 characters.
+static const std::string TAGGED_VDM
+	= {"\\s:r003669945,c:1241544035,g:1-1-4242,d:STATION1,t:TEST*65\\"
+	   "!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13"};
+
+class Test_io_nmea_framer : public ::testing::Test
+{
+public:
+	static std::vector<std::string> feed(
+		io::nmea_framer & framer, const std::string & data, std::size_t chunk)
+	{
+		std::vector<std::string> result;
+		for (std::size_t i = 0; i < data.size(); i += chunk)
+			framer.feed(data.data() + i, std::min(chunk, data.size() - i),
+				[&result](const std::string & s) { result.push_back(s); });
+		return result;
+	}
+};
+
+TEST_F(Test_io_nmea_framer, feed_characters)
+{
+	io::nmea_framer framer;
+
+	int num_sentences = 0;
+	for (auto c : DATA_COMPLETE) {
+		if (framer.feed(c) == io::nmea_framer::status::complete) {
+			++num_sentences;
+			EXPECT_EQ(68u, framer.sentence().size());
+		}
+	}
+	EXPECT_EQ(3, num_sentences);
+}
+
+TEST_F(Test_io_nmea_framer, feed_chunks)
+{
+	for (std::size_t chunk : {1u, 7u, 68u, 70u, 1000u}) {
+		io::nmea_framer framer;
+		const auto result = feed(framer, DATA_COMPLETE, chunk);
+
+		ASSERT_EQ(3u, result.size()) << "chunk=" << chunk;
+		EXPECT_EQ(DATA_COMPLETE.substr(70, 68), result[1]);
+	}
+}
+
+TEST_F(Test_io_nmea_framer, ignore_empty_lines_and_control_characters)
+{
+	io::nmea_framer framer;
+	const auto result = feed(framer, "\r\n\n\t$GPXXX,1*00\x01\r\n\r\n", 1000);
+
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ("$GPXXX,1*00", result[0]);
+}
+
+TEST_F(Test_io_nmea_framer, overflow_resynchronizes)
+{
+	io::nmea_framer framer;
+	const auto result = feed(framer, DATA_MISSING_EOL, 1000);
+
+	EXPECT_EQ(1u, framer.get_overflows());
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ(68u, result[0].size());
+}
+
+TEST_F(Test_io_nmea_framer, tag_block)
+{
+	ASSERT_LT(100u, TAGGED_VDM.size());
+
+	io::nmea_framer framer;
+	const auto result = feed(framer, TAGGED_VDM + "\r\n" + DATA_COMPLETE, 1000);
+
+	EXPECT_EQ(0u, framer.get_overflows());
+	ASSERT_EQ(4u, result.size());
+	EXPECT_EQ(TAGGED_VDM, result[0]);
+}
+
+TEST_F(Test_io_nmea_framer, tag_block_too_long)
+{
+	io::nmea_framer framer{82, 16};
+	const auto result = feed(framer, TAGGED_VDM + "\r\n" + DATA_COMPLETE, 1000);
+
+	EXPECT_EQ(1u, framer.get_overflows());
+	EXPECT_EQ(3u, result.size());
+}
+
+TEST_F(Test_io_nmea_framer, tag_block_allowance_only_for_tag_blocks)
+{
+	io::nmea_framer framer{82, 200};
+	const auto result = feed(framer, DATA_MISSING_EOL, 1000);
+
+	EXPECT_EQ(1u, framer.get_overflows());
+	EXPECT_EQ(1u, result.size());
+}
+
+TEST_F(Test_io_nmea_framer, max_length)
+{
+	io::nmea_framer framer{10, 0};
+	const auto result = feed(framer, "$GPXXX*00\r\n$GPXXXXX*00\r\n\\c:1*00\\$GPX*00\r\n", 1000);
+
+	EXPECT_EQ(2u, framer.get_overflows());
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ("$GPXXX*00", result[0]);
+}
+
+TEST_F(Test_io_nmea_framer, overflow_status)
+{
+	io::nmea_framer framer;
+
+	int overflows = 0;
+	for (auto c : DATA_MISSING_EOL)
+		if (framer.feed(c) == io::nmea_framer::status::overflow)
+			++overflows;
+	EXPECT_EQ(1, overflows);
+}
+
+TEST_F(Test_io_nmea_framer, reset)
+{
+	io::nmea_framer framer;
+	feed(framer, "$GPRMC,202451,A", 1000);
+	framer.reset();
+	const auto result = feed(framer, "$GPXXX*00\r\n", 1000);
+
+	ASSERT_EQ(1u, result.size());
+	EXPECT_EQ("$GPXXX*00", result[0]);
+}
+
+TEST_F(Test_io_nmea_framer, timestamp_of_first_character)
+{
+	using clock = io::nmea_framer::clock;
+	const clock::time_point t0{std::chrono::milliseconds{100}};
+	const clock::time_point t1{std::chrono::milliseconds{200}};
+	const clock::time_point t2{std::chrono::milliseconds{300}};
+
+	io::nmea_framer framer;
+	std::vector<clock::time_point> result;
+	const auto handler = [&](const std::string &) { result.push_back(framer.timestamp()); };
+
+	framer.feed("$GPXXX", 6, t0, handler);
+	framer.feed("*00\r\n$GP", 8, t1, handler);
+	framer.feed("YYY*00\r\n", 8, t2, handler);
+
+	ASSERT_EQ(2u, result.size());
+	EXPECT_TRUE(t0 == result[0]);
+	EXPECT_TRUE(t1 == result[1]);
+}
+
+TEST_F(Test_io_nmea_framer, timestamp_without_time)
+{
+	io::nmea_framer framer;
+	feed(framer, "$GPXXX*00\r\n", 1000);
+	EXPECT_TRUE(io::nmea_framer::clock::time_point{} == framer.timestamp());
+}
+}
@@ -159,6 +159,52 @@ TEST_F(Test_io_nmea_reader, read_count_sentences)
 	EXPECT_EQ(3, device.get_num_sentences());
 }
 
+TEST_F(Test_io_nmea_reader, metrics)
+{
+	using event = io::stream_metrics::event;
+
+	const std::string data = DATA_MISSING_EOL + DATA_COMPLETE;
+	dummy_reader device{data};
+	auto metrics = std::make_shared<io::stream_metrics>();
+	device.set_metrics(metrics);
+
+	int overflows = 0;
+	for (;;) {
+		try {
+			if (!device.read())
+				break;
+		} catch (std::length_error &) {
+			++overflows;
+		}
+	}
+
+	const auto s = metrics->get();
+	EXPECT_EQ(1, overflows);
+	EXPECT_EQ(data.size(), s.get(event::bytes));
+	EXPECT_EQ(1u, s.get(event::overflows));
+	EXPECT_EQ(3u, s.get(event::frames));
+	EXPECT_EQ(0u, s.get(event::filtered));
+	EXPECT_EQ(3, device.get_num_sentences());
+}
+
+TEST_F(Test_io_nmea_reader, metrics_filtered)
+{
+	using event = io::stream_metrics::event;
+
+	dummy_reader device{DATA_COMPLETE};
+	auto metrics = std::make_shared<io::stream_metrics>();
+	device.set_metrics(metrics);
+	device.set_filter(nmea::sentence_filter{nmea::sentence_id::MTW});
+
+	while (device.read())
+		;
+
+	const auto s = metrics->get();
+	EXPECT_EQ(3u, s.get(event::frames));
+	EXPECT_EQ(3u, s.get(event::filtered));
+	EXPECT_EQ(0, device.get_num_sentences());
+}
+
 TEST_F(Test_io_nmea_reader, read_sentence)
 {
 	message_reader dev{DATA_COMPLETE};
@@ -236,4 +282,27 @@ TEST_F(Test_io_nmea_reader, read_after_close)
 
 	ASSERT_THROW(dev.read(), std::runtime_error);
 }
+TEST_F(Test_io_nmea_reader, filter)
+{
+	dummy_reader dev{DATA_COMPLETE + "$IIMTW,9.5,C*2F\r\n"};
+	dev.set_filter(nmea::sentence_filter{nmea::sentence_id::MTW});
+
+	while (dev.read()) {
+	}
+
+	EXPECT_EQ(1, dev.get_num_sentences());
+}
+
+TEST_F(Test_io_nmea_reader, filter_talker)
+{
+	dummy_reader dev{DATA_COMPLETE + "$IIMTW,9.5,C*2F\r\n"};
+	nmea::sentence_filter f;
+	f.add(nmea::talker::global_positioning_system);
+	dev.set_filter(f);
+
+	while (dev.read()) {
+	}
+
+	EXPECT_EQ(3, dev.get_num_sentences());
+}
 }
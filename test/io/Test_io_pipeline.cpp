@@ -0,0 +1,366 @@
+#include <gtest/gtest.h>
+#include <marnav/io/pipeline.hpp>
+#include <marnav/nmea/mtw.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/utils/unique.hpp>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <cstring>
+
+namespace
+{
+
+using namespace marnav;
+
+/// Delivers the data in small chunks, then reports end of file.
+class memory_device : public io::device
+{
+public:
+	memory_device(const std::string & data)
+		: data_(data)
+	{
+	}
+
+	void open() override {}
+	void close() override {}
+
+	virtual int read(char * buffer, uint32_t size) override
+	{
+		const std::size_t n = std::min<std::size_t>({size, data_.size() - pos_, 37});
+		std::memcpy(buffer, data_.data() + pos_, n);
+		pos_ += n;
+		return static_cast<int>(n);
+	}
+
+	virtual int write(const char *, uint32_t) override
+	{
+		throw std::runtime_error{"operation not supported"};
+	}
+
+private:
+	std::string data_;
+	std::size_t pos_ = 0;
+};
+
+class Test_io_pipeline : public ::testing::Test
+{
+public:
+	/// Returns `n` MTW sentences, the temperatures are the sequence number.
+	static std::string make_data(int n)
+	{
+		std::string s;
+		for (int i = 0; i < n; ++i) {
+			nmea::mtw mtw;
+			mtw.set_temperature(units::celsius{static_cast<double>(i)});
+			s += nmea::to_string(mtw) + "\r\n";
+		}
+		return s;
+	}
+
+	static int sequence(const io::pipeline::result & r)
+	{
+		const auto mtw = nmea::sentence_cast<nmea::mtw>(r.sentence.get());
+		return static_cast<int>(mtw->get_temperature().get<units::celsius>().value());
+	}
+
+	/// Polls until the pipeline is done, the handler is called for every result.
+	static void run(io::pipeline & p, const io::pipeline::handler & h)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{30};
+		while (!p.done() && (std::chrono::steady_clock::now() < deadline)) {
+			if (p.poll(h) == 0)
+				std::this_thread::yield();
+		}
+		p.poll(h);
+	}
+};
+
+TEST_F(Test_io_pipeline, invalid_options)
+{
+	using options = io::pipeline::options;
+	EXPECT_ANY_THROW(io::pipeline(options{0, 16, io::pipeline::backpressure::block}));
+	EXPECT_ANY_THROW(io::pipeline(options{1, 0, io::pipeline::backpressure::block}));
+}
+
+TEST_F(Test_io_pipeline, invalid_device)
+{
+	io::pipeline p;
+	EXPECT_ANY_THROW(p.add(nullptr));
+	EXPECT_EQ(0u, p.size());
+}
+
+TEST_F(Test_io_pipeline, add_while_running)
+{
+	io::pipeline p;
+	p.add(utils::make_unique<memory_device>(make_data(1)));
+	p.start();
+	EXPECT_ANY_THROW(p.add(utils::make_unique<memory_device>(make_data(1))));
+	p.stop();
+}
+
+TEST_F(Test_io_pipeline, not_done_before_start)
+{
+	io::pipeline p;
+	p.add(utils::make_unique<memory_device>(make_data(1)));
+	EXPECT_FALSE(p.done());
+}
+
+TEST_F(Test_io_pipeline, unknown_source_stats)
+{
+	io::pipeline p;
+	EXPECT_ANY_THROW(p.get_stats(0));
+}
+
+TEST_F(Test_io_pipeline, single_source_in_order)
+{
+	static const int n = 500;
+	io::pipeline p;
+	const auto id = p.add(utils::make_unique<memory_device>(make_data(n)));
+	p.start();
+
+	int expected = 0;
+	run(p, [&](io::pipeline::result && r) {
+		EXPECT_EQ(id, r.source);
+		ASSERT_TRUE(r.sentence != nullptr);
+		EXPECT_EQ(expected, sequence(r));
+		EXPECT_TRUE(r.message == nullptr);
+		++expected;
+	});
+	p.stop();
+
+	EXPECT_EQ(n, expected);
+	const auto s = p.get_stats(id);
+	EXPECT_EQ(static_cast<uint64_t>(n), s.input.processed);
+	EXPECT_EQ(static_cast<uint64_t>(n), s.output.processed);
+	EXPECT_EQ(0u, s.input.dropped);
+	EXPECT_EQ(0u, s.output.dropped);
+	EXPECT_EQ(0u, s.input.depth);
+	EXPECT_EQ(0u, s.output.depth);
+	EXPECT_LE(1u, s.input.max_depth);
+	EXPECT_EQ(0u, s.errors);
+}
+
+TEST_F(Test_io_pipeline, many_sources_many_workers_in_order_per_source)
+{
+	static const int n = 300;
+	static const std::size_t num_sources = 5;
+	io::pipeline p{io::pipeline::options{3, 32, io::pipeline::backpressure::block}};
+	for (std::size_t i = 0; i < num_sources; ++i)
+		p.add(utils::make_unique<memory_device>(make_data(n)));
+	p.start();
+
+	std::map<io::pipeline::source_id, int> expected;
+	run(p, [&](io::pipeline::result && r) {
+		ASSERT_TRUE(r.sentence != nullptr);
+		EXPECT_EQ(expected[r.source], sequence(r));
+		++expected[r.source];
+	});
+	p.stop();
+
+	ASSERT_EQ(num_sources, expected.size());
+	for (const auto & e : expected)
+		EXPECT_EQ(n, e.second);
+}
+
+TEST_F(Test_io_pipeline, ais_message_assembled)
+{
+	const std::string data
+		= "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E\r\n"
+		  "!AIVDM,2,2,3,B,1@0000000000000,2*55\r\n";
+
+	io::pipeline p;
+	p.add(utils::make_unique<memory_device>(data));
+	p.start();
+
+	std::vector<io::pipeline::result> results;
+	run(p, [&](io::pipeline::result && r) { results.push_back(std::move(r)); });
+	p.stop();
+
+	ASSERT_EQ(2u, results.size());
+	EXPECT_EQ(nmea::sentence_id::VDM, results[0].sentence->id());
+	EXPECT_TRUE(results[0].message == nullptr);
+	EXPECT_EQ(nmea::sentence_id::VDM, results[1].sentence->id());
+	ASSERT_TRUE(results[1].message != nullptr);
+	EXPECT_EQ(ais::message_id::static_and_voyage_related_data, results[1].message->type());
+}
+
+TEST_F(Test_io_pipeline, long_tag_block)
+{
+	const std::string data
+		= "\\s:r003669945,c:1241544035,g:1-1-4242,d:STATION1,t:TEST*65\\"
+		  "!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13\r\n";
+	ASSERT_LT(100u, data.size());
+
+	io::pipeline p;
+	const auto id = p.add(utils::make_unique<memory_device>(data));
+	p.start();
+
+	std::vector<io::pipeline::result> results;
+	run(p, [&](io::pipeline::result && r) { results.push_back(std::move(r)); });
+	p.stop();
+
+	EXPECT_EQ(0u, p.get_stats(id).overflows);
+	ASSERT_EQ(1u, results.size());
+	EXPECT_EQ(nmea::sentence_id::VDM, results[0].sentence->id());
+	EXPECT_TRUE(results[0].message != nullptr);
+}
+
+TEST_F(Test_io_pipeline, invalid_sentences_counted_as_errors)
+{
+	const std::string data = "$IIMTW,9.5,C*2F\r\n"
+							 "$IIMTW,9.5,C*00\r\n"
+							 "garbage\r\n"
+							 "$IIMTW,9.5,C*2F\r\n";
+
+	io::pipeline p;
+	const auto id = p.add(utils::make_unique<memory_device>(data));
+	p.start();
+
+	int count = 0;
+	run(p, [&](io::pipeline::result &&) { ++count; });
+	p.stop();
+
+	EXPECT_EQ(2, count);
+	EXPECT_EQ(2u, p.get_stats(id).errors);
+}
+
+TEST_F(Test_io_pipeline, unsupported_ais_message_delivered_without_message)
+{
+	// type 15 (interrogation) is not supported
+	const std::string data = "!AIVDM,1,1,,B,?03OwnB0ACVlD00,2*43\r\n"
+							 "!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13\r\n";
+
+	io::pipeline p;
+	const auto id = p.add(utils::make_unique<memory_device>(data));
+	p.start();
+
+	std::vector<io::pipeline::result> results;
+	run(p, [&](io::pipeline::result && r) { results.push_back(std::move(r)); });
+	p.stop();
+
+	ASSERT_EQ(2u, results.size());
+	EXPECT_EQ(nmea::sentence_id::VDM, results[0].sentence->id());
+	EXPECT_TRUE(results[0].message == nullptr);
+	ASSERT_TRUE(results[1].message != nullptr);
+	EXPECT_EQ(ais::message_id::position_report_class_a, results[1].message->type());
+
+	const auto s = p.get_stats(id);
+	EXPECT_EQ(0u, s.errors);
+	EXPECT_EQ(1u, s.ais_errors);
+	EXPECT_EQ(1u, p.get_metrics(id)->get().get(io::stream_metrics::event::ais_errors));
+}
+
+TEST_F(Test_io_pipeline, metrics)
+{
+	using event = io::stream_metrics::event;
+
+	const std::string data
+		= "$IIMTW,9.5,C*2F\r\n"
+		  "$IIMTW,9.5,C*00\r\n"
+		  "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E\r\n"
+		  "!AIVDM,2,2,3,B,1@0000000000000,2*55\r\n";
+
+	io::pipeline p;
+	const auto id = p.add(utils::make_unique<memory_device>(data));
+	EXPECT_THROW(p.get_metrics(id + 1), std::out_of_range);
+	p.start();
+	run(p, [](io::pipeline::result &&) {});
+	p.stop();
+
+	const auto s = p.get_metrics(id)->get();
+	EXPECT_EQ(data.size(), s.get(event::bytes));
+	EXPECT_EQ(4u, s.get(event::frames));
+	EXPECT_EQ(1u, s.get(event::checksum_errors));
+	ASSERT_EQ(2u, s.sentences.size());
+	EXPECT_EQ(nmea::sentence_id::MTW, s.sentences[0].id);
+	EXPECT_EQ(1u, s.sentences[0].latency.count);
+	EXPECT_EQ(nmea::sentence_id::VDM, s.sentences[1].id);
+	EXPECT_EQ(2u, s.sentences[1].latency.count);
+	ASSERT_EQ(1u, s.messages.size());
+	EXPECT_EQ(ais::message_id::static_and_voyage_related_data, s.messages[0].id);
+}
+
+TEST_F(Test_io_pipeline, filtered_sentences)
+{
+	const std::string data = "$IIMTW,9.5,C*2F\r\n"
+							 "$PGRME,22.0,M,52.9,M,51.0,M*14\r\n"
+							 "$IIMTW,9.5,C*2F\r\n";
+
+	io::pipeline p;
+	const auto id = p.add(utils::make_unique<memory_device>(data));
+	p.set_filter(nmea::sentence_filter{nmea::sentence_id::MTW});
+	p.start();
+	EXPECT_THROW(p.set_filter(nmea::sentence_filter{}), std::logic_error);
+
+	int count = 0;
+	run(p, [&](io::pipeline::result && r) {
+		EXPECT_EQ(nmea::sentence_id::MTW, r.sentence->id());
+		++count;
+	});
+	p.stop();
+
+	EXPECT_EQ(2, count);
+	EXPECT_EQ(1u, p.get_stats(id).filtered);
+	EXPECT_EQ(0u, p.get_stats(id).errors);
+}
+
+TEST_F(Test_io_pipeline, drop_newest_without_consumer)
+{
+	static const int n = 200;
+	io::pipeline p{io::pipeline::options{1, 8, io::pipeline::backpressure::drop_newest}};
+	const auto id = p.add(utils::make_unique<memory_device>(make_data(n)));
+	p.start();
+
+	// results are not consumed, until all data is processed
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{30};
+	while (!p.done() && (std::chrono::steady_clock::now() < deadline)
+		&& (p.get_stats(id).input.processed + p.get_stats(id).input.dropped
+			< static_cast<uint64_t>(n)))
+		std::this_thread::yield();
+
+	int count = 0;
+	int last = -1;
+	run(p, [&](io::pipeline::result && r) {
+		EXPECT_LT(last, sequence(r));
+		last = sequence(r);
+		++count;
+	});
+	p.stop();
+
+	// at most both rings are full, everything else was dropped
+	const auto s = p.get_stats(id);
+	EXPECT_LE(static_cast<uint64_t>(n - 16), s.input.dropped + s.output.dropped);
+	EXPECT_EQ(static_cast<uint64_t>(n), count + s.input.dropped + s.output.dropped);
+}
+
+TEST_F(Test_io_pipeline, drop_oldest_keeps_newest)
+{
+	static const int n = 200;
+	io::pipeline p{io::pipeline::options{1, 8, io::pipeline::backpressure::drop_oldest}};
+	const auto id = p.add(utils::make_unique<memory_device>(make_data(n)));
+	p.start();
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{30};
+	while (!p.done() && (std::chrono::steady_clock::now() < deadline)
+		&& (p.get_stats(id).input.processed + p.get_stats(id).input.dropped
+			< static_cast<uint64_t>(n)))
+		std::this_thread::yield();
+
+	int count = 0;
+	int last = -1;
+	run(p, [&](io::pipeline::result && r) {
+		EXPECT_LT(last, sequence(r));
+		last = sequence(r);
+		++count;
+	});
+	p.stop();
+
+	const auto s = p.get_stats(id);
+	EXPECT_EQ(n - 1, last);
+	EXPECT_LE(static_cast<uint64_t>(n - 16), s.input.dropped + s.output.dropped);
+	EXPECT_EQ(static_cast<uint64_t>(n), count + s.input.dropped + s.output.dropped);
+}
+}
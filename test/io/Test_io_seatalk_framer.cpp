@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <marnav/io/seatalk_framer.hpp>
+#include <vector>
+
+namespace
+{
+
+using namespace marnav;
+
+// see Test_io_seatalk_reader.cpp for a description of the data
+static const uint8_t DATA[] = {
+	// preliminary garbage
+	0x01, 0xff, 0x00, 0x00, 0x01,
+
+	// depth
+	0x00, 0x02, 0xff, 0x00, 0x60, 0xff, 0x00, 0x65, 0xff, 0x00, 0x00,
+
+	// water temperature
+	0x27, 0x01, 0x64, 0xff, 0x00, 0x00,
+
+	// apparent wind speed, collision with water temperature
+	0x11, 0x01, 0x27, 0x01, 0x64, 0xff, 0x00, 0x00,
+};
+
+class Test_io_seatalk_framer : public ::testing::Test
+{
+};
+
+TEST_F(Test_io_seatalk_framer, feed)
+{
+	io::seatalk_framer framer;
+	std::vector<seatalk::raw> result;
+	framer.feed(DATA, sizeof(DATA), [&result](const seatalk::raw & m) { result.push_back(m); });
+
+	ASSERT_EQ(3u, result.size());
+	EXPECT_EQ((seatalk::raw{0x00, 0x02, 0x60, 0x65, 0x00}), result[0]);
+	EXPECT_EQ((seatalk::raw{0x27, 0x01, 0x64, 0x00}), result[1]);
+	EXPECT_EQ((seatalk::raw{0x27, 0x01, 0x64, 0x00}), result[2]);
+	EXPECT_EQ(1u, framer.get_collisions());
+}
+
+TEST_F(Test_io_seatalk_framer, feed_bytes_same_as_chunk)
+{
+	io::seatalk_framer framer;
+
+	int num_messages = 0;
+	for (auto c : DATA) {
+		if (framer.feed(c) == io::seatalk_framer::status::complete) {
+			++num_messages;
+			EXPECT_FALSE(framer.message().empty());
+		}
+	}
+	EXPECT_EQ(3, num_messages);
+}
+
+TEST_F(Test_io_seatalk_framer, invalid_escape)
+{
+	io::seatalk_framer framer;
+
+	EXPECT_EQ(io::seatalk_framer::status::none, framer.feed(0xff));
+	EXPECT_EQ(io::seatalk_framer::status::error, framer.feed(0x12));
+	EXPECT_EQ(1u, framer.get_errors());
+
+	// recovers
+	std::vector<seatalk::raw> result;
+	framer.feed(DATA, sizeof(DATA), [&result](const seatalk::raw & m) { result.push_back(m); });
+	EXPECT_EQ(3u, result.size());
+}
+
+TEST_F(Test_io_seatalk_framer, timestamp_of_first_byte)
+{
+	using clock = io::seatalk_framer::clock;
+	const clock::time_point t0{std::chrono::milliseconds{100}};
+	const clock::time_point t1{std::chrono::milliseconds{200}};
+
+	// water temperature, command byte and attribute byte in the first chunk
+	static const uint8_t chunk0[] = {0x27, 0x01};
+	static const uint8_t chunk1[] = {0x64, 0xff, 0x00, 0x00};
+
+	io::seatalk_framer framer;
+	std::vector<clock::time_point> result;
+	const auto handler = [&](const seatalk::raw &) { result.push_back(framer.timestamp()); };
+	framer.feed(chunk0, sizeof(chunk0), t0, handler);
+	framer.feed(chunk1, sizeof(chunk1), t1, handler);
+
+	ASSERT_EQ(1u, result.size());
+	EXPECT_TRUE(t0 == result[0]);
+}
+}
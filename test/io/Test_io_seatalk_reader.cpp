@@ -193,6 +193,23 @@ TEST_F(Test_io_seatalk_reader, read_count_messages_and_collisions)
 	EXPECT_EQ(1u, device.get_collisions());
 }
 
+TEST_F(Test_io_seatalk_reader, metrics)
+{
+	using event = io::stream_metrics::event;
+
+	dummy_reader device;
+	auto metrics = std::make_shared<io::stream_metrics>();
+	device.set_metrics(metrics);
+
+	while (device.read())
+		;
+
+	const auto s = metrics->get();
+	EXPECT_EQ(9u, s.get(event::frames));
+	EXPECT_EQ(1u, s.get(event::collisions));
+	EXPECT_LT(0u, s.get(event::bytes));
+}
+
 TEST_F(Test_io_seatalk_reader, read_message)
 {
 	message_reader dev;
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <marnav/io/serial.hpp>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+/// Provides a pseudo terminal, the test writes to the master side,
+/// the serial device opens the slave side.
+class Test_io_serial : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		master = ::posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+		ASSERT_LE(0, master);
+		ASSERT_EQ(0, ::grantpt(master));
+		ASSERT_EQ(0, ::unlockpt(master));
+		slave = ::ptsname(master);
+	}
+
+	void TearDown() override
+	{
+		if (master >= 0)
+			::close(master);
+	}
+
+	io::serial make_serial() const
+	{
+		return io::serial{slave, io::serial::baud::baud_4800, io::serial::databits::bit_8,
+			io::serial::stopbits::bit_1, io::serial::parity::none};
+	}
+
+	int master = -1;
+	std::string slave;
+};
+
+TEST_F(Test_io_serial, default_read_options)
+{
+	auto dev = make_serial();
+	const auto & opt = dev.get_read_options();
+	EXPECT_EQ(1u, opt.min_chars);
+	EXPECT_EQ(0u, opt.timeout);
+	EXPECT_FALSE(opt.non_blocking);
+	EXPECT_FALSE(opt.low_latency);
+}
+
+TEST_F(Test_io_serial, read_options_applied_on_open)
+{
+	io::serial::read_options opt;
+	opt.min_chars = 0;
+	opt.timeout = 5;
+	opt.non_blocking = true;
+	opt.low_latency = true; // not supported by pseudo terminals, must not fail
+
+	auto dev = make_serial();
+	dev.set_read_options(opt);
+	dev.open();
+
+	termios tio;
+	ASSERT_EQ(0, ::tcgetattr(dev.get_fd(), &tio));
+	EXPECT_EQ(0u, tio.c_cc[VMIN]);
+	EXPECT_EQ(5u, tio.c_cc[VTIME]);
+	EXPECT_TRUE((::fcntl(dev.get_fd(), F_GETFL) & O_NONBLOCK) != 0);
+}
+
+TEST_F(Test_io_serial, read_options_applied_to_open_device)
+{
+	auto dev = make_serial();
+	dev.open();
+	EXPECT_FALSE((::fcntl(dev.get_fd(), F_GETFL) & O_NONBLOCK) != 0);
+
+	io::serial::read_options opt;
+	opt.non_blocking = true;
+	dev.set_read_options(opt);
+	EXPECT_TRUE((::fcntl(dev.get_fd(), F_GETFL) & O_NONBLOCK) != 0);
+
+	opt.non_blocking = false;
+	dev.set_read_options(opt);
+	EXPECT_FALSE((::fcntl(dev.get_fd(), F_GETFL) & O_NONBLOCK) != 0);
+}
+
+TEST_F(Test_io_serial, non_blocking_read_without_data)
+{
+	io::serial::read_options opt;
+	opt.non_blocking = true;
+
+	auto dev = make_serial();
+	dev.set_read_options(opt);
+	dev.open();
+
+	char buffer[16];
+	io::serial::clock::time_point t;
+	errno = 0;
+	EXPECT_EQ(-1, dev.read(buffer, sizeof(buffer), t));
+	EXPECT_EQ(EAGAIN, errno);
+	EXPECT_TRUE(io::serial::clock::time_point{} == t);
+}
+
+TEST_F(Test_io_serial, read_with_timestamp)
+{
+	auto dev = make_serial();
+	dev.open();
+
+	const auto before = io::serial::clock::now();
+	ASSERT_EQ(5, ::write(master, "$GPXX", 5));
+
+	char buffer[16];
+	io::serial::clock::time_point t;
+	const int rc = dev.read(buffer, sizeof(buffer), t);
+	const auto after = io::serial::clock::now();
+
+	ASSERT_LT(0, rc);
+	EXPECT_EQ('$', buffer[0]);
+	EXPECT_TRUE(before <= t);
+	EXPECT_TRUE(t <= after);
+}
+}
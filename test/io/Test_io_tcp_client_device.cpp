@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <marnav/io/nmea_framer.hpp>
+#include <marnav/io/tcp_client_device.hpp>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+/// Provides a listening socket on the loopback interface.
+class Test_io_tcp_client_device : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		server = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		ASSERT_LE(0, server);
+
+		sockaddr_in addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = 0;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		ASSERT_EQ(0, ::bind(server, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)));
+		ASSERT_EQ(0, ::listen(server, 1));
+
+		socklen_t len = sizeof(addr);
+		ASSERT_EQ(0, ::getsockname(server, reinterpret_cast<sockaddr *>(&addr), &len));
+		port = ntohs(addr.sin_port);
+	}
+
+	void TearDown() override
+	{
+		if (client >= 0)
+			::close(client);
+		if (server >= 0)
+			::close(server);
+	}
+
+	void accept()
+	{
+		client = ::accept(server, nullptr, nullptr);
+		ASSERT_LE(0, client);
+	}
+
+	void send(const std::string & s)
+	{
+		ASSERT_EQ(static_cast<ssize_t>(s.size()), ::send(client, s.data(), s.size(), 0));
+	}
+
+	int server = -1;
+	int client = -1;
+	uint16_t port = 0;
+};
+
+TEST_F(Test_io_tcp_client_device, read_not_open)
+{
+	io::tcp_client_device dev{"127.0.0.1", port};
+	char buffer[16];
+	EXPECT_ANY_THROW(dev.read(buffer, sizeof(buffer)));
+}
+
+TEST_F(Test_io_tcp_client_device, connection_refused)
+{
+	::close(server);
+	server = -1;
+
+	io::tcp_client_device dev{"127.0.0.1", port};
+	EXPECT_ANY_THROW(dev.open());
+}
+
+TEST_F(Test_io_tcp_client_device, read)
+{
+	io::tcp_client_device dev{"127.0.0.1", port};
+	dev.open();
+	accept();
+	send("$GPAAA*00\r\n");
+
+	char buffer[64];
+	std::string s;
+	while (s.size() < 11u) {
+		const int rc = dev.read(buffer, sizeof(buffer));
+		ASSERT_LT(0, rc);
+		s.append(buffer, rc);
+	}
+	EXPECT_EQ("$GPAAA*00\r\n", s);
+}
+
+TEST_F(Test_io_tcp_client_device, receive_into_framer)
+{
+	io::tcp_client_device dev{"localhost", port};
+	dev.open();
+	accept();
+	send("$GPAAA*00\r\n$GPBBB*00\r\n");
+	::shutdown(client, SHUT_WR);
+
+	io::nmea_framer framer;
+	std::vector<std::string> sentences;
+	while (dev.receive([&](const char * data, std::size_t size) {
+		framer.feed(data, size, [&](const std::string & s) { sentences.push_back(s); });
+	}) > 0) {
+	}
+
+	ASSERT_EQ(2u, sentences.size());
+	EXPECT_EQ("$GPAAA*00", sentences[0]);
+	EXPECT_EQ("$GPBBB*00", sentences[1]);
+}
+
+TEST_F(Test_io_tcp_client_device, write)
+{
+	io::tcp_client_device dev{"127.0.0.1", port};
+	dev.open();
+	accept();
+
+	EXPECT_EQ(5, dev.write("hello", 5));
+
+	char buffer[16];
+	const auto rc = ::recv(client, buffer, sizeof(buffer), 0);
+	ASSERT_EQ(5, rc);
+	EXPECT_EQ("hello", std::string(buffer, rc));
+}
+
+TEST_F(Test_io_tcp_client_device, move)
+{
+	io::tcp_client_device dev{"127.0.0.1", port};
+	dev.open();
+	const int fd = dev.get_fd();
+
+	io::tcp_client_device other{std::move(dev)};
+	EXPECT_EQ(fd, other.get_fd());
+	EXPECT_EQ(-1, dev.get_fd());
+}
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <marnav/io/nmea_framer.hpp>
+#include <marnav/io/udp_device.hpp>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace marnav;
+
+class Test_io_udp_device : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		sender = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+		ASSERT_LE(0, sender);
+	}
+
+	void TearDown() override
+	{
+		if (sender >= 0)
+			::close(sender);
+	}
+
+	void send(const io::udp_device & dev, const std::string & s)
+	{
+		sockaddr_in addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(dev.get_port());
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		ASSERT_EQ(static_cast<ssize_t>(s.size()),
+			::sendto(sender, s.data(), s.size(), 0, reinterpret_cast<sockaddr *>(&addr),
+				sizeof(addr)));
+	}
+
+	int sender = -1;
+};
+
+TEST_F(Test_io_udp_device, read_not_open)
+{
+	io::udp_device dev{"127.0.0.1", 0};
+	char buffer[16];
+	EXPECT_ANY_THROW(dev.read(buffer, sizeof(buffer)));
+}
+
+TEST_F(Test_io_udp_device, invalid_address)
+{
+	io::udp_device dev{"not-an-address.invalid", 0};
+	EXPECT_ANY_THROW(dev.open());
+}
+
+TEST_F(Test_io_udp_device, system_chosen_port)
+{
+	io::udp_device dev{"127.0.0.1", 0};
+	dev.open();
+	EXPECT_LE(0, dev.get_fd());
+	EXPECT_NE(0u, dev.get_port());
+}
+
+TEST_F(Test_io_udp_device, receive_batch_of_datagrams)
+{
+	io::udp_device dev{"127.0.0.1", 0};
+	dev.open();
+
+	send(dev, "$GPAAA*00\r\n");
+	send(dev, "$GPBBB*00\r\n");
+	send(dev, "$GPCCC*00\r\n");
+
+	std::vector<std::string> datagrams;
+	const int rc = dev.receive(
+		[&](const char * data, std::size_t size) { datagrams.emplace_back(data, size); });
+
+	EXPECT_EQ(3, rc);
+	ASSERT_EQ(3u, datagrams.size());
+	EXPECT_EQ("$GPAAA*00\r\n", datagrams[0]);
+	EXPECT_EQ("$GPBBB*00\r\n", datagrams[1]);
+	EXPECT_EQ("$GPCCC*00\r\n", datagrams[2]);
+}
+
+TEST_F(Test_io_udp_device, receive_into_framer)
+{
+	io::udp_device dev{"127.0.0.1", 0};
+	dev.open();
+
+	send(dev, "$GPAAA*00\r\n$GPBBB*00\r\n");
+
+	io::nmea_framer framer;
+	std::vector<std::string> sentences;
+	dev.receive([&](const char * data, std::size_t size) {
+		framer.feed(data, size, [&](const std::string & s) { sentences.push_back(s); });
+	});
+
+	ASSERT_EQ(2u, sentences.size());
+	EXPECT_EQ("$GPAAA*00", sentences[0]);
+	EXPECT_EQ("$GPBBB*00", sentences[1]);
+}
+
+TEST_F(Test_io_udp_device, read_concatenates_and_splits_datagrams)
+{
+	io::udp_device dev{"127.0.0.1", 0};
+	dev.open();
+
+	send(dev, "0123456789");
+	send(dev, "abcdef");
+
+	char buffer[8];
+	std::string s;
+	int rc = dev.read(buffer, sizeof(buffer));
+	ASSERT_EQ(8, rc);
+	s.append(buffer, rc);
+	while (s.size() < 16u) {
+		rc = dev.read(buffer, sizeof(buffer));
+		ASSERT_LT(0, rc);
+		s.append(buffer, rc);
+	}
+	EXPECT_EQ("0123456789abcdef", s);
+}
+
+TEST_F(Test_io_udp_device, truncated_datagrams_are_discarded)
+{
+	io::udp_device dev{"127.0.0.1", 0};
+	dev.open();
+	ASSERT_EQ(0, ::fcntl(dev.get_fd(), F_SETFL, ::fcntl(dev.get_fd(), F_GETFL) | O_NONBLOCK));
+
+	// only discarded datagrams, must not be mistaken for the end of file
+	send(dev, std::string(io::udp_device::max_datagram_size + 1, 'x'));
+	send(dev, std::string{});
+
+	char buffer[16];
+	errno = 0;
+	const int rc = dev.read(buffer, sizeof(buffer));
+	EXPECT_NE(0, rc);
+	EXPECT_EQ(-1, rc);
+	EXPECT_EQ(EAGAIN, errno);
+	EXPECT_EQ(1u, dev.get_truncated());
+
+	send(dev, std::string(io::udp_device::max_datagram_size + 1, 'x'));
+	send(dev, "$GPAAA*00\r\n");
+
+	std::vector<std::string> datagrams;
+	ASSERT_EQ(1, dev.receive([&](const char * data, std::size_t size) {
+		datagrams.emplace_back(data, size);
+	}));
+
+	ASSERT_EQ(1u, datagrams.size());
+	EXPECT_EQ("$GPAAA*00\r\n", datagrams[0]);
+	EXPECT_EQ(2u, dev.get_truncated());
+}
+
+TEST_F(Test_io_udp_device, write_not_supported)
+{
+	io::udp_device dev{"127.0.0.1", 0};
+	dev.open();
+	EXPECT_EQ(-1, dev.write("x", 1));
+	EXPECT_EQ(EBADF, errno);
+}
+}
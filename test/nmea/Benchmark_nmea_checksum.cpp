@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 #include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/scan.hpp>
+#include <string>
 
 namespace
 {
@@ -34,4 +36,36 @@ static void Benchmark_nmea_checksum_to_string(benchmark::State & state)
 
 BENCHMARK(Benchmark_nmea_checksum_to_string)->Range(0x00, 0xff);
 
+namespace
+{
+static const std::string SENTENCE
+	= "GPRMC,201126,A,4702.3944,N,00818.3381,E,0.0,328.4,260807,0.6,E,A*1E";
+}
+
+static void Benchmark_nmea_checksum_find_and_compute(benchmark::State & state)
+{
+	while (state.KeepRunning()) {
+		const auto end = SENTENCE.find_first_of('*');
+		auto sum = marnav::nmea::checksum(SENTENCE.begin(), SENTENCE.begin() + end);
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK(Benchmark_nmea_checksum_find_and_compute);
+
+template <marnav::nmea::detail::scan_function F>
+static void Benchmark_nmea_checksum_scan(benchmark::State & state)
+{
+	uint64_t mask[marnav::nmea::detail::scan_mask_size(128)];
+	while (state.KeepRunning()) {
+		auto r = F(SENTENCE.data(), SENTENCE.size(), state.range(0) ? mask : nullptr);
+		benchmark::DoNotOptimize(r);
+	}
+}
+
+BENCHMARK_TEMPLATE(Benchmark_nmea_checksum_scan, marnav::nmea::detail::scan_scalar)
+	->Arg(0)
+	->Arg(1);
+BENCHMARK_TEMPLATE(Benchmark_nmea_checksum_scan, marnav::nmea::detail::scan)->Arg(0)->Arg(1);
+
 BENCHMARK_MAIN()
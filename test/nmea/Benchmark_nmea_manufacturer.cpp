@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 #include <marnav/nmea/manufacturer.hpp>
+#include <marnav/nmea/talker_id.hpp>
 
 static void benchmark_get_manufacturer_name_from_id(benchmark::State & state)
 {
@@ -29,4 +30,40 @@ static void benchmark_get_supported_manufacturer_id(benchmark::State & state)
 
 BENCHMARK(benchmark_get_supported_manufacturer_id);
 
+static void benchmark_get_manufacturer_id_from_tag(benchmark::State & state)
+{
+	using namespace marnav;
+
+	std::vector<std::string> tags;
+	for (auto id : nmea::get_supported_manufacturer_id())
+		tags.push_back("P" + nmea::get_manufacturer_tag(id) + "A");
+
+	while (state.KeepRunning()) {
+		for (const auto & tag : tags) {
+			auto id = nmea::get_manufacturer_id(tag);
+			benchmark::DoNotOptimize(id);
+		}
+	}
+}
+
+BENCHMARK(benchmark_get_manufacturer_id_from_tag);
+
+static void benchmark_make_talker(benchmark::State & state)
+{
+	using namespace marnav;
+
+	std::vector<std::string> ids;
+	for (int i = 1; i <= static_cast<int>(nmea::talker::ais_physical_shore_station); ++i)
+		ids.push_back(nmea::to_string(static_cast<nmea::talker>(i)));
+
+	while (state.KeepRunning()) {
+		for (const auto & id : ids) {
+			auto t = nmea::make_talker(id);
+			benchmark::DoNotOptimize(t);
+		}
+	}
+}
+
+BENCHMARK(benchmark_make_talker);
+
 BENCHMARK_MAIN()
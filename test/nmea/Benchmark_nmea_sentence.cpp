@@ -1,5 +1,7 @@
+#include "allocation_counter.hpp"
 #include <benchmark/benchmark.h>
 #include <algorithm>
+#include <chrono>
 #include <typeindex>
 #include <marnav/nmea/aam.hpp>
 #include <marnav/nmea/alm.hpp>
@@ -76,6 +78,8 @@
 #include <marnav/nmea/ztg.hpp>
 #include <marnav/nmea/pgrme.hpp>
 #include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/binary_codec.hpp>
+#include <marnav/nmea/lazy_sentence.hpp>
 
 using namespace marnav;
 
@@ -202,10 +206,12 @@ template <class T> static void specific(benchmark::internal::Benchmark * b)
 static void Benchmark_make_sentence(benchmark::State & state)
 {
 	state.SetLabel(sentences[state.range(0)].tag);
+	const auto before = marnav_test::allocations_of_thread();
 	while (state.KeepRunning()) {
 		auto tmp = nmea::make_sentence(sentences[state.range(0)].text);
 		benchmark::DoNotOptimize(tmp);
 	}
+	marnav_test::set_allocation_counters(state, marnav_test::allocations_of_thread() - before);
 }
 
 BENCHMARK(Benchmark_make_sentence)->Apply(all_sentences);
@@ -213,14 +219,18 @@ BENCHMARK(Benchmark_make_sentence)->Apply(all_sentences);
 static void Benchmark_sentence_to_string(benchmark::State & state)
 {
 	state.SetLabel(sentences[state.range(0)].tag);
+	marnav_test::allocations allocs;
 	while (state.KeepRunning()) {
 		state.PauseTiming();
 		const auto raw = sentences[state.range(0)].text;
 		const auto sentence = nmea::make_sentence(raw);
+		const auto before = marnav_test::allocations_of_thread();
 		state.ResumeTiming();
 		std::string s = to_string(*sentence);
 		benchmark::DoNotOptimize(s);
+		allocs += marnav_test::allocations_of_thread() - before;
 	}
+	marnav_test::set_allocation_counters(state, allocs);
 }
 
 BENCHMARK(Benchmark_sentence_to_string)->Apply(all_sentences);
@@ -320,4 +330,108 @@ static void Benchmark_extract_id(benchmark::State & state)
 
 BENCHMARK(Benchmark_extract_id)->Apply(all_sentences);
 
+static void Benchmark_validate_sentence(benchmark::State & state)
+{
+	state.SetLabel(sentences[state.range(0)].tag);
+	while (state.KeepRunning()) {
+		auto tmp = nmea::validate_sentence(sentences[state.range(0)].text);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_validate_sentence)->Apply(all_sentences);
+
+static void Benchmark_tag_to_id(benchmark::State & state)
+{
+	const auto tags = nmea::get_supported_sentences_str();
+	while (state.KeepRunning()) {
+		for (const auto & tag : tags) {
+			auto tmp = nmea::tag_to_id(tag);
+			benchmark::DoNotOptimize(tmp);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tags.size()));
+}
+
+BENCHMARK(Benchmark_tag_to_id);
+
+static void Benchmark_lazy_sentence(benchmark::State & state)
+{
+	state.SetLabel(sentences[state.range(0)].tag);
+	while (state.KeepRunning()) {
+		nmea::lazy_sentence tmp{sentences[state.range(0)].text};
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_lazy_sentence)->Apply(all_sentences);
+
+/// Returns the average time of one call of the function in seconds.
+template <class F> static double time_per_call(F f)
+{
+	constexpr int n = 1000;
+	const auto t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < n; ++i)
+		f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() / n;
+}
+
+/// Sentences registered with binary support are read directly from the binary
+/// fields, all others from text. The counter `speedup` is relative to `make_sentence`.
+static void Benchmark_decode_binary(benchmark::State & state)
+{
+	state.SetLabel(sentences[state.range(0)].tag);
+	const auto & text = sentences[state.range(0)].text;
+	const auto data = nmea::encode_binary(*nmea::make_sentence(text));
+	double speedup = 0.0;
+	try {
+		const auto t_text = time_per_call([&text] {
+			auto tmp = nmea::make_sentence(text);
+			benchmark::DoNotOptimize(tmp);
+		});
+		const auto t_binary = time_per_call([&data] {
+			auto tmp = nmea::decode_binary(data);
+			benchmark::DoNotOptimize(tmp);
+		});
+		speedup = t_text / t_binary;
+	} catch (std::exception &) {
+		// rendered text of some sentences cannot be parsed again
+		state.SkipWithError("round trip not supported");
+	}
+	const auto before = marnav_test::allocations_of_thread();
+	while (state.KeepRunning()) {
+		auto tmp = nmea::decode_binary(data);
+		benchmark::DoNotOptimize(tmp);
+	}
+	marnav_test::set_allocation_counters(state, marnav_test::allocations_of_thread() - before);
+	state.counters["speedup"] = speedup;
+}
+
+BENCHMARK(Benchmark_decode_binary)->Apply(all_sentences);
+
+static const std::string tag_block_text = "g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A";
+
+static void Benchmark_make_tag_block(benchmark::State & state)
+{
+	while (state.KeepRunning()) {
+		auto tmp = nmea::make_tag_block(tag_block_text);
+		benchmark::DoNotOptimize(tmp);
+	}
+}
+
+BENCHMARK(Benchmark_make_tag_block);
+
+static void Benchmark_decode_tag_block(benchmark::State & state)
+{
+	nmea::tag_block_values values;
+	while (state.KeepRunning()) {
+		auto tmp = nmea::detail::decode_tag_block(
+			tag_block_text.data(), tag_block_text.size(), values);
+		benchmark::DoNotOptimize(tmp);
+		benchmark::DoNotOptimize(values);
+	}
+}
+
+BENCHMARK(Benchmark_decode_tag_block);
+
 BENCHMARK_MAIN()
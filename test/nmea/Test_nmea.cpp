@@ -136,6 +136,28 @@ TEST_F(Test_nmea, tag_to_id_invalid_tag)
 	EXPECT_ANY_THROW(nmea::tag_to_id("???"));
 }
 
+TEST_F(Test_nmea, tag_to_id_all_supported)
+{
+	for (const auto & tag : nmea::get_supported_sentences_str()) {
+		const auto id = nmea::tag_to_id(tag);
+		EXPECT_EQ(tag, nmea::to_string(id));
+	}
+}
+
+TEST_F(Test_nmea, tag_to_id_partial_and_extended_tags)
+{
+	EXPECT_ANY_THROW(nmea::tag_to_id(""));
+	EXPECT_ANY_THROW(nmea::tag_to_id("BO"));
+	EXPECT_ANY_THROW(nmea::tag_to_id("BODX"));
+	EXPECT_ANY_THROW(nmea::tag_to_id("XBOD"));
+	EXPECT_ANY_THROW(nmea::tag_to_id("bod"));
+	EXPECT_ANY_THROW(nmea::tag_to_id("PGRM"));
+	EXPECT_ANY_THROW(nmea::tag_to_id("PGRMEPGRME"));
+	EXPECT_ANY_THROW(nmea::tag_to_id(std::string("BOD\0", 4)));
+	EXPECT_ANY_THROW(nmea::tag_to_id(std::string("\0BOD", 4)));
+	EXPECT_ANY_THROW(nmea::tag_to_id(std::string("\0\0\0\0BOD", 7)));
+}
+
 TEST_F(Test_nmea, to_string_sentence_id)
 {
 	auto tag = nmea::to_string(nmea::sentence_id::BOD);
@@ -246,4 +268,100 @@ TEST_F(Test_nmea, parse_address_regular_unknown)
 		EXPECT_STREQ("unknown regular tag in address: [GPXXX]", e.what());
 	}
 }
+
+TEST_F(Test_nmea, validate_sentence_regular)
+{
+	const std::string s = "$IIMTW,9.5,C*2F";
+	const auto r = nmea::validate_sentence(s);
+	EXPECT_TRUE(static_cast<bool>(r));
+	EXPECT_EQ(nmea::validation::ok, r.status);
+	EXPECT_EQ(nmea::sentence_id::MTW, r.id);
+	EXPECT_EQ(nmea::talker::integrated_instrumentation, r.talk);
+	EXPECT_EQ(1u, r.address);
+	EXPECT_EQ(5u, r.address_size);
+	EXPECT_EQ(2u, r.fields);
+}
+
+TEST_F(Test_nmea, validate_sentence_ais_with_tag_block)
+{
+	const std::string s
+		= "\\s:r003669959,c:1241544035*74\\!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C";
+	const auto r = nmea::validate_sentence(s);
+	EXPECT_EQ(nmea::validation::ok, r.status);
+	EXPECT_EQ(nmea::sentence_id::VDM, r.id);
+	EXPECT_EQ(nmea::talker::ais_mobile_station, r.talk);
+	EXPECT_EQ(31u, r.address);
+	EXPECT_EQ("AIVDM", s.substr(r.address, r.address_size));
+}
+
+TEST_F(Test_nmea, validate_sentence_proprietary)
+{
+	const auto r = nmea::validate_sentence("$PGRME,22.0,M,52.9,M,51.0,M*14");
+	EXPECT_EQ(nmea::validation::ok, r.status);
+	EXPECT_EQ(nmea::sentence_id::PGRME, r.id);
+	EXPECT_EQ(nmea::talker::none, r.talk);
+
+	const auto s = nmea::validate_sentence("$STALK,84,86,26,97,02,00,00,00,08*6F");
+	EXPECT_EQ(nmea::validation::ok, s.status);
+	EXPECT_EQ(nmea::sentence_id::STALK, s.id);
+	EXPECT_EQ(nmea::talker::none, s.talk);
+}
+
+TEST_F(Test_nmea, validate_sentence_unsupported)
+{
+	const auto r = nmea::validate_sentence("$GPXXX,1*52");
+	EXPECT_EQ(nmea::validation::ok, r.status);
+	EXPECT_EQ(nmea::sentence_id::NONE, r.id);
+	EXPECT_EQ(nmea::talker::global_positioning_system, r.talk);
+
+	const auto s = nmea::validate_sentence("$PSRT,1*18");
+	EXPECT_EQ(nmea::validation::ok, s.status);
+	EXPECT_EQ(nmea::sentence_id::NONE, s.id);
+	EXPECT_EQ(nmea::talker::none, s.talk);
+}
+
+TEST_F(Test_nmea, validate_sentence_no_fields)
+{
+	const auto r = nmea::validate_sentence("$GPMTW*59");
+	EXPECT_EQ(nmea::validation::ok, r.status);
+	EXPECT_EQ(nmea::sentence_id::MTW, r.id);
+	EXPECT_EQ(0u, r.fields);
+}
+
+TEST_F(Test_nmea, validate_sentence_invalid)
+{
+	EXPECT_EQ(nmea::validation::empty, nmea::validate_sentence("").status);
+	EXPECT_EQ(nmea::validation::empty, nmea::validate_sentence(nullptr, 10).status);
+	EXPECT_EQ(nmea::validation::start_token, nmea::validate_sentence("#IIMTW,9.5,C*2F").status);
+	EXPECT_EQ(nmea::validation::start_token, nmea::validate_sentence("\\c:1*68\\").status);
+	EXPECT_EQ(nmea::validation::tag_block,
+		nmea::validate_sentence("\\s:r003669959,c:1241544035*4A\\$IIMTW,9.5,C*2F").status);
+	EXPECT_EQ(
+		nmea::validation::tag_block, nmea::validate_sentence("\\c:1*00$IIMTW,9.5,C*2F").status);
+	EXPECT_EQ(nmea::validation::address, nmea::validate_sentence("$,9.5,C*2F").status);
+	EXPECT_EQ(nmea::validation::address, nmea::validate_sentence("$gpMTW,9.5,C*38").status);
+	EXPECT_EQ(nmea::validation::address, nmea::validate_sentence("$GPRMCXYZ0,1*3D").status);
+	EXPECT_EQ(nmea::validation::character, nmea::validate_sentence("$IIMTW,9.5\x01,C*2E").status);
+	EXPECT_EQ(
+		nmea::validation::checksum_format, nmea::validate_sentence("$IIMTW,9.5,C").status);
+	EXPECT_EQ(
+		nmea::validation::checksum_format, nmea::validate_sentence("$IIMTW,9.5,C*2").status);
+	EXPECT_EQ(
+		nmea::validation::checksum_format, nmea::validate_sentence("$IIMTW,9.5,C*2FF").status);
+	EXPECT_EQ(
+		nmea::validation::checksum_format, nmea::validate_sentence("$IIMTW,9.5,C*XY").status);
+	EXPECT_EQ(nmea::validation::checksum, nmea::validate_sentence("$IIMTW,9.5,C*00").status);
+	EXPECT_FALSE(static_cast<bool>(nmea::validate_sentence("$IIMTW,9.5,C*00")));
+}
+
+TEST_F(Test_nmea, validate_sentence_too_many_fields)
+{
+	const auto r = nmea::validate_sentence("$IIMTW" + std::string(100, ',') + "*4E");
+	EXPECT_EQ(nmea::validation::field_count, r.status);
+}
+
+TEST_F(Test_nmea, validate_sentence_lower_case_checksum)
+{
+	EXPECT_EQ(nmea::validation::ok, nmea::validate_sentence("$IIMTW,9.5,C*2f").status);
+}
 }
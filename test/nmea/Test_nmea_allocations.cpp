@@ -0,0 +1,176 @@
+#include "allocation_counter.hpp"
+#include <gtest/gtest.h>
+#include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/sentence_filter.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/talker_id.hpp>
+#include <marnav/nmea/timestamp.hpp>
+#include <algorithm>
+
+namespace
+{
+using namespace marnav;
+
+/// Maximum number of allocations to parse and to render a sentence.
+///
+/// Budgets are meant to be lowered with improvements. Raising them needs
+/// good reasons.
+struct budget {
+	std::string text;
+	uint64_t make_sentence;
+	uint64_t to_string;
+};
+
+// clang-format off
+static const std::vector<budget> budgets = {
+	{"$GPAAM,A,A,0.5,N,POINT1*6E", 3, 1},
+	{"$GPALM,1,1,15,1159,00,441d,4e,16be,fd5e,a10c9f,4a2da4,686e81,58cbe1,0a4,001*77", 4, 1},
+	{"$GPAPA,A,A,0.10,R,N,V,V,011,M,DEST*3F", 3, 1},
+	{"$GPAPB,A,A,0.10,R,N,V,V,011,M,DEST,011,M,011,M*3C", 4, 1},
+	{"$GPBEC,123456.78,12.34,N,123.45,E,12.34,T,23.45,M,21.43,N,WAYPNT0*07", 3, 1},
+	{"$GPBOD,12.5,T,11.2,M,POINT2,POINT1*40", 3, 1},
+	{"$GPBWC,220516,5130.02,N,00046.34,W,213.8,T,218.0,M,0004.6,N,EGLM,A*4C", 4, 1},
+	{"$GPBWR,220516,5130.02,N,00046.34,W,213.8,T,218.0,M,0004.6,N,EGLM*30", 3, 1},
+	{"$GPBWW,213.8,T,218.0,M,POINT1,POINT2*4C", 3, 1},
+	{"$IIDBK,9.3,f,1.2,M,3.4,F*00", 3, 1},
+	{"$IIDBT,9.3,f,2.84,M,1.55,F*14", 3, 1},
+	{"$IIDPT,9.3,1.0*4B", 3, 1},
+	{"$CDDSC,20,3380210040,00,21,26,1394807410,2242,,,B,E*71", 3, 1},
+	{"$CDDSE,1,1,A,3664251410,00,47800350*1D", 3, 1},
+	{"$GPDTM,W84,,0.000000,N,0.000000,E,0.0,W84*6F", 3, 1},
+	{"$GPFSI,156000,156025,,,*60", 3, 1},
+	{"$GPGBS,123456.32,1.0,2.0,3.0,034,0.1,1.2,0.6*5A", 3, 1},
+	{"$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47", 4, 1},
+	{"$GPGLC,1,1,A,1,A,2,A,3,A,4,V,,*21", 4, 1},
+	{"$GPGLL,3553.5295,N,13938.6570,E,002454,A,A*4F", 3, 1},
+	{"$GNGNS,122310.0,3722.42567,N,12258.856215,W,AA,15,0.9,1005.54,6.5,,*75", 3, 1},
+	{"$GPGRS,024603.00,1,-1.8,-2.7,0.3,,,,,,,,,*6C", 4, 1},
+	{"$GPGSA,A,3,07,08,09,11,18,23,26,28,29,,,,6.6,2.0,3.0*38", 4, 1},
+	{"$GPGST,123456.34,1.0,2.1,3.2,4.3,5.4,6.5,7.6*50", 3, 1},
+	{"$GPGSV,3,1,09,07,29,138,44,08,22,099,42,09,30,273,44,11,07,057,35*75", 4, 1},
+	{"$GPGTD,1.0,2.0,3.0,4.0,5.0*43", 3, 1},
+	{"$HCHDG,45.8,,,0.6,E*16", 3, 1},
+	{"$HCHDM,45.8,M*10", 3, 1},
+	{"$IIHDT,45.8,T*1B", 3, 1},
+	{"$GPHFB,1.0,M,2.0,M*58", 3, 1},
+	{"$GPHSC,45.8,T,,*0C", 3, 1},
+	{"$GPITS,1.0,M*3B", 3, 1},
+	{"$GPLCD,1,001,000,001,000,002,000,003,000,004,000,,*44", 4, 1},
+	{"$INMOB,,E,000000,6,010100,000000,0000.0000,N,00000.0000,E,0,0,000000000,6*09", 4, 1},
+	{"$GPMSK,123,A,110,M,321*52", 3, 1},
+	{"$GPMSS,12,34,123,456,1*44", 3, 1},
+	{"$IIMTW,9.5,C*2F", 3, 1},
+	{"$WIMWD,12.4,T,,,,,,*0D", 3, 1},
+	{"$IIMWV,084.0,R,10.4,N,A*04", 3, 1},
+	{"$IIOSD,123.4,A,,,,,,,*1F", 3, 1},
+	{"$GPR00,EGLL,EGLM,EGTB,EGUB,EGTK,MBOT,EGTB,,,,,,,*58", 4, 1},
+	{"$GPRMA,,1234.9333,N,,,,,,,,*0B", 3, 1},
+	{"$GPRMB,A,0.00,L,SIM001,SIM002,5102.6069,N,00500.0000,E,002.4,000.,021.7,V*0D", 4, 1},
+	{"$GPRMC,201126,A,4702.3944,N,00818.3381,E,0.0,328.4,260807,0.6,E,A*1E", 3, 1},
+	{"$GPROT,1.0,A*30", 3, 1},
+	{"$IIRPM,S,1,1800.0,5.0,A*7C", 3, 1},
+	{"$IIRSA,1.0,A,,*2E", 3, 1},
+	{"$IIRSD,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,A,A*47", 4, 1},
+	{"$GPRTE,1,1,c,*37", 3, 1},
+	{"$GPSFI,1,1,156025,M*03", 4, 1},
+	{"$GPSTN,10*73", 3, 1},
+	{"$GPTDS,12.3,M*07", 3, 1},
+	{"$GPTFI,0,1,2*53", 3, 1},
+	{"$GPTLL,00,0000.0000,N,00000.0000,E,,000000,T,*00", 3, 1},
+	{"$GPTPC,1.0,M,2.0,M,3.0,M*33", 3, 1},
+	{"$GPTPR,1.0,M,2.0,P,3.0,M*3F", 3, 1},
+	{"$GPTPT,1.0,M,2.0,P,3.0,M*39", 3, 1},
+	{"$GPTTM,,,,,,,,,,,,,*76", 4, 1},
+	{"$IIVBW,1.0,-1.5,A,1.0,0.5,A*6F", 3, 1},
+	{"!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C", 6, 2},
+	{"!AIVDO,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5E", 6, 2},
+	{"$IIVDR,211.0,T,1.00,M,1.25,N*3C", 3, 1},
+	{"$IIVHW,,T,211.0,M,0.00,N,0.00,K*79", 3, 1},
+	{"$IIVLW,7803.2,N,0.00,N*43", 3, 1},
+	{"$IIVPW,4.5,N,6.7,M*52", 3, 1},
+	{"$GPVTG,156.1,T,140.9,M,0.0,N,0.0,K*41", 3, 1},
+	{"$IIVWR,084.0,R,10.4,N,5.4,M,19.3,K*4A", 3, 1},
+	{"$GPWCV,12.3,N,POINT1*54", 3, 1},
+	{"$GPWNC,12.3,N,5.6,K,POINT1,POINT2*78", 3, 1},
+	{"$GPWPL,12.3,N,123.4,E,POINT1*32", 3, 1},
+	{"$YXXDR,a,16.0,M,abc*1A", 3, 1},
+	{"$GPXTE,,,,,,*5E", 3, 1},
+	{"$GPXTR,,,*65", 3, 1},
+	{"$GPZDA,050306,29,10,2003,,*43", 3, 1},
+	{"$GPZDL,383401,12.3,R*28", 3, 1},
+	{"$GPZFO,123456.1,000010,POINT1*0C", 3, 1},
+	{"$GPZTG,123456.1,000010,POINT1*16", 3, 1},
+	{"$PGRME,22.0,M,52.9,M,51.0,M*14", 3, 1},
+	{"$PGRMM,WGS 84*06", 3, 1},
+	{"$PGRMZ,1494,f,*10", 3, 1},
+	{"$STALK,00,01,02,03,04,05*40", 4, 1},
+};
+// clang-format on
+
+class Test_nmea_allocations : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		if (!marnav_test::allocation_counting_enabled())
+			GTEST_SKIP() << "allocation counting not enabled, see ENABLE_ALLOCATION_COUNTING";
+	}
+
+	/// Counts the allocations of the function, after a first call to
+	/// exclude initialization of static data.
+	template <class Function> static marnav_test::allocations count(Function f)
+	{
+		f();
+		return marnav_test::count_allocations(f);
+	}
+};
+
+TEST(Test_nmea_allocation_budgets, all_sentences_have_budgets)
+{
+	std::vector<nmea::sentence_id> ids;
+	for (const auto & b : budgets)
+		ids.push_back(nmea::make_sentence(b.text)->id());
+
+	for (const auto id : nmea::get_supported_sentences_id())
+		EXPECT_NE(ids.end(), std::find(ids.begin(), ids.end(), id))
+			<< "no budget for " << nmea::to_string(id);
+}
+
+TEST_F(Test_nmea_allocations, make_sentence)
+{
+	for (const auto & b : budgets) {
+		const auto a = count([&] { nmea::make_sentence(b.text); });
+		EXPECT_GE(b.make_sentence, a.count)
+			<< b.text << ": " << a.count << " allocations, " << a.bytes << " bytes";
+	}
+}
+
+TEST_F(Test_nmea_allocations, to_string)
+{
+	for (const auto & b : budgets) {
+		const auto s = nmea::make_sentence(b.text);
+		const auto a = count([&] { nmea::to_string(*s); });
+		EXPECT_GE(b.to_string, a.count)
+			<< b.text << ": " << a.count << " allocations, " << a.bytes << " bytes";
+	}
+}
+
+TEST_F(Test_nmea_allocations, allocation_free)
+{
+	const std::string text = "$GPRMC,201126,A,4702.3944,N,00818.3381,E,0.0,328.4,260807,0.6,E,A*1E";
+	nmea::timestamp_converter converter;
+	nmea::timestamp t;
+	const std::string proprietary = "$PGRME,22.0,M,52.9,M,51.0,M*14";
+	nmea::sentence_filter filter{nmea::sentence_id::PGRME};
+	filter.add(nmea::talker::global_positioning_system);
+
+	EXPECT_EQ(0u, count([&] { nmea::validate_sentence(text); }).count);
+	EXPECT_EQ(0u, count([&] { nmea::extract_id(text); }).count);
+	EXPECT_EQ(0u, count([&] { nmea::checksum(text.begin() + 1, text.end() - 3); }).count);
+	EXPECT_EQ(0u, count([&] { nmea::make_talker("GP"); }).count);
+	EXPECT_EQ(0u, count([&] { filter.accepts(text); }).count);
+	EXPECT_EQ(0u, count([&] { filter.accepts(proprietary); }).count);
+	EXPECT_EQ(0u, count([&] { converter.convert("260807", 6, "201126", 6, t); }).count);
+}
+}
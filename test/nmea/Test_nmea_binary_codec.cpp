@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/binary_codec.hpp>
+#include <marnav/nmea/gga.hpp>
+#include <marnav/nmea/gll.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/rmc.hpp>
+#include <marnav/nmea/sentence.hpp>
+#include <marnav/nmea/wpl.hpp>
+
+namespace
+{
+
+using namespace marnav;
+
+class Test_nmea_binary_codec : public ::testing::Test
+{
+public:
+	static const std::vector<std::string> SENTENCES;
+};
+
+// sentences whose text is rendered the same as parsed
+// clang-format off
+const std::vector<std::string> Test_nmea_binary_codec::SENTENCES = {
+	"$GPAAM,A,A,0.5,N,POINT1*6E",
+	"$GPALM,1,1,15,1159,00,441d,4e,16be,fd5e,a10c9f,4a2da4,686e81,58cbe1,0a4,001*77",
+	"$GPAPB,A,A,0.10,R,N,V,V,11.0,M,DEST,11.0,M,11.0,M*12",
+	"$GPBEC,123456.78,12.34,N,123.45,E,12.34,T,23.45,M,21.43,N,WAYPNT0*07",
+	"$GPBWC,220516,5130.02,N,00046.34,W,213.8,T,218.0,M,0004.6,N,EGLM*21",
+	"$IIDBT,9.3,f,2.84,M,1.55,F*14",
+	"$IIDPT,9.3,1.0*4B",
+	"$GPDTM,W84,,0.000000,N,0.000000,E,0.0,W84*6F",
+	"$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47",
+	"$GPGLL,,,,,,*50",
+	"$GPGLL,3553.5295,N,13938.6570,E,002454,A,A*4F",
+	"$GNGNS,122310.0,3722.42567,N,12258.856215,W,AA,15,0.9,1005.54,6.5,,*75",
+	"$GPGRS,024603.00,1,-1.8,-2.7,0.3,,,,,,,,,*6C",
+	"$GPGSA,A,1,05,08,,,,17,,,,,,,,,*15",
+	"$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74",
+	"$HCHDG,45.8,,,0.6,E*16",
+	"$IIHDT,45.8,T*1B",
+	"$IIMWV,084.0,R,10.4,N,A*04",
+	"$PGRME,1.1,M,2.2,M,3.3,M*2E",
+	"$PGRMM,WGS 84*06",
+	"$PGRMZ,1494,f,*10",
+	"$GPR00,EGLL,EGLM,EGTB,EGUB,EGTK,MBOT,EGTB,,,,,,,*58",
+	"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17",
+	"$GPRMC,,V,,,,,,,300510,0.6,E,N*39",
+	"$IIRPM,S,1,1800.0,5.0,A*7C",
+	"$GPRTE,1,1,c,*37",
+	"$STALK,00,01,02,03,04,05*40",
+	"!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C",
+	"!AIVDO,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5E",
+	"$IIVLW,7803.2,N,0.00,N*43",
+	"$GPVTG,,T,,M,,N,,K,N*2C",
+	"$IIVWR,084.0,R,10.4,N,5.4,M,19.3,K*4A",
+	"$GPWPL,12.3,N,123.4,E,POINT1*32",
+	"$YXXDR,a,16.0,M,abc*1A",
+	"$GPZDA,160012.71,11,03,2004,-1,00*7D",
+	"$GPZTG,123456.1,000010,POINT1*16",
+};
+// clang-format on
+
+TEST_F(Test_nmea_binary_codec, round_trip)
+{
+	for (const auto & raw : SENTENCES) {
+		const auto s = nmea::make_sentence(raw);
+
+		const auto data = nmea::encode_binary(*s);
+		const auto d = nmea::decode_binary(data);
+
+		ASSERT_NE(nullptr, d) << raw;
+		EXPECT_EQ(s->id(), d->id()) << raw;
+		EXPECT_EQ(s->get_talker(), d->get_talker()) << raw;
+		EXPECT_EQ(nmea::to_string(*s), nmea::to_string(*d)) << raw;
+	}
+}
+
+TEST_F(Test_nmea_binary_codec, smaller_than_text)
+{
+	std::size_t text = 0;
+	std::size_t binary = 0;
+	for (const auto & raw : SENTENCES) {
+		const auto n = nmea::encode_binary(*nmea::make_sentence(raw)).size();
+
+		// sentences of text or empty fields only are of about the same size
+		EXPECT_LE(n, raw.size() + 2) << raw;
+		text += raw.size();
+		binary += n;
+	}
+	EXPECT_LT(binary, text * 3 / 4);
+}
+
+TEST_F(Test_nmea_binary_codec, tag_block)
+{
+	const auto s = nmea::make_sentence(
+		"\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\"
+		"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17");
+
+	const auto d = nmea::decode_binary(nmea::encode_binary(*s));
+
+	EXPECT_EQ("g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A", d->get_tag_block());
+	EXPECT_EQ(nmea::to_string(*s), nmea::to_string(*d));
+}
+
+TEST_F(Test_nmea_binary_codec, single_character_not_printable)
+{
+	for (const char c : {'\x7f', '\xc3', '\x1f'}) {
+		nmea::wpl s;
+		s.set_waypoint(nmea::waypoint{std::string(1, c)});
+
+		const auto d = nmea::decode_binary(nmea::encode_binary(s));
+		const auto wpl = nmea::sentence_cast<nmea::wpl>(d.get());
+
+		ASSERT_NE(nullptr, wpl);
+		ASSERT_TRUE(wpl->get_waypoint_id().available());
+		EXPECT_EQ(std::string(1, c), wpl->get_waypoint_id()->get());
+	}
+}
+
+TEST_F(Test_nmea_binary_codec, typed_values)
+{
+	const auto s = nmea::make_sentence(
+		"$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17");
+
+	const auto d = nmea::decode_binary(nmea::encode_binary(*s));
+	const auto rmc = nmea::sentence_cast<nmea::rmc>(d.get());
+
+	ASSERT_NE(nullptr, rmc);
+	EXPECT_NEAR(47.04006667, rmc->get_lat()->get(), 1e-6);
+	EXPECT_NEAR(8.30546833, rmc->get_lon()->get(), 1e-6);
+}
+
+TEST_F(Test_nmea_binary_codec, typed_values_same_as_text)
+{
+	// sentences read directly from binary fields, instead of text
+	const auto s0 = nmea::make_sentence("$GPGLL,3553.5295,N,13938.6570,E,002454.1234,A,A*65");
+	const auto d0 = nmea::decode_binary(nmea::encode_binary(*s0));
+	const auto gll0 = nmea::sentence_cast<nmea::gll>(s0.get());
+	const auto gll1 = nmea::sentence_cast<nmea::gll>(d0.get());
+
+	ASSERT_NE(nullptr, gll1);
+	EXPECT_EQ(gll0->get_lat()->get(), gll1->get_lat()->get());
+	EXPECT_EQ(gll0->get_lon()->get(), gll1->get_lon()->get());
+	auto t0 = *gll0->get_time_utc();
+	EXPECT_TRUE(t0 == *gll1->get_time_utc());
+	EXPECT_EQ(123u, t0.milliseconds());
+
+	const auto s1 = nmea::make_sentence(
+		"$GPGGA,123519.5,4807.038,S,01131.000,W,1,08,0.9,-45.4,M,46.9,M,,*4B");
+	const auto d1 = nmea::decode_binary(nmea::encode_binary(*s1));
+	const auto gga0 = nmea::sentence_cast<nmea::gga>(s1.get());
+	const auto gga1 = nmea::sentence_cast<nmea::gga>(d1.get());
+
+	ASSERT_NE(nullptr, gga1);
+	EXPECT_EQ(gga0->get_lat()->get(), gga1->get_lat()->get());
+	EXPECT_EQ(gga0->get_lon()->get(), gga1->get_lon()->get());
+	auto t1 = *gga0->get_time();
+	EXPECT_TRUE(t1 == *gga1->get_time());
+	EXPECT_EQ(500u, t1.milliseconds());
+	EXPECT_EQ(8u, *gga1->get_n_satellites());
+	EXPECT_EQ(gga0->get_altitude()->get<units::meters>().value(),
+		gga1->get_altitude()->get<units::meters>().value());
+	EXPECT_EQ(-45.4, gga1->get_altitude()->get<units::meters>().value());
+	EXPECT_FALSE(gga1->get_dgps_age().available());
+	EXPECT_EQ(nmea::to_string(*s1), nmea::to_string(*d1));
+}
+
+TEST_F(Test_nmea_binary_codec, many_records)
+{
+	std::vector<uint8_t> buffer;
+	for (const auto & raw : SENTENCES)
+		nmea::encode_binary(buffer, *nmea::make_sentence(raw));
+
+	std::size_t pos = 0;
+	for (const auto & raw : SENTENCES) {
+		const auto h = nmea::read_binary_header(buffer.data(), buffer.size(), pos);
+		EXPECT_EQ(nmea::binary_record::sentence, h.kind);
+
+		const auto start = pos;
+		const auto s = nmea::decode_binary(buffer.data(), buffer.size(), pos);
+		EXPECT_EQ(start + h.size, pos);
+		EXPECT_EQ(nmea::to_string(*nmea::make_sentence(raw)), nmea::to_string(*s));
+	}
+	EXPECT_EQ(buffer.size(), pos);
+}
+
+TEST_F(Test_nmea_binary_codec, large_record)
+{
+	// tag block too large for a size of one byte
+	const std::string block(200, 'x');
+	auto s = nmea::make_sentence("$IIHDT,45.8,T*1B");
+	s->set_tag_block(block);
+
+	const auto data = nmea::encode_binary(*s);
+	const auto h = nmea::read_binary_header(data.data(), data.size(), 0);
+
+	EXPECT_EQ(data.size(), h.size);
+	EXPECT_EQ(3u, h.body);
+	EXPECT_EQ(block, nmea::decode_binary(data)->get_tag_block());
+}
+
+TEST_F(Test_nmea_binary_codec, malformed)
+{
+	const auto data = nmea::encode_binary(*nmea::make_sentence("$IIHDT,45.8,T*1B"));
+
+	// truncated
+	for (std::size_t n = 0; n < data.size(); ++n) {
+		std::size_t pos = 0;
+		EXPECT_ANY_THROW(nmea::decode_binary(data.data(), n, pos)) << n;
+		EXPECT_EQ(0u, pos);
+	}
+
+	// unsupported version
+	auto v = data;
+	v[0] = static_cast<uint8_t>((v[0] & 0xf0) | (nmea::binary_version + 1));
+	EXPECT_ANY_THROW(nmea::decode_binary(v));
+
+	// wrong kind of record
+	v = data;
+	v[0] = static_cast<uint8_t>(
+		(static_cast<uint8_t>(nmea::binary_record::ais_message) << 4) | nmea::binary_version);
+	EXPECT_ANY_THROW(nmea::decode_binary(v));
+
+	// trailing data
+	v = data;
+	v.push_back(0);
+	EXPECT_ANY_THROW(nmea::decode_binary(v));
+}
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/group_assembler.hpp>
+#include <marnav/nmea/bod.hpp>
+#include <marnav/nmea/rmc.hpp>
+#include <marnav/nmea/tag_block.hpp>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_group_assembler : public ::testing::Test
+{
+public:
+	using clock = nmea::group_assembler::clock;
+	using status = nmea::group_assembler::status;
+
+	/// Returns a sentence with the specified group, the bearing is set to the
+	/// number within the group, to identify it.
+	static std::unique_ptr<nmea::sentence> make(
+		int number, int total, int id, const std::string & source = "src")
+	{
+		nmea::tag_block t;
+		t.set_group({number, total, id});
+		t.set_source(source);
+
+		std::unique_ptr<nmea::bod> s{new nmea::bod};
+		s->set_bearing_true(number);
+		s->set_tag_block(to_string(t));
+		return std::unique_ptr<nmea::sentence>{s.release()};
+	}
+
+	static double number(const std::unique_ptr<nmea::sentence> & s)
+	{
+		return *nmea::sentence_cast<nmea::bod>(s.get())->get_bearing_true();
+	}
+
+	const clock::time_point t0 = clock::now();
+};
+
+TEST_F(Test_nmea_group_assembler, invalid_options)
+{
+	nmea::group_assembler::options opt;
+	opt.capacity = 0;
+	EXPECT_ANY_THROW(nmea::group_assembler{opt});
+
+	opt.capacity = 1;
+	opt.max_group_size = 0;
+	EXPECT_ANY_THROW(nmea::group_assembler{opt});
+}
+
+TEST_F(Test_nmea_group_assembler, sentence_without_group)
+{
+	nmea::group_assembler a;
+
+	EXPECT_EQ(status::ungrouped, a.add(std::unique_ptr<nmea::sentence>(new nmea::rmc), t0));
+	ASSERT_EQ(1u, a.group().size());
+	EXPECT_EQ(nmea::sentence_id::RMC, a.group()[0]->id());
+	EXPECT_EQ(1u, a.get_stats().ungrouped);
+	EXPECT_EQ(0u, a.pending());
+}
+
+TEST_F(Test_nmea_group_assembler, nullptr)
+{
+	nmea::group_assembler a;
+
+	EXPECT_EQ(status::error, a.add(nullptr, t0));
+	EXPECT_EQ(1u, a.get_stats().errors);
+}
+
+TEST_F(Test_nmea_group_assembler, group_of_one)
+{
+	nmea::group_assembler a;
+
+	EXPECT_EQ(status::complete, a.add(make(1, 1, 7), t0));
+	EXPECT_EQ(1u, a.group().size());
+	EXPECT_EQ(1u, a.get_stats().completed);
+}
+
+TEST_F(Test_nmea_group_assembler, complete_group)
+{
+	nmea::group_assembler a;
+
+	EXPECT_EQ(status::none, a.add(make(1, 3, 7), t0));
+	EXPECT_EQ(1u, a.pending());
+	EXPECT_EQ(status::none, a.add(make(2, 3, 7), t0));
+	EXPECT_EQ(status::complete, a.add(make(3, 3, 7), t0));
+
+	ASSERT_EQ(3u, a.group().size());
+	EXPECT_DOUBLE_EQ(1.0, number(a.group()[0]));
+	EXPECT_DOUBLE_EQ(2.0, number(a.group()[1]));
+	EXPECT_DOUBLE_EQ(3.0, number(a.group()[2]));
+	EXPECT_EQ(0u, a.pending());
+	EXPECT_EQ(1u, a.get_stats().completed);
+	EXPECT_EQ(0u, a.get_stats().out_of_order);
+}
+
+TEST_F(Test_nmea_group_assembler, out_of_order)
+{
+	nmea::group_assembler a;
+
+	EXPECT_EQ(status::none, a.add(make(3, 3, 7), t0));
+	EXPECT_EQ(status::none, a.add(make(1, 3, 7), t0));
+	EXPECT_EQ(status::complete, a.add(make(2, 3, 7), t0));
+
+	ASSERT_EQ(3u, a.group().size());
+	EXPECT_DOUBLE_EQ(1.0, number(a.group()[0]));
+	EXPECT_DOUBLE_EQ(2.0, number(a.group()[1]));
+	EXPECT_DOUBLE_EQ(3.0, number(a.group()[2]));
+	EXPECT_EQ(1u, a.get_stats().out_of_order);
+}
+
+TEST_F(Test_nmea_group_assembler, interleaved_groups_and_sources)
+{
+	nmea::group_assembler a;
+
+	EXPECT_EQ(status::none, a.add(make(1, 2, 7, "a"), t0));
+	EXPECT_EQ(status::none, a.add(make(1, 2, 7, "b"), t0));
+	EXPECT_EQ(status::none, a.add(make(1, 2, 8, "a"), t0));
+	EXPECT_EQ(3u, a.pending());
+
+	EXPECT_EQ(status::complete, a.add(make(2, 2, 7, "b"), t0));
+	EXPECT_EQ("b", a.group()[0]->get_tag_block_view().get_source().str());
+	EXPECT_EQ(status::complete, a.add(make(2, 2, 8, "a"), t0));
+	EXPECT_EQ(8, a.group()[0]->get_tag_block_view().get_group().id);
+	EXPECT_EQ(status::complete, a.add(make(2, 2, 7, "a"), t0));
+	EXPECT_EQ(7, a.group()[1]->get_tag_block_view().get_group().id);
+
+	EXPECT_EQ(0u, a.pending());
+	EXPECT_EQ(3u, a.get_stats().completed);
+}
+
+TEST_F(Test_nmea_group_assembler, invalid_group)
+{
+	nmea::group_assembler::options opt;
+	opt.max_group_size = 4;
+	nmea::group_assembler a{opt};
+
+	EXPECT_EQ(status::error, a.add(make(3, 2, 7), t0));
+	EXPECT_EQ(status::error, a.add(make(1, 5, 7), t0));
+	EXPECT_EQ(2u, a.get_stats().errors);
+	EXPECT_EQ(0u, a.pending());
+}
+
+TEST_F(Test_nmea_group_assembler, duplicate_sentence_restarts_group)
+{
+	nmea::group_assembler a;
+
+	EXPECT_EQ(status::none, a.add(make(1, 2, 7), t0));
+	EXPECT_EQ(status::none, a.add(make(1, 2, 7), t0));
+	EXPECT_EQ(1u, a.get_stats().dropped);
+	EXPECT_EQ(status::complete, a.add(make(2, 2, 7), t0));
+	EXPECT_EQ(2u, a.group().size());
+}
+
+TEST_F(Test_nmea_group_assembler, pool_exhausted_drops_oldest)
+{
+	nmea::group_assembler::options opt;
+	opt.capacity = 2;
+	nmea::group_assembler a{opt};
+
+	EXPECT_EQ(status::none, a.add(make(1, 2, 1), t0));
+	EXPECT_EQ(status::none, a.add(make(1, 2, 2), t0 + std::chrono::milliseconds{1}));
+	EXPECT_EQ(status::none, a.add(make(1, 2, 3), t0 + std::chrono::milliseconds{2}));
+
+	EXPECT_EQ(2u, a.pending());
+	EXPECT_EQ(1u, a.get_stats().dropped);
+
+	// the first group was dropped, its second sentence starts a new group
+	EXPECT_EQ(status::none, a.add(make(2, 2, 1), t0 + std::chrono::milliseconds{3}));
+	EXPECT_EQ(2u, a.get_stats().dropped);
+	EXPECT_EQ(status::complete, a.add(make(2, 2, 3), t0 + std::chrono::milliseconds{4}));
+}
+
+TEST_F(Test_nmea_group_assembler, expiry_while_adding)
+{
+	nmea::group_assembler::options opt;
+	opt.timeout = std::chrono::seconds{1};
+	nmea::group_assembler a{opt};
+
+	EXPECT_EQ(status::none, a.add(make(1, 2, 7), t0));
+	EXPECT_EQ(status::none, a.add(make(1, 2, 8), t0 + std::chrono::milliseconds{500}));
+	EXPECT_EQ(status::none, a.add(make(2, 2, 7), t0 + std::chrono::seconds{1}));
+
+	EXPECT_EQ(1u, a.get_stats().expired);
+	EXPECT_EQ(2u, a.pending());
+	EXPECT_EQ(status::complete, a.add(make(2, 2, 8), t0 + std::chrono::milliseconds{1400}));
+}
+
+TEST_F(Test_nmea_group_assembler, explicit_expiry)
+{
+	nmea::group_assembler::options opt;
+	opt.timeout = std::chrono::seconds{1};
+	nmea::group_assembler a{opt};
+
+	a.add(make(1, 2, 7), t0);
+	a.add(make(1, 2, 8), t0 + std::chrono::milliseconds{500});
+
+	EXPECT_EQ(0u, a.expire(t0 + std::chrono::milliseconds{999}));
+	EXPECT_EQ(1u, a.expire(t0 + std::chrono::seconds{1}));
+	EXPECT_EQ(1u, a.pending());
+	EXPECT_EQ(1u, a.expire(t0 + std::chrono::seconds{2}));
+	EXPECT_EQ(0u, a.pending());
+	EXPECT_EQ(2u, a.get_stats().expired);
+}
+
+TEST_F(Test_nmea_group_assembler, reset)
+{
+	nmea::group_assembler a;
+	a.add(make(1, 2, 7), t0);
+	a.add(make(1, 2, 8), t0);
+
+	a.reset();
+
+	EXPECT_EQ(0u, a.pending());
+	EXPECT_EQ(status::none, a.add(make(2, 2, 7), t0));
+}
+
+TEST_F(Test_nmea_group_assembler, sentences_can_be_moved_out)
+{
+	nmea::group_assembler a;
+	a.add(make(1, 2, 7), t0);
+	a.add(make(2, 2, 7), t0);
+
+	auto group = std::move(a.group());
+
+	EXPECT_EQ(2u, group.size());
+	EXPECT_EQ(status::none, a.add(make(1, 2, 9), t0));
+	EXPECT_EQ(status::complete, a.add(make(2, 2, 9), t0));
+	EXPECT_EQ(2u, a.group().size());
+}
+}
@@ -150,4 +150,15 @@ TEST_F(Test_nmea_gsv, get_sat)
 		EXPECT_EQ(0u, sat.snr);
 	}
 }
+
+TEST_F(Test_nmea_gsv, empty_sat)
+{
+	auto s = nmea::make_sentence("$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D");
+	auto gsv = nmea::sentence_cast<nmea::gsv>(s);
+
+	EXPECT_TRUE(gsv->get_sat(2).available());
+	EXPECT_FALSE(gsv->get_sat(3).available());
+	EXPECT_EQ("$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D",
+		nmea::to_string(*gsv));
+}
 }
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/gsv_aggregator.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/rmc.hpp>
+#include <atomic>
+#include <thread>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_gsv_aggregator : public ::testing::Test
+{
+public:
+	/// Returns a GSV sentence with `n` satellites, all values set to `value`.
+	static nmea::gsv make(nmea::talker talk, uint32_t number, uint32_t total, int n,
+		uint32_t value = 0)
+	{
+		nmea::gsv s;
+		s.set_talker(talk);
+		s.set_n_messages(total);
+		s.set_message_number(number);
+		s.set_n_satellites_in_view(total * 4);
+		for (int i = 0; i < n; ++i) {
+			const uint32_t id = (number - 1) * 4 + static_cast<uint32_t>(i) + 1;
+			s.set_sat(i, {id, value, value, value});
+		}
+		return s;
+	}
+};
+
+TEST_F(Test_nmea_gsv_aggregator, no_snapshot)
+{
+	nmea::gsv_aggregator a;
+	nmea::gsv_aggregator::snapshot s;
+
+	EXPECT_FALSE(a.get(nmea::talker::global_positioning_system, s));
+	EXPECT_FALSE(a.get(nmea::talker::none, s));
+}
+
+TEST_F(Test_nmea_gsv_aggregator, complete_cycle)
+{
+	nmea::gsv_aggregator a;
+	nmea::gsv_aggregator::snapshot s;
+
+	EXPECT_FALSE(a.add(*nmea::make_sentence(
+		"$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74")));
+	EXPECT_FALSE(a.get(nmea::talker::global_positioning_system, s));
+	EXPECT_FALSE(a.add(*nmea::make_sentence(
+		"$GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00*74")));
+	EXPECT_TRUE(a.add(*nmea::make_sentence(
+		"$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D")));
+
+	ASSERT_TRUE(a.get(nmea::talker::global_positioning_system, s));
+	EXPECT_EQ(nmea::talker::global_positioning_system, s.talk);
+	EXPECT_EQ(1u, s.cycle);
+	EXPECT_EQ(11u, s.n_satellites_in_view);
+	ASSERT_EQ(11u, s.size);
+	EXPECT_EQ(3u, s.satellites[0].id);
+	EXPECT_EQ(111u, s.satellites[0].azimuth);
+	EXPECT_EQ(27u, s.satellites[10].id);
+	EXPECT_EQ(244u, s.satellites[10].azimuth);
+
+	EXPECT_EQ(3u, a.get_stats().sentences);
+	EXPECT_EQ(1u, a.get_stats().cycles);
+}
+
+TEST_F(Test_nmea_gsv_aggregator, other_sentences_ignored)
+{
+	nmea::gsv_aggregator a;
+
+	EXPECT_FALSE(a.add(nmea::rmc{}));
+	EXPECT_EQ(0u, a.get_stats().sentences);
+}
+
+TEST_F(Test_nmea_gsv_aggregator, talkers_independent)
+{
+	nmea::gsv_aggregator a;
+	nmea::gsv_aggregator::snapshot s;
+
+	EXPECT_FALSE(a.add(make(nmea::talker::global_positioning_system, 1, 2, 4)));
+	EXPECT_TRUE(a.add(make(nmea::talker::glonass, 1, 1, 3)));
+	EXPECT_TRUE(a.add(make(nmea::talker::global_positioning_system, 2, 2, 2)));
+
+	ASSERT_TRUE(a.get(nmea::talker::global_positioning_system, s));
+	EXPECT_EQ(6u, s.size);
+	ASSERT_TRUE(a.get(nmea::talker::glonass, s));
+	EXPECT_EQ(3u, s.size);
+	EXPECT_FALSE(a.get(nmea::talker::galileo, s));
+}
+
+TEST_F(Test_nmea_gsv_aggregator, incomplete_cycle_keeps_previous)
+{
+	nmea::gsv_aggregator a;
+	nmea::gsv_aggregator::snapshot s;
+	const auto gp = nmea::talker::global_positioning_system;
+
+	a.add(make(gp, 1, 2, 4, 1));
+	a.add(make(gp, 2, 2, 4, 1));
+
+	// second message missing
+	EXPECT_FALSE(a.add(make(gp, 1, 3, 4, 2)));
+	EXPECT_FALSE(a.add(make(gp, 3, 3, 4, 2)));
+	EXPECT_EQ(1u, a.get_stats().incomplete);
+
+	ASSERT_TRUE(a.get(gp, s));
+	EXPECT_EQ(1u, s.cycle);
+	EXPECT_EQ(8u, s.size);
+	EXPECT_EQ(1u, s.satellites[0].snr);
+
+	// restarted cycle
+	EXPECT_FALSE(a.add(make(gp, 1, 2, 4, 3)));
+	EXPECT_FALSE(a.add(make(gp, 1, 2, 4, 3)));
+	EXPECT_TRUE(a.add(make(gp, 2, 2, 1, 3)));
+	EXPECT_EQ(2u, a.get_stats().incomplete);
+
+	ASSERT_TRUE(a.get(gp, s));
+	EXPECT_EQ(2u, s.cycle);
+	EXPECT_EQ(5u, s.size);
+	EXPECT_EQ(3u, s.satellites[4].snr);
+}
+
+TEST_F(Test_nmea_gsv_aggregator, too_many_talkers)
+{
+	nmea::gsv_aggregator a;
+	const nmea::talker talkers[] = {nmea::talker::global_positioning_system,
+		nmea::talker::glonass, nmea::talker::galileo, nmea::talker::beidou_1,
+		nmea::talker::beidou_2, nmea::talker::mixed_gps_glonass,
+		nmea::talker::qzss_gps_augmentation_system, nmea::talker::integrated_navigation,
+		nmea::talker::electronic_positioning_system};
+
+	for (const auto t : talkers)
+		a.add(make(t, 1, 1, 1));
+
+	EXPECT_EQ(nmea::gsv_aggregator::max_talkers, a.get_stats().cycles);
+	EXPECT_EQ(1u, a.get_stats().overflows);
+}
+
+TEST_F(Test_nmea_gsv_aggregator, concurrent_readers_see_complete_snapshots)
+{
+	nmea::gsv_aggregator a;
+	const auto gp = nmea::talker::global_positioning_system;
+	std::atomic<bool> done{false};
+	std::atomic<int> inconsistent{0};
+	std::atomic<int> reads{0};
+
+	auto reader = [&]() {
+		nmea::gsv_aggregator::snapshot s;
+		while (!done.load()) {
+			if (!a.get(gp, s))
+				continue;
+			++reads;
+			bool ok = (s.size == 12);
+			for (std::size_t i = 0; i < s.size; ++i)
+				ok = ok && (s.satellites[i].snr == static_cast<uint32_t>(s.cycle));
+			if (!ok)
+				++inconsistent;
+		}
+	};
+
+	std::thread r1{reader};
+	std::thread r2{reader};
+	for (uint32_t cycle = 1; cycle <= 5000; ++cycle) {
+		a.add(make(gp, 1, 3, 4, cycle));
+		a.add(make(gp, 2, 3, 4, cycle));
+		a.add(make(gp, 3, 3, 4, cycle));
+	}
+	done = true;
+	r1.join();
+	r2.join();
+
+	EXPECT_EQ(0, inconsistent.load());
+	EXPECT_EQ(5000u, a.get_stats().cycles);
+}
+}
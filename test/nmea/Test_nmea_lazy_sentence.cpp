@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/lazy_sentence.hpp>
+#include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/mtw.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/pgrme.hpp>
+#include <marnav/nmea/rmc.hpp>
+#include <marnav/nmea/vdm.hpp>
+
+namespace
+{
+
+using namespace marnav;
+
+class Test_nmea_lazy_sentence : public ::testing::Test
+{
+};
+
+static const std::string RMC
+	= "$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17";
+
+TEST_F(Test_nmea_lazy_sentence, id_and_talker)
+{
+	const nmea::lazy_sentence s{RMC};
+	EXPECT_EQ(nmea::sentence_id::RMC, s.id());
+	EXPECT_EQ(nmea::talker::global_positioning_system, s.get_talker());
+	EXPECT_EQ("RMC", s.tag());
+	EXPECT_EQ("", s.get_tag_block());
+	EXPECT_EQ(RMC, s.get_raw());
+	EXPECT_FALSE(s.is_parsed());
+}
+
+TEST_F(Test_nmea_lazy_sentence, fields)
+{
+	const nmea::lazy_sentence s{RMC};
+	ASSERT_EQ(12u, s.size());
+	EXPECT_EQ("201034", s.field(0));
+	EXPECT_EQ("A", s.field(1));
+	EXPECT_EQ("4702.4040", s.field(2));
+	EXPECT_EQ("0.6", s.field(9));
+	EXPECT_EQ("A", s.field(11));
+	EXPECT_THROW(s.field(12), std::out_of_range);
+	EXPECT_FALSE(s.is_parsed());
+}
+
+TEST_F(Test_nmea_lazy_sentence, empty_fields)
+{
+	const nmea::lazy_sentence s{"$GPRMC,,V,,,,,,,300510,0.6,E,N*39"};
+	ASSERT_EQ(12u, s.size());
+	EXPECT_EQ("", s.field(0));
+	EXPECT_EQ("V", s.field(1));
+	EXPECT_EQ("", s.field(7));
+	EXPECT_EQ("300510", s.field(8));
+	EXPECT_EQ("N", s.field(11));
+}
+
+TEST_F(Test_nmea_lazy_sentence, no_fields)
+{
+	const nmea::lazy_sentence s{"$GPMTW*59"};
+	EXPECT_EQ(nmea::sentence_id::MTW, s.id());
+	EXPECT_EQ(0u, s.size());
+	EXPECT_THROW(s.field(0), std::out_of_range);
+}
+
+TEST_F(Test_nmea_lazy_sentence, read_field)
+{
+	const nmea::lazy_sentence s{RMC};
+	const auto sog = s.read_field<double>(6);
+	ASSERT_TRUE(sog.available());
+	EXPECT_NEAR(0.0, *sog, 1e-6);
+	const auto mag = s.read_field<double>(9);
+	ASSERT_TRUE(mag.available());
+	EXPECT_NEAR(0.6, *mag, 1e-6);
+	EXPECT_FALSE(s.is_parsed());
+
+	const nmea::lazy_sentence e{"$GPRMC,,V,,,,,,,300510,0.6,E,N*39"};
+	EXPECT_FALSE(e.read_field<double>(6).available());
+}
+
+TEST_F(Test_nmea_lazy_sentence, as_parses_once)
+{
+	const nmea::lazy_sentence s{RMC};
+	const auto & rmc = s.as<nmea::rmc>();
+	EXPECT_TRUE(s.is_parsed());
+	EXPECT_EQ(&rmc, &s.as<nmea::rmc>());
+
+	const auto expected = nmea::create_sentence<nmea::rmc>(RMC);
+	EXPECT_EQ(nmea::to_string(expected), nmea::to_string(rmc));
+}
+
+TEST_F(Test_nmea_lazy_sentence, as_wrong_type)
+{
+	const nmea::lazy_sentence s{RMC};
+	EXPECT_THROW(s.as<nmea::mtw>(), std::bad_cast);
+	EXPECT_FALSE(s.is_parsed());
+}
+
+TEST_F(Test_nmea_lazy_sentence, tag_block)
+{
+	const std::string raw
+		= "\\s:r003669959,c:1241544035*74\\!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C";
+	const nmea::lazy_sentence s{raw};
+	EXPECT_EQ(nmea::sentence_id::VDM, s.id());
+	EXPECT_EQ(nmea::talker::ais_mobile_station, s.get_talker());
+	EXPECT_EQ("s:r003669959,c:1241544035*74", s.get_tag_block());
+	ASSERT_EQ(6u, s.size());
+	EXPECT_EQ("177KQJ5000G?tO`K>RA1wUbN0TKH", s.field(4));
+	EXPECT_EQ("s:r003669959,c:1241544035*74", s.as<nmea::vdm>().get_tag_block());
+}
+
+TEST_F(Test_nmea_lazy_sentence, proprietary)
+{
+	const nmea::lazy_sentence s{"$PGRME,22.0,M,52.9,M,51.0,M*14"};
+	EXPECT_EQ(nmea::sentence_id::PGRME, s.id());
+	EXPECT_EQ(nmea::talker::none, s.get_talker());
+	EXPECT_EQ("PGRME", s.tag());
+	EXPECT_EQ(6u, s.size());
+	EXPECT_NO_THROW(s.as<nmea::pgrme>());
+}
+
+TEST_F(Test_nmea_lazy_sentence, invalid)
+{
+	EXPECT_THROW(nmea::lazy_sentence{""}, std::invalid_argument);
+	EXPECT_THROW(nmea::lazy_sentence{"$GPRMC,,V"}, std::invalid_argument);
+	EXPECT_THROW(nmea::lazy_sentence{"$IIMTW,9.5,C*00"}, nmea::checksum_error);
+	EXPECT_THROW(nmea::lazy_sentence{"$GPXXX,1*52"}, nmea::unknown_sentence);
+}
+
+TEST_F(Test_nmea_lazy_sentence, ignore_checksum)
+{
+	const nmea::lazy_sentence s{"$IIMTW,9.5,C*00", nmea::checksum_handling::ignore};
+	EXPECT_EQ(nmea::sentence_id::MTW, s.id());
+	EXPECT_EQ("9.5", s.field(0));
+}
+
+TEST_F(Test_nmea_lazy_sentence, move)
+{
+	nmea::lazy_sentence s{std::string{RMC}};
+	s.as<nmea::rmc>();
+	nmea::lazy_sentence t{std::move(s)};
+	EXPECT_TRUE(t.is_parsed());
+	EXPECT_EQ("A", t.field(1));
+}
+}
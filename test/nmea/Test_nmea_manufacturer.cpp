@@ -65,4 +65,28 @@ TEST_F(Test_nmea_manufacturer, test_manufacturer_names)
 		EXPECT_FALSE(nmea::get_manufacturer_name(id).empty());
 	}
 }
+
+TEST_F(Test_nmea_manufacturer, tag_id_round_trip)
+{
+	for (const auto id : nmea::get_supported_manufacturer_id()) {
+		const auto tag = "P" + nmea::get_manufacturer_tag(id) + "X";
+		EXPECT_EQ(id, nmea::get_manufacturer_id(tag)) << tag;
+	}
+}
+
+TEST_F(Test_nmea_manufacturer, get_manufacturer_id_unknown_tag)
+{
+	EXPECT_EQ(nmea::manufacturer_id::UNKNOWN, nmea::get_manufacturer_id("PAAAX"));
+	EXPECT_EQ(nmea::manufacturer_id::UNKNOWN, nmea::get_manufacturer_id("PZZZX"));
+	EXPECT_EQ(nmea::manufacturer_id::UNKNOWN, nmea::get_manufacturer_id("P000X"));
+	EXPECT_EQ(nmea::manufacturer_id::_3SN, nmea::get_manufacturer_id("P3SNX"));
+	EXPECT_EQ(nmea::manufacturer_id::ZNS, nmea::get_manufacturer_id("PZNSX"));
+}
+
+TEST_F(Test_nmea_manufacturer, get_manufacturer_tag_from_invalid_id)
+{
+	const auto id = static_cast<nmea::manufacturer_id>(9999);
+	EXPECT_STREQ("", nmea::get_manufacturer_tag(id).c_str());
+	EXPECT_STREQ("", nmea::get_manufacturer_name(id).c_str());
+}
 }
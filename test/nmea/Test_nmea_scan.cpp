@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/scan.hpp>
+#include <marnav/nmea/checksum.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace marnav::nmea::detail;
+
+class Test_nmea_scan : public ::testing::Test
+{
+public:
+	/// Returns all kernels supported by the CPU.
+	static std::vector<scan_function> kernels()
+	{
+		std::vector<scan_function> result{scan_scalar, scan};
+		if (scan_sse2_supported())
+			result.push_back(scan_sse2);
+		if (scan_avx2_supported())
+			result.push_back(scan_avx2);
+		return result;
+	}
+
+	/// Straight forward reference implementation.
+	static scan_result reference(const std::string & s, std::vector<uint64_t> & mask)
+	{
+		scan_result result;
+		mask.assign(scan_mask_size(s.size()), 0u);
+		const auto end = s.find('*');
+		if (end != std::string::npos)
+			result.end = end;
+		result.sum = marnav::nmea::checksum(
+			s.begin(), (end == std::string::npos) ? s.end() : s.begin() + end);
+		for (std::size_t i = 0; i < s.size(); ++i)
+			if ((s[i] == ',') || (s[i] == '*'))
+				mask[i / 64] |= uint64_t{1} << (i % 64);
+		return result;
+	}
+};
+
+TEST_F(Test_nmea_scan, implementation)
+{
+	const std::string name = scan_implementation();
+	EXPECT_TRUE((name == "scalar") || (name == "sse2") || (name == "avx2"));
+}
+
+TEST_F(Test_nmea_scan, empty)
+{
+	for (auto f : kernels()) {
+		const auto r = f("", 0, nullptr);
+		EXPECT_EQ(0u, r.sum);
+		EXPECT_EQ(scan_result::npos, r.end);
+	}
+}
+
+TEST_F(Test_nmea_scan, sentence)
+{
+	const std::string s = "GPRMC,201126,A,4702.3944,N,00818.3381,E,0.0,328.4,260807,0.6,E,A*1E";
+	for (auto f : kernels()) {
+		std::vector<uint64_t> mask(scan_mask_size(s.size()), ~uint64_t{0});
+		const auto r = f(s.data(), s.size(), mask.data());
+		EXPECT_EQ(0x1e, r.sum);
+		EXPECT_EQ(s.size() - 3, r.end);
+		ASSERT_EQ(2u, mask.size());
+		EXPECT_EQ(0x510208a005005020u, mask[0]);
+		EXPECT_EQ(0x1u, mask[1]);
+	}
+}
+
+TEST_F(Test_nmea_scan, checksum_only)
+{
+	const std::string s = "IIMTW,9.5,C*2F,*";
+	for (auto f : kernels()) {
+		const auto r = f(s.data(), s.size(), nullptr);
+		EXPECT_EQ(0x2f, r.sum);
+		EXPECT_EQ(11u, r.end);
+	}
+}
+
+TEST_F(Test_nmea_scan, random_compared_to_reference)
+{
+	std::mt19937 gen{42};
+	std::uniform_int_distribution<int> chars{0, 15};
+	const char alphabet[] = "AB09.,*,,xyz-\x7f\x01 ";
+
+	for (std::size_t size = 0; size < 300; ++size) {
+		std::string s;
+		for (std::size_t i = 0; i < size; ++i)
+			s += alphabet[chars(gen)];
+
+		std::vector<uint64_t> expected_mask;
+		const auto expected = reference(s, expected_mask);
+
+		for (auto f : kernels()) {
+			std::vector<uint64_t> mask(scan_mask_size(s.size()), ~uint64_t{0});
+			const auto r = f(s.data(), s.size(), mask.data());
+			EXPECT_EQ(expected.sum, r.sum) << "size=" << size;
+			EXPECT_EQ(expected.end, r.end) << "size=" << size;
+			EXPECT_EQ(expected_mask, mask) << "size=" << size;
+
+			const auto c = f(s.data(), s.size(), nullptr);
+			EXPECT_EQ(expected.sum, c.sum) << "size=" << size;
+			EXPECT_EQ(expected.end, c.end) << "size=" << size;
+		}
+	}
+}
+
+TEST_F(Test_nmea_scan, ensure_checksum)
+{
+	const std::string s = "IIMTW,9.5,C*2F";
+	const auto r = scan(s.data(), s.size(), nullptr);
+	EXPECT_NO_THROW(ensure_checksum(r, s.size(), "2F"));
+	EXPECT_NO_THROW(ensure_checksum(r, s.size(), "2f"));
+	EXPECT_THROW(ensure_checksum(r, s.size(), "00"), marnav::nmea::checksum_error);
+	EXPECT_THROW(ensure_checksum(r, s.size(), "XY"), std::invalid_argument);
+	EXPECT_THROW(ensure_checksum(r, s.size(), "2"), std::invalid_argument);
+	EXPECT_THROW(ensure_checksum(r, s.size() + 1, "2F"), std::invalid_argument);
+	EXPECT_THROW(ensure_checksum(scan_result{}, s.size(), "2F"), std::invalid_argument);
+}
+}
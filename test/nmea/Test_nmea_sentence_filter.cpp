@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/sentence_filter.hpp>
+#include <marnav/nmea/checksum.hpp>
+#include <marnav/nmea/nmea.hpp>
+#include <marnav/nmea/sentence.hpp>
+
+namespace
+{
+
+using namespace marnav;
+
+class Test_nmea_sentence_filter : public ::testing::Test
+{
+};
+
+static const std::string RMC
+	= "$GPRMC,201034,A,4702.4040,N,00818.3281,E,0.0,328.4,260807,0.6,E,A*17";
+static const std::string MTW = "$IIMTW,9.5,C*2F";
+static const std::string PGRME = "$PGRME,22.0,M,52.9,M,51.0,M*14";
+static const std::string STALK = "$STALK,84,86,26,97,02,00,00,00,08*6F";
+
+TEST_F(Test_nmea_sentence_filter, default_accepts_all)
+{
+	const nmea::sentence_filter f;
+	EXPECT_TRUE(f.accepts(RMC));
+	EXPECT_TRUE(f.accepts(MTW));
+	EXPECT_TRUE(f.accepts(PGRME));
+	EXPECT_TRUE(f.accepts("garbage"));
+	EXPECT_TRUE(f.accepts(""));
+	EXPECT_TRUE(f.accepts(nmea::sentence_id::GGA));
+	EXPECT_TRUE(f.accepts(nmea::talker::global_positioning_system));
+}
+
+TEST_F(Test_nmea_sentence_filter, ids)
+{
+	const nmea::sentence_filter f{nmea::sentence_id::RMC, nmea::sentence_id::PGRME};
+	EXPECT_TRUE(f.accepts(RMC));
+	EXPECT_FALSE(f.accepts(MTW));
+	EXPECT_TRUE(f.accepts(PGRME));
+	EXPECT_FALSE(f.accepts(STALK));
+	EXPECT_TRUE(f.accepts("$IIRMC,*00")); // any talker
+	EXPECT_TRUE(f.accepts(nmea::sentence_id::RMC));
+	EXPECT_FALSE(f.accepts(nmea::sentence_id::GGA));
+}
+
+TEST_F(Test_nmea_sentence_filter, unclassified_rejected_if_restricted)
+{
+	const nmea::sentence_filter f{nmea::sentence_id::RMC};
+	EXPECT_FALSE(f.accepts("garbage"));
+	EXPECT_FALSE(f.accepts(""));
+	EXPECT_FALSE(f.accepts("$PXYZ,1*00"));
+	EXPECT_FALSE(f.accepts("$gprmc,1*00"));
+}
+
+TEST_F(Test_nmea_sentence_filter, add_and_remove)
+{
+	nmea::sentence_filter f;
+	f.add(nmea::sentence_id::MTW);
+	EXPECT_TRUE(f.accepts(MTW));
+	EXPECT_FALSE(f.accepts(RMC));
+
+	f.add(nmea::sentence_id::RMC).remove(nmea::sentence_id::MTW);
+	EXPECT_FALSE(f.accepts(MTW));
+	EXPECT_TRUE(f.accepts(RMC));
+
+	f.reject_all();
+	EXPECT_FALSE(f.accepts(RMC));
+
+	f.accept_all();
+	EXPECT_TRUE(f.accepts(MTW));
+	EXPECT_TRUE(f.accepts(RMC));
+}
+
+TEST_F(Test_nmea_sentence_filter, remove_from_accept_all_has_no_effect)
+{
+	nmea::sentence_filter f;
+	f.remove(nmea::sentence_id::MTW);
+	EXPECT_TRUE(f.accepts(MTW));
+}
+
+TEST_F(Test_nmea_sentence_filter, talkers)
+{
+	nmea::sentence_filter f;
+	f.add(nmea::talker::global_positioning_system);
+	EXPECT_TRUE(f.accepts(RMC));
+	EXPECT_FALSE(f.accepts(MTW));
+	EXPECT_TRUE(f.accepts(PGRME)); // no talker
+	EXPECT_TRUE(f.accepts(STALK)); // no talker
+	EXPECT_TRUE(f.accepts(nmea::talker::global_positioning_system));
+	EXPECT_FALSE(f.accepts(nmea::talker::integrated_instrumentation));
+
+	f.add(nmea::talker::integrated_instrumentation);
+	EXPECT_TRUE(f.accepts(MTW));
+	f.remove(nmea::talker::global_positioning_system);
+	EXPECT_FALSE(f.accepts(RMC));
+
+	f.accept_all_talkers();
+	EXPECT_TRUE(f.accepts(RMC));
+}
+
+TEST_F(Test_nmea_sentence_filter, ids_and_talkers)
+{
+	nmea::sentence_filter f{nmea::sentence_id::MTW};
+	f.add(nmea::talker::global_positioning_system);
+	EXPECT_FALSE(f.accepts(MTW));
+	EXPECT_TRUE(f.accepts("$GPMTW*59"));
+	EXPECT_FALSE(f.accepts(RMC));
+}
+
+TEST_F(Test_nmea_sentence_filter, all_supported_sentences)
+{
+	for (const auto id : nmea::get_supported_sentences_id()) {
+		const auto tag = nmea::to_string(id);
+		const auto address = (tag.size() == 3) ? "GP" + tag : tag;
+
+		const nmea::sentence_filter f{id};
+		EXPECT_TRUE(f.accepts_address(address.data(), address.size())) << address;
+
+		const nmea::sentence_filter g{(id == nmea::sentence_id::MTW) ? nmea::sentence_id::RMC
+																	  : nmea::sentence_id::MTW};
+		EXPECT_FALSE(g.accepts_address(address.data(), address.size())) << address;
+	}
+}
+
+TEST_F(Test_nmea_sentence_filter, invalid_talker)
+{
+	nmea::sentence_filter f;
+	EXPECT_THROW(f.add(nmea::talker::none), std::invalid_argument);
+}
+
+TEST_F(Test_nmea_sentence_filter, tag_block)
+{
+	const nmea::sentence_filter f{nmea::sentence_id::VDM};
+	EXPECT_TRUE(f.accepts("\\s:r003669959,c:1241544035*74\\"
+						  "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C"));
+	EXPECT_FALSE(f.accepts("\\s:r003669959,c:1241544035*74\\" + MTW));
+}
+
+TEST_F(Test_nmea_sentence_filter, make_sentence)
+{
+	const nmea::sentence_filter f{nmea::sentence_id::MTW};
+	EXPECT_TRUE(nmea::make_sentence(RMC, f) == nullptr);
+	auto s = nmea::make_sentence(MTW, f);
+	ASSERT_TRUE(s != nullptr);
+	EXPECT_EQ(nmea::sentence_id::MTW, s->id());
+
+	// rejected sentences are not checked at all
+	EXPECT_TRUE(nmea::make_sentence("$GPRMC,foo*00", f) == nullptr);
+	EXPECT_THROW(nmea::make_sentence("$IIMTW,9.5,C*00", f), nmea::checksum_error);
+}
+}
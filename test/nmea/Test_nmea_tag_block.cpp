@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <marnav/nmea/tag_block.hpp>
 #include <marnav/nmea/bod.hpp>
+#include <marnav/nmea/checksum.hpp>
 #include <marnav/nmea/nmea.hpp>
 
 namespace
@@ -41,6 +42,17 @@ TEST_F(Test_nmea_tag_block, invalid_checksum)
 	EXPECT_ANY_THROW(nmea::make_tag_block("g:1-2-73874,n:157036,s:r003669945,c:1241544035*40"));
 }
 
+TEST_F(Test_nmea_tag_block, invalid_checksum_values)
+{
+	try {
+		nmea::make_tag_block("g:1-2-73874,n:157036,s:r003669945,c:1241544035*40");
+		FAIL() << "checksum_error expected";
+	} catch (const nmea::checksum_error & e) {
+		EXPECT_EQ(0x40, e.expected());
+		EXPECT_EQ(0x4a, e.actual());
+	}
+}
+
 TEST_F(Test_nmea_tag_block, parse)
 {
 	const auto b = nmea::make_tag_block("g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A");
@@ -166,4 +178,121 @@ TEST_F(Test_nmea_tag_block, write_sentence_with_tag_block)
 
 	EXPECT_STREQ(raw_sentence.c_str(), s.c_str());
 }
+
+TEST_F(Test_nmea_tag_block, view_of_sentence_without_tag_block)
+{
+	const auto s = nmea::make_sentence("$GPBOD,123,T,,M,,*77");
+
+	const auto v = s->get_tag_block_view();
+
+	EXPECT_FALSE(v.is_valid());
+	EXPECT_FALSE(v.is_unix_time_valid());
+	EXPECT_FALSE(v.is_source_valid());
+	EXPECT_TRUE(v.get_source().empty());
+}
+
+TEST_F(Test_nmea_tag_block, view_of_parsed_sentence)
+{
+	const auto s = nmea::make_sentence(
+		"\\s:2573135,c:1671620143*0B\\!AIVDM,1,1,,B,15N4cJ`005Jrek0H@9n`DW5608EP,0*13");
+
+	const auto v = s->get_tag_block_view();
+
+	EXPECT_TRUE(v.is_valid());
+	EXPECT_TRUE(v.is_unix_time_valid());
+	EXPECT_EQ(1671620143, v.get_unix_time());
+	EXPECT_TRUE(v.is_source_valid());
+	EXPECT_EQ("2573135", v.get_source().str());
+	EXPECT_FALSE(v.is_group_valid());
+	EXPECT_FALSE(v.is_destination_valid());
+
+	// the source refers to the raw tag block of the sentence
+	EXPECT_EQ(s->get_tag_block().data() + 2, v.get_source().data);
+}
+
+TEST_F(Test_nmea_tag_block, view_with_group_and_line_count)
+{
+	const auto s = nmea::make_sentence(
+		"\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\$GPBOD,123,T,,M,,*77");
+
+	const auto v = s->get_tag_block_view();
+
+	EXPECT_TRUE(v.is_valid());
+	EXPECT_EQ(1, v.get_group().number);
+	EXPECT_EQ(2, v.get_group().total_number);
+	EXPECT_EQ(73874, v.get_group().id);
+	EXPECT_EQ(157036, v.get_line_count());
+	EXPECT_EQ("r003669945", v.get_source().str());
+	EXPECT_EQ(1241544035, v.get_unix_time());
+}
+
+TEST_F(Test_nmea_tag_block, view_texts_truncated)
+{
+	const auto s = nmea::make_sentence(
+		"\\d:0123456789abcdefgh,s:src,t:hello*50\\$GPBOD,123,T,,M,,*77");
+
+	const auto v = s->get_tag_block_view();
+
+	EXPECT_EQ("0123456789abcde", v.get_destination().str());
+	EXPECT_EQ("src", v.get_source().str());
+	EXPECT_EQ("hello", v.get_text().str());
+}
+
+TEST_F(Test_nmea_tag_block, view_of_malformed_tag_block)
+{
+	for (const auto & t : {"g:1-2-73874,n:157036,s:r003669945,c:1241544035*40", "g:1-2*73",
+			 "n:abc*34", "c:99999999999999999999*59", "c:1234", "c:1234*1"}) {
+		auto s = nmea::make_sentence("$GPBOD,123,T,,M,,*77");
+		s->set_tag_block(t);
+
+		const auto v = s->get_tag_block_view();
+
+		EXPECT_FALSE(v.is_valid()) << t;
+		EXPECT_FALSE(v.is_unix_time_valid()) << t;
+		EXPECT_FALSE(v.is_group_valid()) << t;
+		EXPECT_EQ(t, s->get_tag_block());
+	}
+}
+
+TEST_F(Test_nmea_tag_block, view_updated_by_set_tag_block)
+{
+	auto s = nmea::make_sentence("\\g:1-2-3,c:1234*1C\\$GPBOD,123,T,,M,,*77");
+
+	s->set_tag_block("s:2573135,c:1671620143*0B");
+
+	const auto v = s->get_tag_block_view();
+	EXPECT_FALSE(v.is_group_valid());
+	EXPECT_EQ(1671620143, v.get_unix_time());
+}
+
+TEST_F(Test_nmea_tag_block, view_of_copied_sentence)
+{
+	nmea::bod b;
+	b.set_tag_block("s:2573135,c:1671620143*0B");
+	const nmea::bod copy = b;
+	b.set_tag_block("");
+
+	const auto v = copy.get_tag_block_view();
+
+	EXPECT_EQ("2573135", v.get_source().str());
+	EXPECT_FALSE(b.get_tag_block_view().is_valid());
+}
+
+TEST_F(Test_nmea_tag_block, view_to_tag_block)
+{
+	const auto s = nmea::make_sentence(
+		"\\g:1-2-73874,n:157036,s:r003669945,c:1241544035*4A\\$GPBOD,123,T,,M,,*77");
+
+	const auto t = s->get_tag_block_view().to_tag_block();
+
+	EXPECT_EQ(to_string(nmea::make_tag_block(s->get_tag_block())), to_string(t));
+}
+
+TEST_F(Test_nmea_tag_block, parse_invalid_numbers)
+{
+	EXPECT_ANY_THROW(nmea::make_tag_block("n:abc*34"));
+	EXPECT_ANY_THROW(nmea::make_tag_block("g:1-2*73"));
+	EXPECT_ANY_THROW(nmea::make_tag_block("c:99999999999999999999*59"));
+	EXPECT_ANY_THROW(nmea::make_tag_block("c:1234"));
+}
 }
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/talker_id.hpp>
+#include <marnav/nmea/detail.hpp>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_talker_id : public ::testing::Test
+{
+};
+
+TEST_F(Test_nmea_talker_id, make_talker)
+{
+	EXPECT_EQ(nmea::talker::global_positioning_system, nmea::make_talker("GP"));
+	EXPECT_EQ(nmea::talker::ais_mobile_station, nmea::make_talker("AI"));
+	EXPECT_EQ(nmea::talker::none, nmea::make_talker("QQ"));
+	EXPECT_EQ(nmea::talker::none, nmea::make_talker("gp"));
+}
+
+TEST_F(Test_nmea_talker_id, make_talker_invalid_size)
+{
+	EXPECT_ANY_THROW(nmea::make_talker(""));
+	EXPECT_ANY_THROW(nmea::make_talker("G"));
+	EXPECT_ANY_THROW(nmea::make_talker("GPS"));
+}
+
+TEST_F(Test_nmea_talker_id, to_string)
+{
+	EXPECT_STREQ("", nmea::to_string(nmea::talker::none).c_str());
+	EXPECT_STREQ("GP", nmea::to_string(nmea::talker::global_positioning_system).c_str());
+	EXPECT_STREQ("SA", nmea::to_string(nmea::talker::ais_physical_shore_station).c_str());
+	EXPECT_STREQ("-", nmea::to_string(static_cast<nmea::talker>(9999)).c_str());
+}
+
+TEST_F(Test_nmea_talker_id, find_talker)
+{
+	EXPECT_EQ(nmea::talker::global_positioning_system, nmea::detail::find_talker('G', 'P'));
+	EXPECT_EQ(nmea::talker::none, nmea::detail::find_talker('\0', 'P'));
+	EXPECT_EQ(nmea::talker::none, nmea::detail::find_talker('G', '\0'));
+	EXPECT_EQ(nmea::talker::none, nmea::detail::find_talker('$', 'P'));
+}
+
+TEST_F(Test_nmea_talker_id, round_trip)
+{
+	for (int i = 1; i <= static_cast<int>(nmea::talker::ais_physical_shore_station); ++i) {
+		const auto t = static_cast<nmea::talker>(i);
+		EXPECT_EQ(t, nmea::make_talker(nmea::to_string(t))) << i;
+	}
+}
+}
@@ -59,6 +59,26 @@ TEST_F(Test_nmea_time, invalid_format_for_double)
 	EXPECT_ANY_THROW(nmea::time::parse("123.455.6"));
 }
 
+TEST_F(Test_nmea_time, parse)
+{
+	const auto t = nmea::time::parse("123519.123");
+
+	EXPECT_EQ(12u, t.hour());
+	EXPECT_EQ(35u, t.minutes());
+	EXPECT_EQ(19u, t.seconds());
+	EXPECT_EQ(123u, t.milliseconds());
+}
+
+TEST_F(Test_nmea_time, parse_fractions)
+{
+	EXPECT_EQ(500u, nmea::time::parse("123519.5").milliseconds());
+	EXPECT_EQ(120u, nmea::time::parse("123519.12").milliseconds());
+	EXPECT_EQ(999u, nmea::time::parse("123519.9999").milliseconds());
+	EXPECT_EQ(0u, nmea::time::parse("123519.").milliseconds());
+	EXPECT_ANY_THROW(nmea::time::parse(""));
+	EXPECT_ANY_THROW(nmea::time::parse(".5"));
+}
+
 TEST_F(Test_nmea_time, to_string_no_ms)
 {
 	nmea::time t{1, 2, 3, 0};
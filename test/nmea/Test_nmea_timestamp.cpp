@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <marnav/nmea/timestamp.hpp>
+
+namespace
+{
+using namespace marnav;
+
+class Test_nmea_timestamp : public ::testing::Test
+{
+public:
+	static int64_t ms(const nmea::timestamp & t) { return t.time_since_epoch().count(); }
+};
+
+TEST_F(Test_nmea_timestamp, full_year)
+{
+	EXPECT_EQ(2000u, nmea::full_year(0));
+	EXPECT_EQ(2069u, nmea::full_year(69));
+	EXPECT_EQ(1970u, nmea::full_year(70));
+	EXPECT_EQ(1999u, nmea::full_year(99));
+	EXPECT_EQ(2018u, nmea::full_year(2018));
+}
+
+TEST_F(Test_nmea_timestamp, days_since_epoch)
+{
+	EXPECT_EQ(0, nmea::days_since_epoch(1970, 1, 1));
+	EXPECT_EQ(-1, nmea::days_since_epoch(1969, 12, 31));
+	EXPECT_EQ(10957, nmea::days_since_epoch(2000, 1, 1));
+	EXPECT_EQ(11016, nmea::days_since_epoch(2000, 2, 29));
+	EXPECT_EQ(17532, nmea::days_since_epoch(2018, 1, 1));
+}
+
+TEST_F(Test_nmea_timestamp, to_timestamp)
+{
+	const nmea::date d{7, nmea::month::august, 26};
+	const nmea::time t{20, 10, 34, 500};
+
+	// 2007-08-26T20:10:34.500Z
+	EXPECT_EQ(1188159034500, ms(nmea::to_timestamp(d, t)));
+}
+
+TEST_F(Test_nmea_timestamp, converter_same_as_to_timestamp)
+{
+	nmea::timestamp_converter c;
+	const nmea::date d0{18, nmea::month::march, 1};
+	const nmea::date d1{2018, nmea::month::march, 2};
+	const nmea::time t{23, 59, 59, 999};
+
+	EXPECT_EQ(nmea::to_timestamp(d0, t), c.convert(d0, t));
+	EXPECT_EQ(nmea::to_timestamp(d0, nmea::time{}), c.convert(d0, nmea::time{}));
+	EXPECT_EQ(nmea::to_timestamp(d1, t), c.convert(d1, t));
+	EXPECT_EQ(ms(c.convert(d0, t)) + 1, ms(c.convert(d1, nmea::time{})));
+}
+
+TEST_F(Test_nmea_timestamp, converter_fields)
+{
+	nmea::timestamp_converter c;
+	nmea::timestamp t;
+
+	ASSERT_TRUE(c.convert("260807", "201034.5", t));
+	EXPECT_EQ(1188159034500, ms(t));
+	ASSERT_TRUE(c.convert("260807", "201035", t));
+	EXPECT_EQ(1188159035000, ms(t));
+	ASSERT_TRUE(c.convert("270807", "000000.001", t));
+	EXPECT_EQ(1188172800001, ms(t));
+}
+
+TEST_F(Test_nmea_timestamp, converter_fields_mixed_with_objects)
+{
+	nmea::timestamp_converter c;
+	nmea::timestamp t;
+
+	ASSERT_TRUE(c.convert("260807", "201034", t));
+	c.convert(nmea::date{7, nmea::month::august, 27}, nmea::time{});
+	ASSERT_TRUE(c.convert("260807", "201034", t));
+	EXPECT_EQ(1188159034000, ms(t));
+}
+
+TEST_F(Test_nmea_timestamp, converter_invalid_fields)
+{
+	nmea::timestamp_converter c;
+	nmea::timestamp t{std::chrono::milliseconds{42}};
+
+	EXPECT_FALSE(c.convert("", "201034", t));
+	EXPECT_FALSE(c.convert("260807", "", t));
+	EXPECT_FALSE(c.convert("2608x7", "201034", t));
+	EXPECT_FALSE(c.convert("260807", "2010.3.4", t));
+	EXPECT_FALSE(c.convert("260807", "241034", t));
+	EXPECT_FALSE(c.convert("320807", "201034", t));
+	EXPECT_FALSE(c.convert("290207", "201034", t));
+	EXPECT_FALSE(c.convert("000000", "201034", t));
+	EXPECT_FALSE(c.convert("261307", "201034", t));
+	EXPECT_EQ(42, ms(t));
+
+	EXPECT_TRUE(c.convert("290208", "201034", t));
+}
+}
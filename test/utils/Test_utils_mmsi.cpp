@@ -140,6 +140,10 @@ TEST_F(Test_utils_mmsi, ais_aids)
 	EXPECT_EQ(0u, m.mob_mid());
 	EXPECT_EQ(0u, m.mob_id());
 	EXPECT_EQ(0u, m.sar_mid());
+	EXPECT_EQ(0u, m.sart_mid());
+	EXPECT_EQ(269u, m.ais_aids_mid());
+	EXPECT_EQ(1111u, m.ais_aids_id());
+	EXPECT_EQ(269u, m.mid());
 }
 
 TEST_F(Test_utils_mmsi, coastal)
@@ -254,6 +258,12 @@ TEST_F(Test_utils_mmsi, sart)
 	EXPECT_EQ(0u, m.mob_mid());
 	EXPECT_EQ(0u, m.mob_id());
 	EXPECT_EQ(0u, m.sar_mid());
+	EXPECT_EQ(0u, m.ais_aids_mid());
+	EXPECT_EQ(269u, m.sart_mid());
+	EXPECT_EQ(123u, m.sart_id());
+	EXPECT_EQ(0u, m.epirb_mid());
+	EXPECT_EQ(0u, m.epirb_id());
+	EXPECT_EQ(269u, m.mid());
 }
 
 TEST_F(Test_utils_mmsi, mob)
@@ -308,5 +318,10 @@ TEST_F(Test_utils_mmsi, eprib_ais)
 	EXPECT_EQ(0u, m.mob_mid());
 	EXPECT_EQ(0u, m.mob_id());
 	EXPECT_EQ(0u, m.sar_mid());
+	EXPECT_EQ(0u, m.sart_mid());
+	EXPECT_EQ(0u, m.sart_id());
+	EXPECT_EQ(269u, m.epirb_mid());
+	EXPECT_EQ(123u, m.epirb_id());
+	EXPECT_EQ(269u, m.mid());
 }
 }
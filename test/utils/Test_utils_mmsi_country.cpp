@@ -27,4 +27,82 @@ TEST_F(Test_utils_mmsi_country, valid_code)
 	EXPECT_STREQ("CH", info.code.c_str());
 	EXPECT_STREQ("Switzerland", info.name.c_str());
 }
+
+TEST_F(Test_utils_mmsi_country, sar_aircraft)
+{
+	const auto info = marnav::utils::mmsi_country(mmsi{111269123});
+
+	EXPECT_EQ(269u, info.mid);
+	EXPECT_STREQ("CH", info.code.c_str());
+}
+
+TEST_F(Test_utils_mmsi_country, coastal_not_considered)
+{
+	const auto info = marnav::utils::mmsi_country(mmsi{2691111});
+
+	EXPECT_EQ(0u, info.mid);
+	EXPECT_TRUE(info.code.empty());
+}
+
+TEST_F(Test_utils_mmsi_country, find_mmsi_country)
+{
+	EXPECT_EQ(nullptr, marnav::utils::find_mmsi_country(0));
+	EXPECT_EQ(nullptr, marnav::utils::find_mmsi_country(200));
+	EXPECT_EQ(nullptr, marnav::utils::find_mmsi_country(1000));
+
+	const auto first = marnav::utils::find_mmsi_country(201);
+	ASSERT_NE(nullptr, first);
+	EXPECT_STREQ("AL", first->code.c_str());
+
+	const auto last = marnav::utils::find_mmsi_country(775);
+	ASSERT_NE(nullptr, last);
+	EXPECT_STREQ("VE", last->code.c_str());
+}
+
+TEST_F(Test_utils_mmsi_country, find_mmsi_country_all_mids)
+{
+	for (uint32_t mid = 0; mid < 1000; ++mid) {
+		const auto info = marnav::utils::find_mmsi_country(mid);
+		if (info) {
+			EXPECT_EQ(mid, info->mid);
+		}
+	}
+}
+
+TEST_F(Test_utils_mmsi_country, classify_mmsi)
+{
+	using marnav::utils::mmsi_type;
+
+	const std::vector<mmsi> m = {mmsi{269104520}, mmsi{26911111}, mmsi{2691111},
+		mmsi{982691111}, mmsi{992691111}, mmsi{111269123}, mmsi{970269123}, mmsi{972269123},
+		mmsi{974269123}, mmsi{100000000}};
+	const mmsi_type types[] = {mmsi_type::regular, mmsi_type::group, mmsi_type::coastal,
+		mmsi_type::auxiliary, mmsi_type::ais_aids, mmsi_type::sar_aircraft, mmsi_type::sart,
+		mmsi_type::mob, mmsi_type::epirb_ais, mmsi_type::unknown};
+
+	const auto result = marnav::utils::classify_mmsi(m);
+
+	ASSERT_EQ(m.size(), result.size());
+	for (std::size_t i = 0; i < m.size(); ++i) {
+		EXPECT_EQ(types[i], result[i].type) << i;
+		if (result[i].type == mmsi_type::unknown) {
+			EXPECT_EQ(0u, result[i].mid);
+			EXPECT_EQ(nullptr, result[i].country);
+		} else {
+			EXPECT_EQ(269u, result[i].mid) << i;
+			ASSERT_NE(nullptr, result[i].country) << i;
+			EXPECT_STREQ("CH", result[i].country->code.c_str()) << i;
+		}
+	}
+}
+
+TEST_F(Test_utils_mmsi_country, classify_mmsi_same_mid_as_mmsi)
+{
+	const std::vector<mmsi> m = {mmsi{}, mmsi{269104520}, mmsi{26911111}, mmsi{2691111},
+		mmsi{982691111}, mmsi{992691111}, mmsi{111269123}, mmsi{970269123}, mmsi{972269123},
+		mmsi{974269123}};
+
+	for (const auto & v : m)
+		EXPECT_EQ(v.mid(), marnav::utils::classify_mmsi(v).mid) << static_cast<uint32_t>(v);
+}
 }
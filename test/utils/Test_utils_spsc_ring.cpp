@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <marnav/utils/spsc_ring.hpp>
+#include <string>
+#include <thread>
+
+namespace
+{
+using namespace marnav::utils;
+
+class Test_utils_spsc_ring : public ::testing::Test
+{
+};
+
+TEST_F(Test_utils_spsc_ring, invalid_capacity)
+{
+	EXPECT_ANY_THROW(spsc_ring<int>{0});
+}
+
+TEST_F(Test_utils_spsc_ring, capacity_rounded_up_to_power_of_two)
+{
+	EXPECT_EQ(1u, spsc_ring<int>{1}.capacity());
+	EXPECT_EQ(4u, spsc_ring<int>{3}.capacity());
+	EXPECT_EQ(16u, spsc_ring<int>{16}.capacity());
+	EXPECT_EQ(32u, spsc_ring<int>{17}.capacity());
+}
+
+TEST_F(Test_utils_spsc_ring, empty_ring)
+{
+	spsc_ring<int> ring{4};
+	int value = 0;
+
+	EXPECT_TRUE(ring.empty());
+	EXPECT_EQ(0u, ring.size());
+	EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST_F(Test_utils_spsc_ring, first_in_first_out)
+{
+	spsc_ring<int> ring{4};
+
+	EXPECT_TRUE(ring.try_push(1));
+	EXPECT_TRUE(ring.try_push(2));
+	EXPECT_TRUE(ring.try_push(3));
+	EXPECT_EQ(3u, ring.size());
+
+	int value = 0;
+	EXPECT_TRUE(ring.try_pop(value));
+	EXPECT_EQ(1, value);
+	EXPECT_TRUE(ring.try_pop(value));
+	EXPECT_EQ(2, value);
+	EXPECT_TRUE(ring.try_pop(value));
+	EXPECT_EQ(3, value);
+	EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(Test_utils_spsc_ring, full_ring_rejects_values)
+{
+	spsc_ring<std::string> ring{2};
+	std::string s = "three";
+
+	EXPECT_TRUE(ring.try_push("one"));
+	EXPECT_TRUE(ring.try_push("two"));
+	EXPECT_FALSE(ring.try_push(std::move(s)));
+	EXPECT_STREQ("three", s.c_str()); // not moved on failure
+	EXPECT_EQ(2u, ring.size());
+}
+
+TEST_F(Test_utils_spsc_ring, wrap_around)
+{
+	spsc_ring<int> ring{4};
+	int value = 0;
+
+	for (int i = 0; i < 100; ++i) {
+		ASSERT_TRUE(ring.try_push(std::move(i)));
+		ASSERT_TRUE(ring.try_pop(value));
+		EXPECT_EQ(i, value);
+	}
+	EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(Test_utils_spsc_ring, push_drop_oldest)
+{
+	spsc_ring<int> ring{4};
+
+	for (int i = 0; i < 4; ++i)
+		EXPECT_EQ(0u, ring.push_drop_oldest(std::move(i)));
+	EXPECT_EQ(1u, ring.push_drop_oldest(4));
+	EXPECT_EQ(1u, ring.push_drop_oldest(5));
+	EXPECT_EQ(4u, ring.size());
+
+	int value = 0;
+	for (int i = 2; i < 6; ++i) {
+		EXPECT_TRUE(ring.try_pop(value));
+		EXPECT_EQ(i, value);
+	}
+	EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(Test_utils_spsc_ring, concurrent_producer_and_consumer)
+{
+	static const int n = 100000;
+	spsc_ring<int> ring{64};
+
+	std::thread producer{[&ring]() {
+		for (int i = 0; i < n; ++i)
+			while (!ring.try_push(std::move(i)))
+				std::this_thread::yield();
+	}};
+
+	int expected = 0;
+	int value = 0;
+	while (expected < n) {
+		if (ring.try_pop(value)) {
+			ASSERT_EQ(expected, value);
+			++expected;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+	EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(Test_utils_spsc_ring, concurrent_drop_oldest_keeps_order)
+{
+	static const int n = 100000;
+	spsc_ring<int> ring{16};
+	std::size_t dropped = 0;
+
+	std::thread producer{[&ring, &dropped]() {
+		for (int i = 0; i < n; ++i)
+			dropped += ring.push_drop_oldest(std::move(i));
+		dropped += ring.push_drop_oldest(-1);
+	}};
+
+	std::size_t received = 0;
+	int last = -1;
+	int value = 0;
+	for (;;) {
+		if (!ring.try_pop(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+		if (value < 0)
+			break;
+		ASSERT_GT(value, last);
+		last = value;
+		++received;
+	}
+	producer.join();
+
+	EXPECT_EQ(n - 1, last);
+	EXPECT_EQ(static_cast<std::size_t>(n), received + dropped);
+}
+}
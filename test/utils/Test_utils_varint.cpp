@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <marnav/utils/varint.hpp>
+#include <limits>
+
+namespace
+{
+using namespace marnav::utils;
+
+class Test_utils_varint : public ::testing::Test
+{
+};
+
+TEST_F(Test_utils_varint, encode_small_values)
+{
+	std::vector<uint8_t> buffer;
+	append_varint(buffer, 0);
+	append_varint(buffer, 1);
+	append_varint(buffer, 127);
+
+	const std::vector<uint8_t> expected = {0x00, 0x01, 0x7f};
+	EXPECT_EQ(expected, buffer);
+}
+
+TEST_F(Test_utils_varint, encode_multi_byte_values)
+{
+	std::vector<uint8_t> buffer;
+	append_varint(buffer, 128);
+	append_varint(buffer, 300);
+
+	const std::vector<uint8_t> expected = {0x80, 0x01, 0xac, 0x02};
+	EXPECT_EQ(expected, buffer);
+}
+
+TEST_F(Test_utils_varint, round_trip)
+{
+	const std::vector<uint64_t> values = {0u, 1u, 127u, 128u, 16383u, 16384u, 4702404u,
+		std::numeric_limits<uint32_t>::max(), std::numeric_limits<uint64_t>::max()};
+
+	std::vector<uint8_t> buffer;
+	for (const auto v : values)
+		append_varint(buffer, v);
+
+	std::size_t pos = 0;
+	for (const auto v : values) {
+		uint64_t value = 0;
+		ASSERT_TRUE(read_varint(buffer.data(), buffer.size(), pos, value));
+		EXPECT_EQ(v, value);
+	}
+	EXPECT_EQ(buffer.size(), pos);
+}
+
+TEST_F(Test_utils_varint, maximum_size)
+{
+	std::vector<uint8_t> buffer;
+	append_varint(buffer, std::numeric_limits<uint64_t>::max());
+
+	EXPECT_EQ(max_varint_size, buffer.size());
+}
+
+TEST_F(Test_utils_varint, truncated)
+{
+	const uint8_t data[] = {0x80, 0x80};
+	std::size_t pos = 0;
+	uint64_t value = 0;
+
+	EXPECT_FALSE(read_varint(data, sizeof(data), pos, value));
+	EXPECT_EQ(0u, pos);
+}
+
+TEST_F(Test_utils_varint, too_large)
+{
+	const uint8_t data[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02};
+	std::size_t pos = 0;
+	uint64_t value = 0;
+
+	EXPECT_FALSE(read_varint(data, sizeof(data), pos, value));
+	EXPECT_EQ(0u, pos);
+}
+}